@@ -1,19 +1,199 @@
 module;
 
-/*
-    DEBUG
-*/
+#include <atomic>      // std::atomic
+#include <bit>         // std::bit_width
+#include <concepts>    // std::predicate
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <cstring>     // std::memcmp
+#include <functional>  // std::identity, std::invoke
+#include <iterator>    // std::iterator_traits, std::ranges::iter_swap, ...
+#include <memory>      // std::to_address, std::allocator, std::destroy, ...
+#include <type_traits> // std::is_integral_v, std::make_unsigned_t
+#include <utility>     // std::pair, std::move
 
-#include <type_traits>
-
-#include <iterator>
+#include "../internal/simd/bytes.hpp"
+#include "../internal/simd/compact.hpp"
+#include "../internal/simd/find.hpp"
 
 export module algorithm;
 
-// import type_traits;
-// import utility;
+import execution;
+import functional;
+import type_traits;
+import vector;
 
-namespace isl {
+namespace isl::detail {
+namespace simd = isl::internal::simd;
+
+// Element types the search kernels handle, as the kernels see them:
+// integers by their unsigned bit pattern, floats as themselves.
+template <class T>
+concept simd_searchable =
+    (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <class T> struct simd_lane {
+  using type = T;
+};
+template <class T>
+  requires std::is_integral_v<T>
+struct simd_lane<T> {
+  using type = std::make_unsigned_t<T>;
+};
+template <class T> using simd_lane_t = typename simd_lane<T>::type;
+
+// find and count take the kernels when the range is contiguous and
+// comparing an element with `value` is comparing it with value converted
+// to the element type. That holds between any two integer types, which
+// compare in a common type both convert to losslessly, and between a
+// floating-point type and itself.
+template <class It, class T>
+concept simd_find_range =
+    std::contiguous_iterator<It> &&
+    simd_searchable<std::iter_value_t<It>> &&
+    ((std::is_integral_v<std::iter_value_t<It>> && std::is_integral_v<T> &&
+      !std::is_same_v<T, bool>) ||
+     std::is_same_v<std::iter_value_t<It>, T>);
+
+// If value does not survive the conversion no element can equal it: it
+// is out of the element type's range, or NaN.
+template <class It, class T>
+std::size_t simd_find(It first, It last, const T &value) noexcept {
+  using lane = simd_lane_t<std::iter_value_t<It>>;
+  auto target = static_cast<std::iter_value_t<It>>(value);
+  if (!(target == value)) {
+    return simd::not_found;
+  }
+  return simd::find_value(
+      reinterpret_cast<const lane *>(std::to_address(first)),
+      static_cast<std::size_t>(last - first), static_cast<lane>(target));
+}
+
+template <class It, class T>
+std::size_t simd_count(It first, It last, const T &value) noexcept {
+  using lane = simd_lane_t<std::iter_value_t<It>>;
+  auto target = static_cast<std::iter_value_t<It>>(value);
+  if (!(target == value)) {
+    return 0;
+  }
+  return simd::count_value(
+      reinterpret_cast<const lane *>(std::to_address(first)),
+      static_cast<std::size_t>(last - first), static_cast<lane>(target));
+}
+
+// Types whose == compares object representations, so that ranges of them
+// compare as bytes. Floats are not: 0.0 == -0.0 and NaN != NaN.
+template <class T>
+concept bitwise_comparable = std::is_integral_v<T> || std::is_enum_v<T> ||
+                             std::is_pointer_v<T>;
+
+// Types whose < orders like memcmp orders their bytes.
+template <class T>
+concept memcmp_orderable =
+    std::is_same_v<T, unsigned char> || std::is_same_v<T, char8_t> ||
+    std::is_same_v<T, bool> ||
+    (std::is_same_v<T, char> && static_cast<char>(-1) > 0) ||
+    (std::is_enum_v<T> && sizeof(T) == 1 &&
+     std::is_unsigned_v<std::underlying_type_t<T>>);
+
+template <class It1, class It2>
+concept bitwise_comparable_ranges =
+    std::contiguous_iterator<It1> && std::contiguous_iterator<It2> &&
+    std::is_same_v<std::iter_value_t<It1>, std::iter_value_t<It2>> &&
+    bitwise_comparable<std::iter_value_t<It1>>;
+
+/// Index of the first of n elements where the ranges differ, or n.
+template <class It1, class It2>
+std::size_t bitwise_mismatch(It1 first1, It2 first2, std::size_t n) noexcept {
+  using T = std::iter_value_t<It1>;
+  const T *a = std::to_address(first1);
+  const T *b = std::to_address(first2);
+  if (n * sizeof(T) < 16) {
+    // shorter than a vector, where whole elements beat bytes
+    std::size_t i = 0;
+    while (i != n && a[i] == b[i]) {
+      ++i;
+    }
+    return i;
+  }
+  return simd::mismatch(reinterpret_cast<const char *>(a),
+                        reinterpret_cast<const char *>(b), n * sizeof(T)) /
+         sizeof(T);
+}
+
+// Elements per block of the predicate loops below. The predicate runs
+// over a whole block into a mask that is tested once, so a simple
+// predicate vectorizes instead of branching on every element.
+inline constexpr std::size_t predicate_block = 32;
+
+// The isl comparisons, whose calls on arithmetic values have no effects.
+template <class F> inline constexpr bool is_comparison = false;
+template <class T> inline constexpr bool is_comparison<equal_to<T>> = true;
+template <class T> inline constexpr bool is_comparison<not_equal_to<T>> = true;
+template <class T> inline constexpr bool is_comparison<less<T>> = true;
+template <class T> inline constexpr bool is_comparison<greater<T>> = true;
+template <class T> inline constexpr bool is_comparison<less_equal<T>> = true;
+template <class T>
+inline constexpr bool is_comparison<greater_equal<T>> = true;
+
+// Predicates the block loops may run past a match: a comparison bound with
+// bind_front or bind_back to an arithmetic value. Any other predicate may
+// be costly or have effects, so it runs only as often as it must.
+template <class Predicate> inline constexpr bool is_block_predicate = false;
+template <bool Front, class F, class... Bound>
+inline constexpr bool is_block_predicate<bound_call<Front, F, Bound...>> =
+    is_comparison<F> && sizeof...(Bound) == 1 &&
+    (std::is_arithmetic_v<Bound> && ...);
+
+// Ranges the predicate loops take: contiguous, of arithmetic values, with a
+// predicate that is cheap and unobservable to evaluate past a match.
+template <class It, class Predicate>
+concept block_predicate_range =
+    std::contiguous_iterator<It> &&
+    std::is_arithmetic_v<std::iter_value_t<It>> &&
+    is_block_predicate<Predicate> &&
+    std::predicate<Predicate &, std::iter_reference_t<It>>;
+
+/// Whether bool(p(x)) == Value for some x in the n elements at s.
+template <bool Value, class T, class Predicate>
+constexpr bool any_in_blocks(const T *s, std::size_t n, Predicate &p) {
+  std::size_t i = 0;
+  for (; i + predicate_block <= n; i += predicate_block) {
+    unsigned mask = 0;
+    for (std::size_t j = 0; j != predicate_block; ++j) {
+      mask |= static_cast<bool>(p(s[i + j])) == Value;
+    }
+    if (mask != 0)
+      return true;
+  }
+  unsigned mask = 0;
+  for (; i != n; ++i) {
+    mask |= static_cast<bool>(p(s[i])) == Value;
+  }
+  return mask != 0;
+}
+
+template <class T, class Predicate>
+constexpr std::size_t count_in_blocks(const T *s, std::size_t n,
+                                      Predicate &p) {
+  std::size_t count = 0;
+  std::size_t i = 0;
+  for (; i + predicate_block <= n; i += predicate_block) {
+    unsigned hits = 0;
+    for (std::size_t j = 0; j != predicate_block; ++j) {
+      hits += static_cast<bool>(p(s[i + j]));
+    }
+    count += hits;
+  }
+  for (; i != n; ++i) {
+    count += static_cast<bool>(p(s[i]));
+  }
+  return count;
+}
+} // namespace isl::detail
+
+export namespace isl {
 template <class InputIt, class UnaryPredicate>
 constexpr bool all_of(InputIt first, InputIt last, UnaryPredicate p);
 template <class InputIt, class UnaryPredicate>
@@ -22,9 +202,12 @@ template <class InputIt, class UnaryPredicate>
 constexpr bool none_of(InputIt first, InputIt last, UnaryPredicate p);
 
 template <class InputIt, class Function>
-constexpr Function for_each(InputIt first, InputIt last, Function f);
+constexpr Function for_each(InputIt first, InputIt last, Function f) requires(
+    isl::is_move_constructible_v<Function> // Enforce preconditions
+);
 template <class InputIt, class Size, class Function>
-constexpr InputIt for_each_n(InputIt first, Size n, Function f);
+constexpr InputIt for_each_n(InputIt first, Size n,
+                             Function f) requires(isl::is_integral_v<Size>);
 
 template <class InputIt, class T>
 constexpr typename std::iterator_traits<InputIt>::difference_type
@@ -47,6 +230,26 @@ constexpr std::pair<InputIt1, InputIt2>
 mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
          BinaryPredicate p);
 
+template <class InputIt1, class InputIt2>
+constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2);
+template <class InputIt1, class InputIt2, class BinaryPredicate>
+constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                     BinaryPredicate p);
+template <class InputIt1, class InputIt2>
+constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                     InputIt2 last2);
+template <class InputIt1, class InputIt2, class BinaryPredicate>
+constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                     InputIt2 last2, BinaryPredicate p);
+
+template <class InputIt1, class InputIt2>
+constexpr bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
+                                       InputIt2 first2, InputIt2 last2);
+template <class InputIt1, class InputIt2, class Compare>
+constexpr bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
+                                       InputIt2 first2, InputIt2 last2,
+                                       Compare comp);
+
 template <class InputIterator, class T>
 constexpr InputIterator find(InputIterator first, InputIterator last,
                              const T &value);
@@ -69,11 +272,83 @@ constexpr ForwardIt adjacent_find(ForwardIt first, ForwardIt last);
 template <class ForwardIt, class BinaryPredicate>
 constexpr ForwardIt adjacent_find(ForwardIt first, ForwardIt last,
                                   BinaryPredicate p);
+
+template <class ForwardIt, class T>
+constexpr ForwardIt remove(ForwardIt first, ForwardIt last, const T &value);
+template <class ForwardIt, class UnaryPredicate>
+constexpr ForwardIt remove_if(ForwardIt first, ForwardIt last,
+                              UnaryPredicate p);
+template <class InputIt, class OutputIt, class UnaryPredicate>
+constexpr OutputIt copy_if(InputIt first, InputIt last, OutputIt d_first,
+                           UnaryPredicate pred);
+template <class ForwardIt>
+constexpr ForwardIt unique(ForwardIt first, ForwardIt last);
+template <class ForwardIt, class BinaryPredicate>
+constexpr ForwardIt unique(ForwardIt first, ForwardIt last,
+                           BinaryPredicate p);
+template <class ForwardIt, class UnaryPredicate>
+constexpr ForwardIt partition(ForwardIt first, ForwardIt last,
+                              UnaryPredicate p);
+
+template <class ForwardIt>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last);
+template <class ForwardIt, class Compare>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last, Compare comp);
+template <class ForwardIt>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last);
+template <class ForwardIt, class Compare>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last,
+                                    Compare comp);
+
+template <class RandomIt> constexpr void sort(RandomIt first, RandomIt last);
+template <class RandomIt, class Compare>
+constexpr void sort(RandomIt first, RandomIt last, Compare comp);
+template <class RandomIt> void stable_sort(RandomIt first, RandomIt last);
+template <class RandomIt, class Compare>
+void stable_sort(RandomIt first, RandomIt last, Compare comp);
+template <class RandomIt>
+constexpr void partial_sort(RandomIt first, RandomIt middle, RandomIt last);
+template <class RandomIt, class Compare>
+constexpr void partial_sort(RandomIt first, RandomIt middle, RandomIt last,
+                            Compare comp);
+
+template <class ForwardIt, class T>
+constexpr ForwardIt lower_bound(ForwardIt first, ForwardIt last,
+                                const T &value);
+template <class ForwardIt, class T, class Compare>
+constexpr ForwardIt lower_bound(ForwardIt first, ForwardIt last,
+                                const T &value, Compare comp);
+template <class ForwardIt, class T>
+constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last,
+                                const T &value);
+template <class ForwardIt, class T, class Compare>
+constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last,
+                                const T &value, Compare comp);
+template <class ForwardIt, class T>
+constexpr std::pair<ForwardIt, ForwardIt>
+equal_range(ForwardIt first, ForwardIt last, const T &value);
+template <class ForwardIt, class T, class Compare>
+constexpr std::pair<ForwardIt, ForwardIt>
+equal_range(ForwardIt first, ForwardIt last, const T &value, Compare comp);
+template <class ForwardIt, class T>
+constexpr bool binary_search(ForwardIt first, ForwardIt last, const T &value);
+template <class ForwardIt, class T, class Compare>
+constexpr bool binary_search(ForwardIt first, ForwardIt last, const T &value,
+                             Compare comp);
 } // namespace isl
 
 namespace isl {
+// Over contiguous ranges of arithmetic values, all_of, any_of, none_of and
+// count_if evaluate a comparison bound with bind_front or bind_back block by
+// block, so it may run on up to a block of elements past the one that
+// decides the result. Other predicates run one element at a time.
+
 template <class InputIt, class UnaryPredicate>
 constexpr bool all_of(InputIt first, InputIt last, UnaryPredicate p) {
+  if constexpr (detail::block_predicate_range<InputIt, UnaryPredicate>) {
+    return !detail::any_in_blocks<false>(
+        std::to_address(first), static_cast<std::size_t>(last - first), p);
+  }
   for (auto it = first; it != last; ++it)
     if (p(*it) == false)
       return false;
@@ -82,6 +357,10 @@ constexpr bool all_of(InputIt first, InputIt last, UnaryPredicate p) {
 
 template <class InputIt, class UnaryPredicate>
 constexpr bool any_of(InputIt first, InputIt last, UnaryPredicate p) {
+  if constexpr (detail::block_predicate_range<InputIt, UnaryPredicate>) {
+    return detail::any_in_blocks<true>(
+        std::to_address(first), static_cast<std::size_t>(last - first), p);
+  }
   for (auto it = first; it != last; ++it)
     if (p(*it) == true)
       return true;
@@ -90,6 +369,10 @@ constexpr bool any_of(InputIt first, InputIt last, UnaryPredicate p) {
 
 template <class InputIt, class UnaryPredicate>
 constexpr bool none_of(InputIt first, InputIt last, UnaryPredicate p) {
+  if constexpr (detail::block_predicate_range<InputIt, UnaryPredicate>) {
+    return !detail::any_in_blocks<true>(
+        std::to_address(first), static_cast<std::size_t>(last - first), p);
+  }
   for (auto it = first; it != last; ++it)
     if (p(*it) == true)
       return false;
@@ -117,6 +400,13 @@ constexpr InputIt for_each_n(InputIt first, Size n,
 template <class InputIt, class T>
 constexpr typename std::iterator_traits<InputIt>::difference_type
 count(InputIt first, InputIt last, const T &value) {
+  if constexpr (detail::simd_find_range<InputIt, T>) {
+    if (!std::is_constant_evaluated()) {
+      return static_cast<
+          typename std::iterator_traits<InputIt>::difference_type>(
+          detail::simd_count(first, last, value));
+    }
+  }
   typename std::iterator_traits<InputIt>::difference_type counter{0};
   for (; first != last; ++first) {
     if (*first == value)
@@ -127,6 +417,12 @@ count(InputIt first, InputIt last, const T &value) {
 template <class InputIt, class UnaryPredicate>
 constexpr typename std::iterator_traits<InputIt>::difference_type
 count_if(InputIt first, InputIt last, UnaryPredicate p) {
+  if constexpr (detail::block_predicate_range<InputIt, UnaryPredicate>) {
+    return static_cast<
+        typename std::iterator_traits<InputIt>::difference_type>(
+        detail::count_in_blocks(std::to_address(first),
+                                static_cast<std::size_t>(last - first), p));
+  }
   typename std::iterator_traits<InputIt>::difference_type counter{0};
   for (; first != last; ++first) {
     if (p(*first))
@@ -138,11 +434,19 @@ count_if(InputIt first, InputIt last, UnaryPredicate p) {
 template <class InputIt1, class InputIt2>
 constexpr std::pair<InputIt1, InputIt2>
 mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+  if constexpr (detail::bitwise_comparable_ranges<InputIt1, InputIt2>) {
+    if (!std::is_constant_evaluated()) {
+      auto index = static_cast<std::iter_difference_t<InputIt1>>(
+          detail::bitwise_mismatch(first1, first2,
+                                   static_cast<std::size_t>(last1 - first1)));
+      return std::pair(first1 + index, first2 + index);
+    }
+  }
   for (; first1 != last1; ++first1, ++first2) {
     if (*first1 != *first2)
-      return isl::pair(first1, first2);
+      return std::pair(first1, first2);
   }
-  return isl::pair(last1, first2);
+  return std::pair(last1, first2);
 }
 
 template <class InputIt1, class InputIt2, class BinaryPredicate>
@@ -150,19 +454,26 @@ constexpr std::pair<InputIt1, InputIt2>
 mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, BinaryPredicate p) {
   for (; first1 != last1; ++first1, ++first2) {
     if (!p(*first1, *first2))
-      return isl::pair(first1, first2);
+      return std::pair(first1, first2);
   }
-  return isl::pair(last1, first2);
+  return std::pair(last1, first2);
 }
 
 template <class InputIt1, class InputIt2>
 constexpr std::pair<InputIt1, InputIt2>
 mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2) {
+  if constexpr (detail::bitwise_comparable_ranges<InputIt1, InputIt2>) {
+    if (!std::is_constant_evaluated()) {
+      auto n = last1 - first1 < last2 - first2 ? last1 - first1
+                                                : last2 - first2;
+      return isl::mismatch(first1, first1 + n, first2);
+    }
+  }
   for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
     if (*first1 != *first2)
-      return isl::pair(first1, first2);
+      return std::pair(first1, first2);
   }
-  return isl::pair(last1, last2);
+  return std::pair(first1, first2);
 }
 
 template <class InputIt1, class InputIt2, class BinaryPredicate>
@@ -171,14 +482,98 @@ mismatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
          BinaryPredicate p) {
   for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
     if (!p(*first1, *first2))
-      return isl::pair(first1, first2);
+      return std::pair(first1, first2);
+  }
+  return std::pair(first1, first2);
+}
+
+template <class InputIt1, class InputIt2>
+constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+  return isl::mismatch(first1, last1, first2).first == last1;
+}
+
+template <class InputIt1, class InputIt2, class BinaryPredicate>
+constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                     BinaryPredicate p) {
+  return isl::mismatch(first1, last1, first2, p).first == last1;
+}
+
+template <class InputIt1, class InputIt2>
+constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                     InputIt2 last2) {
+  if constexpr (std::random_access_iterator<InputIt1> &&
+                std::random_access_iterator<InputIt2>) {
+    if (last1 - first1 != last2 - first2)
+      return false;
+    return isl::mismatch(first1, last1, first2).first == last1;
+  } else {
+    auto [it1, it2] = isl::mismatch(first1, last1, first2, last2);
+    return it1 == last1 && it2 == last2;
+  }
+}
+
+template <class InputIt1, class InputIt2, class BinaryPredicate>
+constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                     InputIt2 last2, BinaryPredicate p) {
+  if constexpr (std::random_access_iterator<InputIt1> &&
+                std::random_access_iterator<InputIt2>) {
+    if (last1 - first1 != last2 - first2)
+      return false;
+  }
+  auto [it1, it2] = isl::mismatch(first1, last1, first2, last2, p);
+  return it1 == last1 && it2 == last2;
+}
+
+template <class InputIt1, class InputIt2>
+constexpr bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
+                                       InputIt2 first2, InputIt2 last2) {
+  if constexpr (detail::bitwise_comparable_ranges<InputIt1, InputIt2>) {
+    if (!std::is_constant_evaluated()) {
+      auto n1 = static_cast<std::size_t>(last1 - first1);
+      auto n2 = static_cast<std::size_t>(last2 - first2);
+      std::size_t n = n1 < n2 ? n1 : n2;
+      if constexpr (detail::memcmp_orderable<std::iter_value_t<InputIt1>>) {
+        int order = n == 0 ? 0
+                           : std::memcmp(std::to_address(first1),
+                                         std::to_address(first2), n);
+        return order != 0 ? order < 0 : n1 < n2;
+      } else {
+        auto index = detail::bitwise_mismatch(first1, first2, n);
+        return index != n ? first1[index] < first2[index] : n1 < n2;
+      }
+    }
+  }
+  for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+    if (*first1 < *first2)
+      return true;
+    if (*first2 < *first1)
+      return false;
+  }
+  return first1 == last1 && first2 != last2;
+}
+
+template <class InputIt1, class InputIt2, class Compare>
+constexpr bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
+                                       InputIt2 first2, InputIt2 last2,
+                                       Compare comp) {
+  for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
+    if (comp(*first1, *first2))
+      return true;
+    if (comp(*first2, *first1))
+      return false;
   }
-  return isl::pair(last1, last2);
+  return first1 == last1 && first2 != last2;
 }
 
 template <class InputIterator, class T>
 constexpr InputIterator find(InputIterator first, InputIterator last,
                              const T &value) {
+  if constexpr (detail::simd_find_range<InputIterator, T>) {
+    if (!std::is_constant_evaluated()) {
+      std::size_t index = detail::simd_find(first, last, value);
+      return index == detail::simd::not_found ? last : first + index;
+    }
+  }
   for (; first != last; ++first) {
     if (*first == value)
       return first;
@@ -241,4 +636,1353 @@ constexpr ForwardIt adjacent_find(ForwardIt first, ForwardIt last,
   }
   return last;
 }
-} // namespace isl
\ No newline at end of file
+} // namespace isl
+// removing and partitioning
+
+namespace isl::detail {
+// Ranges the compaction kernels take: contiguous, of the element types
+// of the search kernels that are 32 or 64 bits wide.
+template <class It>
+concept simd_compactable =
+    std::contiguous_iterator<It> && simd_searchable<std::iter_value_t<It>> &&
+    (sizeof(std::iter_value_t<It>) == 4 || sizeof(std::iter_value_t<It>) == 8);
+
+template <class It, class Predicate>
+concept simd_compactable_by =
+    simd_compactable<It> &&
+    std::predicate<Predicate &, const std::iter_value_t<It> &>;
+
+template <class It> auto *compact_lanes(It it) noexcept {
+  using lane = simd_lane_t<std::iter_value_t<It>>;
+  auto *element = std::to_address(it);
+  if constexpr (std::is_const_v<std::remove_pointer_t<decltype(element)>>) {
+    return reinterpret_cast<const lane *>(element);
+  } else {
+    return reinterpret_cast<lane *>(element);
+  }
+}
+
+// Keeps the elements x of the range at `first` with bool(p(x)) == Value.
+template <bool Value, class It, class Predicate>
+auto keep_where(Predicate &p) noexcept {
+  using lane = simd_lane_t<std::iter_value_t<It>>;
+  return simd::keep_where<lane, std::iter_value_t<It>, Predicate, Value>{p};
+}
+
+// Compacts the range in place and returns its new end.
+template <class It, class Keep> It simd_compact(It first, It last, Keep keep) {
+  auto *s = compact_lanes(first);
+  auto n = static_cast<std::size_t>(last - first);
+  return first + simd::compact(s, n, s, keep);
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// Moves the elements not equal to `value` to the front, keeping their
+/// order, and returns the end of them. Contiguous ranges of 32- and
+/// 64-bit integers and floats are compacted a SIMD block at a time.
+template <class ForwardIt, class T>
+constexpr ForwardIt remove(ForwardIt first, ForwardIt last,
+                           const T &value) {
+  if constexpr (detail::simd_compactable<ForwardIt> &&
+                detail::simd_find_range<ForwardIt, T>) {
+    if (!std::is_constant_evaluated()) {
+      using lane = detail::simd_lane_t<std::iter_value_t<ForwardIt>>;
+      auto target = static_cast<std::iter_value_t<ForwardIt>>(value);
+      if (!(target == value)) {
+        return last;
+      }
+      return detail::simd_compact(
+          first, last, detail::simd::keep_unequal<lane>{
+                           static_cast<lane>(target)});
+    }
+  }
+  return isl::remove_if(first, last, [&value](const auto &element) {
+    return element == value;
+  });
+}
+
+/// Moves the elements for which `p` does not hold to the front, keeping
+/// their order, and returns the end of them. Over contiguous ranges of
+/// 32- and 64-bit integers and floats, p runs over a block into a mask
+/// and the kept elements of the block move with one permutation.
+template <class ForwardIt, class UnaryPredicate>
+constexpr ForwardIt remove_if(ForwardIt first, ForwardIt last,
+                              UnaryPredicate p) {
+  if constexpr (detail::simd_compactable_by<ForwardIt, UnaryPredicate>) {
+    if (!std::is_constant_evaluated()) {
+      return detail::simd_compact(
+          first, last, detail::keep_where<false, ForwardIt>(p));
+    }
+  }
+  first = isl::find_if(first, last, p);
+  if (first != last) {
+    for (ForwardIt it = first; ++it != last;) {
+      if (!p(*it)) {
+        *first = std::move(*it);
+        ++first;
+      }
+    }
+  }
+  return first;
+}
+
+/// Copies the elements for which `pred` holds to d_first, compacted like
+/// remove_if when both ranges are contiguous and of the same type.
+template <class InputIt, class OutputIt, class UnaryPredicate>
+constexpr OutputIt copy_if(InputIt first, InputIt last, OutputIt d_first,
+                           UnaryPredicate pred) {
+  if constexpr (detail::simd_compactable_by<InputIt, UnaryPredicate> &&
+                std::contiguous_iterator<OutputIt> &&
+                std::is_same_v<std::iter_value_t<OutputIt>,
+                               std::iter_value_t<InputIt>>) {
+    if (!std::is_constant_evaluated()) {
+      auto n = static_cast<std::size_t>(last - first);
+      return d_first + detail::simd::compact(
+                           detail::compact_lanes(first), n,
+                           detail::compact_lanes(d_first),
+                           detail::keep_where<true, InputIt>(pred));
+    }
+  }
+  for (; first != last; ++first) {
+    if (pred(*first)) {
+      *d_first = *first;
+      ++d_first;
+    }
+  }
+  return d_first;
+}
+
+/// Removes all but the first of every run of consecutive equal elements
+/// and returns the new end. Without a predicate, contiguous ranges of 32-
+/// and 64-bit integers and floats compare each block against itself
+/// shifted by one element.
+template <class ForwardIt, class BinaryPredicate>
+constexpr ForwardIt unique(ForwardIt first, ForwardIt last,
+                           BinaryPredicate p) {
+  if (first == last) {
+    return last;
+  }
+  ForwardIt result = first;
+  while (++first != last) {
+    if (!p(*result, *first) && ++result != first) {
+      *result = std::move(*first);
+    }
+  }
+  return ++result;
+}
+template <class ForwardIt>
+constexpr ForwardIt unique(ForwardIt first, ForwardIt last) {
+  if constexpr (detail::simd_compactable<ForwardIt>) {
+    if (!std::is_constant_evaluated()) {
+      if (first == last) {
+        return last;
+      }
+      using lane = detail::simd_lane_t<std::iter_value_t<ForwardIt>>;
+      lane previous = *detail::compact_lanes(first);
+      return detail::simd_compact(first + 1, last,
+                                  detail::simd::keep_distinct<lane>{previous});
+    }
+  }
+  return isl::unique(first, last, isl::equal_to<>{});
+}
+
+/// Moves the elements for which `p` holds before the others and returns
+/// the first of the others. Neither group keeps its order. Contiguous
+/// ranges of 32- and 64-bit integers and floats are partitioned a SIMD
+/// block at a time, each block permuted once and stored to both ends.
+template <class ForwardIt, class UnaryPredicate>
+constexpr ForwardIt partition(ForwardIt first, ForwardIt last,
+                              UnaryPredicate p) {
+  if constexpr (detail::simd_compactable_by<ForwardIt, UnaryPredicate>) {
+    if (!std::is_constant_evaluated()) {
+      auto n = static_cast<std::size_t>(last - first);
+      return first + detail::simd::partition(
+                         detail::compact_lanes(first), n,
+                         detail::keep_where<true, ForwardIt>(p));
+    }
+  }
+  first = isl::find_if_not(first, last, p);
+  if (first == last) {
+    return first;
+  }
+  for (ForwardIt it = std::next(first); it != last; ++it) {
+    if (p(*it)) {
+      std::ranges::iter_swap(it, first);
+      ++first;
+    }
+  }
+  return first;
+}
+} // namespace isl
+// sorting
+
+namespace isl::detail {
+// Ranges up to this size are insertion sorted.
+inline constexpr std::ptrdiff_t insertion_sort_threshold = 24;
+// Ranges above this size take the pivot as a pseudomedian of nine.
+inline constexpr std::ptrdiff_t ninther_threshold = 128;
+// Element moves a partial insertion sort may make before it gives up.
+inline constexpr std::ptrdiff_t partial_insertion_sort_limit = 8;
+// Elements classified per side per round of block partitioning.
+inline constexpr std::size_t partition_block = 64;
+
+// Comparisons that are a single instruction on the element type, which
+// makes branchless block partitioning pay off.
+template <class T, class Compare>
+concept branchless_comparable =
+    (std::is_arithmetic_v<T> || std::is_pointer_v<T>) &&
+    (std::is_same_v<Compare, isl::less<>> ||
+     std::is_same_v<Compare, isl::less<T>> ||
+     std::is_same_v<Compare, isl::greater<>> ||
+     std::is_same_v<Compare, isl::greater<T>>);
+
+template <class It, class Compare>
+constexpr void insertion_sort(It first, It last, Compare &comp) {
+  if (first == last)
+    return;
+  for (It i = first + 1; i != last; ++i) {
+    if (comp(*i, *(i - 1))) {
+      std::iter_value_t<It> value = std::move(*i);
+      It hole = i;
+      do {
+        *hole = std::move(*(hole - 1));
+        --hole;
+      } while (hole != first && comp(value, *(hole - 1)));
+      *hole = std::move(value);
+    }
+  }
+}
+
+// Requires an element before `first` that is not greater than any in the
+// range, which stops the inner loop without a bounds check.
+template <class It, class Compare>
+constexpr void unguarded_insertion_sort(It first, It last, Compare &comp) {
+  if (first == last)
+    return;
+  for (It i = first + 1; i != last; ++i) {
+    if (comp(*i, *(i - 1))) {
+      std::iter_value_t<It> value = std::move(*i);
+      It hole = i;
+      do {
+        *hole = std::move(*(hole - 1));
+        --hole;
+      } while (comp(value, *(hole - 1)));
+      *hole = std::move(value);
+    }
+  }
+}
+
+// Insertion sort that gives up after partial_insertion_sort_limit moves.
+// Returns whether the range got sorted.
+template <class It, class Compare>
+constexpr bool partial_insertion_sort(It first, It last, Compare &comp) {
+  if (first == last)
+    return true;
+  std::ptrdiff_t moves = 0;
+  for (It i = first + 1; i != last; ++i) {
+    if (comp(*i, *(i - 1))) {
+      std::iter_value_t<It> value = std::move(*i);
+      It hole = i;
+      do {
+        *hole = std::move(*(hole - 1));
+        --hole;
+      } while (hole != first && comp(value, *(hole - 1)));
+      *hole = std::move(value);
+      moves += i - hole;
+    }
+    if (moves > partial_insertion_sort_limit)
+      return false;
+  }
+  return true;
+}
+
+template <class It, class Compare>
+constexpr void sort2(It a, It b, Compare &comp) {
+  if (comp(*b, *a))
+    std::ranges::iter_swap(a, b);
+}
+
+template <class It, class Compare>
+constexpr void sort3(It a, It b, It c, Compare &comp) {
+  detail::sort2(a, b, comp);
+  detail::sort2(b, c, comp);
+  detail::sort2(a, b, comp);
+}
+
+// heaps, for the worst-case fallback and partial_sort
+
+template <class It, class Compare>
+constexpr void sift_down(It first, std::iter_difference_t<It> hole,
+                         std::iter_difference_t<It> size,
+                         std::iter_value_t<It> value, Compare &comp) {
+  // walk the hole down to a leaf, then sift the value back up from there
+  std::iter_difference_t<It> top = hole;
+  std::iter_difference_t<It> child = 2 * hole + 1;
+  while (child < size) {
+    if (child + 1 < size && comp(first[child], first[child + 1]))
+      ++child;
+    first[hole] = std::move(first[child]);
+    hole = child;
+    child = 2 * hole + 1;
+  }
+  while (hole > top) {
+    std::iter_difference_t<It> parent = (hole - 1) / 2;
+    if (!comp(first[parent], value))
+      break;
+    first[hole] = std::move(first[parent]);
+    hole = parent;
+  }
+  first[hole] = std::move(value);
+}
+
+template <class It, class Compare>
+constexpr void make_heap(It first, It last, Compare &comp) {
+  std::iter_difference_t<It> size = last - first;
+  for (std::iter_difference_t<It> i = size / 2; i-- > 0;) {
+    detail::sift_down(first, i, size, std::move(first[i]), comp);
+  }
+}
+
+template <class It, class Compare>
+constexpr void sort_heap(It first, It last, Compare &comp) {
+  for (std::iter_difference_t<It> size = last - first; size > 1; --size) {
+    std::iter_value_t<It> value = std::move(first[size - 1]);
+    first[size - 1] = std::move(first[0]);
+    detail::sift_down(first, 0, size - 1, std::move(value), comp);
+  }
+}
+
+// Partitions around the pivot at `first` and returns its final position.
+// Elements equal to the pivot go to the left. Only used when the element
+// before `first` is equal to the pivot, so everything in the range is at
+// least the pivot and the equal ones are done.
+template <class It, class Compare>
+constexpr It partition_left(It first, It last, Compare &comp) {
+  std::iter_value_t<It> pivot = std::move(*first);
+  It i = first;
+  It j = last;
+  while (comp(pivot, *--j))
+    ;
+  if (j + 1 == last) {
+    while (i < j && !comp(pivot, *++i))
+      ;
+  } else {
+    while (!comp(pivot, *++i))
+      ;
+  }
+  while (i < j) {
+    std::ranges::iter_swap(i, j);
+    while (comp(pivot, *--j))
+      ;
+    while (!comp(pivot, *++i))
+      ;
+  }
+  *first = std::move(*j);
+  *j = std::move(pivot);
+  return j;
+}
+
+// Partitions around the pivot at `first`, equal elements going right.
+// Returns the pivot's final position and whether no element had to move.
+template <class It, class Compare>
+constexpr std::pair<It, bool> partition_right(It first, It last,
+                                              Compare &comp) {
+  std::iter_value_t<It> pivot = std::move(*first);
+  It i = first;
+  It j = last;
+  // the median-of-three put elements on both sides to stop these scans
+  while (comp(*++i, pivot))
+    ;
+  if (i - 1 == first) {
+    while (i < j && !comp(*--j, pivot))
+      ;
+  } else {
+    while (!comp(*--j, pivot))
+      ;
+  }
+  bool already_partitioned = i >= j;
+  while (i < j) {
+    std::ranges::iter_swap(i, j);
+    while (comp(*++i, pivot))
+      ;
+    while (!comp(*--j, pivot))
+      ;
+  }
+  It pivot_position = i - 1;
+  *first = std::move(*pivot_position);
+  *pivot_position = std::move(pivot);
+  return {pivot_position, already_partitioned};
+}
+
+// Swaps the elements at the first n offsets from each base. When the
+// counts on both sides differ the elements go round in a cycle instead,
+// which takes one move per element rather than three.
+template <class It>
+void swap_offsets(It left, It right, const unsigned char *offsets_l,
+                  const unsigned char *offsets_r, std::size_t n,
+                  bool use_swaps) {
+  if (use_swaps) {
+    for (std::size_t i = 0; i != n; ++i) {
+      std::ranges::iter_swap(left + offsets_l[i], right - offsets_r[i]);
+    }
+  } else if (n != 0) {
+    It l = left + offsets_l[0];
+    It r = right - offsets_r[0];
+    std::iter_value_t<It> value = std::move(*l);
+    *l = std::move(*r);
+    for (std::size_t i = 1; i != n; ++i) {
+      l = left + offsets_l[i];
+      *r = std::move(*l);
+      r = right - offsets_r[i];
+      *l = std::move(*r);
+    }
+    *r = std::move(value);
+  }
+}
+
+// partition_right with the block partitioning of Edelkamp and Weiss
+// (BlockQuicksort): each side first records, without branching, the
+// offsets of the elements that belong on the other side in a block of
+// up to 64, then the recorded elements are swapped pairwise. The
+// comparison results never feed a branch, so mispredictions go away.
+template <class It, class Compare>
+std::pair<It, bool> partition_right_branchless(It first, It last,
+                                               Compare &comp) {
+  std::iter_value_t<It> pivot = std::move(*first);
+  It i = first;
+  It j = last;
+  while (comp(*++i, pivot))
+    ;
+  if (i - 1 == first) {
+    while (i < j && !comp(*--j, pivot))
+      ;
+  } else {
+    while (!comp(*--j, pivot))
+      ;
+  }
+  bool already_partitioned = i >= j;
+  if (!already_partitioned) {
+    std::ranges::iter_swap(i, j);
+    ++i;
+
+    alignas(64) unsigned char offsets_l[partition_block];
+    alignas(64) unsigned char offsets_r[partition_block];
+    It base_l = i;
+    It base_r = j;
+    std::size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+    while (i < j) {
+      // refill the empty sides, splitting what is left between them
+      auto unknown = static_cast<std::size_t>(j - i);
+      std::size_t split_l =
+          num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+      std::size_t split_r = num_r == 0 ? unknown - split_l : 0;
+      split_l = split_l < partition_block ? split_l : partition_block;
+      split_r = split_r < partition_block ? split_r : partition_block;
+
+      for (std::size_t k = 0; k != split_l; ++k) {
+        offsets_l[num_l] = static_cast<unsigned char>(k);
+        num_l += !comp(*i, pivot);
+        ++i;
+      }
+      for (std::size_t k = 0; k != split_r; ++k) {
+        offsets_r[num_r] = static_cast<unsigned char>(k + 1);
+        num_r += comp(*--j, pivot);
+      }
+
+      std::size_t n = num_l < num_r ? num_l : num_r;
+      detail::swap_offsets(base_l, base_r, offsets_l + start_l,
+                           offsets_r + start_r, n, num_l == num_r);
+      num_l -= n;
+      num_r -= n;
+      start_l += n;
+      start_r += n;
+      if (num_l == 0) {
+        start_l = 0;
+        base_l = i;
+      }
+      if (num_r == 0) {
+        start_r = 0;
+        base_r = j;
+      }
+    }
+
+    // at most one side has misplaced elements left; move them to the
+    // boundary
+    if (num_l != 0) {
+      while (num_l-- != 0) {
+        std::ranges::iter_swap(base_l + offsets_l[start_l + num_l], --j);
+      }
+      i = j;
+    }
+    if (num_r != 0) {
+      while (num_r-- != 0) {
+        std::ranges::iter_swap(base_r - offsets_r[start_r + num_r], i);
+        ++i;
+      }
+      j = i;
+    }
+  }
+  It pivot_position = i - 1;
+  *first = std::move(*pivot_position);
+  *pivot_position = std::move(pivot);
+  return {pivot_position, already_partitioned};
+}
+
+// Pattern-defeating quicksort (Orson Peters): introsort that detects
+// runs and equal keys. An already partitioned range gets a partial
+// insertion sort, so sorted and nearly sorted inputs take linear time.
+// A run of equal keys is split off by partition_left in one pass. After
+// a bad split, elements are shuffled to break the pattern, and after
+// log2(n) bad splits the range is heapsorted.
+template <bool Branchless, class It, class Compare>
+void pdqsort_loop(It first, It last, Compare &comp, int bad_allowed,
+                  bool leftmost) {
+  using difference_type = std::iter_difference_t<It>;
+  while (true) {
+    difference_type size = last - first;
+    if (size < insertion_sort_threshold) {
+      if (leftmost)
+        detail::insertion_sort(first, last, comp);
+      else
+        detail::unguarded_insertion_sort(first, last, comp);
+      return;
+    }
+
+    difference_type half = size / 2;
+    if (size > ninther_threshold) {
+      detail::sort3(first, first + half, last - 1, comp);
+      detail::sort3(first + 1, first + (half - 1), last - 2, comp);
+      detail::sort3(first + 2, first + (half + 1), last - 3, comp);
+      detail::sort3(first + (half - 1), first + half, first + (half + 1),
+                    comp);
+      std::ranges::iter_swap(first, first + half);
+    } else {
+      detail::sort3(first + half, first, last - 1, comp);
+    }
+
+    // the element before the range was a pivot; if it equals this one,
+    // everything equal to it can be split off and is done
+    if (!leftmost && !comp(*(first - 1), *first)) {
+      first = detail::partition_left(first, last, comp) + 1;
+      continue;
+    }
+
+    auto [pivot, already_partitioned] =
+        Branchless ? detail::partition_right_branchless(first, last, comp)
+                   : detail::partition_right(first, last, comp);
+
+    difference_type size_l = pivot - first;
+    difference_type size_r = last - (pivot + 1);
+    if (size_l < size / 8 || size_r < size / 8) {
+      if (--bad_allowed == 0) {
+        detail::make_heap(first, last, comp);
+        detail::sort_heap(first, last, comp);
+        return;
+      }
+      if (size_l >= insertion_sort_threshold) {
+        std::ranges::iter_swap(first, first + size_l / 4);
+        std::ranges::iter_swap(pivot - 1, pivot - size_l / 4);
+        if (size_l > ninther_threshold) {
+          std::ranges::iter_swap(first + 1, first + (size_l / 4 + 1));
+          std::ranges::iter_swap(first + 2, first + (size_l / 4 + 2));
+          std::ranges::iter_swap(pivot - 2, pivot - (size_l / 4 + 1));
+          std::ranges::iter_swap(pivot - 3, pivot - (size_l / 4 + 2));
+        }
+      }
+      if (size_r >= insertion_sort_threshold) {
+        std::ranges::iter_swap(pivot + 1, pivot + (1 + size_r / 4));
+        std::ranges::iter_swap(last - 1, last - size_r / 4);
+        if (size_r > ninther_threshold) {
+          std::ranges::iter_swap(pivot + 2, pivot + (2 + size_r / 4));
+          std::ranges::iter_swap(pivot + 3, pivot + (3 + size_r / 4));
+          std::ranges::iter_swap(last - 2, last - (1 + size_r / 4));
+          std::ranges::iter_swap(last - 3, last - (2 + size_r / 4));
+        }
+      }
+    } else if (already_partitioned &&
+               detail::partial_insertion_sort(first, pivot, comp) &&
+               detail::partial_insertion_sort(pivot + 1, last, comp)) {
+      return;
+    }
+
+    // recurse into the left part and loop on the right one
+    detail::pdqsort_loop<Branchless>(first, pivot, comp, bad_allowed,
+                                     leftmost);
+    first = pivot + 1;
+    leftmost = false;
+  }
+}
+
+template <class It, class Compare>
+constexpr void pdqsort(It first, It last, Compare &comp) {
+  if (last - first < 2)
+    return;
+  if (std::is_constant_evaluated()) {
+    detail::make_heap(first, last, comp);
+    detail::sort_heap(first, last, comp);
+    return;
+  }
+  int bad_allowed = static_cast<int>(
+      std::bit_width(static_cast<std::size_t>(last - first)));
+  constexpr bool branchless =
+      branchless_comparable<std::iter_value_t<It>, Compare>;
+  detail::pdqsort_loop<branchless>(first, last, comp, bad_allowed, true);
+}
+
+// Runs up to this size are insertion sorted before merging.
+inline constexpr std::ptrdiff_t merge_run = 32;
+
+// Raw storage for `size` elements, released when it goes out of scope,
+// also when the sort using it throws.
+template <class T> class temporary_buffer {
+  std::allocator<T> allocator;
+  T *data_;
+  std::size_t size_;
+
+public:
+  explicit temporary_buffer(std::size_t size)
+      : data_(allocator.allocate(size)), size_(size) {}
+  temporary_buffer(const temporary_buffer &) = delete;
+  temporary_buffer &operator=(const temporary_buffer &) = delete;
+  ~temporary_buffer() { this->allocator.deallocate(this->data_, this->size_); }
+
+  T *data() const noexcept { return this->data_; }
+};
+
+// Merges the sorted [first, middle) and [middle, last). The left half is
+// moved to `buffer` first, which must have room for it.
+template <class It, class Compare>
+void merge_with_buffer(It first, It middle, It last,
+                       std::iter_value_t<It> *buffer, Compare &comp) {
+  std::iter_value_t<It> *left = buffer;
+  std::iter_value_t<It> *left_end =
+      std::uninitialized_move(first, middle, buffer);
+  It out = first;
+  It right = middle;
+  try {
+    while (left != left_end && right != last) {
+      // taking the left element on ties keeps the merge stable
+      if (comp(*right, *left)) {
+        *out = std::move(*right);
+        ++right;
+      } else {
+        *out = std::move(*left);
+        ++left;
+      }
+      ++out;
+    }
+  } catch (...) {
+    // [out, right) has exactly the room for the elements still buffered
+    std::move(left, left_end, out);
+    std::destroy(buffer, left_end);
+    throw;
+  }
+  for (; left != left_end; ++left, ++out) {
+    *out = std::move(*left);
+  }
+  std::destroy(buffer, left_end);
+}
+
+template <class It, class Compare>
+void merge_sort(It first, It last, std::iter_value_t<It> *buffer,
+                Compare &comp) {
+  std::iter_difference_t<It> size = last - first;
+  if (size <= merge_run) {
+    detail::insertion_sort(first, last, comp);
+    return;
+  }
+  It middle = first + size / 2;
+  detail::merge_sort(first, middle, buffer, comp);
+  detail::merge_sort(middle, last, buffer, comp);
+  // the halves are often already in order, as in sorted input
+  if (comp(*middle, *(middle - 1)))
+    detail::merge_with_buffer(first, middle, last, buffer, comp);
+}
+} // namespace isl::detail
+
+export namespace isl {
+template <class ForwardIt, class Compare>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last,
+                                    Compare comp) {
+  if (first != last) {
+    for (ForwardIt next = first; ++next != last; first = next) {
+      if (comp(*next, *first))
+        return next;
+    }
+  }
+  return last;
+}
+template <class ForwardIt>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last) {
+  return isl::is_sorted_until(first, last, isl::less<>{});
+}
+
+template <class ForwardIt, class Compare>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last, Compare comp) {
+  return isl::is_sorted_until(first, last, comp) == last;
+}
+template <class ForwardIt>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last) {
+  return isl::is_sorted_until(first, last) == last;
+}
+
+/// Pattern-defeating quicksort: O(n log n) worst case, linear on sorted,
+/// reversed and all-equal input. Not stable.
+template <class RandomIt, class Compare>
+constexpr void sort(RandomIt first, RandomIt last, Compare comp) {
+  detail::pdqsort(first, last, comp);
+}
+template <class RandomIt>
+constexpr void sort(RandomIt first, RandomIt last) {
+  isl::less<> comp;
+  detail::pdqsort(first, last, comp);
+}
+
+/// Merge sort keeping equal elements in their order. Allocates a buffer
+/// for half the range.
+template <class RandomIt, class Compare>
+void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+  using value_type = std::iter_value_t<RandomIt>;
+  auto size = static_cast<std::size_t>(last - first);
+  if (size <= static_cast<std::size_t>(detail::merge_run)) {
+    detail::insertion_sort(first, last, comp);
+    return;
+  }
+  detail::temporary_buffer<value_type> buffer(size / 2 + 1);
+  detail::merge_sort(first, last, buffer.data(), comp);
+}
+template <class RandomIt> void stable_sort(RandomIt first, RandomIt last) {
+  isl::stable_sort(first, last, isl::less<>{});
+}
+
+/// Sorts the smallest middle - first elements into [first, middle); the
+/// rest end up in [middle, last) in no particular order.
+template <class RandomIt, class Compare>
+constexpr void partial_sort(RandomIt first, RandomIt middle, RandomIt last,
+                            Compare comp) {
+  if (first == middle)
+    return;
+  // keep the smallest elements seen so far in a max-heap
+  detail::make_heap(first, middle, comp);
+  auto size = middle - first;
+  for (RandomIt i = middle; i != last; ++i) {
+    if (comp(*i, *first)) {
+      std::iter_value_t<RandomIt> value = std::move(*i);
+      *i = std::move(*first);
+      detail::sift_down(first, 0, size, std::move(value), comp);
+    }
+  }
+  detail::sort_heap(first, middle, comp);
+}
+template <class RandomIt>
+constexpr void partial_sort(RandomIt first, RandomIt middle, RandomIt last) {
+  isl::partial_sort(first, middle, last, isl::less<>{});
+}
+} // namespace isl
+// binary search
+
+namespace isl::detail {
+// Ranges at least this long have the next probes prefetched; shorter
+// ones sit in a few cache lines anyway.
+inline constexpr std::ptrdiff_t search_prefetch_threshold = 1 << 10;
+
+template <class It> constexpr void prefetch(It it) noexcept {
+  if constexpr (std::contiguous_iterator<It>) {
+    if (!std::is_constant_evaluated())
+      __builtin_prefetch(std::to_address(it));
+  }
+}
+
+// Binary search without a data-dependent branch: every step halves the
+// range and moves its start by the comparison result, which compiles to
+// a conditional move, so the loop runs the same log2(n) steps for every
+// key and never mispredicts. That leaves the loads as the cost, so both
+// positions the next step may probe are prefetched while this one
+// compares. Returns the first element for which goes_right is false,
+// with goes_right true for a prefix of the range.
+template <class It, class GoesRight>
+constexpr It branchless_partition_point(It first,
+                                        std::iter_difference_t<It> size,
+                                        GoesRight &goes_right) {
+  if (size == 0)
+    return first;
+  bool prefetching = size >= search_prefetch_threshold;
+  while (size > 1) {
+    std::iter_difference_t<It> half = size / 2;
+    size -= half;
+    if (prefetching) {
+      detail::prefetch(first + size / 2);
+      detail::prefetch(first + half + size / 2);
+    }
+    first += goes_right(first[half]) ? half : 0;
+  }
+  return first + (goes_right(*first) ? 1 : 0);
+}
+
+template <class It, class GoesRight>
+constexpr It partition_point(It first, It last, GoesRight &goes_right) {
+  if constexpr (std::random_access_iterator<It>) {
+    return detail::branchless_partition_point(first, last - first,
+                                              goes_right);
+  } else {
+    auto size = std::distance(first, last);
+    while (size > 0) {
+      auto half = size / 2;
+      It middle = std::next(first, half);
+      if (goes_right(*middle)) {
+        first = ++middle;
+        size -= half + 1;
+      } else {
+        size = half;
+      }
+    }
+    return first;
+  }
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// First element not less than `value`. Over random-access ranges the
+/// search is branchless and prefetches its next probes.
+template <class ForwardIt, class T, class Compare>
+constexpr ForwardIt lower_bound(ForwardIt first, ForwardIt last,
+                                const T &value, Compare comp) {
+  auto goes_right = [&](const auto &element) { return comp(element, value); };
+  return detail::partition_point(first, last, goes_right);
+}
+template <class ForwardIt, class T>
+constexpr ForwardIt lower_bound(ForwardIt first, ForwardIt last,
+                                const T &value) {
+  return isl::lower_bound(first, last, value, isl::less<>{});
+}
+
+/// First element greater than `value`.
+template <class ForwardIt, class T, class Compare>
+constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last,
+                                const T &value, Compare comp) {
+  auto goes_right = [&](const auto &element) { return !comp(value, element); };
+  return detail::partition_point(first, last, goes_right);
+}
+template <class ForwardIt, class T>
+constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last,
+                                const T &value) {
+  return isl::upper_bound(first, last, value, isl::less<>{});
+}
+
+template <class ForwardIt, class T, class Compare>
+constexpr std::pair<ForwardIt, ForwardIt>
+equal_range(ForwardIt first, ForwardIt last, const T &value, Compare comp) {
+  ForwardIt lower = isl::lower_bound(first, last, value, comp);
+  return {lower, isl::upper_bound(lower, last, value, comp)};
+}
+template <class ForwardIt, class T>
+constexpr std::pair<ForwardIt, ForwardIt>
+equal_range(ForwardIt first, ForwardIt last, const T &value) {
+  return isl::equal_range(first, last, value, isl::less<>{});
+}
+
+template <class ForwardIt, class T, class Compare>
+constexpr bool binary_search(ForwardIt first, ForwardIt last, const T &value,
+                             Compare comp) {
+  first = isl::lower_bound(first, last, value, comp);
+  return first != last && !comp(value, *first);
+}
+template <class ForwardIt, class T>
+constexpr bool binary_search(ForwardIt first, ForwardIt last,
+                             const T &value) {
+  return isl::binary_search(first, last, value, isl::less<>{});
+}
+} // namespace isl
+// radix sorting
+
+namespace isl::detail {
+// Keys radix sorts take: integers and IEEE floats.
+template <class Key>
+concept radix_key =
+    (std::is_integral_v<Key> && !std::is_same_v<Key, bool>) ||
+    std::is_same_v<Key, float> || std::is_same_v<Key, double>;
+
+template <class It, class Projection>
+concept radix_sortable =
+    std::contiguous_iterator<It> &&
+    std::invocable<Projection &, std::iter_reference_t<It>> &&
+    radix_key<std::remove_cvref_t<
+        std::invoke_result_t<Projection &, std::iter_reference_t<It>>>>;
+
+// Digits are bytes.
+inline constexpr std::size_t radix_buckets = 256;
+// Ranges up to this size are insertion sorted; clearing and scanning the
+// histograms costs more than it saves.
+inline constexpr std::ptrdiff_t radix_sort_threshold = 64;
+// Buckets of an MSD pass up to this size are comparison sorted.
+inline constexpr std::ptrdiff_t msd_radix_sort_threshold = 128;
+
+// Maps a key to an unsigned integer of its size that orders like it.
+// Signed integers have the sign bit flipped. Negative floats have every
+// bit flipped, which reverses their order, and positive ones the sign
+// bit, which puts them above; the result is the IEEE 754 totalOrder, so
+// -0.0 comes before 0.0 and NaNs go to the ends.
+template <class Key> constexpr auto radix_bits(Key key) noexcept {
+  if constexpr (std::is_floating_point_v<Key>) {
+    using bits_type =
+        std::conditional_t<sizeof(Key) == 4, std::uint32_t, std::uint64_t>;
+    constexpr int top = sizeof(bits_type) * 8 - 1;
+    auto bits = std::bit_cast<bits_type>(key);
+    auto mask = static_cast<bits_type>(-(bits >> top)) | bits_type{1} << top;
+    return static_cast<bits_type>(bits ^ mask);
+  } else {
+    using bits_type = std::make_unsigned_t<Key>;
+    auto bits = static_cast<bits_type>(key);
+    if constexpr (std::is_signed_v<Key>)
+      bits ^= bits_type{1} << (sizeof(bits_type) * 8 - 1);
+    return bits;
+  }
+}
+
+template <class T, class Projection>
+using radix_bits_t = decltype(detail::radix_bits(
+    std::declval<std::invoke_result_t<Projection &, T &>>()));
+
+template <class Projection> struct radix_key_less {
+  Projection &proj;
+
+  template <class T> bool operator()(const T &a, const T &b) const {
+    return detail::radix_bits(std::invoke(proj, a)) <
+           detail::radix_bits(std::invoke(proj, b));
+  }
+};
+
+template <class T, class Projection>
+std::size_t radix_digit(T &value, Projection &proj, std::size_t byte) {
+  return static_cast<std::size_t>(
+      detail::radix_bits(std::invoke(proj, value)) >> byte * 8 & 0xFF);
+}
+
+// Stable LSD radix sort, a counting pass per byte from the lowest up,
+// moving the elements between the range and `buffer`, which has room for
+// all of them. One read fills the histograms of every pass.
+template <class T, class Projection>
+void lsd_radix_sort(T *first, T *last, T *buffer, Projection &proj) {
+  constexpr std::size_t passes = sizeof(radix_bits_t<T, Projection>);
+  auto size = static_cast<std::size_t>(last - first);
+  std::size_t counts[passes][radix_buckets] = {};
+  for (T *i = first; i != last; ++i) {
+    auto bits = detail::radix_bits(std::invoke(proj, *i));
+    for (std::size_t pass = 0; pass != passes; ++pass)
+      ++counts[pass][bits >> pass * 8 & 0xFF];
+  }
+
+  T *from = first;
+  T *to = buffer;
+  for (std::size_t pass = 0; pass != passes; ++pass) {
+    std::size_t *count = counts[pass];
+    // every key has the same byte here, so the pass would move nothing
+    if (count[detail::radix_digit(*first, proj, pass)] == size)
+      continue;
+    std::size_t offset = 0;
+    for (std::size_t digit = 0; digit != radix_buckets; ++digit) {
+      std::size_t n = count[digit];
+      count[digit] = offset;
+      offset += n;
+    }
+    for (T *i = from; i != from + size; ++i)
+      to[count[detail::radix_digit(*i, proj, pass)]++] = std::move(*i);
+    std::swap(from, to);
+  }
+  if (from != first) {
+    for (std::size_t i = 0; i != size; ++i)
+      first[i] = std::move(from[i]);
+  }
+}
+
+// In-place MSD radix sort (American flag sort): a counting pass on `byte`
+// sizes the buckets, elements are swapped straight into theirs, then
+// each bucket is sorted on the next byte down.
+template <class T, class Projection>
+void msd_radix_sort(T *first, T *last, Projection &proj, std::size_t byte) {
+  if (last - first <= msd_radix_sort_threshold) {
+    radix_key_less<Projection> comp{proj};
+    detail::pdqsort(first, last, comp);
+    return;
+  }
+  std::size_t count[radix_buckets] = {};
+  for (T *i = first; i != last; ++i)
+    ++count[detail::radix_digit(*i, proj, byte)];
+  // a byte every key shares splits nothing
+  if (count[detail::radix_digit(*first, proj, byte)] ==
+      static_cast<std::size_t>(last - first)) {
+    if (byte != 0)
+      detail::msd_radix_sort(first, last, proj, byte - 1);
+    return;
+  }
+
+  T *heads[radix_buckets];
+  T *tails[radix_buckets];
+  T *end = first;
+  for (std::size_t digit = 0; digit != radix_buckets; ++digit) {
+    heads[digit] = end;
+    end += count[digit];
+    tails[digit] = end;
+  }
+  for (std::size_t digit = 0; digit != radix_buckets; ++digit) {
+    while (heads[digit] != tails[digit]) {
+      std::size_t target = detail::radix_digit(*heads[digit], proj, byte);
+      if (target == digit) {
+        ++heads[digit];
+      } else {
+        std::ranges::iter_swap(heads[digit], heads[target]);
+        ++heads[target];
+      }
+    }
+  }
+
+  if (byte == 0)
+    return;
+  T *bucket = first;
+  for (std::size_t digit = 0; digit != radix_buckets; ++digit) {
+    if (count[digit] > 1)
+      detail::msd_radix_sort(bucket, bucket + count[digit], proj, byte - 1);
+    bucket += count[digit];
+  }
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// Stable LSD radix sort by the key proj(element), which is an integer or
+/// a float. Floats sort in IEEE 754 totalOrder: -0.0 before 0.0, NaNs at
+/// the ends. Makes a pass per key byte, skipping bytes every key shares.
+/// The scratch space comes from `buffer`, which is grown to at least
+/// last - first elements and kept, so repeated sorts through the same
+/// buffer do not allocate.
+template <class RandomIt, class Allocator, class Projection>
+  requires detail::radix_sortable<RandomIt, Projection>
+void radix_sort(RandomIt first, RandomIt last,
+                vector<std::iter_value_t<RandomIt>, Allocator> &buffer,
+                Projection proj) {
+  using value_type = std::iter_value_t<RandomIt>;
+  if (last - first <= detail::radix_sort_threshold) {
+    detail::radix_key_less<Projection> comp{proj};
+    detail::insertion_sort(first, last, comp);
+    return;
+  }
+  auto size = static_cast<std::size_t>(last - first);
+  if (buffer.size() < size) {
+    if constexpr (std::is_trivial_v<value_type>) {
+      // scratch: the elements are written before they are read
+      buffer.resize_and_overwrite(
+          size, [](value_type *, std::size_t n) { return n; });
+    } else {
+      buffer.resize(size);
+    }
+  }
+  value_type *data = std::to_address(first);
+  detail::lsd_radix_sort(data, data + size, buffer.data(), proj);
+}
+template <class RandomIt, class Allocator>
+  requires detail::radix_sortable<RandomIt, std::identity>
+void radix_sort(RandomIt first, RandomIt last,
+                vector<std::iter_value_t<RandomIt>, Allocator> &buffer) {
+  isl::radix_sort(first, last, buffer, std::identity{});
+}
+/// As above with a buffer allocated for the call.
+template <class RandomIt, class Projection>
+  requires detail::radix_sortable<RandomIt, Projection>
+void radix_sort(RandomIt first, RandomIt last, Projection proj) {
+  vector<std::iter_value_t<RandomIt>> buffer;
+  isl::radix_sort(first, last, buffer, proj);
+}
+template <class RandomIt>
+  requires detail::radix_sortable<RandomIt, std::identity>
+void radix_sort(RandomIt first, RandomIt last) {
+  isl::radix_sort(first, last, std::identity{});
+}
+
+/// In-place MSD radix sort by the same keys as radix_sort, starting from
+/// the highest byte. Needs no scratch space but is not stable.
+template <class RandomIt, class Projection>
+  requires detail::radix_sortable<RandomIt, Projection>
+void msd_radix_sort(RandomIt first, RandomIt last, Projection proj) {
+  using bits_type = detail::radix_bits_t<std::iter_value_t<RandomIt>,
+                                         Projection>;
+  if (last - first < 2)
+    return;
+  std::iter_value_t<RandomIt> *data = std::to_address(first);
+  detail::msd_radix_sort(data, data + (last - first), proj,
+                         sizeof(bits_type) - 1);
+}
+template <class RandomIt>
+  requires detail::radix_sortable<RandomIt, std::identity>
+void msd_radix_sort(RandomIt first, RandomIt last) {
+  isl::msd_radix_sort(first, last, std::identity{});
+}
+} // namespace isl
+// parallel algorithms
+
+namespace isl::detail {
+// Chunks per thread a parallel algorithm splits its range into, so that
+// threads done early take over the rest of the slow ones' work.
+inline constexpr std::size_t parallel_chunks_per_thread = 4;
+// Fewest elements per chunk for the algorithms that do little per
+// element; handing a smaller chunk to another thread costs more than
+// scanning it.
+inline constexpr std::size_t parallel_grain = 1 << 14;
+// Elements a parallel search scans between checks for a hit before its
+// chunk.
+inline constexpr std::size_t parallel_search_block = 1 << 12;
+
+template <class Policy>
+concept sequenced_policy =
+    std::is_same_v<std::remove_cvref_t<Policy>, execution::sequenced_policy>;
+
+// Calls fn(begin, end) on the chunks of [0, size), in parallel. Chunks
+// are at least `grain` long, so short ranges stay on the calling thread.
+template <class Function>
+void parallel_ranges(std::size_t size, std::size_t grain, Function fn) {
+  std::size_t chunks = execution::concurrency() * parallel_chunks_per_thread;
+  std::size_t most = (size + grain - 1) / grain;
+  if (most < chunks)
+    chunks = most;
+  if (chunks <= 1) {
+    if (size != 0)
+      fn(std::size_t{0}, size);
+    return;
+  }
+  std::size_t length = (size + chunks - 1) / chunks;
+  execution::bulk((size + length - 1) / length, [&](std::size_t chunk) {
+    std::size_t begin = chunk * length;
+    fn(begin, size - begin < length ? size : begin + length);
+  });
+}
+
+// The first offset in [0, size) that `search` hits, or size.
+// search(begin, end) returns the first hit in [begin, end), or end. A
+// chunk stops once a hit before it has been found, so the search winds
+// down soon after the first hit instead of scanning the whole range.
+template <class Search>
+std::size_t parallel_find_first(std::size_t size, Search search) {
+  std::atomic<std::size_t> found{size};
+  detail::parallel_ranges(
+      size, parallel_grain, [&](std::size_t begin, std::size_t end) {
+        while (begin != end) {
+          if (found.load(std::memory_order_relaxed) <= begin)
+            return;
+          std::size_t block_end =
+              end - begin < parallel_search_block
+                  ? end
+                  : begin + parallel_search_block;
+          std::size_t hit = search(begin, block_end);
+          if (hit != block_end) {
+            std::size_t seen = found.load(std::memory_order_relaxed);
+            while (hit < seen && !found.compare_exchange_weak(
+                                     seen, hit, std::memory_order_relaxed)) {
+            }
+            return;
+          }
+          begin = block_end;
+        }
+      });
+  return found.load(std::memory_order_relaxed);
+}
+} // namespace isl::detail
+
+// Parallel overloads take random-access ranges. With execution::seq they
+// run the sequential algorithm; with par and par_unseq they split the
+// range into chunks run on the worker pool and the calling thread, and
+// an exception escaping the element function calls std::terminate.
+export namespace isl {
+template <class ExecutionPolicy, class RandomIt, class Function>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt>
+void for_each(ExecutionPolicy &&, RandomIt first, RandomIt last,
+              Function f) {
+  if constexpr (detail::sequenced_policy<ExecutionPolicy>) {
+    isl::for_each(first, last, f);
+  } else {
+    detail::parallel_ranges(static_cast<std::size_t>(last - first), 1,
+                            [&](std::size_t begin, std::size_t end) {
+                              for (; begin != end; ++begin) {
+                                f(first[begin]);
+                              }
+                            });
+  }
+}
+template <class ExecutionPolicy, class RandomIt, class Size, class Function>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt> && std::is_integral_v<Size>
+RandomIt for_each_n(ExecutionPolicy &&policy, RandomIt first, Size n,
+                    Function f) {
+  if (n <= 0)
+    return first;
+  isl::for_each(policy, first, first + n, f);
+  return first + n;
+}
+
+template <class ExecutionPolicy, class RandomIt, class UnaryPredicate>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt>
+std::iter_difference_t<RandomIt> count_if(ExecutionPolicy &&, RandomIt first,
+                                          RandomIt last, UnaryPredicate p) {
+  if constexpr (detail::sequenced_policy<ExecutionPolicy>) {
+    return isl::count_if(first, last, p);
+  } else {
+    std::atomic<std::iter_difference_t<RandomIt>> total{0};
+    detail::parallel_ranges(
+        static_cast<std::size_t>(last - first), detail::parallel_grain,
+        [&](std::size_t begin, std::size_t end) {
+          total.fetch_add(isl::count_if(first + begin, first + end, p),
+                          std::memory_order_relaxed);
+        });
+    return total.load(std::memory_order_relaxed);
+  }
+}
+template <class ExecutionPolicy, class RandomIt, class T>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt>
+std::iter_difference_t<RandomIt> count(ExecutionPolicy &&, RandomIt first,
+                                       RandomIt last, const T &value) {
+  if constexpr (detail::sequenced_policy<ExecutionPolicy>) {
+    return isl::count(first, last, value);
+  } else {
+    std::atomic<std::iter_difference_t<RandomIt>> total{0};
+    detail::parallel_ranges(
+        static_cast<std::size_t>(last - first), detail::parallel_grain,
+        [&](std::size_t begin, std::size_t end) {
+          total.fetch_add(isl::count(first + begin, first + end, value),
+                          std::memory_order_relaxed);
+        });
+    return total.load(std::memory_order_relaxed);
+  }
+}
+
+template <class ExecutionPolicy, class RandomIt, class UnaryPredicate>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt>
+RandomIt find_if(ExecutionPolicy &&, RandomIt first, RandomIt last,
+                 UnaryPredicate p) {
+  if constexpr (detail::sequenced_policy<ExecutionPolicy>) {
+    return isl::find_if(first, last, p);
+  } else {
+    return first + detail::parallel_find_first(
+                       static_cast<std::size_t>(last - first),
+                       [&](std::size_t begin, std::size_t end) {
+                         return static_cast<std::size_t>(
+                             isl::find_if(first + begin, first + end, p) -
+                             first);
+                       });
+  }
+}
+template <class ExecutionPolicy, class RandomIt, class UnaryPredicate>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt>
+RandomIt find_if_not(ExecutionPolicy &&policy, RandomIt first, RandomIt last,
+                     UnaryPredicate p) {
+  return isl::find_if(policy, first, last,
+                      [&p](auto &&element) { return !p(element); });
+}
+template <class ExecutionPolicy, class RandomIt, class T>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt>
+RandomIt find(ExecutionPolicy &&, RandomIt first, RandomIt last,
+              const T &value) {
+  if constexpr (detail::sequenced_policy<ExecutionPolicy>) {
+    return isl::find(first, last, value);
+  } else {
+    return first + detail::parallel_find_first(
+                       static_cast<std::size_t>(last - first),
+                       [&](std::size_t begin, std::size_t end) {
+                         return static_cast<std::size_t>(
+                             isl::find(first + begin, first + end, value) -
+                             first);
+                       });
+  }
+}
+
+template <class ExecutionPolicy, class RandomIt, class UnaryPredicate>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt>
+bool any_of(ExecutionPolicy &&policy, RandomIt first, RandomIt last,
+            UnaryPredicate p) {
+  return isl::find_if(policy, first, last, p) != last;
+}
+template <class ExecutionPolicy, class RandomIt, class UnaryPredicate>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt>
+bool all_of(ExecutionPolicy &&policy, RandomIt first, RandomIt last,
+            UnaryPredicate p) {
+  return isl::find_if_not(policy, first, last, p) == last;
+}
+template <class ExecutionPolicy, class RandomIt, class UnaryPredicate>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt>
+bool none_of(ExecutionPolicy &&policy, RandomIt first, RandomIt last,
+             UnaryPredicate p) {
+  return isl::find_if(policy, first, last, p) == last;
+}
+
+template <class ExecutionPolicy, class RandomIt1, class RandomIt2,
+          class BinaryPredicate>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt1> &&
+           std::random_access_iterator<RandomIt2>
+std::pair<RandomIt1, RandomIt2> mismatch(ExecutionPolicy &&, RandomIt1 first1,
+                                         RandomIt1 last1, RandomIt2 first2,
+                                         BinaryPredicate p) {
+  if constexpr (detail::sequenced_policy<ExecutionPolicy>) {
+    return isl::mismatch(first1, last1, first2, p);
+  } else {
+    std::size_t offset = detail::parallel_find_first(
+        static_cast<std::size_t>(last1 - first1),
+        [&](std::size_t begin, std::size_t end) {
+          return static_cast<std::size_t>(
+              isl::mismatch(first1 + begin, first1 + end, first2 + begin, p)
+                  .first -
+              first1);
+        });
+    return {first1 + offset, first2 + offset};
+  }
+}
+template <class ExecutionPolicy, class RandomIt1, class RandomIt2>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt1> &&
+           std::random_access_iterator<RandomIt2>
+std::pair<RandomIt1, RandomIt2> mismatch(ExecutionPolicy &&, RandomIt1 first1,
+                                         RandomIt1 last1, RandomIt2 first2) {
+  if constexpr (detail::sequenced_policy<ExecutionPolicy>) {
+    return isl::mismatch(first1, last1, first2);
+  } else {
+    std::size_t offset = detail::parallel_find_first(
+        static_cast<std::size_t>(last1 - first1),
+        [&](std::size_t begin, std::size_t end) {
+          return static_cast<std::size_t>(
+              isl::mismatch(first1 + begin, first1 + end, first2 + begin)
+                  .first -
+              first1);
+        });
+    return {first1 + offset, first2 + offset};
+  }
+}
+template <class ExecutionPolicy, class RandomIt1, class RandomIt2,
+          class BinaryPredicate>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt1> &&
+           std::random_access_iterator<RandomIt2>
+std::pair<RandomIt1, RandomIt2>
+mismatch(ExecutionPolicy &&policy, RandomIt1 first1, RandomIt1 last1,
+         RandomIt2 first2, RandomIt2 last2, BinaryPredicate p) {
+  if (last2 - first2 < last1 - first1)
+    last1 = first1 + (last2 - first2);
+  return isl::mismatch(policy, first1, last1, first2, p);
+}
+template <class ExecutionPolicy, class RandomIt1, class RandomIt2>
+  requires execution_policy<ExecutionPolicy> &&
+           std::random_access_iterator<RandomIt1> &&
+           std::random_access_iterator<RandomIt2>
+std::pair<RandomIt1, RandomIt2> mismatch(ExecutionPolicy &&policy,
+                                         RandomIt1 first1, RandomIt1 last1,
+                                         RandomIt2 first2, RandomIt2 last2) {
+  if (last2 - first2 < last1 - first1)
+    last1 = first1 + (last2 - first2);
+  return isl::mismatch(policy, first1, last1, first2);
+}
+} // namespace isl
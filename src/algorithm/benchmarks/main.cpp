@@ -0,0 +1,412 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm> // std::find, std::count, std::equal, ...
+#include <cstdint>   // std::uint32_t, std::uint64_t
+#include <random>    // std::mt19937_64
+#include <vector>    // std::vector
+
+import algorithm;
+import execution;
+import functional;
+import vector;
+
+namespace {
+// An id column without the searched id, so find scans all of it.
+template <class T> std::vector<T> id_column(std::size_t n) {
+  std::vector<T> ids(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ids[i] = static_cast<T>(i * 2654435761u % 1000003 + 1);
+  }
+  return ids;
+}
+
+enum class order { random, sorted, reversed, few_unique };
+
+std::vector<std::uint64_t> sort_input(order pattern, std::size_t n) {
+  std::mt19937_64 rng(42);
+  std::vector<std::uint64_t> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    switch (pattern) {
+    case order::random:
+      values[i] = rng();
+      break;
+    case order::sorted:
+      values[i] = i;
+      break;
+    case order::reversed:
+      values[i] = n - i;
+      break;
+    case order::few_unique:
+      values[i] = rng() % 16;
+      break;
+    }
+  }
+  return values;
+}
+
+// pattern x size; every iteration sorts a fresh copy of the input
+void sort_arguments(benchmark::internal::Benchmark *benchmark) {
+  for (int pattern = 0; pattern < 4; ++pattern) {
+    for (int n : {1000, 100000, 1000000}) {
+      benchmark->Args({pattern, n});
+    }
+  }
+}
+// Sorted column of every third value, searched for random keys.
+std::vector<std::uint32_t> sorted_column(std::size_t n) {
+  std::vector<std::uint32_t> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = static_cast<std::uint32_t>(i * 3);
+  }
+  return values;
+}
+
+// Random values half of which a filter keeps, so that a branch on the
+// predicate mispredicts as often as it can.
+std::vector<std::uint32_t> filter_input(std::size_t n) {
+  std::mt19937_64 rng(50);
+  std::vector<std::uint32_t> values(n);
+  for (std::uint32_t &value : values) {
+    value = static_cast<std::uint32_t>(rng() % 4);
+  }
+  return values;
+}
+
+constexpr auto is_odd = [](std::uint32_t x) { return x % 2 != 0; };
+
+std::vector<std::uint32_t> search_keys(std::size_t n) {
+  std::mt19937_64 rng(48);
+  std::vector<std::uint32_t> keys(1 << 16);
+  for (std::uint32_t &key : keys) {
+    key = static_cast<std::uint32_t>(rng() % (n * 3));
+  }
+  return keys;
+}
+} // namespace
+
+template <class T> static void BM_IslFind(benchmark::State &state) {
+  auto ids = id_column<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::find(ids.begin(), ids.end(), T{0}));
+  }
+  state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(T));
+}
+BENCHMARK(BM_IslFind<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_IslFind<std::uint64_t>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_StdFind(benchmark::State &state) {
+  auto ids = id_column<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::find(ids.begin(), ids.end(), T{0}));
+  }
+  state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(T));
+}
+BENCHMARK(BM_StdFind<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_StdFind<std::uint64_t>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_IslCount(benchmark::State &state) {
+  auto ids = id_column<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::count(ids.begin(), ids.end(), T{42}));
+  }
+  state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(T));
+}
+BENCHMARK(BM_IslCount<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_IslCountParallel(benchmark::State &state) {
+  auto ids = id_column<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        isl::count(isl::execution::par, ids.begin(), ids.end(), T{42}));
+  }
+  state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(T));
+}
+BENCHMARK(BM_IslCountParallel<std::uint32_t>)->Arg(1 << 20)->Arg(1 << 24);
+
+template <class T> static void BM_StdCount(benchmark::State &state) {
+  auto ids = id_column<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::count(ids.begin(), ids.end(), T{42}));
+  }
+  state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(T));
+}
+BENCHMARK(BM_StdCount<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_IslEqual(benchmark::State &state) {
+  auto a = id_column<T>(state.range(0));
+  auto b = a;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::equal(a.begin(), a.end(), b.begin()));
+  }
+  state.SetBytesProcessed(state.iterations() * a.size() * sizeof(T));
+}
+BENCHMARK(BM_IslEqual<std::uint32_t>)->Arg(16)->Arg(1 << 20);
+
+template <class T> static void BM_ScalarEqual(benchmark::State &state) {
+  auto a = id_column<T>(state.range(0));
+  auto b = a;
+  for (auto _ : state) {
+    // a comparison std::equal cannot turn into memcmp
+    benchmark::DoNotOptimize(std::equal(
+        a.begin(), a.end(), b.begin(), [](T x, T y) { return x == y; }));
+  }
+  state.SetBytesProcessed(state.iterations() * a.size() * sizeof(T));
+}
+BENCHMARK(BM_ScalarEqual<std::uint32_t>)->Arg(16)->Arg(1 << 20);
+
+template <class T>
+static void BM_IslLexicographicalCompare(benchmark::State &state) {
+  auto a = id_column<T>(state.range(0));
+  auto b = a;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::lexicographical_compare(a.begin(), a.end(),
+                                                          b.begin(), b.end()));
+  }
+  state.SetBytesProcessed(state.iterations() * a.size() * sizeof(T));
+}
+BENCHMARK(BM_IslLexicographicalCompare<std::uint32_t>)->Arg(1 << 20);
+
+template <class T>
+static void BM_StdLexicographicalCompare(benchmark::State &state) {
+  auto a = id_column<T>(state.range(0));
+  auto b = a;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::lexicographical_compare(a.begin(), a.end(),
+                                                          b.begin(), b.end()));
+  }
+  state.SetBytesProcessed(state.iterations() * a.size() * sizeof(T));
+}
+BENCHMARK(BM_StdLexicographicalCompare<std::uint32_t>)->Arg(1 << 20);
+
+template <class T> static void BM_IslAllOf(benchmark::State &state) {
+  auto ids = id_column<T>(state.range(0));
+  auto valid = isl::bind_back(isl::greater<>{}, T{0});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::all_of(ids.begin(), ids.end(), valid));
+  }
+  state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(T));
+}
+BENCHMARK(BM_IslAllOf<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_StdAllOf(benchmark::State &state) {
+  auto ids = id_column<T>(state.range(0));
+  auto valid = isl::bind_back(isl::greater<>{}, T{0});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::all_of(ids.begin(), ids.end(), valid));
+  }
+  state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(T));
+}
+BENCHMARK(BM_StdAllOf<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_IslCountIf(benchmark::State &state) {
+  auto ids = id_column<T>(state.range(0));
+  auto small = isl::bind_back(isl::less<>{}, T{500000});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::count_if(ids.begin(), ids.end(), small));
+  }
+  state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(T));
+}
+BENCHMARK(BM_IslCountIf<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_StdCountIf(benchmark::State &state) {
+  auto ids = id_column<T>(state.range(0));
+  auto small = isl::bind_back(isl::less<>{}, T{500000});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::count_if(ids.begin(), ids.end(), small));
+  }
+  state.SetBytesProcessed(state.iterations() * ids.size() * sizeof(T));
+}
+BENCHMARK(BM_StdCountIf<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_IslSort(benchmark::State &state) {
+  auto input = sort_input(static_cast<order>(state.range(0)), state.range(1));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    isl::sort(values.begin(), values.end());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_IslSort)->Apply(sort_arguments);
+
+static void BM_StdSort(benchmark::State &state) {
+  auto input = sort_input(static_cast<order>(state.range(0)), state.range(1));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    std::sort(values.begin(), values.end());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_StdSort)->Apply(sort_arguments);
+
+static void BM_IslStableSort(benchmark::State &state) {
+  auto input = sort_input(static_cast<order>(state.range(0)), state.range(1));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    isl::stable_sort(values.begin(), values.end());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_IslStableSort)->Apply(sort_arguments);
+
+static void BM_StdStableSort(benchmark::State &state) {
+  auto input = sort_input(static_cast<order>(state.range(0)), state.range(1));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    std::stable_sort(values.begin(), values.end());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_StdStableSort)->Apply(sort_arguments);
+
+static void BM_IslPartialSort(benchmark::State &state) {
+  auto input = sort_input(order::random, state.range(0));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    isl::partial_sort(values.begin(), values.begin() + 100, values.end());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_IslPartialSort)->Arg(100000);
+
+static void BM_StdPartialSort(benchmark::State &state) {
+  auto input = sort_input(order::random, state.range(0));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    std::partial_sort(values.begin(), values.begin() + 100, values.end());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_StdPartialSort)->Arg(100000);
+
+static void BM_IslLowerBound(benchmark::State &state) {
+  auto values = sorted_column(state.range(0));
+  auto keys = search_keys(state.range(0));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::lower_bound(values.begin(), values.end(),
+                                              keys[i++ & 0xFFFF]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IslLowerBound)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 24);
+
+static void BM_StdLowerBound(benchmark::State &state) {
+  auto values = sorted_column(state.range(0));
+  auto keys = search_keys(state.range(0));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::lower_bound(values.begin(), values.end(),
+                                              keys[i++ & 0xFFFF]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdLowerBound)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 24);
+
+static void BM_IslRadixSort(benchmark::State &state) {
+  auto input = sort_input(static_cast<order>(state.range(0)), state.range(1));
+  auto values = input;
+  isl::vector<std::uint64_t> buffer;
+  for (auto _ : state) {
+    values = input;
+    isl::radix_sort(values.begin(), values.end(), buffer);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_IslRadixSort)->Apply(sort_arguments);
+
+static void BM_IslMsdRadixSort(benchmark::State &state) {
+  auto input = sort_input(static_cast<order>(state.range(0)), state.range(1));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    isl::msd_radix_sort(values.begin(), values.end());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_IslMsdRadixSort)->Apply(sort_arguments);
+
+static void BM_IslRemoveIf(benchmark::State &state) {
+  auto input = filter_input(state.range(0));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    benchmark::DoNotOptimize(
+        isl::remove_if(values.begin(), values.end(), is_odd));
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_IslRemoveIf)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_StdRemoveIf(benchmark::State &state) {
+  auto input = filter_input(state.range(0));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    benchmark::DoNotOptimize(
+        std::remove_if(values.begin(), values.end(), is_odd));
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_StdRemoveIf)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_IslUnique(benchmark::State &state) {
+  auto input = filter_input(state.range(0));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    benchmark::DoNotOptimize(isl::unique(values.begin(), values.end()));
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_IslUnique)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_StdUnique(benchmark::State &state) {
+  auto input = filter_input(state.range(0));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    benchmark::DoNotOptimize(std::unique(values.begin(), values.end()));
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_StdUnique)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_IslPartition(benchmark::State &state) {
+  auto input = filter_input(state.range(0));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    benchmark::DoNotOptimize(
+        isl::partition(values.begin(), values.end(), is_odd));
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_IslPartition)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_StdPartition(benchmark::State &state) {
+  auto input = filter_input(state.range(0));
+  auto values = input;
+  for (auto _ : state) {
+    values = input;
+    benchmark::DoNotOptimize(
+        std::partition(values.begin(), values.end(), is_odd));
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_StdPartition)->Arg(1 << 10)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,705 @@
+#include <gtest/gtest.h>
+
+#include <algorithm> // std::lexicographical_compare, std::sort, ...
+#include <array>     // std::array
+#include <cmath>     // NAN, std::isnan
+#include <cstdint>   // std::int8_t, std::uint16_t, std::int32_t, ...
+#include <list>      // std::list
+#include <memory>    // std::unique_ptr, std::make_unique
+#include <random>    // std::mt19937_64
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::string, std::to_string
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+import algorithm;
+import execution;
+import functional;
+import vector;
+
+namespace {
+template <class T> void check_find_and_count(std::mt19937_64 &rng) {
+  for (std::size_t n = 0; n < 300; ++n) {
+    std::vector<T> values(n);
+    for (T &value : values) {
+      value = static_cast<T>(rng() % 8);
+    }
+    for (int v = 0; v < 9; ++v) {
+      T target = static_cast<T>(v);
+      const T *first = values.data();
+      const T *last = first + n;
+
+      const T *expected = last;
+      std::ptrdiff_t expected_count = 0;
+      for (const T *p = last; p != first;) {
+        if (*--p == target) {
+          expected = p;
+          ++expected_count;
+        }
+      }
+      ASSERT_EQ(isl::find(first, last, target), expected) << n;
+      ASSERT_EQ(isl::count(first, last, target), expected_count) << n;
+    }
+  }
+}
+
+template <class T> void check_comparisons(std::mt19937_64 &rng) {
+  for (std::size_t n = 0; n < 200; ++n) {
+    std::vector<T> a(n);
+    for (T &value : a) {
+      value = static_cast<T>(rng() % 1000);
+    }
+    for (int trial = 0; trial < 4; ++trial) {
+      std::vector<T> b = a;
+      std::size_t at = n;
+      if (n != 0 && trial != 0) {
+        at = rng() % n;
+        b[at] = static_cast<T>(b[at] + 1 + rng() % 3);
+      }
+      if (trial == 3) {
+        b.resize(rng() % (n + 1));
+        at = at < b.size() ? at : b.size();
+      }
+
+      auto [i, j] = isl::mismatch(a.begin(), a.end(), b.begin(), b.end());
+      ASSERT_EQ(i - a.begin(), static_cast<std::ptrdiff_t>(at)) << n;
+      ASSERT_EQ(j - b.begin(), static_cast<std::ptrdiff_t>(at)) << n;
+      ASSERT_EQ(isl::equal(a.begin(), a.end(), b.begin(), b.end()), a == b);
+      ASSERT_EQ(isl::lexicographical_compare(a.begin(), a.end(), b.begin(),
+                                             b.end()),
+                std::lexicographical_compare(a.begin(), a.end(), b.begin(),
+                                             b.end()))
+          << n;
+      ASSERT_EQ(isl::lexicographical_compare(b.begin(), b.end(), a.begin(),
+                                             a.end()),
+                std::lexicographical_compare(b.begin(), b.end(), a.begin(),
+                                             a.end()))
+          << n;
+    }
+  }
+}
+
+constexpr int find_in_constexpr() {
+  int values[] = {4, 8, 15, 16, 23, 42};
+  return static_cast<int>(isl::find(values, values + 6, 16) - values) +
+         10 * static_cast<int>(isl::count(values, values + 6, 42));
+}
+} // namespace
+
+static_assert(find_in_constexpr() == 13);
+
+TEST(TestFind, TestElementTypes) {
+  std::mt19937_64 rng(5);
+  check_find_and_count<std::int8_t>(rng);
+  check_find_and_count<std::uint16_t>(rng);
+  check_find_and_count<std::int32_t>(rng);
+  check_find_and_count<std::uint64_t>(rng);
+  check_find_and_count<float>(rng);
+  check_find_and_count<double>(rng);
+}
+
+TEST(TestFind, TestLongRangeCount) {
+  // enough blocks to flush the 16-bit lane counters more than once
+  std::vector<std::uint16_t> values(300000, 7);
+  values[123456] = 8;
+  ASSERT_EQ(isl::count(values.data(), values.data() + values.size(), 7),
+            299999);
+  ASSERT_EQ(isl::find(values.begin(), values.end(), 8),
+            values.begin() + 123456);
+}
+
+TEST(TestFind, TestMixedValueTypes) {
+  std::vector<std::uint8_t> bytes(100, 44);
+  // 300 is out of range for the elements and must not match 300 % 256
+  ASSERT_EQ(isl::find(bytes.begin(), bytes.end(), 300), bytes.end());
+  ASSERT_EQ(isl::count(bytes.begin(), bytes.end(), 44L), 100);
+
+  std::vector<int> ints(100, -1);
+  ints[60] = 5;
+  ASSERT_EQ(isl::find(ints.begin(), ints.end(), 5ull), ints.begin() + 60);
+  ASSERT_EQ(isl::count(ints.begin(), ints.end(), -1L), 99);
+}
+
+TEST(TestFind, TestFloatSemantics) {
+  std::vector<double> values(50, 1.0);
+  values[10] = -0.0;
+  values[20] = NAN;
+  ASSERT_EQ(isl::find(values.begin(), values.end(), 0.0),
+            values.begin() + 10);
+  ASSERT_EQ(isl::count(values.begin(), values.end(), double(NAN)), 0);
+}
+
+TEST(TestFind, TestNonContiguous) {
+  std::list<int> values = {3, 1, 4, 1, 5};
+  ASSERT_EQ(*std::next(isl::find(values.begin(), values.end(), 4), 1), 1);
+  ASSERT_EQ(isl::count(values.begin(), values.end(), 1), 2);
+}
+
+TEST(TestCompare, TestElementTypes) {
+  std::mt19937_64 rng(9);
+  check_comparisons<unsigned char>(rng);
+  check_comparisons<signed char>(rng);
+  check_comparisons<std::uint16_t>(rng);
+  check_comparisons<std::int32_t>(rng);
+  check_comparisons<std::uint64_t>(rng);
+  check_comparisons<double>(rng);
+}
+
+TEST(TestCompare, TestThreeIteratorMismatch) {
+  int a[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  int b[] = {1, 2, 3, 4, 5, 6, 7, 8, 0, 10, 11, 12};
+  auto [i, j] = isl::mismatch(a, a + 12, b);
+  ASSERT_EQ(i, a + 8);
+  ASSERT_EQ(j, b + 8);
+  ASSERT_TRUE(isl::equal(a, a + 8, b));
+  ASSERT_FALSE(isl::equal(a, a + 12, b));
+  ASSERT_TRUE(isl::equal(a, a + 12, b, [](int x, int y) {
+    return x == y || y == 0;
+  }));
+}
+
+TEST(TestCompare, TestFloatingPoint) {
+  std::vector<double> a(40, 1.0), b(40, 1.0);
+  a[30] = 0.0;
+  b[30] = -0.0;
+  ASSERT_TRUE(isl::equal(a.begin(), a.end(), b.begin(), b.end()));
+  b[31] = NAN;
+  a[31] = NAN;
+  ASSERT_FALSE(isl::equal(a.begin(), a.end(), b.begin(), b.end()));
+}
+
+TEST(TestCompare, TestNonContiguous) {
+  std::list<int> a = {1, 2, 3};
+  std::list<int> b = {1, 2, 4};
+  ASSERT_FALSE(isl::equal(a.begin(), a.end(), b.begin(), b.end()));
+  ASSERT_TRUE(isl::lexicographical_compare(a.begin(), a.end(), b.begin(),
+                                           b.end()));
+  ASSERT_EQ(*isl::mismatch(a.begin(), a.end(), b.begin()).first, 3);
+}
+
+TEST(TestPredicates, TestBlocksMatchScalar) {
+  std::mt19937_64 rng(11);
+  for (std::size_t n = 0; n < 200; ++n) {
+    std::vector<int> values(n);
+    for (int &value : values) {
+      value = static_cast<int>(rng() % 1000);
+    }
+    std::list<int> list(values.begin(), values.end());
+    for (int threshold : {-1, 0, 500, 998, 999, 1000}) {
+      auto below = isl::bind_back(isl::less<>{}, threshold);
+      ASSERT_EQ(isl::all_of(values.begin(), values.end(), below),
+                isl::all_of(list.begin(), list.end(), below));
+      ASSERT_EQ(isl::any_of(values.begin(), values.end(), below),
+                isl::any_of(list.begin(), list.end(), below));
+      ASSERT_EQ(isl::none_of(values.begin(), values.end(), below),
+                isl::none_of(list.begin(), list.end(), below));
+      ASSERT_EQ(isl::count_if(values.begin(), values.end(), below),
+                isl::count_if(list.begin(), list.end(), below));
+    }
+  }
+}
+
+TEST(TestPredicates, TestUserPredicateStopsAtMatch) {
+  // only bound isl comparisons run past the element that decides
+  std::vector<int> values(100, 1);
+  values[40] = 0;
+  int calls = 0;
+  auto positive = [&calls](int x) {
+    ++calls;
+    return x > 0;
+  };
+  ASSERT_FALSE(isl::all_of(values.begin(), values.end(), positive));
+  ASSERT_EQ(calls, 41);
+  calls = 0;
+  ASSERT_TRUE(isl::any_of(values.begin(), values.end(),
+                          [&calls](int x) { return ++calls, x == 0; }));
+  ASSERT_EQ(calls, 41);
+  calls = 0;
+  ASSERT_EQ(isl::count_if(values.begin(), values.end(), positive), 99);
+  ASSERT_EQ(calls, 100);
+}
+
+TEST(TestPredicates, TestBind) {
+  auto at_least_five = isl::bind_front(isl::less_equal<>{}, 5);
+  ASSERT_TRUE(at_least_five(5));
+  ASSERT_FALSE(at_least_five(4));
+  auto minus_two = isl::bind_back(isl::minus<>{}, 2);
+  ASSERT_EQ(minus_two(10), 8);
+  auto three_minus = isl::bind_front(isl::minus<>{}, 3);
+  ASSERT_EQ(three_minus(10), -7);
+}
+
+namespace {
+// Inputs that defeat naive quicksorts, at each size.
+std::vector<std::vector<int>> sort_inputs(std::mt19937_64 &rng) {
+  std::vector<std::vector<int>> inputs;
+  for (int n : {0, 1, 2, 3, 10, 23, 24, 25, 100, 129, 1000, 10000, 100000}) {
+    std::vector<int> random(n), sorted(n), reversed(n), few(n), organ(n),
+        sawtooth(n);
+    for (int i = 0; i < n; ++i) {
+      random[i] = static_cast<int>(rng());
+      sorted[i] = i;
+      reversed[i] = n - i;
+      few[i] = static_cast<int>(rng() % 4);
+      organ[i] = i < n / 2 ? i : n - i;
+      sawtooth[i] = i % 50;
+    }
+    std::vector<int> nearly = sorted;
+    if (n > 10) {
+      std::swap(nearly[n / 3], nearly[2 * n / 3]);
+    }
+    for (auto &input : {random, sorted, reversed, few, organ, sawtooth, nearly})
+      inputs.push_back(input);
+  }
+  return inputs;
+}
+} // namespace
+
+TEST(TestSort, TestSortMatchesStd) {
+  std::mt19937_64 rng(13);
+  for (auto input : sort_inputs(rng)) {
+    auto expected = input;
+    std::sort(expected.begin(), expected.end());
+    auto ints = input;
+    isl::sort(ints.begin(), ints.end());
+    ASSERT_EQ(ints, expected);
+
+    std::vector<std::string> strings;
+    for (int value : input)
+      strings.push_back(std::to_string(value));
+    auto expected_strings = strings;
+    std::sort(expected_strings.begin(), expected_strings.end(),
+              std::greater<>{});
+    isl::sort(strings.begin(), strings.end(), std::greater<>{});
+    ASSERT_EQ(strings, expected_strings);
+
+    std::vector<double> doubles(input.begin(), input.end());
+    isl::sort(doubles.begin(), doubles.end(), isl::greater<>{});
+    ASSERT_TRUE(isl::is_sorted(doubles.begin(), doubles.end(),
+                               isl::greater<>{}));
+  }
+}
+
+TEST(TestSort, TestSortMoveOnly) {
+  std::mt19937_64 rng(17);
+  std::vector<std::unique_ptr<int>> values;
+  for (int i = 0; i < 1000; ++i)
+    values.push_back(std::make_unique<int>(static_cast<int>(rng() % 100)));
+  auto by_value = [](const auto &a, const auto &b) { return *a < *b; };
+  isl::sort(values.begin(), values.end(), by_value);
+  ASSERT_TRUE(isl::is_sorted(values.begin(), values.end(), by_value));
+}
+
+TEST(TestSort, TestStableSort) {
+  std::mt19937_64 rng(19);
+  for (auto input : sort_inputs(rng)) {
+    std::vector<std::pair<int, int>> records;
+    for (std::size_t i = 0; i < input.size(); ++i)
+      records.push_back({input[i] % 16, static_cast<int>(i)});
+    auto expected = records;
+    std::stable_sort(
+        expected.begin(), expected.end(),
+        [](const auto &a, const auto &b) { return a.first < b.first; });
+    isl::stable_sort(
+        records.begin(), records.end(),
+        [](const auto &a, const auto &b) { return a.first < b.first; });
+    ASSERT_EQ(records, expected);
+  }
+}
+
+TEST(TestSort, TestStableSortThrows) {
+  // owning elements, so a leaked buffer or element shows up under ASan
+  std::vector<std::string> values;
+  for (int i = 0; i < 500; ++i)
+    values.push_back(std::string(32, 'a') + std::to_string(i * 7919 % 500));
+
+  for (int limit : {10, 2000, 4000}) {
+    auto copy = values;
+    int comparisons = 0;
+    auto throwing = [&comparisons, limit](const std::string &a,
+                                          const std::string &b) {
+      if (++comparisons == limit)
+        throw std::runtime_error("comparison limit");
+      return a < b;
+    };
+    ASSERT_THROW(isl::stable_sort(copy.begin(), copy.end(), throwing),
+                 std::runtime_error);
+    ASSERT_EQ(copy.size(), values.size());
+  }
+}
+
+TEST(TestSort, TestPartialSort) {
+  std::mt19937_64 rng(23);
+  for (auto input : sort_inputs(rng)) {
+    auto expected = input;
+    std::sort(expected.begin(), expected.end());
+    for (std::size_t k : {std::size_t{0}, std::size_t{1}, input.size() / 2,
+                          input.size()}) {
+      if (k > input.size())
+        continue;
+      auto values = input;
+      isl::partial_sort(values.begin(), values.begin() + k, values.end());
+      ASSERT_TRUE(std::equal(values.begin(), values.begin() + k,
+                             expected.begin()));
+      std::sort(values.begin(), values.end());
+      ASSERT_EQ(values, expected);
+    }
+  }
+}
+
+TEST(TestSort, TestIsSorted) {
+  int values[] = {1, 2, 2, 3, 1};
+  ASSERT_TRUE(isl::is_sorted(values, values + 4));
+  ASSERT_FALSE(isl::is_sorted(values, values + 5));
+  ASSERT_EQ(isl::is_sorted_until(values, values + 5), values + 4);
+  ASSERT_TRUE(isl::is_sorted(values, values));
+}
+
+namespace {
+template <class T> void check_radix_sort(std::mt19937_64 &rng) {
+  isl::vector<T> buffer;
+  for (std::size_t n : {0, 1, 2, 63, 64, 65, 500, 5000}) {
+    std::vector<T> values(n);
+    for (T &value : values) {
+      value = static_cast<T>(rng());
+    }
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    auto lsd = values;
+    isl::radix_sort(lsd.begin(), lsd.end(), buffer);
+    ASSERT_EQ(lsd, expected);
+    auto msd = values;
+    isl::msd_radix_sort(msd.begin(), msd.end());
+    ASSERT_EQ(msd, expected);
+  }
+}
+} // namespace
+
+TEST(TestRadixSort, TestIntegers) {
+  std::mt19937_64 rng(45);
+  check_radix_sort<std::uint8_t>(rng);
+  check_radix_sort<std::int8_t>(rng);
+  check_radix_sort<std::uint16_t>(rng);
+  check_radix_sort<std::int32_t>(rng);
+  check_radix_sort<std::uint64_t>(rng);
+  check_radix_sort<std::int64_t>(rng);
+}
+
+TEST(TestRadixSort, TestFloatingPoint) {
+  std::mt19937_64 rng(45);
+  std::vector<double> values(3000);
+  for (double &value : values) {
+    value = std::uniform_real_distribution<double>(-1e6, 1e6)(rng);
+  }
+  values[0] = -INFINITY;
+  values[1] = INFINITY;
+  values[2] = 0.0;
+  values[3] = 1e-310;
+  values[4] = -1e-310;
+  auto expected = values;
+  std::sort(expected.begin(), expected.end());
+
+  auto lsd = values;
+  isl::radix_sort(lsd.begin(), lsd.end());
+  ASSERT_EQ(lsd, expected);
+  auto msd = values;
+  isl::msd_radix_sort(msd.begin(), msd.end());
+  ASSERT_EQ(msd, expected);
+
+  std::vector<float> floats = {1.5f, -0.0f, -2.0f, 0.0f, -NAN, NAN, 3.0f};
+  isl::radix_sort(floats.begin(), floats.end());
+  ASSERT_TRUE(std::isnan(floats[0]) && std::signbit(floats[0]));
+  ASSERT_EQ(floats[1], -2.0f);
+  ASSERT_TRUE(std::signbit(floats[2]));
+  ASSERT_FALSE(std::signbit(floats[3]));
+  ASSERT_EQ(floats[4], 1.5f);
+  ASSERT_EQ(floats[5], 3.0f);
+  ASSERT_TRUE(std::isnan(floats[6]) && !std::signbit(floats[6]));
+}
+
+TEST(TestRadixSort, TestProjectionIsStable) {
+  struct record {
+    std::int32_t key;
+    std::string name;
+  };
+  std::mt19937_64 rng(45);
+  std::vector<record> records(2000);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    records[i] = {static_cast<std::int32_t>(rng() % 100) - 50,
+                  std::to_string(i)};
+  }
+  auto expected = records;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const record &a, const record &b) {
+                     return a.key < b.key;
+                   });
+
+  isl::vector<record> buffer;
+  isl::radix_sort(records.begin(), records.end(), buffer, &record::key);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    ASSERT_EQ(records[i].key, expected[i].key);
+    ASSERT_EQ(records[i].name, expected[i].name);
+  }
+
+  std::shuffle(records.begin(), records.end(), rng);
+  isl::msd_radix_sort(records.begin(), records.end(), &record::key);
+  ASSERT_TRUE(std::is_sorted(records.begin(), records.end(),
+                             [](const record &a, const record &b) {
+                               return a.key < b.key;
+                             }));
+}
+
+TEST(TestRadixSort, TestBufferIsReused) {
+  std::mt19937_64 rng(45);
+  isl::vector<std::uint64_t> buffer;
+  std::vector<std::uint64_t> values(1000);
+  for (std::uint64_t &value : values) {
+    value = rng();
+  }
+  isl::radix_sort(values.begin(), values.end(), buffer);
+  const std::uint64_t *storage = buffer.data();
+  ASSERT_GE(buffer.size(), values.size());
+
+  for (std::uint64_t &value : values) {
+    value = rng() >> 40;
+  }
+  values.resize(800);
+  isl::radix_sort(values.begin(), values.end(), buffer);
+  ASSERT_EQ(buffer.data(), storage);
+  ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST(TestParallel, TestMatchesSequential) {
+  std::vector<std::uint32_t> values(100000);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<std::uint32_t>(i * 2654435761u % 1000);
+  }
+  auto first = values.begin();
+  auto last = values.end();
+  auto odd = [](std::uint32_t v) { return v % 2 == 1; };
+  auto small = [](std::uint32_t v) { return v < 1000; };
+
+  ASSERT_EQ(isl::count(isl::execution::par, first, last, 7u),
+            std::count(first, last, 7u));
+  ASSERT_EQ(isl::count_if(isl::execution::par_unseq, first, last, odd),
+            std::count_if(first, last, odd));
+  ASSERT_EQ(isl::count_if(isl::execution::seq, first, last, odd),
+            std::count_if(first, last, odd));
+  ASSERT_TRUE(isl::all_of(isl::execution::par, first, last, small));
+  ASSERT_TRUE(isl::any_of(isl::execution::par, first, last, odd));
+  ASSERT_FALSE(isl::none_of(isl::execution::par, first, last, odd));
+
+  // hits in several chunks: the first one wins
+  for (std::size_t at : {0, 1, 4095, 4096, 50000, 99999}) {
+    auto copy = values;
+    copy[at] = 5000;
+    copy[copy.size() - 1] = 5000;
+    auto hit = isl::find(isl::execution::par, copy.begin(), copy.end(),
+                         5000u);
+    ASSERT_EQ(hit - copy.begin(), at);
+    auto big = isl::find_if(isl::execution::par, copy.begin(), copy.end(),
+                            [](std::uint32_t v) { return v >= 1000; });
+    ASSERT_EQ(big - copy.begin(), at);
+    ASSERT_FALSE(isl::all_of(isl::execution::par, copy.begin(), copy.end(),
+                             small));
+
+    auto [left, right] = isl::mismatch(isl::execution::par, values.begin(),
+                                       values.end(), copy.begin());
+    ASSERT_EQ(left - values.begin(), at);
+    ASSERT_EQ(right - copy.begin(), at);
+  }
+  ASSERT_EQ(isl::find(isl::execution::par, first, last, 5000u), last);
+  ASSERT_EQ(isl::mismatch(isl::execution::par, first, last, first,
+                          first + 10)
+                .first,
+            first + 10);
+}
+
+TEST(TestParallel, TestForEach) {
+  std::vector<int> values(50000, 1);
+  isl::for_each(isl::execution::par, values.begin(), values.end(),
+                [](int &v) { v *= 3; });
+  ASSERT_EQ(std::count(values.begin(), values.end(), 3), 50000);
+  auto end = isl::for_each_n(isl::execution::par, values.begin(), 100,
+                             [](int &v) { v = 0; });
+  ASSERT_EQ(end - values.begin(), 100);
+  ASSERT_EQ(std::count(values.begin(), values.end(), 0), 100);
+}
+
+TEST(TestBinarySearch, TestMatchesStd) {
+  std::mt19937_64 rng(48);
+  std::list<int> list;
+  for (std::size_t n : {0, 1, 2, 3, 10, 100, 1000, 5000}) {
+    std::vector<int> values(n);
+    for (int &value : values) {
+      value = static_cast<int>(rng() % (n + 1) * 2);
+    }
+    std::sort(values.begin(), values.end());
+    list.assign(values.begin(), values.end());
+    for (int key = -1; key <= static_cast<int>(n) * 2 + 1; ++key) {
+      auto first = values.begin();
+      auto last = values.end();
+      ASSERT_EQ(isl::lower_bound(first, last, key),
+                std::lower_bound(first, last, key));
+      ASSERT_EQ(isl::upper_bound(first, last, key),
+                std::upper_bound(first, last, key));
+      ASSERT_EQ(isl::equal_range(first, last, key),
+                std::equal_range(first, last, key));
+      ASSERT_EQ(isl::binary_search(first, last, key),
+                std::binary_search(first, last, key));
+      ASSERT_EQ(std::distance(list.begin(), isl::lower_bound(
+                                                list.begin(), list.end(), key)),
+                std::lower_bound(first, last, key) - first);
+    }
+  }
+}
+
+TEST(TestBinarySearch, TestComparator) {
+  std::vector<int> values = {9, 7, 7, 4, 1};
+  auto [lower, upper] = isl::equal_range(values.begin(), values.end(), 7,
+                                         isl::greater<>{});
+  ASSERT_EQ(lower - values.begin(), 1);
+  ASSERT_EQ(upper - values.begin(), 3);
+  ASSERT_FALSE(isl::binary_search(values.begin(), values.end(), 5,
+                                  isl::greater<>{}));
+}
+
+namespace {
+template <class T> void check_compaction(std::mt19937_64 &rng) {
+  auto odd = [](const T &x) { return static_cast<long long>(x) % 2 != 0; };
+  for (std::size_t n = 0; n < 200; ++n) {
+    std::vector<T> values(n);
+    for (T &value : values) {
+      value = static_cast<T>(rng() % 4);
+    }
+    T target = static_cast<T>(2);
+
+    auto expected = values;
+    auto actual = values;
+    expected.erase(std::remove(expected.begin(), expected.end(), target),
+                   expected.end());
+    actual.erase(isl::remove(actual.begin(), actual.end(), target),
+                 actual.end());
+    ASSERT_EQ(expected, actual);
+
+    expected = values;
+    actual = values;
+    expected.erase(std::remove_if(expected.begin(), expected.end(), odd),
+                   expected.end());
+    actual.erase(isl::remove_if(actual.begin(), actual.end(), odd),
+                 actual.end());
+    ASSERT_EQ(expected, actual);
+
+    expected = values;
+    actual = values;
+    expected.erase(std::unique(expected.begin(), expected.end()),
+                   expected.end());
+    actual.erase(isl::unique(actual.begin(), actual.end()), actual.end());
+    ASSERT_EQ(expected, actual);
+
+    expected.assign(n, T{});
+    actual.assign(n, T{});
+    expected.erase(
+        std::copy_if(values.begin(), values.end(), expected.begin(), odd),
+        expected.end());
+    actual.erase(
+        isl::copy_if(values.begin(), values.end(), actual.begin(), odd),
+        actual.end());
+    ASSERT_EQ(expected, actual);
+
+    actual = values;
+    auto middle = isl::partition(actual.begin(), actual.end(), odd);
+    ASSERT_TRUE(std::all_of(actual.begin(), middle, odd));
+    ASSERT_TRUE(std::none_of(middle, actual.end(), odd));
+    expected = values;
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    ASSERT_EQ(expected, actual);
+  }
+}
+} // namespace
+
+TEST(TestCompaction, TestMatchesStd) {
+  std::mt19937_64 rng(50);
+  check_compaction<std::int32_t>(rng);
+  check_compaction<std::uint32_t>(rng);
+  check_compaction<std::int64_t>(rng);
+  check_compaction<std::uint64_t>(rng);
+  check_compaction<float>(rng);
+  check_compaction<double>(rng);
+  check_compaction<std::int16_t>(rng);
+}
+
+TEST(TestCompaction, TestFloats) {
+  std::vector<double> values = {0.0, -0.0, NAN, NAN, 1.0, -0.0, 2.0};
+  values.resize(40, 3.0);
+  auto end = isl::remove(values.begin(), values.end(), 0.0);
+  ASSERT_EQ(end - values.begin(), 37);
+  ASSERT_TRUE(std::isnan(values[0]) && std::isnan(values[1]));
+  end = isl::unique(values.begin(), end);
+  ASSERT_EQ(end - values.begin(), 5);
+  // nothing equals NaN
+  ASSERT_EQ(isl::remove(values.begin(), end, NAN), end);
+}
+
+TEST(TestCompaction, TestForwardIterators) {
+  std::list<std::string> words = {"a", "b", "b", "c", "b", "d"};
+  auto end = isl::unique(words.begin(), words.end());
+  end = isl::remove(words.begin(), end, std::string("c"));
+  words.erase(end, words.end());
+  ASSERT_EQ(words, (std::list<std::string>{"a", "b", "b", "d"}));
+  auto middle = isl::partition(words.begin(), words.end(),
+                               [](const std::string &w) { return w == "b"; });
+  ASSERT_EQ(std::distance(words.begin(), middle), 2);
+}
+
+TEST(TestCompaction, TestVectorErase) {
+  isl::vector<int> values;
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i % 10);
+  }
+  ASSERT_EQ(isl::erase(values, 3), 10u);
+  ASSERT_EQ(isl::erase(values, 3000000000LL), 0u);
+  ASSERT_EQ(isl::erase_if(values, [](int x) { return x % 2 == 0; }), 50u);
+  ASSERT_EQ(values.size(), 40u);
+  std::array<int, 4> kept = {1, 5, 7, 9};
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], kept[i % 4]);
+  }
+
+  isl::vector<std::string> words;
+  for (int i = 0; i < 20; ++i) {
+    words.push_back(std::to_string(i));
+  }
+  ASSERT_EQ(isl::erase_if(words, [](const std::string &w) {
+              return w.size() == 2;
+            }),
+            10u);
+  ASSERT_EQ(isl::erase(words, std::string("4")), 1u);
+  ASSERT_EQ(words.size(), 9u);
+  ASSERT_EQ(words[4], "5");
+
+  words.erase(words.begin() + 1, words.begin() + 3);
+  ASSERT_EQ(words.size(), 7u);
+  ASSERT_EQ(words[1], "3");
+  words.erase(words.begin());
+  ASSERT_EQ(words[0], "3");
+}
+
+static_assert([] {
+  int values[] = {1, 3, 3, 5};
+  return isl::lower_bound(values, values + 4, 3) == values + 1 &&
+         isl::upper_bound(values, values + 4, 3) == values + 3;
+}());
+
+static_assert([] {
+  int values[] = {5, 3, 9, 1, 7};
+  isl::sort(values, values + 5);
+  return isl::is_sorted(values, values + 5);
+}());
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -8,6 +8,7 @@ module;
 
 export module array;
 
+import algorithm;
 import type_traits;
 import utility;
 
@@ -24,7 +25,7 @@ template <class T, size_t N> struct array {
   using size_type = size_t;
   using difference_type = ptrdiff_t;
   using iterator = pointer;
-  using const_iterator = const pointer;
+  using const_iterator = const_pointer;
   using reverse_iterator = std::reverse_iterator<iterator>;
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
@@ -61,7 +62,7 @@ template <class T, size_t N> struct array {
   }
 
   constexpr const_iterator cbegin() const noexcept { return this->begin(); }
-  constexpr const_iterator cend() const noexcept { return this->end; }
+  constexpr const_iterator cend() const noexcept { return this->end(); }
   constexpr const_reverse_iterator crbegin() const noexcept {
     return this->rbegin();
   }
@@ -95,8 +96,25 @@ template <class T, size_t N> struct array {
   constexpr const_reference back() const { return __storage[N - 1]; }
 
   constexpr T *data() noexcept { return __storage; }
-  constexpr const T *data() const noexcept { return __storage }
+  constexpr const T *data() const noexcept { return __storage; }
 };
 
 template <class T, class... U> array(T, U...) -> array<T, 1 + sizeof...(U)>;
+
+// comparisons; arrays of integers, enums and pointers compare as bytes
+
+template <class T, size_t N>
+constexpr bool operator==(const array<T, N> &x, const array<T, N> &y) {
+  return isl::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, size_t N>
+  requires std::three_way_comparable<T>
+constexpr std::compare_three_way_result_t<T>
+operator<=>(const array<T, N> &x, const array<T, N> &y) {
+  auto [i, j] = isl::mismatch(x.begin(), x.end(), y.begin());
+  if (i == x.end())
+    return std::strong_ordering::equal;
+  return *i <=> *j;
+}
 } // namespace isl
\ No newline at end of file
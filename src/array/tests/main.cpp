@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <string> // std::string
+
+import array;
+
+TEST(TestArray, TestCompareIntegers) {
+  isl::array<int, 20> a{};
+  isl::array<int, 20> b{};
+  ASSERT_TRUE(a == b);
+  ASSERT_TRUE((a <=> b) == 0);
+
+  b[17] = -1;
+  ASSERT_FALSE(a == b);
+  ASSERT_TRUE(a > b);
+  ASSERT_TRUE(b < a);
+}
+
+TEST(TestArray, TestCompareBytes) {
+  isl::array<unsigned char, 3> a{1, 200, 3};
+  isl::array<unsigned char, 3> b{1, 100, 4};
+  ASSERT_TRUE(a > b);
+  ASSERT_TRUE(a != b);
+}
+
+TEST(TestArray, TestCompareStrings) {
+  isl::array<std::string, 2> a{"apple", "pear"};
+  isl::array<std::string, 2> b{"apple", "plum"};
+  ASSERT_TRUE(a < b);
+  ASSERT_TRUE(a == a);
+  ASSERT_TRUE((b <=> a) == std::strong_ordering::greater);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
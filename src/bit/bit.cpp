@@ -0,0 +1,224 @@
+module;
+
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::is_integral_v, std::make_unsigned_t, ...
+
+export module bit;
+
+import bytes;
+
+namespace isl::detail {
+template <class T>
+concept unsigned_integer =
+    std::is_same_v<T, unsigned char> || std::is_same_v<T, unsigned short> ||
+    std::is_same_v<T, unsigned int> || std::is_same_v<T, unsigned long> ||
+    std::is_same_v<T, unsigned long long>;
+
+template <class T>
+concept loadable_integer =
+    std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template <class T> inline constexpr int digits = sizeof(T) * 8;
+} // namespace isl::detail
+
+export namespace isl {
+enum class endian {
+  little = __ORDER_LITTLE_ENDIAN__,
+  big = __ORDER_BIG_ENDIAN__,
+  native = __BYTE_ORDER__
+};
+
+template <class To, class From>
+  requires(sizeof(To) == sizeof(From) && std::is_trivially_copyable_v<To> &&
+           std::is_trivially_copyable_v<From>)
+constexpr To bit_cast(const From &from) noexcept {
+  return __builtin_bit_cast(To, from);
+}
+
+template <class T>
+  requires detail::loadable_integer<T>
+constexpr T byteswap(T value) noexcept {
+  using U = std::make_unsigned_t<T>;
+  auto bits = static_cast<U>(value);
+  if constexpr (sizeof(T) == 2) {
+    bits = __builtin_bswap16(bits);
+  } else if constexpr (sizeof(T) == 4) {
+    bits = __builtin_bswap32(bits);
+  } else if constexpr (sizeof(T) == 8) {
+    bits = __builtin_bswap64(bits);
+  }
+  return static_cast<T>(bits);
+}
+
+// The counting functions follow <bit>: they take the standard unsigned
+// integer types only and count from the most (l) or least (r)
+// significant bit.
+
+template <detail::unsigned_integer T>
+constexpr int countl_zero(T value) noexcept {
+  if (value == 0) {
+    return detail::digits<T>;
+  }
+  if constexpr (sizeof(T) <= sizeof(unsigned int)) {
+    return __builtin_clz(value) - (detail::digits<unsigned int> -
+                                   detail::digits<T>);
+  } else {
+    return __builtin_clzll(value);
+  }
+}
+
+template <detail::unsigned_integer T>
+constexpr int countr_zero(T value) noexcept {
+  if (value == 0) {
+    return detail::digits<T>;
+  }
+  if constexpr (sizeof(T) <= sizeof(unsigned int)) {
+    return __builtin_ctz(value);
+  } else {
+    return __builtin_ctzll(value);
+  }
+}
+
+template <detail::unsigned_integer T>
+constexpr int countl_one(T value) noexcept {
+  return isl::countl_zero(static_cast<T>(~value));
+}
+
+template <detail::unsigned_integer T>
+constexpr int countr_one(T value) noexcept {
+  return isl::countr_zero(static_cast<T>(~value));
+}
+
+template <detail::unsigned_integer T>
+constexpr int popcount(T value) noexcept {
+  if constexpr (sizeof(T) <= sizeof(unsigned int)) {
+    return __builtin_popcount(value);
+  } else {
+    return __builtin_popcountll(value);
+  }
+}
+
+template <detail::unsigned_integer T>
+constexpr bool has_single_bit(T value) noexcept {
+  return value != 0 && (value & (value - 1)) == 0;
+}
+
+template <detail::unsigned_integer T>
+constexpr int bit_width(T value) noexcept {
+  return detail::digits<T> - isl::countl_zero(value);
+}
+
+/// Smallest power of two not less than `value`; undefined if that does
+/// not fit in T.
+template <detail::unsigned_integer T>
+constexpr T bit_ceil(T value) noexcept {
+  if (value <= 1) {
+    return 1;
+  }
+  return static_cast<T>(T{1} << isl::bit_width(static_cast<T>(value - 1)));
+}
+
+template <detail::unsigned_integer T>
+constexpr T bit_floor(T value) noexcept {
+  if (value == 0) {
+    return 0;
+  }
+  return static_cast<T>(T{1} << (isl::bit_width(value) - 1));
+}
+
+template <detail::unsigned_integer T>
+constexpr T rotl(T value, int shift) noexcept {
+  constexpr unsigned mask = detail::digits<T> - 1;
+  unsigned r = static_cast<unsigned>(shift) & mask;
+  return static_cast<T>(value << r | value >> (-r & mask));
+}
+
+template <detail::unsigned_integer T>
+constexpr T rotr(T value, int shift) noexcept {
+  constexpr unsigned mask = detail::digits<T> - 1;
+  unsigned r = static_cast<unsigned>(shift) & mask;
+  return static_cast<T>(value >> r | value << (-r & mask));
+}
+
+// Unaligned loads and stores of integers in a fixed byte order, for
+// reading and writing binary formats. At run time they are a plain
+// (possibly byte-swapping) move; in constant evaluation they go byte by
+// byte.
+
+template <class T, class B>
+  requires detail::loadable_integer<T> && byte_like<B>
+constexpr T load_le(const B *p) noexcept {
+  using U = std::make_unsigned_t<T>;
+  if (std::is_constant_evaluated()) {
+    U value = 0;
+    for (std::size_t i = 0; i != sizeof(T); ++i) {
+      value |= static_cast<U>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return static_cast<T>(value);
+  }
+  T value;
+  __builtin_memcpy(&value, p, sizeof(T));
+  if constexpr (endian::native == endian::big) {
+    value = isl::byteswap(value);
+  }
+  return value;
+}
+
+template <class T, class B>
+  requires detail::loadable_integer<T> && byte_like<B>
+constexpr T load_be(const B *p) noexcept {
+  using U = std::make_unsigned_t<T>;
+  if (std::is_constant_evaluated()) {
+    U value = 0;
+    for (std::size_t i = 0; i != sizeof(T); ++i) {
+      value = static_cast<U>(value << 8 | static_cast<unsigned char>(p[i]));
+    }
+    return static_cast<T>(value);
+  }
+  T value;
+  __builtin_memcpy(&value, p, sizeof(T));
+  if constexpr (endian::native == endian::little) {
+    value = isl::byteswap(value);
+  }
+  return value;
+}
+
+/// Writes sizeof(T) bytes at `p`; returns their end.
+template <class T, class B>
+  requires detail::loadable_integer<T> && byte_like<B>
+constexpr B *store_le(B *p, T value) noexcept {
+  using U = std::make_unsigned_t<T>;
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i != sizeof(T); ++i) {
+      p[i] = static_cast<B>(static_cast<unsigned char>(
+          static_cast<U>(value) >> (8 * i)));
+    }
+    return p + sizeof(T);
+  }
+  if constexpr (endian::native == endian::big) {
+    value = isl::byteswap(value);
+  }
+  __builtin_memcpy(p, &value, sizeof(T));
+  return p + sizeof(T);
+}
+
+/// Writes sizeof(T) bytes at `p`; returns their end.
+template <class T, class B>
+  requires detail::loadable_integer<T> && byte_like<B>
+constexpr B *store_be(B *p, T value) noexcept {
+  using U = std::make_unsigned_t<T>;
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i != sizeof(T); ++i) {
+      p[sizeof(T) - 1 - i] = static_cast<B>(static_cast<unsigned char>(
+          static_cast<U>(value) >> (8 * i)));
+    }
+    return p + sizeof(T);
+  }
+  if constexpr (endian::native == endian::little) {
+    value = isl::byteswap(value);
+  }
+  __builtin_memcpy(p, &value, sizeof(T));
+  return p + sizeof(T);
+}
+} // namespace isl
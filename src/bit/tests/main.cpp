@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <bit>     // std::popcount, std::countl_zero, ...
+#include <cstdint> // std::uint8_t, std::uint16_t, std::uint32_t, ...
+#include <random>  // std::mt19937_64
+
+import bit;
+import cstddef;
+
+namespace {
+constexpr std::uint32_t load_in_constexpr() {
+  unsigned char bytes[4] = {};
+  isl::store_be(bytes, std::uint32_t{0x01020304});
+  return isl::load_le<std::uint32_t>(bytes);
+}
+} // namespace
+
+static_assert(isl::popcount(0xF0F0u) == 8);
+static_assert(isl::countl_zero(std::uint8_t{1}) == 7);
+static_assert(isl::countl_zero(std::uint16_t{0}) == 16);
+static_assert(isl::countr_zero(std::uint64_t{1} << 40) == 40);
+static_assert(isl::countl_one(std::uint8_t{0xE0}) == 3);
+static_assert(isl::countr_one(0x7u) == 3);
+static_assert(isl::rotl(std::uint8_t{0x81}, 1) == 0x03);
+static_assert(isl::rotr(std::uint8_t{0x81}, 1) == 0xC0);
+static_assert(isl::rotl(0x80000000u, -1) == 0x40000000u);
+static_assert(isl::bit_ceil(0u) == 1 && isl::bit_ceil(5u) == 8);
+static_assert(isl::bit_floor(0u) == 0 && isl::bit_floor(5u) == 4);
+static_assert(isl::bit_width(std::uint64_t{255}) == 8);
+static_assert(isl::has_single_bit(64u) && !isl::has_single_bit(65u));
+static_assert(isl::byteswap(std::uint32_t{0x01020304}) == 0x04030201);
+static_assert(isl::byteswap(std::int16_t{0x0180}) == -32767);
+static_assert(isl::bit_cast<std::uint32_t>(1.0f) == 0x3F800000);
+static_assert(load_in_constexpr() == 0x04030201);
+
+TEST(TestBit, TestCountingMatchesStd) {
+  std::mt19937_64 rng(7);
+  for (int i = 0; i < 10000; ++i) {
+    std::uint64_t x = rng() >> (rng() % 64);
+    auto x32 = static_cast<std::uint32_t>(x);
+    auto x16 = static_cast<std::uint16_t>(x);
+    auto x8 = static_cast<std::uint8_t>(x);
+    int shift = static_cast<int>(rng() % 200) - 100;
+
+    ASSERT_EQ(isl::popcount(x), std::popcount(x));
+    ASSERT_EQ(isl::countl_zero(x), std::countl_zero(x));
+    ASSERT_EQ(isl::countr_zero(x32), std::countr_zero(x32));
+    ASSERT_EQ(isl::countl_zero(x16), std::countl_zero(x16));
+    ASSERT_EQ(isl::countl_one(x8), std::countl_one(x8));
+    ASSERT_EQ(isl::bit_width(x), std::bit_width(x));
+    ASSERT_EQ(isl::rotl(x, shift), std::rotl(x, shift));
+    ASSERT_EQ(isl::rotr(x16, shift), std::rotr(x16, shift));
+    if (x32 <= 0x80000000u) {
+      ASSERT_EQ(isl::bit_ceil(x32), std::bit_ceil(x32));
+    }
+  }
+}
+
+TEST(TestBit, TestLoadStore) {
+  unsigned char buffer[11] = {};
+  unsigned char *p = buffer + 1; // deliberately misaligned
+  p = isl::store_le(p, std::uint16_t{0x0102});
+  p = isl::store_be(p, std::uint32_t{0x03040506});
+  p = isl::store_le(p, std::int32_t{-2});
+  ASSERT_EQ(p, buffer + 11);
+
+  unsigned char expected[11] = {0,    0x02, 0x01, 0x03, 0x04, 0x05,
+                                0x06, 0xFE, 0xFF, 0xFF, 0xFF};
+  for (int i = 0; i < 11; ++i) {
+    ASSERT_EQ(buffer[i], expected[i]) << i;
+  }
+
+  ASSERT_EQ(isl::load_le<std::uint16_t>(buffer + 1), 0x0102);
+  ASSERT_EQ(isl::load_be<std::uint16_t>(buffer + 1), 0x0201);
+  ASSERT_EQ(isl::load_be<std::uint32_t>(buffer + 3), 0x03040506u);
+  ASSERT_EQ(isl::load_le<std::int32_t>(buffer + 7), -2);
+  ASSERT_EQ(isl::load_le<std::uint8_t>(buffer + 1), 0x02);
+}
+
+TEST(TestBit, TestLoadStoreRoundTrip) {
+  std::mt19937_64 rng(3);
+  isl::byte buffer[16];
+  for (int i = 0; i < 1000; ++i) {
+    std::uint64_t value = rng();
+    int offset = static_cast<int>(rng() % 8);
+    isl::store_be(buffer + offset, value);
+    ASSERT_EQ(isl::load_be<std::uint64_t>(buffer + offset), value);
+    ASSERT_EQ(isl::load_le<std::uint64_t>(buffer + offset),
+              isl::byteswap(value));
+    isl::store_le(buffer + offset, static_cast<std::int64_t>(value));
+    ASSERT_EQ(isl::load_le<std::int64_t>(buffer + offset),
+              static_cast<std::int64_t>(value));
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
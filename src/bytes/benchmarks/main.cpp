@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm> // std::count, std::find_if
+#include <cstdint>   // std::uint8_t
+#include <random>    // std::mt19937
+#include <vector>    // std::vector
+
+import bytes;
+
+namespace {
+// Random printable bytes, so a search for a control byte scans it all.
+std::vector<std::uint8_t> make_buffer(std::size_t size) {
+  std::mt19937 rng(42);
+  std::vector<std::uint8_t> buffer(size);
+  for (std::uint8_t &b : buffer) {
+    b = static_cast<std::uint8_t>(' ' + rng() % 95);
+  }
+  return buffer;
+}
+} // namespace
+
+static void BM_IslCountByte(benchmark::State &state) {
+  auto buffer = make_buffer(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        isl::count_byte(buffer.data(), buffer.data() + buffer.size(), 'e'));
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_IslCountByte)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_StdCount(benchmark::State &state) {
+  auto buffer = make_buffer(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::count(buffer.begin(), buffer.end(), 'e'));
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_StdCount)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+// Scans for the first control byte, i.e. the first byte not printable.
+static void BM_IslFindByteNotIn(benchmark::State &state) {
+  auto buffer = make_buffer(state.range(0));
+  isl::byte_set printable;
+  for (int c = ' '; c <= '~'; ++c) {
+    printable.insert(static_cast<std::uint8_t>(c));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::find_byte_not_in(
+        buffer.data(), buffer.data() + buffer.size(), printable));
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_IslFindByteNotIn)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_StdFindIf(benchmark::State &state) {
+  auto buffer = make_buffer(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::find_if(buffer.begin(), buffer.end(),
+                     [](std::uint8_t b) { return b < ' ' || b > '~'; }));
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_StdFindIf)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
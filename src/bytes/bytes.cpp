@@ -0,0 +1,124 @@
+module;
+
+#include <cstddef>          // std::size_t
+#include <initializer_list> // std::initializer_list
+#include <type_traits>      // std::is_same_v, std::remove_const_t
+
+#include "../internal/simd/bytes.hpp"
+
+export module bytes;
+
+import cstddef;
+
+export namespace isl {
+/// Element types the byte kernels accept: isl::byte and the narrow
+/// character and integer types, std::uint8_t included.
+template <class T>
+concept byte_like =
+    std::is_same_v<T, isl::byte> || std::is_same_v<T, char> ||
+    std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+    std::is_same_v<T, char8_t>;
+} // namespace isl
+
+namespace isl::detail {
+namespace simd = isl::internal::simd;
+
+template <class T> const char *as_chars(T *p) noexcept {
+  return reinterpret_cast<const char *>(p);
+}
+template <class T> char as_char(T value) noexcept {
+  return static_cast<char>(static_cast<unsigned char>(value));
+}
+
+// Maps a kernel's index back to a pointer, `not_found` to `last`.
+template <class T>
+T *from_index(T *first, T *last, std::size_t index) noexcept {
+  return index == simd::not_found ? last : first + index;
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// Set of byte values for find_byte_in and find_byte_not_in. Classifying a
+/// block costs the same whatever the size of the set, so a set is built
+/// once and reused across searches.
+class byte_set {
+  internal::simd::byte_set tables;
+
+public:
+  constexpr byte_set() noexcept = default;
+  template <byte_like T> constexpr byte_set(std::initializer_list<T> values) {
+    for (T value : values) {
+      this->insert(value);
+    }
+  }
+  template <byte_like T> byte_set(const T *first, const T *last) noexcept {
+    for (; first != last; ++first) {
+      this->insert(*first);
+    }
+  }
+
+  template <byte_like T> constexpr void insert(T value) noexcept {
+    this->tables.insert(static_cast<unsigned char>(value));
+  }
+  template <byte_like T> constexpr bool contains(T value) const noexcept {
+    return this->tables.contains(static_cast<unsigned char>(value));
+  }
+
+  const internal::simd::byte_set &nibble_tables() const noexcept {
+    return this->tables;
+  }
+};
+
+// All searches take a contiguous range [first, last) and return `last` if
+// nothing matches. Each runs an SSE2/SSE4.2, AVX2 or AVX-512 kernel chosen
+// once at startup from the CPU's features.
+
+/// First byte equal to `value`, like memchr.
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+T *find_byte(T *first, T *last, std::remove_const_t<T> value) noexcept {
+  return detail::from_index(
+      first, last,
+      detail::simd::find_byte(detail::as_chars(first), last - first,
+                              detail::as_char(value)));
+}
+
+/// Last byte equal to `value`, like memrchr.
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+T *find_last_byte(T *first, T *last, std::remove_const_t<T> value) noexcept {
+  return detail::from_index(
+      first, last,
+      detail::simd::rfind_byte(detail::as_chars(first), last - first,
+                               detail::as_char(value)));
+}
+
+/// First byte that is in `set`.
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+T *find_byte_in(T *first, T *last, const byte_set &set) noexcept {
+  return detail::from_index(
+      first, last,
+      detail::simd::find_in_set(detail::as_chars(first), last - first,
+                                set.nibble_tables(), true));
+}
+
+/// First byte that is not in `set`.
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+T *find_byte_not_in(T *first, T *last, const byte_set &set) noexcept {
+  return detail::from_index(
+      first, last,
+      detail::simd::find_in_set(detail::as_chars(first), last - first,
+                                set.nibble_tables(), false));
+}
+
+/// Number of bytes equal to `value`.
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+std::size_t count_byte(T *first, T *last,
+                       std::remove_const_t<T> value) noexcept {
+  return detail::simd::count_byte(detail::as_chars(first), last - first,
+                                  detail::as_char(value));
+}
+} // namespace isl
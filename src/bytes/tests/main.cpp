@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cstdint> // std::uint8_t
+#include <random>  // std::mt19937
+#include <vector>  // std::vector
+
+import bytes;
+import cstddef;
+
+TEST(bytes, TestFindByte) {
+  const char text[] = "key=value; other=thing";
+  const char *end = text + sizeof(text) - 1;
+
+  ASSERT_EQ(isl::find_byte(text, end, '='), text + 3);
+  ASSERT_EQ(isl::find_last_byte(text, end, '='), text + 16);
+  ASSERT_EQ(isl::find_byte(text, end, '#'), end);
+  ASSERT_EQ(isl::find_last_byte(text, end, '#'), end);
+  ASSERT_EQ(isl::count_byte(text, end, 'e'), 3);
+}
+
+TEST(bytes, TestByteSet) {
+  isl::byte_set whitespace{' ', '\t', '\n', '\r'};
+  const char text[] = "  \t token \n";
+  const char *end = text + sizeof(text) - 1;
+
+  ASSERT_TRUE(whitespace.contains('\t'));
+  ASSERT_FALSE(whitespace.contains('t'));
+  ASSERT_EQ(isl::find_byte_not_in(text, end, whitespace), text + 4);
+  ASSERT_EQ(isl::find_byte_in(text + 4, end, whitespace), text + 9);
+}
+
+TEST(bytes, TestByteTypes) {
+  isl::byte raw[] = {isl::byte{0x00}, isl::byte{0x80}, isl::byte{0xff}};
+  std::uint8_t octets[] = {1, 2, 3, 2, 1};
+
+  ASSERT_EQ(isl::find_byte(raw, raw + 3, isl::byte{0xff}), raw + 2);
+  ASSERT_EQ(isl::count_byte(octets, octets + 5, 2), 2);
+  isl::byte_set three{std::uint8_t{3}};
+  ASSERT_EQ(isl::find_byte_in(octets, octets + 5, three), octets + 2);
+}
+
+// Random buffers of every length up to a few AVX-512 blocks, against
+// straightforward loops. Covers each kernel's full blocks and tails.
+TEST(bytes, TestMatchesReference) {
+  std::mt19937 rng(11);
+  for (std::size_t size = 0; size < 300; ++size) {
+    std::vector<std::uint8_t> buffer(size);
+    for (std::uint8_t &b : buffer) {
+      b = static_cast<std::uint8_t>(rng() % 8 == 0 ? 0x80 + rng() % 128
+                                                    : rng() % 16);
+    }
+    const std::uint8_t *first = buffer.data();
+    const std::uint8_t *last = first + size;
+
+    std::uint8_t value = static_cast<std::uint8_t>(rng() % 20);
+    isl::byte_set set;
+    bool members[256] = {};
+    for (int j = 0; j < 6; ++j) {
+      std::uint8_t member = static_cast<std::uint8_t>(rng() % 256);
+      set.insert(member);
+      members[member] = true;
+    }
+
+    const std::uint8_t *find = last, *find_last = last, *in = last,
+                       *not_in = last;
+    std::size_t count = 0;
+    for (const std::uint8_t *p = first; p != last; ++p) {
+      if (*p == value) {
+        find = find == last ? p : find;
+        find_last = p;
+        ++count;
+      }
+      if (members[*p] && in == last) {
+        in = p;
+      }
+      if (!members[*p] && not_in == last) {
+        not_in = p;
+      }
+    }
+
+    ASSERT_EQ(isl::find_byte(first, last, value), find) << size;
+    ASSERT_EQ(isl::find_last_byte(first, last, value), find_last) << size;
+    ASSERT_EQ(isl::count_byte(first, last, value), count) << size;
+    ASSERT_EQ(isl::find_byte_in(first, last, set), in) << size;
+    ASSERT_EQ(isl::find_byte_not_in(first, last, set), not_in) << size;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
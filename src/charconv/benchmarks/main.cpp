@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include <bit>      // std::bit_cast
+#include <charconv> // std::to_chars, std::from_chars
+#include <cstdint>  // std::uint64_t
+#include <random>   // std::mt19937_64
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+import charconv;
+
+namespace {
+// Finite doubles spread over the whole exponent range.
+std::vector<double> make_doubles() {
+  std::mt19937_64 rng(42);
+  std::vector<double> values;
+  while (values.size() < 4096) {
+    auto value = std::bit_cast<double>(rng());
+    if (value - value == 0) {
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+// Integers with every digit count.
+std::vector<std::uint64_t> make_integers() {
+  std::mt19937_64 rng(42);
+  std::vector<std::uint64_t> values(4096);
+  for (std::uint64_t &value : values) {
+    value = rng() >> (rng() % 64);
+  }
+  return values;
+}
+
+std::vector<std::string> make_texts() {
+  std::vector<std::string> texts;
+  for (double value : make_doubles()) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    texts.emplace_back(buffer, result.ptr);
+  }
+  return texts;
+}
+} // namespace
+
+static void BM_IslToCharsInteger(benchmark::State &state) {
+  auto values = make_integers();
+  char buffer[32];
+  for (auto _ : state) {
+    for (std::uint64_t value : values) {
+      benchmark::DoNotOptimize(
+          isl::to_chars(buffer, buffer + sizeof(buffer), value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_IslToCharsInteger);
+
+static void BM_StdToCharsInteger(benchmark::State &state) {
+  auto values = make_integers();
+  char buffer[32];
+  for (auto _ : state) {
+    for (std::uint64_t value : values) {
+      benchmark::DoNotOptimize(
+          std::to_chars(buffer, buffer + sizeof(buffer), value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_StdToCharsInteger);
+
+static void BM_IslToCharsDouble(benchmark::State &state) {
+  auto values = make_doubles();
+  char buffer[32];
+  for (auto _ : state) {
+    for (double value : values) {
+      benchmark::DoNotOptimize(
+          isl::to_chars(buffer, buffer + sizeof(buffer), value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_IslToCharsDouble);
+
+static void BM_StdToCharsDouble(benchmark::State &state) {
+  auto values = make_doubles();
+  char buffer[32];
+  for (auto _ : state) {
+    for (double value : values) {
+      benchmark::DoNotOptimize(
+          std::to_chars(buffer, buffer + sizeof(buffer), value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_StdToCharsDouble);
+
+static void BM_IslFromCharsDouble(benchmark::State &state) {
+  auto texts = make_texts();
+  for (auto _ : state) {
+    for (const std::string &text : texts) {
+      double value;
+      benchmark::DoNotOptimize(
+          isl::from_chars(text.data(), text.data() + text.size(), value));
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * texts.size());
+}
+BENCHMARK(BM_IslFromCharsDouble);
+
+static void BM_StdFromCharsDouble(benchmark::State &state) {
+  auto texts = make_texts();
+  for (auto _ : state) {
+    for (const std::string &text : texts) {
+      double value;
+      benchmark::DoNotOptimize(
+          std::from_chars(text.data(), text.data() + text.size(), value));
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * texts.size());
+}
+BENCHMARK(BM_StdFromCharsDouble);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,981 @@
+module;
+
+#include <bit>          // std::bit_cast, std::bit_width, std::countl_zero
+#include <cstdint>      // std::uint32_t, std::uint64_t, std::int64_t
+#include <cstring>      // std::memcpy
+#include <limits>       // std::numeric_limits
+#include <system_error> // std::errc
+#include <type_traits>  // std::is_integral_v, std::make_unsigned_t
+
+#include "../internal/charconv/tables.hpp"
+
+export module charconv;
+
+export namespace isl {
+struct to_chars_result {
+  char *ptr;
+  std::errc ec;
+
+  friend bool operator==(const to_chars_result &,
+                         const to_chars_result &) = default;
+};
+
+struct from_chars_result {
+  const char *ptr;
+  std::errc ec;
+
+  friend bool operator==(const from_chars_result &,
+                         const from_chars_result &) = default;
+};
+} // namespace isl
+
+namespace isl::detail {
+namespace tables = isl::internal::charconv;
+
+// integers
+
+inline constexpr std::uint64_t powers_of_ten[20] = {
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+    10000000000ull,
+    100000000000ull,
+    1000000000000ull,
+    10000000000000ull,
+    100000000000000ull,
+    1000000000000000ull,
+    10000000000000000ull,
+    100000000000000000ull,
+    1000000000000000000ull,
+    10000000000000000000ull,
+};
+
+/// Number of decimal digits in `v`, one for zero.
+constexpr int decimal_digits(std::uint64_t v) noexcept {
+  // bit_width * log10(2), off by at most one
+  int guess = std::bit_width(v | 1) * 1233 >> 12;
+  return guess + ((v | 1) >= powers_of_ten[guess]);
+}
+
+inline void write_pair(char *out, std::uint32_t pair) noexcept {
+  std::memcpy(out, tables::digit_pairs + 2 * pair, 2);
+}
+
+/// Writes the digits of `v` so that they end right before `end`.
+inline void write_decimal(char *end, std::uint64_t v) noexcept {
+  // 8 digits at a time, as two independent halves of four
+  while (v >= 100000000) {
+    auto low = static_cast<std::uint32_t>(v % 100000000);
+    v /= 100000000;
+    std::uint32_t high_half = low / 10000;
+    std::uint32_t low_half = low % 10000;
+    end -= 8;
+    write_pair(end, high_half / 100);
+    write_pair(end + 2, high_half % 100);
+    write_pair(end + 4, low_half / 100);
+    write_pair(end + 6, low_half % 100);
+  }
+  auto rest = static_cast<std::uint32_t>(v);
+  while (rest >= 100) {
+    end -= 2;
+    write_pair(end, rest % 100);
+    rest /= 100;
+  }
+  if (rest >= 10) {
+    write_pair(end - 2, rest);
+  } else {
+    end[-1] = static_cast<char>('0' + rest);
+  }
+}
+
+inline constexpr char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/// Value of `c` as a digit in `base`, or `base` if it is not one.
+constexpr unsigned digit_value(char c, int base) noexcept {
+  unsigned value;
+  if (c >= '0' && c <= '9') {
+    value = c - '0';
+  } else if (c >= 'a' && c <= 'z') {
+    value = c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'Z') {
+    value = c - 'A' + 10;
+  } else {
+    return base;
+  }
+  return value < static_cast<unsigned>(base) ? value : base;
+}
+
+// floating point, shortest round-trip output (Schubfach)
+//
+// Port of Raffaello Giulietti's "The Schubfach way to render doubles", as
+// in OpenJDK's DoubleToDecimal and FloatToDecimal.
+
+struct decimal_fp {
+  std::uint64_t significand;
+  int exponent;
+};
+
+constexpr int flog10_pow2(int e) noexcept {
+  return static_cast<int>(std::int64_t{e} * 661'971'961'083 >> 41);
+}
+constexpr int flog10_three_quarters_pow2(int e) noexcept {
+  return static_cast<int>(
+      (std::int64_t{e} * 661'971'961'083 - 274'743'187'321) >> 41);
+}
+constexpr int flog2_pow10(int e) noexcept {
+  return static_cast<int>(std::int64_t{e} * 913'124'641'741 >> 38);
+}
+
+inline std::uint64_t multiply_high(std::uint64_t a, std::uint64_t b) noexcept {
+  return static_cast<std::uint64_t>(
+      static_cast<unsigned __int128>(a) * b >> 64);
+}
+
+inline std::uint64_t schubfach_g1(int k) noexcept {
+  return tables::schubfach_g[2 * (k - tables::schubfach_k_min)];
+}
+inline std::uint64_t schubfach_g0(int k) noexcept {
+  return tables::schubfach_g[2 * (k - tables::schubfach_k_min) + 1];
+}
+
+// g * cp / 2^127 with g = g1 2^63 + g0, rounded to odd.
+inline std::uint64_t round_to_odd(std::uint64_t g1, std::uint64_t g0,
+                                  std::uint64_t cp) noexcept {
+  constexpr std::uint64_t mask63 = (std::uint64_t{1} << 63) - 1;
+  std::uint64_t x1 = multiply_high(g0, cp);
+  std::uint64_t y0 = g1 * cp;
+  std::uint64_t y1 = multiply_high(g1, cp);
+  std::uint64_t z = (y0 >> 1) + x1;
+  std::uint64_t vbp = y1 + (z >> 63);
+  return vbp | ((z & mask63) + mask63) >> 63;
+}
+
+// g * cp / 2^95, rounded to odd.
+inline std::uint32_t round_to_odd(std::uint64_t g, std::uint64_t cp) noexcept {
+  constexpr std::uint64_t mask32 = (std::uint64_t{1} << 32) - 1;
+  std::uint64_t x1 = multiply_high(g, cp);
+  std::uint64_t vbp = x1 >> 31;
+  return static_cast<std::uint32_t>(vbp | ((x1 & mask32) + mask32) >> 32);
+}
+
+// Shortest decimal in the rounding interval of c 2^q.
+inline decimal_fp to_decimal(int q, std::uint64_t c, bool binary64) noexcept {
+  const std::uint64_t c_min = binary64 ? std::uint64_t{1} << 52 : 1u << 23;
+  const int q_min = binary64 ? -1074 : -149;
+
+  std::uint64_t out = c & 1;
+  std::uint64_t cb = c << 2;
+  std::uint64_t cbr = cb + 2;
+  std::uint64_t cbl;
+  int k;
+  if (c != c_min || q == q_min) {
+    cbl = cb - 2;
+    k = flog10_pow2(q);
+  } else {
+    // the interval is asymmetric at a power of two
+    cbl = cb - 1;
+    k = flog10_three_quarters_pow2(q);
+  }
+
+  std::uint64_t vb, vbl, vbr;
+  if (binary64) {
+    int h = q + flog2_pow10(-k) + 2;
+    std::uint64_t g1 = schubfach_g1(k);
+    std::uint64_t g0 = schubfach_g0(k);
+    vb = round_to_odd(g1, g0, cb << h);
+    vbl = round_to_odd(g1, g0, cbl << h);
+    vbr = round_to_odd(g1, g0, cbr << h);
+  } else {
+    int h = q + flog2_pow10(-k) + 33;
+    std::uint64_t g = schubfach_g1(k) + 1;
+    vb = round_to_odd(g, cb << h);
+    vbl = round_to_odd(g, cbl << h);
+    vbr = round_to_odd(g, cbr << h);
+  }
+
+  std::uint64_t s = vb >> 2;
+  if (s >= 100) {
+    // try one digit less: the multiples of ten around s
+    std::uint64_t sp10 = 10 * (s / 10);
+    std::uint64_t tp10 = sp10 + 10;
+    bool upin = vbl + out <= sp10 << 2;
+    bool wpin = (tp10 << 2) + out <= vbr;
+    if (upin != wpin) {
+      return {upin ? sp10 : tp10, k};
+    }
+  }
+  std::uint64_t t = s + 1;
+  bool uin = vbl + out <= s << 2;
+  bool win = (t << 2) + out <= vbr;
+  if (uin != win) {
+    return {uin ? s : t, k};
+  }
+  // both or neither are in the interval, pick the closer one
+  auto cmp = static_cast<std::int64_t>(vb - ((s + t) << 1));
+  return {cmp < 0 || (cmp == 0 && (s & 1) == 0) ? s : t, k};
+}
+
+template <class Float> struct float_format;
+
+template <> struct float_format<double> {
+  using bits_type = std::uint64_t;
+  static constexpr int mantissa_bits = 52;
+  static constexpr int exponent_bias = 1023;
+  static constexpr int q_min = -1074;
+  // Eisel-Lemire and Clinger limits
+  static constexpr int minimum_exponent = -1023;
+  static constexpr int infinite_power = 0x7FF;
+  static constexpr int smallest_power_of_ten = -342;
+  static constexpr int largest_power_of_ten = 308;
+  static constexpr int min_exponent_round_to_even = -4;
+  static constexpr int max_exponent_round_to_even = 23;
+  static constexpr int max_exponent_fast_path = 22;
+};
+
+template <> struct float_format<float> {
+  using bits_type = std::uint32_t;
+  static constexpr int mantissa_bits = 23;
+  static constexpr int exponent_bias = 127;
+  static constexpr int q_min = -149;
+  static constexpr int minimum_exponent = -127;
+  static constexpr int infinite_power = 0xFF;
+  static constexpr int smallest_power_of_ten = -64;
+  static constexpr int largest_power_of_ten = 38;
+  static constexpr int min_exponent_round_to_even = -17;
+  static constexpr int max_exponent_round_to_even = 10;
+  static constexpr int max_exponent_fast_path = 10;
+};
+
+/// Shortest decimal that rounds back to `value`, which must be finite and
+/// non-zero. Trailing zeros are stripped from the significand.
+template <class Float> decimal_fp shortest_decimal(Float value) noexcept {
+  using format = float_format<Float>;
+  constexpr int precision = format::mantissa_bits + 1;
+
+  auto bits = std::bit_cast<typename format::bits_type>(value);
+  std::uint64_t t = bits & ((std::uint64_t{1} << format::mantissa_bits) - 1);
+  int bq = static_cast<int>(bits >> format::mantissa_bits) &
+           (2 * format::exponent_bias + 1);
+
+  decimal_fp decimal;
+  if (bq != 0) {
+    int mq = -format::q_min + 1 - bq;
+    std::uint64_t c = (std::uint64_t{1} << format::mantissa_bits) | t;
+    if (0 < mq && mq < precision && (c >> mq << mq) == c) {
+      // a small integer is its own shortest representation
+      decimal = {c >> mq, 0};
+    } else {
+      decimal = to_decimal(-mq, c, sizeof(Float) == 8);
+    }
+  } else {
+    // subnormal
+    decimal = to_decimal(format::q_min, t, sizeof(Float) == 8);
+  }
+
+  while (decimal.significand % 10 == 0) {
+    decimal.significand /= 10;
+    decimal.exponent += 1;
+  }
+  return decimal;
+}
+
+/// Exact value of `value`, which must be a non-negative integer below
+/// 2^128.
+template <class Float> unsigned __int128 exact_integer(Float value) noexcept {
+  using format = float_format<Float>;
+  auto bits = std::bit_cast<typename format::bits_type>(value);
+  std::uint64_t c = bits & ((std::uint64_t{1} << format::mantissa_bits) - 1);
+  int bq = static_cast<int>(bits >> format::mantissa_bits) &
+           (2 * format::exponent_bias + 1);
+  c |= std::uint64_t{1} << format::mantissa_bits;
+  int q = bq + format::q_min - 1;
+  return q >= 0 ? static_cast<unsigned __int128>(c) << q : c >> -q;
+}
+
+/// Writes `decimal`, the shortest form of `value`, in whichever of fixed
+/// and scientific notation is shorter, preferring fixed, as std::to_chars
+/// does.
+template <class Float>
+to_chars_result write_shortest(char *first, char *last, Float value,
+                               decimal_fp decimal, bool negative) noexcept {
+  int n = decimal_digits(decimal.significand);
+  int e = decimal.exponent;
+
+  int scientific_exponent = e + n - 1;
+  int exponent_magnitude =
+      scientific_exponent < 0 ? -scientific_exponent : scientific_exponent;
+  int scientific_size = n + (n > 1) + 2 + (exponent_magnitude >= 100 ? 3 : 2);
+  int fixed_size = e >= 0 ? n + e : (-e < n ? n + 1 : 2 - e);
+
+  bool fixed = fixed_size <= scientific_size;
+  int size = negative + (fixed ? fixed_size : scientific_size);
+  if (last - first < size) {
+    return {last, std::errc::value_too_large};
+  }
+
+  char *out = first;
+  if (negative) {
+    *out++ = '-';
+  }
+  if (fixed) {
+    if (e > 0) {
+      // of the representations this long, the exact integer is closest,
+      // e.g. 90282311680 rather than 90282310000 for that float
+      unsigned __int128 integer = exact_integer(negative ? -value : value);
+      constexpr std::uint64_t ten19 = powers_of_ten[19];
+      std::memset(out, '0', n + e);
+      write_decimal(out + n + e, static_cast<std::uint64_t>(integer % ten19));
+      if (integer >= ten19) {
+        write_decimal(out + n + e - 19,
+                      static_cast<std::uint64_t>(integer / ten19));
+      }
+    } else if (e == 0) {
+      write_decimal(out + n, decimal.significand);
+    } else if (-e < n) {
+      int integer_digits = n + e;
+      write_decimal(out + n, decimal.significand);
+      std::memmove(out + integer_digits + 1, out + integer_digits, -e);
+      out[integer_digits] = '.';
+    } else {
+      out[0] = '0';
+      out[1] = '.';
+      std::memset(out + 2, '0', -e - n);
+      write_decimal(out + 2 - e, decimal.significand);
+    }
+    return {first + size, std::errc{}};
+  }
+
+  write_decimal(out + 1 + n, decimal.significand);
+  out[0] = out[1];
+  if (n > 1) {
+    out[1] = '.';
+    out += n + 1;
+  } else {
+    out += 1;
+  }
+  *out++ = 'e';
+  *out++ = scientific_exponent < 0 ? '-' : '+';
+  if (exponent_magnitude >= 100) {
+    *out++ = static_cast<char>('0' + exponent_magnitude / 100);
+    exponent_magnitude %= 100;
+  }
+  write_pair(out, exponent_magnitude);
+  return {first + size, std::errc{}};
+}
+
+template <class Float>
+to_chars_result float_to_chars(char *first, char *last, Float value) noexcept {
+  using format = float_format<Float>;
+  auto bits = std::bit_cast<typename format::bits_type>(value);
+  bool negative = bits >> (sizeof(Float) * 8 - 1);
+
+  const char *special = nullptr;
+  if (value != value) {
+    special = negative ? "-nan" : "nan";
+  } else if (value == std::numeric_limits<Float>::infinity()) {
+    special = "inf";
+  } else if (value == -std::numeric_limits<Float>::infinity()) {
+    special = "-inf";
+  } else if (value == 0) {
+    special = negative ? "-0" : "0";
+  }
+  if (special) {
+    std::size_t size = std::strlen(special);
+    if (static_cast<std::size_t>(last - first) < size) {
+      return {last, std::errc::value_too_large};
+    }
+    std::memcpy(first, special, size);
+    return {first + size, std::errc{}};
+  }
+  return write_shortest(first, last, value, shortest_decimal(value),
+                        negative);
+}
+
+// floating point input (Clinger, then Eisel-Lemire)
+//
+// Follows Daniel Lemire's "Number Parsing at a Gigabyte per Second" and
+// the fast_float library. The rare inputs neither path can round correctly
+// are decided by comparing all their digits with the halfway point.
+
+// Powers of ten a double holds exactly.
+inline constexpr double exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+struct parsed_decimal {
+  std::uint64_t mantissa; // first 19 significant digits
+  std::int64_t exponent;  // value = mantissa 10^exponent
+  bool negative;
+  bool truncated; // digits past the 19th significant one were dropped
+};
+
+constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+// Whether 8 bytes, read little-endian, are all ASCII digits.
+constexpr bool is_eight_digits(std::uint64_t v) noexcept {
+  return (((v & 0xF0F0F0F0F0F0F0F0) |
+           (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+          0x3333333333333333);
+}
+
+// Value of 8 ASCII digits read little-endian, with three multiplications.
+constexpr std::uint32_t parse_eight_digits(std::uint64_t v) noexcept {
+  v -= 0x3030303030303030;
+  v = (v * 10) + (v >> 8);
+  v = (((v & 0x000000FF000000FF) * (100 + (1000000ull << 32))) +
+       (((v >> 16) & 0x000000FF000000FF) * (1 + (10000ull << 32)))) >>
+      32;
+  return static_cast<std::uint32_t>(v);
+}
+
+inline std::uint64_t read_eight(const char *p) noexcept {
+  std::uint64_t v;
+  std::memcpy(&v, p, 8);
+  return v;
+}
+
+/// Scans digits, an optional fraction and an optional exponent into
+/// `number`. Returns the end of the number, or null if it has no digits.
+/// Digits are accumulated unchecked; the rare inputs with more than 19
+/// significant digits are rescanned to keep only the first 19.
+inline const char *parse_decimal(const char *p, const char *last,
+                                 parsed_decimal &number) noexcept {
+  const char *integer_first = p;
+  std::uint64_t mantissa = 0;
+  for (; p != last && is_digit(*p); ++p) {
+    mantissa = mantissa * 10 + (*p - '0');
+  }
+  const char *integer_last = p;
+  std::int64_t digit_count = integer_last - integer_first;
+
+  const char *fraction_first = p;
+  std::int64_t exponent = 0;
+  if (p != last && *p == '.') {
+    fraction_first = ++p;
+    while (last - p >= 8 && is_eight_digits(read_eight(p))) {
+      mantissa = mantissa * 100000000 + parse_eight_digits(read_eight(p));
+      p += 8;
+    }
+    for (; p != last && is_digit(*p); ++p) {
+      mantissa = mantissa * 10 + (*p - '0');
+    }
+    exponent = fraction_first - p;
+    digit_count -= exponent;
+  }
+  if (digit_count == 0) {
+    return nullptr;
+  }
+  const char *fraction_last = p;
+
+  std::int64_t explicit_exponent = 0;
+  if (p != last && (*p == 'e' || *p == 'E')) {
+    const char *q = p + 1;
+    bool negative_exponent = false;
+    if (q != last && (*q == '-' || *q == '+')) {
+      negative_exponent = *q++ == '-';
+    }
+    // without digits the 'e' is not part of the number
+    if (q != last && is_digit(*q)) {
+      for (; q != last && is_digit(*q); ++q) {
+        // saturate, anything this large is zero or infinity anyway
+        if (explicit_exponent < 0x10000) {
+          explicit_exponent = explicit_exponent * 10 + (*q - '0');
+        }
+      }
+      if (negative_exponent) {
+        explicit_exponent = -explicit_exponent;
+      }
+      p = q;
+    }
+  }
+
+  if (digit_count > 19) {
+    // leading zeros are not significant
+    for (const char *q = integer_first; q != fraction_last; ++q) {
+      if (*q != '0' && *q != '.') {
+        break;
+      }
+      digit_count -= *q == '0';
+    }
+  }
+  if (digit_count > 19) {
+    number.truncated = true;
+    mantissa = 0;
+    const char *q = integer_first;
+    for (; mantissa < 1000000000000000000 && q != integer_last; ++q) {
+      mantissa = mantissa * 10 + (*q - '0');
+    }
+    if (mantissa >= 1000000000000000000) {
+      exponent = integer_last - q;
+    } else {
+      for (q = fraction_first;
+           mantissa < 1000000000000000000 && q != fraction_last; ++q) {
+        mantissa = mantissa * 10 + (*q - '0');
+      }
+      exponent = fraction_first - q;
+    }
+  }
+  number.mantissa = mantissa;
+  number.exponent = exponent + explicit_exponent;
+  return p;
+}
+
+// Case-insensitive match of the lowercase `word` at `p`.
+inline bool starts_with_word(const char *p, const char *last,
+                             const char *word) noexcept {
+  for (; *word; ++p, ++word) {
+    if (p == last || (*p | 0x20) != *word) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct adjusted_mantissa {
+  std::uint64_t mantissa;
+  int power2;
+
+  friend bool operator==(const adjusted_mantissa &,
+                         const adjusted_mantissa &) = default;
+};
+
+/// Eisel-Lemire: w 10^q rounded to nearest, as a biased exponent and an
+/// explicit mantissa.
+template <class Float>
+adjusted_mantissa compute_float(std::int64_t q, std::uint64_t w) noexcept {
+  using format = float_format<Float>;
+  constexpr int mantissa_bits = format::mantissa_bits;
+
+  if (w == 0 || q < format::smallest_power_of_ten) {
+    return {0, 0};
+  }
+  if (q > format::largest_power_of_ten) {
+    return {0, format::infinite_power};
+  }
+
+  int lz = std::countl_zero(w);
+  w <<= lz;
+
+  // w 5^q, with enough correct high bits for the mantissa plus rounding
+  auto index = static_cast<std::size_t>(2 * (q - tables::powers_of_five_min));
+  auto first =
+      static_cast<unsigned __int128>(w) * tables::powers_of_five[index];
+  auto high = static_cast<std::uint64_t>(first >> 64);
+  auto low = static_cast<std::uint64_t>(first);
+  constexpr std::uint64_t precision_mask =
+      ~std::uint64_t{0} >> (mantissa_bits + 3);
+  if ((high & precision_mask) == precision_mask) {
+    auto second = static_cast<unsigned __int128>(w) *
+                  tables::powers_of_five[index + 1];
+    auto second_high = static_cast<std::uint64_t>(second >> 64);
+    low += second_high;
+    high += second_high > low;
+  }
+
+  int upperbit = static_cast<int>(high >> 63);
+  int shift = upperbit + 64 - mantissa_bits - 3;
+  adjusted_mantissa answer;
+  answer.mantissa = high >> shift;
+  // floor(log2(10^q)) + 63, plus the normalization
+  int power = static_cast<int>(((152170 + 65536) * q) >> 16) + 63;
+  answer.power2 = power + upperbit - lz - format::minimum_exponent;
+
+  if (answer.power2 <= 0) {
+    // subnormal
+    if (-answer.power2 + 1 >= 64) {
+      return {0, 0};
+    }
+    answer.mantissa >>= -answer.power2 + 1;
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    answer.power2 =
+        answer.mantissa < (std::uint64_t{1} << mantissa_bits) ? 0 : 1;
+    return answer;
+  }
+
+  // exactly halfway between two floats: round to even rather than up
+  if (low <= 1 && q >= format::min_exponent_round_to_even &&
+      q <= format::max_exponent_round_to_even && (answer.mantissa & 3) == 1 &&
+      (answer.mantissa << shift) == high) {
+    answer.mantissa &= ~std::uint64_t{1};
+  }
+
+  answer.mantissa += answer.mantissa & 1;
+  answer.mantissa >>= 1;
+  if (answer.mantissa >= (std::uint64_t{2} << mantissa_bits)) {
+    answer.mantissa = std::uint64_t{1} << mantissa_bits;
+    answer.power2 += 1;
+  }
+  answer.mantissa &= ~(std::uint64_t{1} << mantissa_bits);
+  if (answer.power2 >= format::infinite_power) {
+    return {0, format::infinite_power};
+  }
+  return answer;
+}
+
+// Fixed-capacity natural number for round_long_decimal; its operands stay
+// below 2800 bits.
+struct big_integer {
+  static constexpr int capacity = 64;
+  std::uint64_t limbs[capacity]; // least significant first
+  int size = 0;
+
+  explicit big_integer(std::uint64_t value) noexcept {
+    if (value != 0) {
+      this->limbs[0] = value;
+      this->size = 1;
+    }
+  }
+
+  // *this = *this factor + addend
+  void multiply_add(std::uint64_t factor, std::uint64_t addend) noexcept {
+    unsigned __int128 carry = addend;
+    for (int i = 0; i != this->size; ++i) {
+      carry += static_cast<unsigned __int128>(this->limbs[i]) * factor;
+      this->limbs[i] = static_cast<std::uint64_t>(carry);
+      carry >>= 64;
+    }
+    if (carry != 0) {
+      this->limbs[this->size++] = static_cast<std::uint64_t>(carry);
+    }
+  }
+
+  void multiply_power_of_five(std::int64_t n) noexcept {
+    constexpr std::uint64_t five_to_27 = 7450580596923828125u;
+    for (; n >= 27; n -= 27) {
+      this->multiply_add(five_to_27, 0);
+    }
+    std::uint64_t rest = 1;
+    for (; n > 0; --n) {
+      rest *= 5;
+    }
+    this->multiply_add(rest, 0);
+  }
+
+  void shift_left(std::int64_t n) noexcept {
+    if (this->size == 0) {
+      return;
+    }
+    auto words = static_cast<int>(n / 64);
+    auto bits = static_cast<int>(n % 64);
+    if (bits != 0) {
+      std::uint64_t carry = 0;
+      for (int i = 0; i != this->size; ++i) {
+        std::uint64_t limb = this->limbs[i];
+        this->limbs[i] = (limb << bits) | carry;
+        carry = limb >> (64 - bits);
+      }
+      if (carry != 0) {
+        this->limbs[this->size++] = carry;
+      }
+    }
+    if (words != 0) {
+      for (int i = this->size; i-- > 0;) {
+        this->limbs[i + words] = this->limbs[i];
+      }
+      for (int i = 0; i != words; ++i) {
+        this->limbs[i] = 0;
+      }
+      this->size += words;
+    }
+  }
+
+  int compare(const big_integer &other) const noexcept {
+    if (this->size != other.size) {
+      return this->size < other.size ? -1 : 1;
+    }
+    for (int i = this->size; i-- > 0;) {
+      if (this->limbs[i] != other.limbs[i]) {
+        return this->limbs[i] < other.limbs[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+};
+
+// The halfway point between two adjacent doubles has at most 767
+// significant digits, so digits past these can only break a tie.
+inline constexpr std::int64_t max_compared_digits = 800;
+
+/// Rounds the long decimal in [p, last), already scanned into `number`,
+/// to `lower` or the float after it, by comparing all of its digits
+/// exactly with their midpoint. Eisel-Lemire gives `lower` for the first
+/// 19 digits but cannot tell which side of the midpoint the rest fall.
+template <class Float>
+adjusted_mantissa round_long_decimal(const char *p, const char *last,
+                                     const parsed_decimal &number,
+                                     adjusted_mantissa lower) noexcept {
+  using format = float_format<Float>;
+  constexpr int mantissa_bits = format::mantissa_bits;
+
+  // significant digits, 19 per multiplication
+  big_integer digits(0);
+  std::int64_t count = 0;
+  bool nonzero_tail = false;
+  std::uint64_t chunk = 0;
+  std::uint64_t chunk_scale = 1;
+  for (; p != last && (is_digit(*p) || *p == '.'); ++p) {
+    if (*p == '.' || (count == 0 && *p == '0')) {
+      continue;
+    }
+    if (count == max_compared_digits) {
+      nonzero_tail |= *p != '0';
+      continue;
+    }
+    chunk = chunk * 10 + (*p - '0');
+    chunk_scale *= 10;
+    if (++count % 19 == 0) {
+      digits.multiply_add(chunk_scale, chunk);
+      chunk = 0;
+      chunk_scale = 1;
+    }
+  }
+  digits.multiply_add(chunk_scale, chunk);
+  // number.exponent belongs to the 19th significant digit
+  std::int64_t decimal_exponent = number.exponent - (count - 19);
+
+  // midpoint = (2 m + 1) 2^binary_exponent
+  std::uint64_t m = lower.mantissa;
+  if (lower.power2 != 0) {
+    m |= std::uint64_t{1} << mantissa_bits;
+  }
+  std::int64_t binary_exponent = (lower.power2 != 0 ? lower.power2 : 1) +
+                                 format::minimum_exponent - mantissa_bits - 1;
+  big_integer halfway(2 * m + 1);
+
+  if (decimal_exponent >= 0) {
+    digits.multiply_power_of_five(decimal_exponent);
+  } else {
+    halfway.multiply_power_of_five(-decimal_exponent);
+  }
+  if (decimal_exponent > binary_exponent) {
+    digits.shift_left(decimal_exponent - binary_exponent);
+  } else {
+    halfway.shift_left(binary_exponent - decimal_exponent);
+  }
+
+  int order = digits.compare(halfway);
+  if (order > 0 || (order == 0 && (nonzero_tail || (m & 1) != 0))) {
+    // a carry out of the mantissa moves to the next binade or infinity
+    if (++lower.mantissa >> mantissa_bits) {
+      lower.mantissa = 0;
+      ++lower.power2;
+    }
+  }
+  return lower;
+}
+
+template <class Float>
+from_chars_result float_from_chars(const char *first, const char *last,
+                                   Float &value) noexcept {
+  using format = float_format<Float>;
+  using bits_type = typename format::bits_type;
+
+  parsed_decimal number{0, 0, false, false};
+  const char *p = first;
+  if (p != last && *p == '-') {
+    number.negative = true;
+    ++p;
+  }
+
+  if (p != last && !is_digit(*p) && *p != '.') {
+    const char *end = nullptr;
+    Float special = 0;
+    if (starts_with_word(p, last, "infinity")) {
+      end = p + 8;
+      special = std::numeric_limits<Float>::infinity();
+    } else if (starts_with_word(p, last, "inf")) {
+      end = p + 3;
+      special = std::numeric_limits<Float>::infinity();
+    } else if (starts_with_word(p, last, "nan")) {
+      end = p + 3;
+      special = std::numeric_limits<Float>::quiet_NaN();
+      // optional (n-char-sequence)
+      const char *q = end;
+      if (q != last && *q == '(') {
+        for (++q;
+             q != last &&
+             (is_digit(*q) ||
+              static_cast<unsigned>((*q | 0x20) - 'a') < 26u || *q == '_');
+             ++q) {
+        }
+        if (q != last && *q == ')') {
+          end = q + 1;
+        }
+      }
+    }
+    if (!end) {
+      return {first, std::errc::invalid_argument};
+    }
+    value = number.negative ? -special : special;
+    return {end, std::errc{}};
+  }
+
+  const char *digits_first = p;
+  p = parse_decimal(p, last, number);
+  if (!p) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  Float result;
+  if (!number.truncated &&
+      number.mantissa <= std::uint64_t{2} << format::mantissa_bits &&
+      number.exponent >= -format::max_exponent_fast_path &&
+      number.exponent <= format::max_exponent_fast_path) {
+    // Clinger: both operands are exact, so one rounding gives the answer
+    result = static_cast<Float>(number.mantissa);
+    auto scale = static_cast<Float>(
+        exact_powers_of_ten[number.exponent < 0 ? -number.exponent
+                                                : number.exponent]);
+    result = number.exponent < 0 ? result / scale : result * scale;
+    if (number.negative) {
+      result = -result;
+    }
+  } else {
+    adjusted_mantissa am =
+        compute_float<Float>(number.exponent, number.mantissa);
+    if (number.truncated &&
+        am != compute_float<Float>(number.exponent, number.mantissa + 1)) {
+      am = round_long_decimal<Float>(digits_first, p, number, am);
+    }
+    bits_type bits = static_cast<bits_type>(
+        am.mantissa |
+        (static_cast<std::uint64_t>(am.power2) << format::mantissa_bits));
+    if (number.negative) {
+      bits |= bits_type{1} << (sizeof(Float) * 8 - 1);
+    }
+    result = std::bit_cast<Float>(bits);
+  }
+
+  bool overflow = result == std::numeric_limits<Float>::infinity() ||
+                  result == -std::numeric_limits<Float>::infinity();
+  bool underflow = result == 0 && number.mantissa != 0;
+  if (overflow || underflow) {
+    return {p, std::errc::result_out_of_range};
+  }
+  value = result;
+  return {p, std::errc{}};
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// Integer to text in `base` (2 to 36), like std::to_chars. Base 10 emits
+/// two digits per division through a pair table.
+template <class Integer>
+  requires(std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>)
+to_chars_result to_chars(char *first, char *last, Integer value,
+                         int base = 10) noexcept {
+  using unsigned_type = std::make_unsigned_t<Integer>;
+  auto magnitude = static_cast<unsigned_type>(value);
+  bool negative = false;
+  if constexpr (std::is_signed_v<Integer>) {
+    if (value < 0) {
+      negative = true;
+      magnitude = static_cast<unsigned_type>(0 - magnitude);
+    }
+  }
+
+  int digits;
+  if (base == 10) {
+    digits = detail::decimal_digits(magnitude);
+  } else {
+    digits = 1;
+    for (unsigned_type rest = magnitude / base; rest != 0; rest /= base) {
+      ++digits;
+    }
+  }
+  if (last - first < negative + digits) {
+    return {last, std::errc::value_too_large};
+  }
+
+  if (negative) {
+    *first++ = '-';
+  }
+  char *end = first + digits;
+  if (base == 10) {
+    detail::write_decimal(end, magnitude);
+  } else {
+    for (char *out = end; out != first; magnitude /= base) {
+      *--out = detail::digit_chars[magnitude % base];
+    }
+  }
+  return {end, std::errc{}};
+}
+
+to_chars_result to_chars(char *first, char *last, bool value,
+                         int base = 10) = delete;
+
+/// Shortest text that reads back as `value`, in fixed or scientific
+/// notation, whichever is shorter, like std::to_chars.
+inline to_chars_result to_chars(char *first, char *last,
+                                double value) noexcept {
+  return detail::float_to_chars(first, last, value);
+}
+inline to_chars_result to_chars(char *first, char *last,
+                                float value) noexcept {
+  return detail::float_to_chars(first, last, value);
+}
+
+/// Text to integer in `base` (2 to 36), like std::from_chars.
+template <class Integer>
+  requires(std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>)
+from_chars_result from_chars(const char *first, const char *last,
+                             Integer &value, int base = 10) noexcept {
+  using unsigned_type = std::make_unsigned_t<Integer>;
+  const char *p = first;
+  bool negative = false;
+  if constexpr (std::is_signed_v<Integer>) {
+    if (p != last && *p == '-') {
+      negative = true;
+      ++p;
+    }
+  }
+
+  const char *digits = p;
+  unsigned_type magnitude = 0;
+  bool overflow = false;
+  for (; p != last; ++p) {
+    unsigned digit = detail::digit_value(*p, base);
+    if (digit == static_cast<unsigned>(base)) {
+      break;
+    }
+    overflow |= __builtin_mul_overflow(magnitude, base, &magnitude) ||
+                __builtin_add_overflow(magnitude, digit, &magnitude);
+  }
+  if (p == digits) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  if constexpr (std::is_signed_v<Integer>) {
+    auto limit = static_cast<unsigned_type>(
+        std::numeric_limits<Integer>::max()) + negative;
+    overflow |= magnitude > limit;
+    if (!overflow) {
+      value = negative ? static_cast<Integer>(0 - magnitude)
+                       : static_cast<Integer>(magnitude);
+    }
+  } else if (!overflow) {
+    value = magnitude;
+  }
+  return {p, overflow ? std::errc::result_out_of_range : std::errc{}};
+}
+
+/// Decimal text to the nearest double, like std::from_chars with
+/// chars_format::general.
+inline from_chars_result from_chars(const char *first, const char *last,
+                                    double &value) noexcept {
+  return detail::float_from_chars(first, last, value);
+}
+inline from_chars_result from_chars(const char *first, const char *last,
+                                    float &value) noexcept {
+  return detail::float_from_chars(first, last, value);
+}
+} // namespace isl
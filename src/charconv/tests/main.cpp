@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+
+#include <bit>          // std::bit_cast
+#include <charconv>     // std::to_chars, std::from_chars
+#include <cstdint>      // std::int64_t, std::uint64_t
+#include <limits>       // std::numeric_limits
+#include <random>       // std::mt19937_64
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <system_error> // std::errc
+
+import charconv;
+
+namespace {
+template <class T> std::string isl_to_string(T value) {
+  char buffer[64];
+  auto [ptr, ec] = isl::to_chars(buffer, buffer + sizeof(buffer), value);
+  EXPECT_EQ(ec, std::errc{});
+  return std::string(buffer, ptr);
+}
+
+template <class T> std::string std_to_string(T value) {
+  char buffer[64];
+  auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  return std::string(buffer, ptr);
+}
+
+template <class T> T isl_parse(std::string_view text) {
+  T value{};
+  auto [ptr, ec] = isl::from_chars(text.data(), text.data() + text.size(),
+                                   value);
+  EXPECT_EQ(ec, std::errc{}) << text;
+  EXPECT_EQ(ptr, text.data() + text.size()) << text;
+  return value;
+}
+} // namespace
+
+TEST(charconv, TestIntegerToChars) {
+  ASSERT_EQ(isl_to_string(0), "0");
+  ASSERT_EQ(isl_to_string(7), "7");
+  ASSERT_EQ(isl_to_string(-42), "-42");
+  ASSERT_EQ(isl_to_string(std::numeric_limits<std::int64_t>::min()),
+            "-9223372036854775808");
+  ASSERT_EQ(isl_to_string(std::numeric_limits<std::uint64_t>::max()),
+            "18446744073709551615");
+  ASSERT_EQ(isl_to_string(static_cast<signed char>(-128)), "-128");
+
+  char buffer[8];
+  auto result = isl::to_chars(buffer, buffer + sizeof(buffer), 255, 16);
+  ASSERT_EQ(std::string(buffer, result.ptr), "ff");
+  result = isl::to_chars(buffer, buffer + sizeof(buffer), -5, 2);
+  ASSERT_EQ(std::string(buffer, result.ptr), "-101");
+
+  result = isl::to_chars(buffer, buffer + 3, 1234);
+  ASSERT_EQ(result.ec, std::errc::value_too_large);
+  ASSERT_EQ(result.ptr, buffer + 3);
+}
+
+TEST(charconv, TestIntegerFromChars) {
+  ASSERT_EQ(isl_parse<int>("-2147483648"), std::numeric_limits<int>::min());
+  ASSERT_EQ(isl_parse<std::uint64_t>("18446744073709551615"),
+            std::numeric_limits<std::uint64_t>::max());
+
+  std::string_view text = "12abc";
+  int value = 0;
+  auto result = isl::from_chars(text.data(), text.data() + text.size(), value);
+  ASSERT_EQ(value, 12);
+  ASSERT_EQ(result.ptr, text.data() + 2);
+  result = isl::from_chars(text.data() + 2, text.data() + text.size(), value,
+                           16);
+  ASSERT_EQ(value, 0xabc);
+
+  text = "-1";
+  unsigned unsigned_value = 3;
+  result = isl::from_chars(text.data(), text.data() + text.size(),
+                           unsigned_value);
+  ASSERT_EQ(result.ec, std::errc::invalid_argument);
+  ASSERT_EQ(result.ptr, text.data());
+
+  text = "300x";
+  unsigned char byte = 9;
+  result = isl::from_chars(text.data(), text.data() + text.size(), byte);
+  ASSERT_EQ(result.ec, std::errc::result_out_of_range);
+  ASSERT_EQ(result.ptr, text.data() + 3);
+  ASSERT_EQ(byte, 9);
+}
+
+TEST(charconv, TestIntegerRoundTrip) {
+  std::mt19937_64 rng(3);
+  for (int i = 0; i < 100000; ++i) {
+    // spread the values over every digit count
+    auto value = static_cast<std::int64_t>(rng() >> (rng() % 64));
+    value = i % 2 ? -value : value;
+    std::string text = isl_to_string(value);
+    ASSERT_EQ(text, std_to_string(value));
+    ASSERT_EQ(isl_parse<std::int64_t>(text), value);
+  }
+}
+
+TEST(charconv, TestFloatToChars) {
+  ASSERT_EQ(isl_to_string(0.0), "0");
+  ASSERT_EQ(isl_to_string(-0.0), "-0");
+  ASSERT_EQ(isl_to_string(0.1), "0.1");
+  ASSERT_EQ(isl_to_string(1.5e300), "1.5e+300");
+  ASSERT_EQ(isl_to_string(123456.0), "123456");
+  ASSERT_EQ(isl_to_string(1e22), "1e+22");
+  ASSERT_EQ(isl_to_string(5e-324), "5e-324");
+  ASSERT_EQ(isl_to_string(0.3f), "0.3");
+  ASSERT_EQ(isl_to_string(std::numeric_limits<double>::infinity()), "inf");
+  ASSERT_EQ(isl_to_string(-std::numeric_limits<float>::infinity()), "-inf");
+  ASSERT_EQ(isl_to_string(std::numeric_limits<double>::quiet_NaN()), "nan");
+
+  char buffer[4];
+  auto result = isl::to_chars(buffer, buffer + sizeof(buffer), 0.125);
+  ASSERT_EQ(result.ec, std::errc::value_too_large);
+}
+
+TEST(charconv, TestFloatFromChars) {
+  ASSERT_EQ(isl_parse<double>("0.1"), 0.1);
+  ASSERT_EQ(isl_parse<double>("-2.5e-3"), -2.5e-3);
+  ASSERT_EQ(isl_parse<double>("1e308"), 1e308);
+  ASSERT_EQ(isl_parse<double>("4.9406564584124654e-324"), 5e-324);
+  ASSERT_EQ(isl_parse<float>("3.4028235e38"),
+            std::numeric_limits<float>::max());
+  // halfway between 1 and the next double, rounds to even
+  ASSERT_EQ(isl_parse<double>("1.00000000000000011102230246251565404236316680"
+                              "908203125"),
+            1.0);
+  ASSERT_EQ(isl_parse<double>("9007199254740993"), 9007199254740992.0);
+  ASSERT_EQ(isl_parse<double>("0.000000000000000000000000123456789012345678"
+                              "90123"),
+            1.2345678901234567890123e-25);
+  ASSERT_EQ(isl_parse<double>("Infinity"),
+            std::numeric_limits<double>::infinity());
+  ASSERT_TRUE(isl_parse<double>("nan(123)") != isl_parse<double>("nan"));
+
+  std::string_view text = "1e400";
+  double value = 7;
+  auto result = isl::from_chars(text.data(), text.data() + text.size(), value);
+  ASSERT_EQ(result.ec, std::errc::result_out_of_range);
+  ASSERT_EQ(value, 7);
+
+  // an exponent without digits is not part of the number
+  text = "2e+";
+  result = isl::from_chars(text.data(), text.data() + text.size(), value);
+  ASSERT_EQ(value, 2);
+  ASSERT_EQ(result.ptr, text.data() + 1);
+
+  text = ".e1";
+  result = isl::from_chars(text.data(), text.data() + text.size(), value);
+  ASSERT_EQ(result.ec, std::errc::invalid_argument);
+}
+
+// Random bit patterns, so subnormals and both notations show up. Output must
+// match the standard library byte for byte and read back to the same bits.
+TEST(charconv, TestDoubleRoundTrip) {
+  std::mt19937_64 rng(5);
+  for (int i = 0; i < 200000; ++i) {
+    auto value = std::bit_cast<double>(rng());
+    if (value != value) {
+      continue;
+    }
+    std::string text = isl_to_string(value);
+    ASSERT_EQ(text, std_to_string(value));
+    if (value == 0 || value - value != 0) {
+      continue;
+    }
+    ASSERT_EQ(std::bit_cast<std::uint64_t>(isl_parse<double>(text)),
+              std::bit_cast<std::uint64_t>(value))
+        << text;
+  }
+}
+
+TEST(charconv, TestFloatRoundTrip) {
+  std::mt19937 rng(7);
+  for (int i = 0; i < 200000; ++i) {
+    auto value = std::bit_cast<float>(static_cast<std::uint32_t>(rng()));
+    if (value != value) {
+      continue;
+    }
+    std::string text = isl_to_string(value);
+    ASSERT_EQ(text, std_to_string(value));
+    if (value == 0 || value - value != 0) {
+      continue;
+    }
+    ASSERT_EQ(std::bit_cast<std::uint32_t>(isl_parse<float>(text)),
+              std::bit_cast<std::uint32_t>(value))
+        << text;
+  }
+}
+
+// Long decimal inputs take the Eisel-Lemire path with truncated digits;
+// the standard library is the reference.
+TEST(charconv, TestFromCharsMatchesStd) {
+  std::mt19937_64 rng(9);
+  for (int i = 0; i < 50000; ++i) {
+    std::string text = std::to_string(rng() % 1000);
+    text += '.';
+    int digits = 1 + rng() % 30;
+    for (int j = 0; j < digits; ++j) {
+      text += static_cast<char>('0' + rng() % 10);
+    }
+    text += 'e';
+    text += std::to_string(static_cast<int>(rng() % 640) - 330);
+
+    double expected = 0;
+    std::from_chars(text.data(), text.data() + text.size(), expected);
+    double value = 0;
+    isl::from_chars(text.data(), text.data() + text.size(), value);
+    ASSERT_EQ(std::bit_cast<std::uint64_t>(value),
+              std::bit_cast<std::uint64_t>(expected))
+        << text;
+
+    float expected_float = 0;
+    std::from_chars(text.data(), text.data() + text.size(), expected_float);
+    float value_float = 0;
+    isl::from_chars(text.data(), text.data() + text.size(), value_float);
+    ASSERT_EQ(std::bit_cast<std::uint32_t>(value_float),
+              std::bit_cast<std::uint32_t>(expected_float))
+        << text;
+  }
+}
+
+// Exact midpoints between adjacent floats, printed in full through a wider
+// type: a tie rounds to even, any further nonzero digit rounds up, and
+// anything just below rounds down.
+template <class Float, class Bits, class Wide>
+void check_midpoints(std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  for (int i = 0; i < 2000; ++i) {
+    auto lower = std::bit_cast<Float>(static_cast<Bits>(rng() >> 1));
+    auto upper = std::bit_cast<Float>(std::bit_cast<Bits>(lower) + 1);
+    if (upper - upper != 0) {
+      continue; // NaN or infinity
+    }
+    Wide midpoint = (static_cast<Wide>(lower) + static_cast<Wide>(upper)) / 2;
+    char buffer[2000];
+    auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), midpoint,
+                                   std::chars_format::scientific, 1100);
+    ASSERT_EQ(ec, std::errc{});
+    std::string text(buffer, ptr);
+    std::size_t e = text.find('e');
+    std::string digits = text.substr(0, e);
+    std::string exponent = text.substr(e);
+    digits.erase(digits.find_last_not_of('0') + 1);
+
+    Float even = (std::bit_cast<Bits>(lower) & 1) == 0 ? lower : upper;
+    ASSERT_EQ(isl_parse<Float>(digits + exponent), even) << text;
+    ASSERT_EQ(isl_parse<Float>(digits + "0000001" + exponent), upper) << text;
+    --digits.back();
+    ASSERT_EQ(isl_parse<Float>(digits + "9999999" + exponent), lower) << text;
+  }
+}
+
+TEST(charconv, TestFromCharsMidpoints) {
+  check_midpoints<double, std::uint64_t, long double>(11);
+  check_midpoints<float, std::uint32_t, double>(13);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
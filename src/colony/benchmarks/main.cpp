@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint> // std::uint32_t
+#include <random>  // std::mt19937
+
+import colony;
+import vector;
+
+namespace {
+struct particle {
+  double x, y, z;
+  double vx, vy, vz;
+};
+
+// The pattern colony replaces: a vector of tombstoned entries plus a stack of
+// free indices.
+class free_list_pool {
+  struct entry {
+    particle value;
+    bool alive;
+  };
+
+  isl::vector<entry> entries;
+  isl::vector<std::uint32_t> free;
+
+public:
+  std::uint32_t insert(const particle &value) {
+    if (!this->free.empty()) {
+      std::uint32_t index = this->free.back();
+      this->free.pop_back();
+      this->entries[index] = {value, true};
+      return index;
+    }
+    this->entries.push_back({value, true});
+    return static_cast<std::uint32_t>(this->entries.size() - 1);
+  }
+  void erase(std::uint32_t index) {
+    this->entries[index].alive = false;
+    this->free.push_back(index);
+  }
+  template <class F> void for_each(F f) {
+    for (auto &e : this->entries) {
+      if (e.alive) {
+        f(e.value);
+      }
+    }
+  }
+};
+
+// Fills a container with `size` elements, then erases every element with
+// probability `erased_percent`.
+template <class Insert, class Erase>
+void churn(std::size_t size, int erased_percent, Insert insert, Erase erase) {
+  std::mt19937 rng(42);
+  for (std::size_t i = 0; i != size; ++i) {
+    insert(i);
+  }
+  for (std::size_t i = 0; i != size; ++i) {
+    if (static_cast<int>(rng() % 100) < erased_percent) {
+      erase(i);
+    }
+  }
+}
+} // namespace
+
+static void BM_ColonyIterate(benchmark::State &state) {
+  isl::colony<particle> pool;
+  isl::vector<isl::colony<particle>::iterator> handles;
+  churn(
+      state.range(0), state.range(1),
+      [&](std::size_t) { handles.push_back(pool.insert(particle{})); },
+      [&](std::size_t i) { pool.erase(handles[i]); });
+
+  for (auto _ : state) {
+    double sum = 0;
+    for (const particle &p : pool) {
+      sum += p.x;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * pool.size());
+}
+BENCHMARK(BM_ColonyIterate)->ArgsProduct({{1 << 16, 1 << 20}, {10, 50, 90}});
+
+static void BM_FreeListIterate(benchmark::State &state) {
+  free_list_pool pool;
+  std::size_t alive = 0;
+  churn(
+      state.range(0), state.range(1),
+      [&](std::size_t) { pool.insert(particle{}), ++alive; },
+      [&](std::size_t i) { pool.erase(i), --alive; });
+
+  for (auto _ : state) {
+    double sum = 0;
+    pool.for_each([&sum](const particle &p) { sum += p.x; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * alive);
+}
+BENCHMARK(BM_FreeListIterate)->ArgsProduct({{1 << 16, 1 << 20}, {10, 50, 90}});
+
+// Steady-state churn: erase a random live element and insert a new one.
+static void BM_ColonyChurn(benchmark::State &state) {
+  std::size_t size = state.range(0);
+  isl::colony<particle> pool;
+  isl::vector<isl::colony<particle>::iterator> handles;
+  for (std::size_t i = 0; i != size; ++i) {
+    handles.push_back(pool.insert(particle{}));
+  }
+
+  std::mt19937 rng(42);
+  for (auto _ : state) {
+    std::size_t victim = rng() % size;
+    pool.erase(handles[victim]);
+    handles[victim] = pool.insert(particle{});
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ColonyChurn)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_FreeListChurn(benchmark::State &state) {
+  std::size_t size = state.range(0);
+  free_list_pool pool;
+  isl::vector<std::uint32_t> handles;
+  for (std::size_t i = 0; i != size; ++i) {
+    handles.push_back(pool.insert(particle{}));
+  }
+
+  std::mt19937 rng(42);
+  for (auto _ : state) {
+    std::size_t victim = rng() % size;
+    pool.erase(handles[victim]);
+    handles[victim] = pool.insert(particle{});
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FreeListChurn)->Arg(1 << 16)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
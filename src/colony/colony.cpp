@@ -0,0 +1,414 @@
+module;
+
+#include <algorithm>   // std::max, std::min
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint16_t
+#include <iterator>    // std::forward_iterator_tag
+#include <memory>      // std::allocator, std::allocator_traits
+#include <new>         // std::launder
+#include <type_traits> // std::conditional_t
+#include <utility>     // std::forward, std::move
+
+export module colony;
+
+namespace isl::detail {
+using skipfield_type = std::uint16_t;
+
+inline constexpr skipfield_type no_slot = ~skipfield_type{0};
+
+// Erased slots that start a skipblock hold the links of their block's free
+// list, so a slot is as large as the bigger of the two.
+struct colony_free_links {
+  skipfield_type previous;
+  skipfield_type next;
+};
+
+template <class T> struct colony_slot {
+  alignas(std::max(alignof(T), alignof(colony_free_links))) unsigned char
+      bytes[std::max(sizeof(T), sizeof(colony_free_links))];
+
+  T *value() noexcept { return std::launder(reinterpret_cast<T *>(bytes)); }
+  colony_free_links *links() noexcept {
+    return std::launder(reinterpret_cast<colony_free_links *>(bytes));
+  }
+};
+
+template <class T> struct colony_block {
+  colony_slot<T> *slots;
+  // One entry per slot plus a zero sentinel. Non-zero only for erased
+  // slots; at both ends of a run of erased slots (a skipblock) it holds the
+  // run's length.
+  skipfield_type *skipfield;
+
+  colony_block *next;
+  colony_block *previous;
+  colony_block *next_with_erasures;
+  colony_block *previous_with_erasures;
+
+  skipfield_type capacity;
+  skipfield_type last; // slots past `last` have never been used
+  skipfield_type size;
+  skipfield_type free_list_head; // first skipblock start, or no_slot
+};
+} // namespace isl::detail
+
+export namespace isl {
+/// Unordered container for insert/erase-heavy object pools.
+///
+/// Elements live in a list of blocks of growing size and never move, so
+/// pointers and iterators stay valid until their element is erased. Erased
+/// slots are recorded in a per-block skipfield (the "low-complexity jump
+/// counting" pattern) that lets iteration jump over each run of holes in
+/// one step, and in a per-block free list of runs so insertion reuses holes
+/// before growing. A block is released as soon as it is empty.
+template <class T, class Allocator = std::allocator<T>> class colony {
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = T *;
+  using const_pointer = const T *;
+
+private:
+  using skipfield_type = detail::skipfield_type;
+  using block = detail::colony_block<T>;
+  using slot = detail::colony_slot<T>;
+
+  template <class U>
+  using rebind = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<U>;
+
+  static constexpr skipfield_type min_block_capacity = 8;
+  static constexpr skipfield_type max_block_capacity = 1 << 14;
+
+  template <bool Const> class basic_iterator {
+    friend class colony;
+    template <bool> friend class basic_iterator;
+
+    block *current{nullptr};
+    skipfield_type index{0};
+
+    constexpr basic_iterator(block *current, skipfield_type index) noexcept
+        : current(current), index(index) {}
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    constexpr basic_iterator() noexcept = default;
+    constexpr basic_iterator(const basic_iterator &) noexcept = default;
+    constexpr basic_iterator(const basic_iterator<false> &other) noexcept
+        requires(Const)
+        : current(other.current), index(other.index) {}
+
+    reference operator*() const noexcept {
+      return *this->current->slots[this->index].value();
+    }
+    pointer operator->() const noexcept {
+      return this->current->slots[this->index].value();
+    }
+
+    basic_iterator &operator++() noexcept {
+      ++this->index;
+      this->index += this->current->skipfield[this->index];
+      if (this->index == this->current->last) {
+        this->current = this->current->next;
+        this->index = this->current ? this->current->skipfield[0] : 0;
+      }
+      return *this;
+    }
+    basic_iterator operator++(int) noexcept {
+      basic_iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    constexpr basic_iterator &
+    operator=(const basic_iterator &) noexcept = default;
+
+    friend bool operator==(const basic_iterator &,
+                           const basic_iterator &) noexcept = default;
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+private:
+  [[no_unique_address]] Allocator allocator;
+
+  block *head{nullptr};
+  block *tail{nullptr};
+  block *with_erasures{nullptr};
+
+  std::size_t size_{0};
+  std::size_t capacity_{0};
+
+  // blocks
+
+  block *allocate_block(skipfield_type capacity) {
+    rebind<block> block_allocator(this->allocator);
+    rebind<slot> slot_allocator(this->allocator);
+    rebind<skipfield_type> skipfield_allocator(this->allocator);
+
+    block *allocated = std::allocator_traits<rebind<block>>::allocate(
+        block_allocator, 1);
+    allocated->slots = std::allocator_traits<rebind<slot>>::allocate(
+        slot_allocator, capacity);
+    allocated->skipfield =
+        std::allocator_traits<rebind<skipfield_type>>::allocate(
+            skipfield_allocator, capacity + 1);
+    std::uninitialized_fill_n(allocated->skipfield, capacity + 1,
+                              skipfield_type{0});
+
+    allocated->next = nullptr;
+    allocated->previous = this->tail;
+    allocated->next_with_erasures = nullptr;
+    allocated->previous_with_erasures = nullptr;
+    allocated->capacity = capacity;
+    allocated->last = 0;
+    allocated->size = 0;
+    allocated->free_list_head = detail::no_slot;
+
+    (this->tail ? this->tail->next : this->head) = allocated;
+    this->tail = allocated;
+    this->capacity_ += capacity;
+    return allocated;
+  }
+
+  // `linked` tells whether the block is on the with_erasures list; erase_slot
+  // may already have pushed a run onto a block that was never linked.
+  void deallocate_block(block *released, bool linked) noexcept {
+    (released->previous ? released->previous->next : this->head) =
+        released->next;
+    (released->next ? released->next->previous : this->tail) =
+        released->previous;
+    if (linked) {
+      this->unlink_erasures(released);
+    }
+    this->capacity_ -= released->capacity;
+
+    rebind<block> block_allocator(this->allocator);
+    rebind<slot> slot_allocator(this->allocator);
+    rebind<skipfield_type> skipfield_allocator(this->allocator);
+
+    std::allocator_traits<rebind<skipfield_type>>::deallocate(
+        skipfield_allocator, released->skipfield, released->capacity + 1);
+    std::allocator_traits<rebind<slot>>::deallocate(
+        slot_allocator, released->slots, released->capacity);
+    std::allocator_traits<rebind<block>>::deallocate(block_allocator,
+                                                     released, 1);
+  }
+
+  void link_erasures(block *target) noexcept {
+    target->previous_with_erasures = nullptr;
+    target->next_with_erasures = this->with_erasures;
+    if (this->with_erasures) {
+      this->with_erasures->previous_with_erasures = target;
+    }
+    this->with_erasures = target;
+  }
+  void unlink_erasures(block *target) noexcept {
+    (target->previous_with_erasures
+         ? target->previous_with_erasures->next_with_erasures
+         : this->with_erasures) = target->next_with_erasures;
+    if (target->next_with_erasures) {
+      target->next_with_erasures->previous_with_erasures =
+          target->previous_with_erasures;
+    }
+  }
+
+  // per-block free list of skipblocks
+
+  static void push_run(block *target, skipfield_type start) noexcept {
+    *target->slots[start].links() = {detail::no_slot, target->free_list_head};
+    if (target->free_list_head != detail::no_slot) {
+      target->slots[target->free_list_head].links()->previous = start;
+    }
+    target->free_list_head = start;
+  }
+  static void remove_run(block *target, skipfield_type start) noexcept {
+    detail::colony_free_links links = *target->slots[start].links();
+    if (links.previous != detail::no_slot) {
+      target->slots[links.previous].links()->next = links.next;
+    } else {
+      target->free_list_head = links.next;
+    }
+    if (links.next != detail::no_slot) {
+      target->slots[links.next].links()->previous = links.previous;
+    }
+  }
+  // The run starting at `from` now starts at `to`.
+  static void move_run(block *target, skipfield_type from,
+                       skipfield_type to) noexcept {
+    detail::colony_free_links links = *target->slots[from].links();
+    *target->slots[to].links() = links;
+    if (links.previous != detail::no_slot) {
+      target->slots[links.previous].links()->next = to;
+    } else {
+      target->free_list_head = to;
+    }
+    if (links.next != detail::no_slot) {
+      target->slots[links.next].links()->previous = to;
+    }
+  }
+
+  // Picks the slot for a new element and updates the bookkeeping, leaving
+  // the slot raw.
+  iterator acquire_slot() {
+    if (block *target = this->with_erasures) {
+      skipfield_type start = target->free_list_head;
+      skipfield_type length = target->skipfield[start];
+
+      if (length == 1) {
+        remove_run(target, start);
+      } else {
+        move_run(target, start, start + 1);
+        target->skipfield[start + 1] = length - 1;
+        target->skipfield[start + length - 1] = length - 1;
+      }
+      target->skipfield[start] = 0;
+
+      if (target->free_list_head == detail::no_slot) {
+        this->unlink_erasures(target);
+      }
+      return iterator(target, start);
+    }
+
+    block *target = this->tail;
+    if (target == nullptr || target->last == target->capacity) {
+      skipfield_type capacity =
+          target == nullptr
+              ? min_block_capacity
+              : static_cast<skipfield_type>(std::min<std::size_t>(
+                    this->capacity_, max_block_capacity));
+      target = this->allocate_block(capacity);
+    }
+    return iterator(target, target->last++);
+  }
+
+public:
+  constexpr colony() noexcept(noexcept(Allocator())) {}
+  constexpr explicit colony(const Allocator &alloc) noexcept
+      : allocator(alloc) {}
+  colony(const colony &) = delete;
+  colony &operator=(const colony &) = delete;
+  ~colony() { this->clear(); }
+
+  // capacity
+
+  [[nodiscard]] bool empty() const noexcept { return this->size_ == 0; }
+  size_type size() const noexcept { return this->size_; }
+  size_type capacity() const noexcept { return this->capacity_; }
+
+  // iterators
+
+  iterator begin() noexcept {
+    return this->head ? iterator(this->head, this->head->skipfield[0])
+                      : iterator();
+  }
+  const_iterator begin() const noexcept {
+    return const_cast<colony *>(this)->begin();
+  }
+  iterator end() noexcept { return iterator(); }
+  const_iterator end() const noexcept { return const_iterator(); }
+
+  // modifiers
+
+  template <class... Args> iterator emplace(Args &&...args) {
+    iterator position = this->acquire_slot();
+    block *target = position.current;
+
+    try {
+      std::allocator_traits<Allocator>::construct(
+          this->allocator, target->slots[position.index].value(),
+          std::forward<Args>(args)...);
+    } catch (...) {
+      // Put the slot back as a one-element run so the block stays valid.
+      target->size += 1;
+      this->size_ += 1;
+      this->erase_slot(position);
+      throw;
+    }
+
+    target->size += 1;
+    this->size_ += 1;
+    return position;
+  }
+  iterator insert(const T &value) { return this->emplace(value); }
+  iterator insert(T &&value) { return this->emplace(std::move(value)); }
+
+  /// Returns the iterator following the erased element.
+  iterator erase(const_iterator position) {
+    iterator mutable_position(position.current, position.index);
+    std::allocator_traits<Allocator>::destroy(
+        this->allocator,
+        mutable_position.current->slots[mutable_position.index].value());
+    return this->erase_slot(mutable_position);
+  }
+
+  void clear() noexcept {
+    while (block *current = this->head) {
+      for (iterator it(current, current->skipfield[0]);
+           it.current == current; ++it) {
+        std::allocator_traits<Allocator>::destroy(this->allocator, &*it);
+      }
+      this->deallocate_block(current,
+                             current->free_list_head != detail::no_slot);
+    }
+    this->size_ = 0;
+  }
+
+private:
+  iterator erase_slot(iterator position) noexcept {
+    block *target = position.current;
+    skipfield_type index = position.index;
+    skipfield_type *skipfield = target->skipfield;
+
+    skipfield_type left = index > 0 ? skipfield[index - 1] : 0;
+    skipfield_type right = skipfield[index + 1];
+    bool had_erasures = target->free_list_head != detail::no_slot;
+
+    if (left == 0 && right == 0) {
+      skipfield[index] = 1;
+      push_run(target, index);
+    } else if (right == 0) {
+      skipfield_type length = left + 1;
+      skipfield[index - left] = length;
+      skipfield[index] = length;
+    } else if (left == 0) {
+      skipfield_type length = right + 1;
+      skipfield[index] = length;
+      skipfield[index + right] = length;
+      move_run(target, index + 1, index);
+    } else {
+      skipfield_type length = left + right + 1;
+      skipfield[index - left] = length;
+      skipfield[index + right] = length;
+      remove_run(target, index + 1);
+    }
+
+    target->size -= 1;
+    this->size_ -= 1;
+
+    // Iterator to the first element after the run that now holds `index`.
+    iterator next(target, index + right);
+    ++next;
+
+    if (target->size == 0) {
+      this->deallocate_block(target, had_erasures);
+    } else if (!had_erasures) {
+      this->link_erasures(target);
+    }
+    return next;
+  }
+};
+} // namespace isl
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <algorithm> // std::sort
+#include <random>    // std::mt19937
+#include <stdexcept> // std::runtime_error
+#include <vector>    // std::vector
+
+import colony;
+
+namespace {
+template <class T> std::vector<T> contents(const isl::colony<T> &colony) {
+  std::vector<T> values(colony.begin(), colony.end());
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+struct may_throw {
+  int value;
+
+  explicit may_throw(int value) : value(value) {
+    if (value < 0) {
+      throw std::runtime_error("negative");
+    }
+  }
+};
+} // namespace
+
+TEST(colony, TestInsertErase) {
+  isl::colony<int> colony;
+  std::vector<isl::colony<int>::iterator> positions;
+  for (int i = 0; i < 100; ++i) {
+    positions.push_back(colony.insert(i));
+  }
+  ASSERT_EQ(colony.size(), 100);
+  std::size_t capacity = colony.capacity();
+
+  // holes in every block
+  std::vector<int> expected;
+  for (int i = 0; i < 100; ++i) {
+    if (i % 2 == 0) {
+      colony.erase(positions[i]);
+    } else {
+      expected.push_back(i);
+      ASSERT_EQ(*positions[i], i);
+    }
+  }
+  ASSERT_EQ(colony.size(), 50);
+  ASSERT_EQ(contents(colony), expected);
+
+  // the holes are reused before the colony grows
+  for (int i = 100; i < 150; ++i) {
+    colony.insert(i);
+    expected.push_back(i);
+  }
+  ASSERT_EQ(colony.capacity(), capacity);
+  ASSERT_EQ(contents(colony), expected);
+}
+
+TEST(colony, TestIterationSkipsRuns) {
+  isl::colony<int> colony;
+  std::vector<isl::colony<int>::iterator> positions;
+  for (int i = 0; i < 64; ++i) {
+    positions.push_back(colony.insert(i));
+  }
+
+  // runs of one, several, at the start of a block and joining two runs
+  std::vector<bool> erased(64, false);
+  for (int i : {0, 1, 2, 5, 9, 10, 11, 12, 13, 7, 8, 30, 31, 33, 32, 63}) {
+    colony.erase(positions[i]);
+    erased[i] = true;
+  }
+
+  std::vector<int> expected;
+  for (int i = 0; i < 64; ++i) {
+    if (!erased[i]) {
+      expected.push_back(i);
+    }
+  }
+  std::vector<int> seen;
+  for (int value : colony) {
+    seen.push_back(value);
+  }
+  // each block is iterated in slot order
+  ASSERT_EQ(seen, expected);
+
+  // erase returns the next live element
+  auto next = colony.erase(positions[6]);
+  ASSERT_EQ(*next, 14);
+}
+
+TEST(colony, TestEraseWholeBlocks) {
+  isl::colony<int> colony;
+  std::vector<isl::colony<int>::iterator> positions;
+  for (int i = 0; i < 9; ++i) {
+    positions.push_back(colony.insert(i));
+  }
+  ASSERT_EQ(colony.capacity(), 16);
+
+  // a hole in the first block, then the second block empties
+  colony.erase(positions[3]);
+  auto next = colony.erase(positions[8]);
+  ASSERT_EQ(next, colony.end());
+  ASSERT_EQ(colony.capacity(), 8);
+
+  // the hole in the first block is still found
+  colony.insert(100);
+  ASSERT_EQ(colony.capacity(), 8);
+  ASSERT_EQ(contents(colony), (std::vector<int>{0, 1, 2, 4, 5, 6, 7, 100}));
+
+  // emptying the first block releases it too
+  colony.clear();
+  ASSERT_TRUE(colony.empty());
+  ASSERT_EQ(colony.capacity(), 0);
+  ASSERT_EQ(colony.begin(), colony.end());
+}
+
+TEST(colony, TestRandomOperations) {
+  isl::colony<int> colony;
+  std::vector<isl::colony<int>::iterator> positions;
+  std::vector<int> expected;
+  std::mt19937 rng(30);
+
+  for (int step = 0; step < 20000; ++step) {
+    if (positions.empty() || rng() % 3 != 0) {
+      positions.push_back(colony.insert(step));
+      expected.push_back(step);
+    } else {
+      std::size_t i = rng() % positions.size();
+      int value = *positions[i];
+      colony.erase(positions[i]);
+      positions[i] = positions.back();
+      positions.pop_back();
+      expected.erase(std::find(expected.begin(), expected.end(), value));
+    }
+  }
+  ASSERT_EQ(colony.size(), expected.size());
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(contents(colony), expected);
+}
+
+TEST(colony, TestEmplaceThrows) {
+  isl::colony<may_throw> colony;
+  for (int i = 0; i < 10; ++i) {
+    colony.emplace(i);
+  }
+  std::size_t capacity = colony.capacity();
+
+  ASSERT_THROW(colony.emplace(-1), std::runtime_error);
+  ASSERT_EQ(colony.size(), 10);
+
+  int sum = 0;
+  for (const may_throw &element : colony) {
+    sum += element.value;
+  }
+  ASSERT_EQ(sum, 45);
+
+  // the slot given back is reused
+  colony.emplace(10);
+  ASSERT_EQ(colony.size(), 11);
+  ASSERT_EQ(colony.capacity(), capacity);
+
+  // a failed insert into an empty colony leaves it empty
+  isl::colony<may_throw> empty;
+  ASSERT_THROW(empty.emplace(-1), std::runtime_error);
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(empty.begin(), empty.end());
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -42,33 +42,26 @@ export namespace isl {
         return byte(static_cast<unsigned char>(b) >> shift);
     }
 
-	template<class IntegerType>
-    constexpr byte& operator|=(byte& l, byte& r) noexcept {
-        return l = l | r;
-    }
-    template<class IntegerType>
-    constexpr byte& operator&=(byte& l, byte& r) noexcept {
-        return l = l & r;
-    }
-    template<class IntegerType>
-    constexpr byte& operator^=(byte& l, byte& r) noexcept {
-        return l = l ^ r;
-    }
+	constexpr byte operator|(byte l, byte r) noexcept {
+		return byte(static_cast<unsigned char>(l) | static_cast<unsigned char>(r));
+	}
+	constexpr byte operator&(byte l, byte r) noexcept {
+		return byte(static_cast<unsigned char>(l) & static_cast<unsigned char>(r));
+	}
+	constexpr byte operator^(byte l, byte r) noexcept {
+		return byte(static_cast<unsigned char>(l) ^ static_cast<unsigned char>(r));
+	}
+	constexpr byte operator~(byte b) noexcept {
+		return byte(~static_cast<unsigned char>(b));
+	}
 
-    template<class IntegerType>
-    constexpr byte operator|(byte l, byte r) noexcept {
-        return byte(static_cast<unsigned char>(l) | static_cast<unsigned char>(r));
-    }
-    template<class IntegerType>
-    constexpr byte operator&(byte l, byte r) noexcept {
-        return byte(static_cast<unsigned char>(l) & static_cast<unsigned char>(r));
+	constexpr byte& operator|=(byte& l, byte r) noexcept {
+		return l = l | r;
 	}
-    template<class IntegerType>
-    constexpr byte operator^(byte l, byte r) noexcept {
-        return byte(static_cast<unsigned char>(l) ^ static_cast<unsigned char>(r));
+	constexpr byte& operator&=(byte& l, byte r) noexcept {
+		return l = l & r;
 	}
-    template<class IntegerType>
-    constexpr byte operator~(byte l) noexcept {
-        return byte(~static_cast<unsigned char>(l));
+	constexpr byte& operator^=(byte& l, byte r) noexcept {
+		return l = l ^ r;
 	}
 }
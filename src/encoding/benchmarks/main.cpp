@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef> // std::size_t
+#include <random>  // std::mt19937
+#include <string>  // std::string
+
+import encoding;
+
+namespace {
+std::string random_bytes(std::size_t n) {
+  std::mt19937 rng(1);
+  std::string data(n, '\0');
+  for (char &c : data) {
+    c = static_cast<char>(rng());
+  }
+  return data;
+}
+
+// A table-driven byte-at-a-time decoder for comparison.
+std::size_t naive_base64_decode(const std::string &text, char *out) {
+  static const auto values = [] {
+    std::string alphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string table(256, '\xFF');
+    for (std::size_t i = 0; i < alphabet.size(); ++i) {
+      table[static_cast<unsigned char>(alphabet[i])] = static_cast<char>(i);
+    }
+    return table;
+  }();
+  std::size_t w = 0;
+  unsigned bits = 0;
+  int count = 0;
+  for (char c : text) {
+    auto value =
+        static_cast<unsigned char>(values[static_cast<unsigned char>(c)]);
+    if (value == 0xFF) {
+      break;
+    }
+    bits = bits << 6 | value;
+    count += 6;
+    if (count >= 8) {
+      count -= 8;
+      out[w++] = static_cast<char>(bits >> count);
+    }
+  }
+  return w;
+}
+} // namespace
+
+static void BM_Base64Encode(benchmark::State &state) {
+  std::string data = random_bytes(state.range(0));
+  std::string out(isl::base64_encoded_length(data.size()), '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::base64_encode(
+        data.data(), data.data() + data.size(), out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_Base64Encode)->Arg(64)->Arg(1 << 20);
+
+static void BM_Base64Decode(benchmark::State &state) {
+  std::string data = random_bytes(state.range(0));
+  std::string text(isl::base64_encoded_length(data.size()), '\0');
+  isl::base64_encode(data.data(), data.data() + data.size(), text.data());
+  std::string out(isl::base64_decoded_max_length(text.size()), '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::base64_decode(
+        text.data(), text.data() + text.size(), out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Base64Decode)->Arg(64)->Arg(1 << 20);
+
+static void BM_NaiveBase64Decode(benchmark::State &state) {
+  std::string data = random_bytes(state.range(0));
+  std::string text(isl::base64_encoded_length(data.size()), '\0');
+  isl::base64_encode(data.data(), data.data() + data.size(), text.data());
+  std::string out(isl::base64_decoded_max_length(text.size()), '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(naive_base64_decode(text, out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_NaiveBase64Decode)->Arg(64)->Arg(1 << 20);
+
+static void BM_HexEncode(benchmark::State &state) {
+  std::string data = random_bytes(state.range(0));
+  std::string out(2 * data.size(), '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        isl::hex_encode(data.data(), data.data() + data.size(), out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_HexEncode)->Arg(64)->Arg(1 << 20);
+
+static void BM_HexDecode(benchmark::State &state) {
+  std::string data = random_bytes(state.range(0));
+  std::string text(2 * data.size(), '\0');
+  isl::hex_encode(data.data(), data.data() + data.size(), text.data());
+  std::string out(data.size(), '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        isl::hex_decode(text.data(), text.data() + text.size(), out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_HexDecode)->Arg(64)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,164 @@
+module;
+
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::remove_const_t
+
+#include "../internal/simd/encoding.hpp"
+
+export module encoding;
+
+import bytes;
+import cstddef;
+import vector;
+
+namespace isl::detail {
+namespace simd = isl::internal::simd;
+
+template <class T> const unsigned char *as_encoded(T *p) noexcept {
+  return reinterpret_cast<const unsigned char *>(p);
+}
+
+inline constexpr char lower_hex_digits[] = "0123456789abcdef";
+inline constexpr char upper_hex_digits[] = "0123456789ABCDEF";
+} // namespace isl::detail
+
+export namespace isl {
+/// Outcome of a decode. On success `read` is the whole input; on failure
+/// it is the offset of the first offending char and `written` what the
+/// input before it decoded to.
+struct decode_result {
+  std::size_t read;
+  std::size_t written;
+  bool valid;
+
+  friend bool operator==(const decode_result &,
+                         const decode_result &) = default;
+};
+
+enum class hex_case { lower, upper };
+
+// Inputs and outputs are contiguous ranges of any byte_like type. The
+// kernels run on AVX2 where the CPU has it and are scalar otherwise.
+
+// Base64 per RFC 4648: standard alphabet, '=' padding. Decoding accepts
+// input with or without padding but rejects whitespace and other chars.
+
+constexpr std::size_t base64_encoded_length(std::size_t n) noexcept {
+  return (n + 2) / 3 * 4;
+}
+/// Room decoding `n` chars needs; the exact length can be less.
+constexpr std::size_t base64_decoded_max_length(std::size_t n) noexcept {
+  return (n + 3) / 4 * 3;
+}
+
+/// Writes base64_encoded_length(last - first) chars; returns their end.
+template <class T, byte_like U>
+  requires byte_like<std::remove_const_t<T>>
+U *base64_encode(T *first, T *last, U *out) noexcept {
+  std::size_t written = detail::simd::base64_encode(
+      detail::as_encoded(first), last - first, reinterpret_cast<char *>(out));
+  return out + written;
+}
+
+/// Appends the encoding of [first, last) to `out`.
+template <class T, byte_like U, class Allocator>
+  requires byte_like<std::remove_const_t<T>>
+void base64_encode(T *first, T *last, vector<U, Allocator> &out) {
+  std::size_t size = out.size();
+  out.resize_and_overwrite(
+      size + base64_encoded_length(last - first),
+      [&](U *data, std::size_t) {
+        return isl::base64_encode(first, last, data + size) - data;
+      });
+}
+
+/// `out` must have room for base64_decoded_max_length(last - first) bytes.
+template <class T, byte_like U>
+  requires byte_like<std::remove_const_t<T>>
+decode_result base64_decode(T *first, T *last, U *out) noexcept {
+  const unsigned char *s = detail::as_encoded(first);
+  std::size_t n = last - first;
+  // padding only completes a group of four
+  std::size_t padding = 0;
+  if (n != 0 && n % 4 == 0 && s[n - 1] == '=') {
+    padding = s[n - 2] == '=' ? 2 : 1;
+  }
+  auto [read, written, valid] = detail::simd::base64_decode(
+      s, n - padding, reinterpret_cast<unsigned char *>(out));
+  return {valid ? n : read, written, valid};
+}
+
+/// Appends the decoded bytes to `out`, decoding straight into its storage.
+/// On failure `out` keeps what the valid prefix decoded to.
+template <class T, byte_like U, class Allocator>
+  requires byte_like<std::remove_const_t<T>>
+decode_result base64_decode(T *first, T *last, vector<U, Allocator> &out) {
+  std::size_t size = out.size();
+  decode_result result;
+  out.resize_and_overwrite(
+      size + base64_decoded_max_length(last - first),
+      [&](U *data, std::size_t) {
+        result = isl::base64_decode(first, last, data + size);
+        return size + result.written;
+      });
+  return result;
+}
+
+// Hex: two digits per byte. Decoding accepts either case.
+
+/// Writes 2 * (last - first) chars; returns their end.
+template <class T, byte_like U>
+  requires byte_like<std::remove_const_t<T>>
+U *hex_encode(T *first, T *last, U *out,
+              hex_case letters = hex_case::lower) noexcept {
+  std::size_t n = last - first;
+  detail::simd::hex_encode(detail::as_encoded(first), n,
+                           reinterpret_cast<char *>(out),
+                           letters == hex_case::lower
+                               ? detail::lower_hex_digits
+                               : detail::upper_hex_digits);
+  return out + 2 * n;
+}
+
+template <class T, byte_like U, class Allocator>
+  requires byte_like<std::remove_const_t<T>>
+void hex_encode(T *first, T *last, vector<U, Allocator> &out,
+                hex_case letters = hex_case::lower) {
+  std::size_t size = out.size();
+  out.resize_and_overwrite(size + 2 * (last - first),
+                           [&](U *data, std::size_t n) {
+                             isl::hex_encode(first, last, data + size,
+                                             letters);
+                             return n;
+                           });
+}
+
+/// `out` must have room for (last - first) / 2 bytes. An odd length is
+/// invalid at its last char.
+template <class T, byte_like U>
+  requires byte_like<std::remove_const_t<T>>
+decode_result hex_decode(T *first, T *last, U *out) noexcept {
+  std::size_t n = last - first;
+  auto [read, written, valid] =
+      detail::simd::hex_decode(detail::as_encoded(first), n & ~std::size_t{1},
+                               reinterpret_cast<unsigned char *>(out));
+  if (valid && n % 2 != 0) {
+    return {n - 1, written, false};
+  }
+  return {read, written, valid};
+}
+
+template <class T, byte_like U, class Allocator>
+  requires byte_like<std::remove_const_t<T>>
+decode_result hex_decode(T *first, T *last, vector<U, Allocator> &out) {
+  std::size_t size = out.size();
+  decode_result result;
+  out.resize_and_overwrite(size + (last - first) / 2,
+                           [&](U *data, std::size_t) {
+                             result = isl::hex_decode(first, last,
+                                                      data + size);
+                             return size + result.written;
+                           });
+  return result;
+}
+} // namespace isl
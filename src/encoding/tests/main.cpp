@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <cstddef> // std::size_t
+#include <random>  // std::mt19937
+#include <string>  // std::string
+
+import cstddef;
+import encoding;
+import vector;
+
+namespace {
+std::string base64(const std::string &data) {
+  std::string out(isl::base64_encoded_length(data.size()), '\0');
+  char *end = isl::base64_encode(data.data(), data.data() + data.size(),
+                                 out.data());
+  EXPECT_EQ(end, out.data() + out.size());
+  return out;
+}
+
+std::string hex(const std::string &data,
+                isl::hex_case letters = isl::hex_case::lower) {
+  std::string out(2 * data.size(), '\0');
+  isl::hex_encode(data.data(), data.data() + data.size(), out.data(),
+                  letters);
+  return out;
+}
+
+isl::decode_result unbase64(const std::string &text, std::string &out) {
+  out.assign(isl::base64_decoded_max_length(text.size()), '\0');
+  auto result = isl::base64_decode(text.data(), text.data() + text.size(),
+                                   out.data());
+  out.resize(result.written);
+  return result;
+}
+
+std::string random_bytes(std::mt19937 &rng, std::size_t n) {
+  std::string data(n, '\0');
+  for (char &c : data) {
+    c = static_cast<char>(rng());
+  }
+  return data;
+}
+} // namespace
+
+TEST(encoding, TestBase64) {
+  // RFC 4648 test vectors
+  ASSERT_EQ(base64(""), "");
+  ASSERT_EQ(base64("f"), "Zg==");
+  ASSERT_EQ(base64("fo"), "Zm8=");
+  ASSERT_EQ(base64("foo"), "Zm9v");
+  ASSERT_EQ(base64("foobar"), "Zm9vYmFy");
+  ASSERT_EQ(base64("\xFB\xFF\xBF"), "+/+/");
+
+  std::string out;
+  ASSERT_EQ(unbase64("Zm9vYg==", out), (isl::decode_result{8, 4, true}));
+  ASSERT_EQ(out, "foob");
+  ASSERT_EQ(unbase64("Zm9vYg", out), (isl::decode_result{6, 4, true}));
+  ASSERT_EQ(out, "foob");
+  ASSERT_EQ(unbase64("Zm9vYmE=", out), (isl::decode_result{8, 5, true}));
+
+  ASSERT_EQ(unbase64("Zm9v YmFy", out), (isl::decode_result{4, 3, false}));
+  ASSERT_EQ(out, "foo");
+  ASSERT_EQ(unbase64("Zm9vY", out).valid, false);
+  ASSERT_EQ(unbase64("Zm=v", out), (isl::decode_result{2, 0, false}));
+  ASSERT_EQ(unbase64("Zg=", out), (isl::decode_result{2, 0, false}));
+  ASSERT_EQ(unbase64("====", out), (isl::decode_result{0, 0, false}));
+}
+
+// Long inputs take the vector kernels; errors anywhere are located exactly.
+TEST(encoding, TestBase64Random) {
+  std::mt19937 rng(3);
+  for (int round = 0; round < 2000; ++round) {
+    std::string data = random_bytes(rng, rng() % 300);
+    std::string text = base64(data);
+    std::string out;
+    ASSERT_TRUE(unbase64(text, out).valid);
+    ASSERT_EQ(out, data);
+
+    if (text.size() > 4) {
+      // a char outside the alphabet, before any padding
+      std::size_t at = rng() % (text.size() - 4);
+      text[at] = "*\n -\x80"[rng() % 5];
+      auto result = unbase64(text, out);
+      ASSERT_FALSE(result.valid);
+      ASSERT_EQ(result.read, at);
+      ASSERT_EQ(out, data.substr(0, at / 4 * 3));
+    }
+  }
+}
+
+TEST(encoding, TestHex) {
+  ASSERT_EQ(hex("\x01\xAB\xFF"), "01abff");
+  ASSERT_EQ(hex("\x01\xAB\xFF", isl::hex_case::upper), "01ABFF");
+
+  std::mt19937 rng(5);
+  for (int round = 0; round < 2000; ++round) {
+    std::string data = random_bytes(rng, rng() % 100);
+    std::string text = hex(data, round % 2 ? isl::hex_case::upper
+                                           : isl::hex_case::lower);
+    std::string out(data.size(), '\0');
+    auto result = isl::hex_decode(text.data(), text.data() + text.size(),
+                                  out.data());
+    ASSERT_EQ(result, (isl::decode_result{text.size(), data.size(), true}));
+    ASSERT_EQ(out, data);
+
+    if (!text.empty()) {
+      std::size_t at = rng() % text.size();
+      text[at] = "gG/:@`\x80"[rng() % 7];
+      result = isl::hex_decode(text.data(), text.data() + text.size(),
+                               out.data());
+      ASSERT_EQ(result, (isl::decode_result{at, at / 2, false}));
+    }
+  }
+
+  std::string odd = "abc";
+  std::string out(1, '\0');
+  ASSERT_EQ(isl::hex_decode(odd.data(), odd.data() + 3, out.data()),
+            (isl::decode_result{2, 1, false}));
+}
+
+// The vector overloads append, decoding in place.
+TEST(encoding, TestAppendToVector) {
+  std::string text = base64("hello, world");
+  isl::vector<isl::byte> bytes;
+  bytes.push_back(isl::byte{0x7F});
+  auto result = isl::base64_decode(text.data(), text.data() + text.size(),
+                                   bytes);
+  ASSERT_TRUE(result.valid);
+  ASSERT_EQ(bytes.size(), 13);
+  ASSERT_EQ(bytes[0], isl::byte{0x7F});
+  ASSERT_EQ(bytes[1], isl::byte{'h'});
+
+  isl::vector<char> encoded;
+  isl::base64_encode(bytes.data() + 1, bytes.data() + bytes.size(), encoded);
+  ASSERT_EQ(std::string(encoded.data(), encoded.size()), text);
+  isl::hex_encode(bytes.data(), bytes.data() + 1, encoded);
+  ASSERT_EQ(std::string(encoded.data() + text.size(), 2), "7f");
+
+  const char digits[] = "00ff";
+  result = isl::hex_decode(digits, digits + 4, bytes);
+  ASSERT_EQ(bytes.size(), 15);
+  ASSERT_EQ(bytes[14], isl::byte{0xFF});
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
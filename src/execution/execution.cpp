@@ -0,0 +1,47 @@
+module;
+
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::bool_constant, std::remove_cvref_t
+
+export module execution;
+
+import executor;
+
+export namespace isl::execution {
+struct sequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+} // namespace isl::execution
+
+export namespace isl {
+template <class T>
+struct is_execution_policy
+    : std::bool_constant<
+          std::is_same_v<T, execution::sequenced_policy> ||
+          std::is_same_v<T, execution::parallel_policy> ||
+          std::is_same_v<T, execution::parallel_unsequenced_policy>> {};
+template <class T>
+inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+
+template <class T>
+concept execution_policy = is_execution_policy_v<std::remove_cvref_t<T>>;
+} // namespace isl
+
+export namespace isl::execution {
+/// Threads a parallel algorithm spreads over, the calling one included.
+/// Starts the global executor if it is not running yet.
+std::size_t concurrency() { return executor::global().size() + 1; }
+
+/// Calls fn(i) for every i in [0, chunks) on the global executor and the
+/// calling thread, and returns once all calls have returned. Calls may
+/// run concurrently and in any order; an exception escaping one calls
+/// std::terminate, as in the standard parallel algorithms.
+template <class Function> void bulk(std::size_t chunks, Function fn) {
+  executor::global().parallel_for(
+      0, chunks, [&fn](std::size_t chunk) noexcept { fn(chunk); }, 1);
+}
+} // namespace isl::execution
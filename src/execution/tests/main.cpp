@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <atomic>  // std::atomic
+#include <cstddef> // std::size_t
+#include <thread>  // std::thread
+#include <vector>  // std::vector
+
+import execution;
+
+static_assert(isl::is_execution_policy_v<isl::execution::sequenced_policy>);
+static_assert(isl::is_execution_policy_v<isl::execution::parallel_policy>);
+static_assert(isl::is_execution_policy_v<
+              isl::execution::parallel_unsequenced_policy>);
+static_assert(!isl::is_execution_policy_v<int>);
+static_assert(isl::execution_policy<const isl::execution::parallel_policy &>);
+
+TEST(TestBulk, TestEveryChunkRunsOnce) {
+  ASSERT_GE(isl::execution::concurrency(), 1u);
+  for (std::size_t chunks : {0, 1, 2, 7, 1000}) {
+    std::vector<std::atomic<int>> runs(chunks);
+    isl::execution::bulk(chunks, [&](std::size_t chunk) { ++runs[chunk]; });
+    for (std::atomic<int> &count : runs) {
+      ASSERT_EQ(count.load(), 1);
+    }
+  }
+}
+
+TEST(TestBulk, TestNested) {
+  std::atomic<std::size_t> total{0};
+  isl::execution::bulk(16, [&](std::size_t outer) {
+    isl::execution::bulk(16, [&](std::size_t inner) {
+      total.fetch_add(outer * 16 + inner, std::memory_order_relaxed);
+    });
+  });
+  ASSERT_EQ(total.load(), 256 * 255 / 2);
+}
+
+TEST(TestBulk, TestConcurrentCallers) {
+  std::vector<std::thread> threads;
+  std::atomic<std::size_t> total{0};
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&total] {
+      for (int round = 0; round < 100; ++round) {
+        isl::execution::bulk(64, [&](std::size_t) {
+          total.fetch_add(1, std::memory_order_relaxed);
+        });
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(total.load(), 4u * 100 * 64);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>  // std::atomic
+#include <cstddef> // std::size_t
+
+import executor;
+
+namespace {
+long fib(isl::executor &pool, int n) {
+  if (n < 2)
+    return n;
+  long left = 0;
+  long right = 0;
+  pool.fork_join([&] { left = fib(pool, n - 1); },
+                 [&] { right = fib(pool, n - 2); });
+  return left + right;
+}
+} // namespace
+
+// Fine-grained fork/join: every call below the top forks, so this
+// measures the cost of a fork that is taken back by its own thread.
+static void BM_ForkJoinFib(benchmark::State &state) {
+  isl::executor &pool = isl::executor::global();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fib(pool, 20));
+  }
+  state.SetItemsProcessed(state.iterations() * 21891); // calls of fib(20)
+}
+BENCHMARK(BM_ForkJoinFib);
+
+static void BM_Submit(benchmark::State &state) {
+  isl::executor &pool = isl::executor::global();
+  std::atomic<std::size_t> runs{0};
+  for (auto _ : state) {
+    for (int i = 0; i < 1000; ++i) {
+      pool.submit([&runs] { runs.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.wait();
+  }
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(BM_Submit);
+
+static void BM_ParallelFor(benchmark::State &state) {
+  isl::executor &pool = isl::executor::global();
+  std::atomic<std::size_t> sum{0};
+  for (auto _ : state) {
+    pool.parallel_for(0, state.range(0), [&sum](std::size_t i) {
+      sum.fetch_add(i, std::memory_order_relaxed);
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelFor)->Arg(1 << 10)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,475 @@
+module;
+
+#include <atomic>      // std::atomic, std::atomic_thread_fence
+#include <concepts>    // std::invocable
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <memory>      // std::unique_ptr, std::make_unique
+#include <mutex>       // std::mutex, std::unique_lock
+#include <new>         // std::align_val_t
+#include <thread>      // std::thread, std::this_thread::yield
+#include <type_traits> // std::decay_t, std::remove_reference_t
+#include <utility>     // std::forward
+#include <vector>      // std::vector
+
+#if defined(__linux__)
+#include <pthread.h> // pthread_setaffinity_np
+#include <sched.h>   // cpu_set_t, sched_getaffinity, CPU_SET
+#endif
+
+#include "../internal/concurrency/cache_line.hpp"
+#include "../internal/concurrency/futex.hpp"
+#include "../internal/concurrency/work_deque.hpp"
+
+export module executor;
+
+namespace isl::detail {
+namespace concurrency = isl::internal::concurrency;
+
+// A unit of work in the deques and the injection queue. Concrete tasks
+// derive from it; `execute` runs the task and retires it, after which it
+// is not touched again.
+struct task {
+  void (*execute)(task *) noexcept;
+  task *next = nullptr; // injection queue link
+};
+
+// The task fork_join hands out. Lives on the stack of the forking
+// thread, which does not return before `done` is set.
+template <class Function> struct join_task : task {
+  Function *function;
+  std::atomic<bool> done{false};
+
+  explicit join_task(Function &f) : task{&join_task::run}, function(&f) {}
+
+  static void run(task *base) noexcept {
+    auto *self = static_cast<join_task *>(base);
+    (*self->function)();
+    self->done.store(true, std::memory_order_release);
+  }
+};
+
+// Detached tasks are built in fixed-size frames that every thread keeps a
+// stack of, so a task costs no allocation once the frames are warm. A
+// frame goes back to whichever thread ran its task. Callables too big for
+// a frame get an allocation of their own.
+inline constexpr std::size_t task_frame_size = 128;
+inline constexpr std::size_t task_frame_cache_limit = 256;
+inline constexpr std::align_val_t task_frame_alignment{
+    concurrency::cache_line_size};
+
+struct task_frame_cache {
+  std::vector<void *> frames;
+
+  ~task_frame_cache() {
+    for (void *frame : this->frames) {
+      ::operator delete(frame, task_frame_alignment);
+    }
+  }
+};
+thread_local task_frame_cache task_frames;
+
+void *allocate_task_frame() {
+  if (task_frames.frames.empty())
+    return ::operator new(task_frame_size, task_frame_alignment);
+  void *frame = task_frames.frames.back();
+  task_frames.frames.pop_back();
+  return frame;
+}
+
+void release_task_frame(void *frame) noexcept {
+  if (task_frames.frames.size() < task_frame_cache_limit) {
+    try {
+      task_frames.frames.push_back(frame);
+      return;
+    } catch (...) {
+    }
+  }
+  ::operator delete(frame, task_frame_alignment);
+}
+
+template <class Function> struct detached_task : task {
+  static constexpr bool framed =
+      sizeof(Function) + sizeof(task) + sizeof(void *) <= task_frame_size &&
+      alignof(Function) <= concurrency::cache_line_size;
+
+  Function function;
+  std::atomic<std::size_t> *outstanding;
+
+  template <class F>
+  detached_task(F &&f, std::atomic<std::size_t> *outstanding)
+      : task{&detached_task::run}, function(std::forward<F>(f)),
+        outstanding(outstanding) {}
+
+  template <class F>
+  static detached_task *make(F &&f, std::atomic<std::size_t> *outstanding) {
+    if constexpr (framed) {
+      void *frame = detail::allocate_task_frame();
+      try {
+        return ::new (frame) detached_task(std::forward<F>(f), outstanding);
+      } catch (...) {
+        detail::release_task_frame(frame);
+        throw;
+      }
+    } else {
+      return new detached_task(std::forward<F>(f), outstanding);
+    }
+  }
+
+  static void run(task *base) noexcept {
+    auto *self = static_cast<detached_task *>(base);
+    self->function();
+    std::atomic<std::size_t> *outstanding = self->outstanding;
+    if constexpr (framed) {
+      self->~detached_task();
+      detail::release_task_frame(self);
+    } else {
+      delete self;
+    }
+    outstanding->fetch_sub(1, std::memory_order_release);
+  }
+};
+
+struct alignas(concurrency::cache_line_size) executor_worker {
+  concurrency::work_deque<task> deque;
+  // xorshift state picking the victims of steals
+  std::uint64_t seed;
+  std::thread thread;
+
+  explicit executor_worker(std::uint64_t seed) : seed(seed) {}
+
+  std::uint64_t random() noexcept {
+    this->seed ^= this->seed << 13;
+    this->seed ^= this->seed >> 7;
+    this->seed ^= this->seed << 17;
+    return this->seed;
+  }
+};
+
+// Which executor's worker the current thread is, if any.
+struct worker_identity {
+  const void *executor = nullptr;
+  std::size_t index = 0;
+};
+thread_local worker_identity current_worker;
+
+// Rounds of looking for work a worker makes before it goes to sleep.
+inline constexpr int idle_spin_limit = 64;
+
+// Pins the calling thread to the (index mod n)-th of the n CPUs in its
+// affinity mask, which cgroups or taskset may have narrowed. Pinning only
+// helps locality, so when the mask cannot be read or set the thread just
+// stays unpinned.
+void pin_to_cpu(std::size_t index) noexcept {
+#if defined(__linux__)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return;
+  }
+  auto count = static_cast<std::size_t>(CPU_COUNT(&allowed));
+  if (count == 0) {
+    return;
+  }
+  std::size_t skip = index % count;
+  for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed) && skip-- == 0) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+      return;
+    }
+  }
+#else
+  (void)index;
+#endif
+}
+} // namespace isl::detail
+
+export namespace isl {
+struct executor_options {
+  /// Worker threads to start. May be zero, in which case tasks run only
+  /// on threads that wait on the executor.
+  std::size_t threads = std::thread::hardware_concurrency();
+  /// Pins worker i to the i-th, modulo their count, of the CPUs the
+  /// process may run on. Linux only; ignored elsewhere, and a worker that
+  /// cannot be pinned runs unpinned.
+  bool pin_threads = false;
+};
+
+/// Work-stealing thread pool.
+///
+/// Every worker owns a Chase-Lev deque: tasks it forks go to the bottom,
+/// it takes work back from the bottom, and idle workers steal from the
+/// top of a random victim's, which hands them the oldest and so usually
+/// the biggest pieces of work. Tasks from threads outside the pool go to
+/// a shared injection queue. Idle workers spin briefly, then sleep on a
+/// futex; waking them costs a submitter one fence and one load while
+/// nobody sleeps.
+///
+/// Tasks are nullary callables, run once; an exception escaping one
+/// calls std::terminate. Threads that wait on the executor (fork_join,
+/// parallel_for, wait) run tasks while they wait.
+class executor {
+  static constexpr std::size_t cache_line =
+      isl::internal::concurrency::cache_line_size;
+
+  std::vector<std::unique_ptr<detail::executor_worker>> workers;
+
+  std::mutex injection_mutex;
+  detail::task *injection_head = nullptr;
+  detail::task *injection_tail = nullptr;
+  alignas(cache_line) std::atomic<std::size_t> injected{0};
+
+  alignas(cache_line) isl::internal::concurrency::futex_word epoch{0};
+  std::atomic<std::uint32_t> sleepers{0};
+  std::atomic<bool> stopping{false};
+
+  // submitted detached tasks that have not finished
+  alignas(cache_line) std::atomic<std::size_t> outstanding{0};
+
+  detail::executor_worker *current() const noexcept {
+    if (detail::current_worker.executor != this)
+      return nullptr;
+    return this->workers[detail::current_worker.index].get();
+  }
+
+  void notify() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->sleepers.load(std::memory_order_relaxed) != 0) {
+      this->epoch.fetch_add(1, std::memory_order_release);
+      isl::internal::concurrency::futex_wake_one(this->epoch);
+    }
+  }
+
+  void schedule(detail::task *task) {
+    if (detail::executor_worker *self = this->current()) {
+      self->deque.push(task);
+    } else {
+      std::unique_lock lock(this->injection_mutex);
+      if (this->injection_tail != nullptr) {
+        this->injection_tail->next = task;
+      } else {
+        this->injection_head = task;
+      }
+      this->injection_tail = task;
+      this->injected.fetch_add(1, std::memory_order_relaxed);
+    }
+    this->notify();
+  }
+
+  detail::task *take_injected() {
+    if (this->injected.load(std::memory_order_relaxed) == 0)
+      return nullptr;
+    std::unique_lock lock(this->injection_mutex);
+    detail::task *task = this->injection_head;
+    if (task == nullptr)
+      return nullptr;
+    this->injection_head = task->next;
+    if (this->injection_head == nullptr)
+      this->injection_tail = nullptr;
+    this->injected.fetch_sub(1, std::memory_order_relaxed);
+    task->next = nullptr;
+    return task;
+  }
+
+  // Own deque first, then the injection queue, then the other workers'
+  // deques from a random one on.
+  detail::task *find_work(detail::executor_worker *self) {
+    if (self != nullptr) {
+      if (detail::task *task = self->deque.pop())
+        return task;
+    }
+    if (detail::task *task = this->take_injected())
+      return task;
+    std::size_t count = this->workers.size();
+    if (count == 0)
+      return nullptr;
+    std::size_t start =
+        self != nullptr ? static_cast<std::size_t>(self->random() % count) : 0;
+    for (std::size_t i = 0; i != count; ++i) {
+      detail::executor_worker &victim = *this->workers[(start + i) % count];
+      if (&victim == self)
+        continue;
+      if (detail::task *task = victim.deque.steal())
+        return task;
+    }
+    return nullptr;
+  }
+
+  // Runs tasks until done() holds.
+  template <class Predicate> void help_until(Predicate done) {
+    detail::executor_worker *self = this->current();
+    int idle = 0;
+    while (!done()) {
+      if (detail::task *task = this->find_work(self)) {
+        task->execute(task);
+        idle = 0;
+      } else if (++idle < detail::idle_spin_limit) {
+        isl::internal::concurrency::cpu_relax();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void work(std::size_t index, bool pin) {
+    detail::current_worker = {this, index};
+    if (pin)
+      detail::pin_to_cpu(index);
+    detail::executor_worker *self = this->workers[index].get();
+    int idle = 0;
+    for (;;) {
+      if (detail::task *task = this->find_work(self)) {
+        task->execute(task);
+        idle = 0;
+        continue;
+      }
+      if (++idle < detail::idle_spin_limit) {
+        isl::internal::concurrency::cpu_relax();
+        continue;
+      }
+      idle = 0;
+
+      // Register as a sleeper before the last look for work, so that a
+      // task scheduled after that look sees us and bumps the epoch.
+      this->sleepers.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::uint32_t observed = this->epoch.load(std::memory_order_acquire);
+      detail::task *task = this->find_work(self);
+      bool stop = this->stopping.load(std::memory_order_acquire);
+      if (task == nullptr && !stop)
+        isl::internal::concurrency::futex_wait(this->epoch, observed);
+      this->sleepers.fetch_sub(1, std::memory_order_relaxed);
+      if (task != nullptr) {
+        task->execute(task);
+      } else if (stop) {
+        return;
+      }
+    }
+  }
+
+  template <class Function>
+  void split(std::size_t first, std::size_t last, std::size_t grain,
+             Function &fn) {
+    if (last - first <= grain) {
+      for (; first != last; ++first) {
+        fn(first);
+      }
+      return;
+    }
+    std::size_t middle = first + (last - first) / 2;
+    this->fork_join([&] { this->split(first, middle, grain, fn); },
+                    [&] { this->split(middle, last, grain, fn); });
+  }
+
+public:
+  executor() : executor(executor_options{}) {}
+  explicit executor(executor_options options) {
+    for (std::size_t i = 0; i != options.threads; ++i) {
+      std::uint64_t seed = 0x9E3779B97F4A7C15u * (i + 1);
+      this->workers.push_back(std::make_unique<detail::executor_worker>(seed));
+    }
+    // start the threads once every deque exists to steal from
+    for (std::size_t i = 0; i != options.threads; ++i) {
+      this->workers[i]->thread =
+          std::thread([this, i, pin = options.pin_threads] {
+            this->work(i, pin);
+          });
+    }
+  }
+  executor(const executor &) = delete;
+  executor &operator=(const executor &) = delete;
+  /// Waits for the submitted tasks, then stops the workers.
+  ~executor() {
+    this->wait();
+    this->stopping.store(true, std::memory_order_release);
+    this->epoch.fetch_add(1, std::memory_order_release);
+    isl::internal::concurrency::futex_wake_all(this->epoch);
+    for (std::unique_ptr<detail::executor_worker> &worker : this->workers) {
+      worker->thread.join();
+    }
+  }
+
+  /// The pool parallel algorithms run on: one worker fewer than the
+  /// hardware has threads, since the calling thread works too. Started
+  /// on first use.
+  static executor &global() {
+    static executor pool([] {
+      executor_options options;
+      options.threads = options.threads > 1 ? options.threads - 1 : 0;
+      return options;
+    }());
+    return pool;
+  }
+
+  /// Worker threads.
+  std::size_t size() const noexcept { return this->workers.size(); }
+
+  /// Runs `f` on the pool at some point. From a worker it goes to the
+  /// worker's own deque, from anywhere else to the injection queue. `f`
+  /// is moved into a recycled frame, so small callables cost no
+  /// allocation.
+  template <class Function>
+    requires std::invocable<std::decay_t<Function> &>
+  void submit(Function &&f) {
+    using task_type = detail::detached_task<std::decay_t<Function>>;
+    this->outstanding.fetch_add(1, std::memory_order_relaxed);
+    task_type *task;
+    try {
+      task = task_type::make(std::forward<Function>(f), &this->outstanding);
+    } catch (...) {
+      this->outstanding.fetch_sub(1, std::memory_order_relaxed);
+      throw;
+    }
+    this->schedule(task);
+  }
+
+  /// Runs submitted tasks until all of them, and those they submit, have
+  /// finished.
+  void wait() {
+    this->help_until([this] {
+      return this->outstanding.load(std::memory_order_acquire) == 0;
+    });
+  }
+
+  /// Runs `left` and `right`, possibly in parallel, and returns when both
+  /// have. `left` runs on the calling thread; `right` is offered to the
+  /// pool, and taken back by the caller if nobody stole it by the time
+  /// `left` is done. Neither is copied. An exception from `left`
+  /// propagates once `right` has finished.
+  template <class Left, class Right>
+    requires std::invocable<Left &> && std::invocable<Right &>
+  void fork_join(Left &&left, Right &&right) {
+    detail::join_task<std::remove_reference_t<Right>> task(right);
+    this->schedule(&task);
+    auto joined = [&task] {
+      return task.done.load(std::memory_order_acquire);
+    };
+    try {
+      left();
+    } catch (...) {
+      this->help_until(joined);
+      throw;
+    }
+    this->help_until(joined);
+  }
+
+  /// Calls fn(i) for every i in [first, last), splitting the range in
+  /// halves with fork_join down to pieces of `grain` indices. A grain of
+  /// zero picks one giving a few pieces per thread.
+  template <class Function>
+    requires std::invocable<Function &, std::size_t>
+  void parallel_for(std::size_t first, std::size_t last, Function fn,
+                    std::size_t grain = 0) {
+    if (first >= last)
+      return;
+    if (grain == 0) {
+      std::size_t pieces = (this->size() + 1) * 4;
+      grain = (last - first + pieces - 1) / pieces;
+    }
+    this->split(first, last, grain, fn);
+  }
+};
+} // namespace isl
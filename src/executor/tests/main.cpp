@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <array>     // std::array
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::size_t
+#include <stdexcept> // std::runtime_error
+#include <thread>    // std::this_thread::get_id
+#include <vector>    // std::vector
+
+#if defined(__linux__)
+#include <sched.h> // sched_getaffinity, CPU_COUNT
+#endif
+
+import executor;
+
+namespace {
+isl::executor_options with_threads(std::size_t threads, bool pin = false) {
+  isl::executor_options options;
+  options.threads = threads;
+  options.pin_threads = pin;
+  return options;
+}
+
+long fib(isl::executor &pool, int n) {
+  if (n < 2)
+    return n;
+  if (n < 12)
+    return fib(pool, n - 1) + fib(pool, n - 2);
+  long left = 0;
+  long right = 0;
+  pool.fork_join([&] { left = fib(pool, n - 1); },
+                 [&] { right = fib(pool, n - 2); });
+  return left + right;
+}
+} // namespace
+
+TEST(TestExecutor, TestSubmit) {
+  for (std::size_t threads : {0, 1, 4}) {
+    isl::executor pool(with_threads(threads));
+    ASSERT_EQ(pool.size(), threads);
+    std::atomic<int> runs{0};
+    for (int i = 0; i < 10000; ++i) {
+      pool.submit([&runs] { runs.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.wait();
+    ASSERT_EQ(runs.load(), 10000);
+  }
+}
+
+TEST(TestExecutor, TestSubmitFromTasks) {
+  isl::executor pool(with_threads(4));
+  std::atomic<int> runs{0};
+  for (int i = 0; i < 100; ++i) {
+    pool.submit([&pool, &runs] {
+      for (int j = 0; j < 100; ++j) {
+        pool.submit([&runs] { runs.fetch_add(1, std::memory_order_relaxed); });
+      }
+    });
+  }
+  pool.wait();
+  ASSERT_EQ(runs.load(), 100 * 100);
+}
+
+TEST(TestExecutor, TestLargeCallable) {
+  isl::executor pool(with_threads(2));
+  std::array<int, 100> values{};
+  values[99] = 7;
+  std::atomic<int> seen{0};
+  pool.submit([values, &seen] { seen = values[99]; });
+  pool.wait();
+  ASSERT_EQ(seen.load(), 7);
+}
+
+TEST(TestExecutor, TestDestructorDrains) {
+  std::atomic<int> runs{0};
+  {
+    isl::executor pool(with_threads(2));
+    for (int i = 0; i < 1000; ++i) {
+      pool.submit([&runs] { runs.fetch_add(1, std::memory_order_relaxed); });
+    }
+  }
+  ASSERT_EQ(runs.load(), 1000);
+}
+
+TEST(TestExecutor, TestForkJoin) {
+  for (std::size_t threads : {0, 4}) {
+    isl::executor pool(with_threads(threads));
+    ASSERT_EQ(fib(pool, 25), 75025);
+  }
+}
+
+TEST(TestExecutor, TestForkJoinException) {
+  isl::executor pool(with_threads(2));
+  bool right_ran = false;
+  ASSERT_THROW(pool.fork_join([] { throw std::runtime_error("left"); },
+                              [&right_ran] { right_ran = true; }),
+               std::runtime_error);
+  ASSERT_TRUE(right_ran);
+}
+
+TEST(TestExecutor, TestParallelFor) {
+  for (std::size_t threads : {0, 3}) {
+    isl::executor pool(with_threads(threads, true));
+    for (std::size_t grain : {0, 1, 7, 100000}) {
+      std::vector<std::atomic<int>> runs(10000);
+      pool.parallel_for(
+          0, runs.size(), [&runs](std::size_t i) { ++runs[i]; }, grain);
+      for (std::atomic<int> &count : runs) {
+        ASSERT_EQ(count.load(), 1);
+      }
+    }
+    int calls = 0;
+    pool.parallel_for(5, 5, [&calls](std::size_t) { ++calls; });
+    ASSERT_EQ(calls, 0);
+  }
+}
+
+TEST(TestExecutor, TestNestedParallelFor) {
+  isl::executor pool(with_threads(4));
+  std::atomic<std::size_t> total{0};
+  pool.parallel_for(0, 64, [&](std::size_t outer) {
+    pool.parallel_for(0, 64, [&](std::size_t inner) {
+      total.fetch_add(outer * 64 + inner, std::memory_order_relaxed);
+    });
+  });
+  ASSERT_EQ(total.load(), 4096u * 4095 / 2);
+}
+
+#if defined(__linux__)
+TEST(TestExecutor, TestPinnedWorkersStayInAffinityMask) {
+  cpu_set_t allowed;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  // more workers than CPUs, so the surplus wraps around
+  std::size_t threads = 2 * CPU_COUNT(&allowed) + 1;
+
+  isl::executor pool(with_threads(threads, true));
+  auto caller = std::this_thread::get_id();
+  std::atomic<int> unpinned{0};
+  pool.parallel_for(
+      0, 1000,
+      [&](std::size_t) {
+        // the waiting caller runs tasks too and is not pinned
+        if (std::this_thread::get_id() == caller) {
+          return;
+        }
+        cpu_set_t set;
+        sched_getaffinity(0, sizeof(set), &set);
+        cpu_set_t inside;
+        CPU_AND(&inside, &set, &allowed);
+        if (CPU_COUNT(&set) != 1 || !CPU_EQUAL(&inside, &set)) {
+          ++unpinned;
+        }
+      },
+      1);
+  ASSERT_EQ(unpinned.load(), 0);
+}
+#endif
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
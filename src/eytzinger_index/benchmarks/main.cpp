@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm> // std::lower_bound
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint32_t
+#include <random>    // std::mt19937_64
+#include <vector>    // std::vector
+
+import eytzinger_index;
+import vector;
+
+namespace {
+// A static table of every third price level and random lookups into it.
+isl::vector<std::uint32_t> price_levels(std::size_t n) {
+  isl::vector<std::uint32_t> levels;
+  for (std::size_t i = 0; i < n; ++i) {
+    levels.push_back(static_cast<std::uint32_t>(i * 3));
+  }
+  return levels;
+}
+
+std::vector<std::uint32_t> lookups(std::size_t n) {
+  std::mt19937_64 rng(48);
+  std::vector<std::uint32_t> keys(1 << 16);
+  for (std::uint32_t &key : keys) {
+    key = static_cast<std::uint32_t>(rng() % (n * 3));
+  }
+  return keys;
+}
+} // namespace
+
+static void BM_EytzingerLowerBound(benchmark::State &state) {
+  isl::eytzinger_index<std::uint32_t> index(price_levels(state.range(0)));
+  auto keys = lookups(state.range(0));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index.lower_bound(keys[i++ & 0xFFFF]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EytzingerLowerBound)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 24);
+
+static void BM_EytzingerBatchLowerBound(benchmark::State &state) {
+  isl::eytzinger_index<std::uint32_t> index(price_levels(state.range(0)));
+  auto keys = lookups(state.range(0));
+  std::vector<std::size_t> ranks(keys.size());
+  for (auto _ : state) {
+    index.lower_bound(keys.data(), keys.size(), ranks.data());
+    benchmark::DoNotOptimize(ranks.data());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_EytzingerBatchLowerBound)
+    ->Arg(1 << 10)
+    ->Arg(1 << 20)
+    ->Arg(1 << 24);
+
+static void BM_StdLowerBound(benchmark::State &state) {
+  auto levels = price_levels(state.range(0));
+  auto keys = lookups(state.range(0));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::lower_bound(levels.begin(), levels.end(),
+                                              keys[i++ & 0xFFFF]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdLowerBound)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 24);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,231 @@
+module;
+
+#include <bit>     // std::bit_floor, std::bit_width, std::countr_one
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uintptr_t
+#include <memory>  // std::allocator, std::allocator_traits
+#include <utility> // std::move
+
+#include "../internal/concurrency/cache_line.hpp"
+
+export module eytzinger_index;
+
+import functional;
+import vector;
+
+namespace isl::detail {
+// Keys the batched lookups search side by side. Their probes do not
+// depend on each other, so the cache misses of one level overlap instead
+// of queuing behind each other.
+inline constexpr std::size_t eytzinger_batch = 16;
+} // namespace isl::detail
+
+export namespace isl {
+/// Read-only index over a sorted sequence, for many lookups into a table
+/// that does not change.
+///
+/// The keys are stored in Eytzinger order, the breadth-first order of the
+/// implicit search tree with the children of node k at 2k and 2k + 1
+/// (Khuong and Morin, "Array Layouts for Comparison-Based Searching").
+/// The nodes every search visits first are packed at the front and stay
+/// cached, and a search descends without branching while it prefetches
+/// the cache line holding the node's descendants a few levels down.
+/// Lookups return ranks: positions in the sorted sequence the index was
+/// built from, with size() for none.
+template <class T, class Compare = isl::less<>,
+          class Allocator = std::allocator<T>>
+class eytzinger_index {
+public:
+  using value_type = T;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+private:
+  template <class U>
+  using rebind =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+  static constexpr std::size_t cache_line =
+      isl::internal::concurrency::cache_line_size;
+  // Nodes per cache line. Node 0 starts a line, so the descendants of
+  // node k log2(line_nodes) levels down share the line at k * line_nodes.
+  static constexpr std::size_t line_nodes =
+      sizeof(T) < cache_line ? std::bit_floor(cache_line / sizeof(T)) : 1;
+
+  // node k at storage[offset + k]; node 0 is unused padding
+  isl::vector<T, Allocator> storage;
+  std::size_t offset = 0;
+  // ranks[k] is the rank of node k
+  isl::vector<std::size_t, rebind<std::size_t>> ranks;
+  std::size_t count = 0;
+  [[no_unique_address]] Compare comp;
+
+  const T *nodes() const noexcept {
+    return this->storage.data() + this->offset;
+  }
+
+  // Sizes `storage` for count nodes plus padding, filled with `fill`, and
+  // picks the offset at which node 0 starts a cache line.
+  void allocate(const T &fill) {
+    this->storage.resize(this->count + 1 + line_nodes, fill);
+    auto address = reinterpret_cast<std::uintptr_t>(this->storage.data());
+    std::size_t misalignment = address % cache_line;
+    this->offset = misalignment % sizeof(T) == 0
+                       ? (cache_line - misalignment) % cache_line / sizeof(T)
+                       : 0;
+  }
+
+  // In-order walk of the implicit tree under node k, handing out the
+  // sorted keys from sorted[next] on.
+  void place(const T *sorted, std::size_t &next, std::size_t k) {
+    if (k > this->count)
+      return;
+    this->place(sorted, next, 2 * k);
+    this->storage[this->offset + k] = sorted[next];
+    this->ranks[k] = next++;
+    this->place(sorted, next, 2 * k + 1);
+  }
+
+  // A search goes right at every node for which goes_right holds. The
+  // node it ends on is the last one where it went left: the path is the
+  // bits of k, so stripping the trailing right turns and then that left
+  // turn leaves it, or 0 if the search never went left.
+  std::size_t rank_of(std::size_t k) const noexcept {
+    k >>= std::countr_one(k) + 1;
+    return k == 0 ? this->count : this->ranks[k];
+  }
+
+  template <class GoesRight>
+  std::size_t descend(const T &key, GoesRight goes_right) const {
+    const T *nodes = this->nodes();
+    std::size_t k = 1;
+    while (k <= this->count) {
+      __builtin_prefetch(nodes + k * line_nodes);
+      k = 2 * k + (goes_right(nodes[k], key) ? 1 : 0);
+    }
+    return k;
+  }
+
+  // Every search takes the same number of steps, one per level, so a
+  // batch of them steps through the levels together. Only the last level
+  // may be partly missing; a missing node counts as a right turn, which
+  // rank_of strips anyway.
+  template <class GoesRight>
+  void descend(const T *keys, std::size_t n, std::size_t *out,
+               GoesRight goes_right) const {
+    const T *nodes = this->nodes();
+    int full_levels = static_cast<int>(std::bit_width(this->count)) - 1;
+    for (std::size_t first = 0; first < n; first += detail::eytzinger_batch) {
+      std::size_t batch = n - first < detail::eytzinger_batch
+                              ? n - first
+                              : detail::eytzinger_batch;
+      const T *batch_keys = keys + first;
+      std::size_t k[detail::eytzinger_batch];
+      for (std::size_t i = 0; i != batch; ++i) {
+        k[i] = 1;
+      }
+      for (int level = 0; level != full_levels; ++level) {
+        for (std::size_t i = 0; i != batch; ++i) {
+          __builtin_prefetch(nodes + k[i] * line_nodes);
+          k[i] = 2 * k[i] + (goes_right(nodes[k[i]], batch_keys[i]) ? 1 : 0);
+        }
+      }
+      for (std::size_t i = 0; i != batch; ++i) {
+        bool right = k[i] > this->count ||
+                     goes_right(nodes[k[i]], batch_keys[i]);
+        out[first + i] = this->rank_of(2 * k[i] + (right ? 1 : 0));
+      }
+    }
+  }
+
+  struct before_key {
+    const Compare &comp;
+    bool operator()(const T &node, const T &key) const {
+      return this->comp(node, key);
+    }
+  };
+  struct not_after_key {
+    const Compare &comp;
+    bool operator()(const T &node, const T &key) const {
+      return !this->comp(key, node);
+    }
+  };
+
+public:
+  eytzinger_index() = default;
+  /// `sorted` must be sorted by `comp`.
+  template <class SortedAllocator>
+  explicit eytzinger_index(const vector<T, SortedAllocator> &sorted,
+                           Compare comp = Compare(),
+                           const Allocator &alloc = Allocator())
+      : storage(alloc), ranks(rebind<std::size_t>(alloc)),
+        count(sorted.size()), comp(std::move(comp)) {
+    if (this->count == 0)
+      return;
+    this->allocate(sorted[0]);
+    this->ranks.resize(this->count + 1, 0);
+    std::size_t next = 0;
+    this->place(sorted.data(), next, 1);
+  }
+  eytzinger_index(const eytzinger_index &other)
+      : storage(other.storage.get_allocator()), ranks(other.ranks),
+        count(other.count), comp(other.comp) {
+    if (this->count == 0)
+      return;
+    // the copy's storage has an alignment of its own
+    const T *nodes = other.nodes();
+    this->allocate(nodes[0]);
+    for (std::size_t k = 1; k <= this->count; ++k) {
+      this->storage[this->offset + k] = nodes[k];
+    }
+  }
+  eytzinger_index(eytzinger_index &&) noexcept = default;
+  eytzinger_index &operator=(const eytzinger_index &other) {
+    if (this != &other)
+      *this = eytzinger_index(other);
+    return *this;
+  }
+  eytzinger_index &operator=(eytzinger_index &&) noexcept = default;
+
+  size_type size() const noexcept { return this->count; }
+  [[nodiscard]] bool empty() const noexcept { return this->count == 0; }
+  key_compare key_comp() const { return this->comp; }
+
+  /// Rank of the first key not less than `key`.
+  size_type lower_bound(const T &key) const {
+    return this->rank_of(this->descend(key, before_key{this->comp}));
+  }
+  /// Rank of the first key greater than `key`.
+  size_type upper_bound(const T &key) const {
+    return this->rank_of(this->descend(key, not_after_key{this->comp}));
+  }
+  bool contains(const T &key) const {
+    std::size_t k = this->descend(key, before_key{this->comp});
+    k >>= std::countr_one(k) + 1;
+    return k != 0 && !this->comp(key, this->nodes()[k]);
+  }
+
+  /// out[i] = lower_bound(keys[i]) for i in [0, n), with the searches of
+  /// consecutive keys interleaved.
+  void lower_bound(const T *keys, size_type n, size_type *out) const {
+    if (this->count == 0) {
+      for (std::size_t i = 0; i != n; ++i) {
+        out[i] = 0;
+      }
+      return;
+    }
+    this->descend(keys, n, out, before_key{this->comp});
+  }
+  /// out[i] = upper_bound(keys[i]) for i in [0, n).
+  void upper_bound(const T *keys, size_type n, size_type *out) const {
+    if (this->count == 0) {
+      for (std::size_t i = 0; i != n; ++i) {
+        out[i] = 0;
+      }
+      return;
+    }
+    this->descend(keys, n, out, not_after_key{this->comp});
+  }
+};
+} // namespace isl
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <algorithm> // std::sort, std::lower_bound, std::upper_bound
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::int64_t
+#include <random>    // std::mt19937_64
+#include <string>    // std::string, std::to_string
+#include <vector>    // std::vector
+
+import eytzinger_index;
+import functional;
+import vector;
+
+namespace {
+template <class T>
+void check_against_sorted(const isl::vector<T> &sorted,
+                          const std::vector<T> &keys) {
+  isl::eytzinger_index<T> index(sorted);
+  ASSERT_EQ(index.size(), sorted.size());
+  const T *first = sorted.data();
+  const T *last = first + sorted.size();
+
+  std::vector<std::size_t> lower(keys.size());
+  std::vector<std::size_t> upper(keys.size());
+  index.lower_bound(keys.data(), keys.size(), lower.data());
+  index.upper_bound(keys.data(), keys.size(), upper.data());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    std::size_t expected_lower = std::lower_bound(first, last, keys[i]) - first;
+    std::size_t expected_upper = std::upper_bound(first, last, keys[i]) - first;
+    ASSERT_EQ(index.lower_bound(keys[i]), expected_lower);
+    ASSERT_EQ(index.upper_bound(keys[i]), expected_upper);
+    ASSERT_EQ(lower[i], expected_lower);
+    ASSERT_EQ(upper[i], expected_upper);
+    ASSERT_EQ(index.contains(keys[i]), expected_lower != expected_upper);
+  }
+}
+} // namespace
+
+TEST(TestEytzingerIndex, TestEverySize) {
+  std::mt19937_64 rng(48);
+  for (std::size_t n = 0; n <= 130; ++n) {
+    isl::vector<std::int64_t> sorted;
+    for (std::size_t i = 0; i < n; ++i) {
+      sorted.push_back(static_cast<std::int64_t>(rng() % (2 * n + 1)));
+    }
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<std::int64_t> keys;
+    for (std::int64_t key = -1; key <= static_cast<std::int64_t>(2 * n + 1);
+         ++key) {
+      keys.push_back(key);
+    }
+    check_against_sorted(sorted, keys);
+  }
+}
+
+TEST(TestEytzingerIndex, TestLarge) {
+  std::mt19937_64 rng(48);
+  isl::vector<double> sorted;
+  for (int i = 0; i < 100000; ++i) {
+    sorted.push_back(static_cast<double>(rng() % 1000000) / 100);
+  }
+  std::sort(sorted.begin(), sorted.end());
+  std::vector<double> keys(20001);
+  for (double &key : keys) {
+    key = static_cast<double>(rng() % 1000100) / 100 - 0.5;
+  }
+  check_against_sorted(sorted, keys);
+}
+
+TEST(TestEytzingerIndex, TestComparatorAndCopy) {
+  isl::vector<std::string> sorted;
+  for (int i = 0; i < 50; ++i) {
+    sorted.push_back(std::to_string(9000 - i * 7));
+  }
+  isl::eytzinger_index<std::string, isl::greater<>> index(sorted);
+  auto copy = index;
+  isl::eytzinger_index<std::string, isl::greater<>> moved(std::move(index));
+  for (int i = 0; i < 50; ++i) {
+    std::string key = std::to_string(9000 - i * 7);
+    ASSERT_EQ(copy.lower_bound(key), static_cast<std::size_t>(i));
+    ASSERT_EQ(moved.upper_bound(key), static_cast<std::size_t>(i + 1));
+    ASSERT_TRUE(copy.contains(key));
+  }
+  ASSERT_FALSE(copy.contains("999"));
+  ASSERT_EQ(copy.lower_bound("0"), 50u);
+  ASSERT_EQ(copy.lower_bound("9999"), 0u);
+}
+
+TEST(TestEytzingerIndex, TestEmpty) {
+  isl::eytzinger_index<int> index(isl::vector<int>{});
+  ASSERT_TRUE(index.empty());
+  ASSERT_EQ(index.lower_bound(5), 0u);
+  ASSERT_FALSE(index.contains(5));
+  int keys[] = {1, 2};
+  std::size_t out[] = {9, 9};
+  index.lower_bound(keys, 2, out);
+  ASSERT_EQ(out[0], 0u);
+  ASSERT_EQ(out[1], 0u);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>  // std::snprintf
+#include <sstream> // std::ostringstream
+
+import format;
+import vector;
+
+// A typical structured log line: integers, a float and a string.
+
+static void BM_IslFormatTo(benchmark::State &state) {
+  isl::vector<char> out;
+  int i = 0;
+  for (auto _ : state) {
+    out.clear();
+    isl::format_to(out, "request id={} status={} latency={:.3f}ms path={}",
+                   i++, 200, 12.3456, "/index.html");
+    benchmark::DoNotOptimize(out.data());
+  }
+}
+BENCHMARK(BM_IslFormatTo);
+
+static void BM_IslFormatToN(benchmark::State &state) {
+  char buffer[128];
+  int i = 0;
+  for (auto _ : state) {
+    auto result = isl::format_to_n(
+        buffer, sizeof(buffer),
+        "request id={} status={} latency={}ms path={}", i++, 200, 12.3456,
+        "/index.html");
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_IslFormatToN);
+
+static void BM_Snprintf(benchmark::State &state) {
+  char buffer[128];
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::snprintf(
+        buffer, sizeof(buffer),
+        "request id=%d status=%d latency=%.3fms path=%s", i++, 200, 12.3456,
+        "/index.html"));
+  }
+}
+BENCHMARK(BM_Snprintf);
+
+static void BM_Ostringstream(benchmark::State &state) {
+  int i = 0;
+  for (auto _ : state) {
+    std::ostringstream out;
+    out.precision(3);
+    out << "request id=" << i++ << " status=" << 200
+        << " latency=" << std::fixed << 12.3456 << "ms path=" << "/index.html";
+    benchmark::DoNotOptimize(out.str());
+  }
+}
+BENCHMARK(BM_Ostringstream);
+
+static void BM_IslFormatIntegers(benchmark::State &state) {
+  isl::vector<char> out;
+  unsigned i = 0;
+  for (auto _ : state) {
+    out.clear();
+    isl::format_to(out, "{} {} {} {}", i, i * 7, i * 131, i * 65537);
+    ++i;
+    benchmark::DoNotOptimize(out.data());
+  }
+}
+BENCHMARK(BM_IslFormatIntegers);
+
+static void BM_SnprintfIntegers(benchmark::State &state) {
+  char buffer[64];
+  unsigned i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::snprintf(buffer, sizeof(buffer),
+                                           "%u %u %u %u", i, i * 7, i * 131,
+                                           i * 65537));
+    ++i;
+  }
+}
+BENCHMARK(BM_SnprintfIntegers);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,822 @@
+module;
+
+#include <algorithm>   // std::min
+#include <array>       // std::array
+#include <concepts>    // std::integral, std::same_as
+#include <cstddef>     // std::size_t, std::nullptr_t
+#include <cstdint>     // std::uintptr_t
+#include <cstdio>      // std::snprintf
+#include <cstring>     // std::memcpy, std::memset, std::strlen
+#include <memory>      // std::allocator
+#include <stdexcept>   // std::runtime_error
+#include <type_traits> // std::decay_t, std::make_unsigned_t
+
+export module format;
+
+import charconv;
+import string;
+import string_view;
+import vector;
+
+export namespace isl {
+/// Malformed format string. Format strings are checked while compiling, so
+/// in practice this surfaces as a compile error naming the throw.
+class format_error : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+/// Output of isl::format_to: a window of chars that is flushed or enlarged
+/// when full. Formatters write through push_back and append only, so the
+/// same code serves growable and fixed destinations.
+class format_buffer {
+protected:
+  char *data_;
+  std::size_t size_{0};
+  std::size_t capacity_;
+  // Called with the window full; leaves room for at least one more char.
+  void (*grow_)(format_buffer &);
+
+  format_buffer(void (*grow)(format_buffer &), char *data,
+                std::size_t capacity) noexcept
+      : data_(data), capacity_(capacity), grow_(grow) {}
+  ~format_buffer() = default;
+
+public:
+  format_buffer(const format_buffer &) = delete;
+  format_buffer &operator=(const format_buffer &) = delete;
+
+  void push_back(char ch) {
+    if (this->size_ == this->capacity_) {
+      this->grow_(*this);
+    }
+    this->data_[this->size_++] = ch;
+  }
+
+  void append(const char *s, std::size_t count) {
+    while (count != 0) {
+      if (this->size_ == this->capacity_) {
+        this->grow_(*this);
+      }
+      std::size_t chunk = std::min(count, this->capacity_ - this->size_);
+      std::memcpy(this->data_ + this->size_, s, chunk);
+      this->size_ += chunk;
+      s += chunk;
+      count -= chunk;
+    }
+  }
+  void append(string_view sv) { this->append(sv.data(), sv.size()); }
+
+  /// Calls `write(out)`, which writes at most `MaxSize` chars to `out` and
+  /// returns their end, straight into the window when there is room.
+  template <std::size_t MaxSize, class Write> void write_bounded(Write write) {
+    if (this->capacity_ - this->size_ >= MaxSize) {
+      char *out = this->data_ + this->size_;
+      this->size_ += write(out) - out;
+      return;
+    }
+    char buffer[MaxSize];
+    this->append(buffer, write(buffer) - buffer);
+  }
+
+  void append(std::size_t count, char ch) {
+    while (count != 0) {
+      if (this->size_ == this->capacity_) {
+        this->grow_(*this);
+      }
+      std::size_t chunk = std::min(count, this->capacity_ - this->size_);
+      std::memset(this->data_ + this->size_, ch, chunk);
+      this->size_ += chunk;
+      count -= chunk;
+    }
+  }
+};
+
+/// Standard format specification,
+/// [[fill]align][sign][#][0][width][.precision][type].
+struct format_spec {
+  char fill = ' ';
+  char align = 0; // '<', '>', '^', or 0 for the type's default
+  char sign = 0;  // '+', '-', ' ', or 0 if not given
+  bool alternate = false;
+  bool zero_pad = false;
+  int width = 0;
+  int precision = -1;
+  char type = 0;
+
+  /// Parses as much of [first, last) as forms a specification and returns
+  /// where it stopped.
+  constexpr const char *parse(const char *first, const char *last) {
+    auto is_align = [](char c) { return c == '<' || c == '>' || c == '^'; };
+    auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    auto parse_int = [&](const char *&p) {
+      int value = 0;
+      for (; p != last && is_digit(*p); ++p) {
+        if (value > 100000) {
+          throw format_error{"number too large in format specification"};
+        }
+        value = value * 10 + (*p - '0');
+      }
+      return value;
+    };
+
+    if (last - first >= 2 && is_align(first[1])) {
+      this->fill = first[0];
+      this->align = first[1];
+      first += 2;
+    } else if (first != last && is_align(*first)) {
+      this->align = *first++;
+    }
+    if (first != last && (*first == '+' || *first == '-' || *first == ' ')) {
+      this->sign = *first++;
+    }
+    if (first != last && *first == '#') {
+      this->alternate = true;
+      ++first;
+    }
+    if (first != last && *first == '0') {
+      this->zero_pad = true;
+      ++first;
+    }
+    this->width = parse_int(first);
+    if (first != last && *first == '.') {
+      ++first;
+      if (first == last || !is_digit(*first)) {
+        throw format_error{"missing precision in format specification"};
+      }
+      this->precision = parse_int(first);
+    }
+    if (first != last && ((*first >= 'a' && *first <= 'z') ||
+                          (*first >= 'A' && *first <= 'Z'))) {
+      this->type = *first++;
+    }
+    return first;
+  }
+};
+
+/// How values of T are formatted. Specializations provide
+///
+///   constexpr const char *parse(const char *first, const char *last);
+///   void format(const T &value, format_buffer &out) const;
+///
+/// where parse reads the specification after the ':' of a placeholder,
+/// throws format_error if it is invalid and returns where it stopped. It
+/// must be constexpr, as format strings are checked while compiling. A
+/// formatter whose only member is a `format_spec spec` is handed the spec
+/// parsed by that check; others parse again when formatting.
+template <class T> struct formatter {
+  formatter() = delete;
+};
+} // namespace isl
+
+namespace isl::detail {
+constexpr void require(bool condition, const char *message) {
+  if (!condition) {
+    throw format_error{message};
+  }
+}
+
+constexpr bool is_integer_type(char type) {
+  return type == 'd' || type == 'b' || type == 'B' || type == 'o' ||
+         type == 'x' || type == 'X';
+}
+
+constexpr void require_no_numeric_flags(const format_spec &spec) {
+  require(spec.sign == 0 && !spec.alternate && !spec.zero_pad,
+          "sign, '#' and '0' only apply to numbers");
+}
+
+/// Writes `text`, padded to the spec's width with its fill and alignment;
+/// `default_align` applies when the spec has none.
+inline void write_padded(format_buffer &out, const format_spec &spec,
+                         const char *text, std::size_t size,
+                         char default_align) {
+  auto width = static_cast<std::size_t>(spec.width);
+  if (width <= size) {
+    out.append(text, size);
+    return;
+  }
+  std::size_t padding = width - size;
+  char align = spec.align ? spec.align : default_align;
+  std::size_t before =
+      align == '<' ? 0 : (align == '^' ? padding / 2 : padding);
+  out.append(before, spec.fill);
+  out.append(text, size);
+  out.append(padding - before, spec.fill);
+}
+
+/// Writes a number whose sign and base prefix are the first `prefix_size`
+/// chars of `text`. The '0' flag pads between the prefix and the digits.
+inline void write_number(format_buffer &out, const format_spec &spec,
+                         const char *text, std::size_t size,
+                         std::size_t prefix_size) {
+  auto width = static_cast<std::size_t>(spec.width);
+  if (spec.zero_pad && !spec.align && width > size) {
+    out.append(text, prefix_size);
+    out.append(width - size, '0');
+    out.append(text + prefix_size, size - prefix_size);
+    return;
+  }
+  write_padded(out, spec, text, size, '>');
+}
+
+constexpr void check_integer_spec(const format_spec &spec) {
+  require(spec.type == 0 || is_integer_type(spec.type),
+          "invalid type for an integer");
+  require(spec.precision < 0, "precision is not allowed for integers");
+}
+
+template <class T>
+void format_integer(format_buffer &out, const format_spec &spec, T value) {
+  using unsigned_type = std::make_unsigned_t<T>;
+  auto magnitude = static_cast<unsigned_type>(value);
+  bool negative = false;
+  if constexpr (std::is_signed_v<T>) {
+    if (value < 0) {
+      negative = true;
+      magnitude = static_cast<unsigned_type>(0 - magnitude);
+    }
+  }
+
+  // sign, two prefix chars and up to 64 binary digits
+  char buffer[67];
+  char *p = buffer;
+  if (negative) {
+    *p++ = '-';
+  } else if (spec.sign == '+' || spec.sign == ' ') {
+    *p++ = spec.sign;
+  }
+
+  int base = 10;
+  switch (spec.type) {
+  case 'b':
+  case 'B':
+    base = 2;
+    break;
+  case 'o':
+    base = 8;
+    break;
+  case 'x':
+  case 'X':
+    base = 16;
+    break;
+  }
+  if (spec.alternate && base != 10) {
+    *p++ = '0';
+    if (base != 8) {
+      *p++ = spec.type;
+    }
+  }
+  std::size_t prefix_size = p - buffer;
+  char *end = to_chars(p, buffer + sizeof(buffer), magnitude, base).ptr;
+  if (spec.alternate && base == 8 && magnitude == 0) {
+    // "0" already reads as octal
+    end -= 1;
+  }
+  if (spec.type == 'X') {
+    for (; p != end; ++p) {
+      *p = *p >= 'a' ? static_cast<char>(*p - 'a' + 'A') : *p;
+    }
+  }
+  write_number(out, spec, buffer, end - buffer, prefix_size);
+}
+
+/// Floats with a precision or a notation go through snprintf; the rest
+/// take the shortest round-trip form from isl::to_chars.
+template <class T>
+void format_float(format_buffer &out, const format_spec &spec, T value) {
+  char buffer[128];
+  char *text = buffer;
+  std::size_t size;
+  vector<char> large;
+
+  if (spec.precision < 0 && spec.type == 0) {
+    char *p = buffer;
+    if (spec.sign == '+' || spec.sign == ' ') {
+      *p++ = spec.sign;
+    }
+    char *end = to_chars(p, buffer + sizeof(buffer), value).ptr;
+    if (*p == '-' && p != buffer) {
+      // negative after all, drop the sign placeholder
+      text += 1;
+    }
+    size = end - text;
+  } else {
+    // "%" flags ".*" type
+    char conversion[8];
+    char *c = conversion;
+    *c++ = '%';
+    if (spec.sign == '+' || spec.sign == ' ') {
+      *c++ = spec.sign;
+    }
+    if (spec.alternate) {
+      *c++ = '#';
+    }
+    *c++ = '.';
+    *c++ = '*';
+    *c++ = spec.type ? spec.type : 'g';
+    *c = '\0';
+
+    int precision = spec.precision < 0 ? 6 : spec.precision;
+    double argument = value;
+    int length = std::snprintf(buffer, sizeof(buffer), conversion,
+                               precision, argument);
+    size = static_cast<std::size_t>(length);
+    if (size >= sizeof(buffer)) {
+      large.resize(size + 1);
+      std::snprintf(large.data(), size + 1, conversion, precision, argument);
+      text = large.data();
+    }
+  }
+
+  std::size_t prefix_size =
+      size != 0 && (*text == '-' || *text == '+' || *text == ' ');
+  bool finite = value - value == 0;
+  if (finite) {
+    write_number(out, spec, text, size, prefix_size);
+  } else {
+    // the '0' flag does not pad inf and nan
+    format_spec padded = spec;
+    padded.zero_pad = false;
+    write_number(out, padded, text, size, prefix_size);
+  }
+}
+} // namespace isl::detail
+
+export namespace isl {
+// Integers: d (default), b, B, o, x, X, with sign, '#' and '0' flags.
+template <std::integral T> struct formatter<T> {
+  format_spec spec;
+
+  constexpr const char *parse(const char *first, const char *last) {
+    first = this->spec.parse(first, last);
+    detail::check_integer_spec(this->spec);
+    return first;
+  }
+  void format(T value, format_buffer &out) const {
+    if (this->spec.type == 0 && this->spec.width == 0 &&
+        this->spec.sign == 0) {
+      out.write_bounded<20>([value](char *first) {
+        return to_chars(first, first + 20, value).ptr;
+      });
+      return;
+    }
+    detail::format_integer(out, this->spec, value);
+  }
+};
+
+// bool: "true" or "false" (s, the default) or an integer type.
+template <> struct formatter<bool> {
+  format_spec spec;
+
+  constexpr const char *parse(const char *first, const char *last) {
+    first = this->spec.parse(first, last);
+    if (this->spec.type == 0 || this->spec.type == 's') {
+      detail::require_no_numeric_flags(this->spec);
+      detail::require(this->spec.precision < 0,
+                      "precision is not allowed for bool");
+    } else {
+      detail::check_integer_spec(this->spec);
+    }
+    return first;
+  }
+  void format(bool value, format_buffer &out) const {
+    if (this->spec.type == 0 || this->spec.type == 's') {
+      detail::write_padded(out, this->spec, value ? "true" : "false",
+                           value ? 4 : 5, '<');
+      return;
+    }
+    detail::format_integer(out, this->spec, static_cast<unsigned>(value));
+  }
+};
+
+// char: the character (c, the default) or an integer type.
+template <> struct formatter<char> {
+  format_spec spec;
+
+  constexpr const char *parse(const char *first, const char *last) {
+    first = this->spec.parse(first, last);
+    if (this->spec.type == 0 || this->spec.type == 'c') {
+      detail::require_no_numeric_flags(this->spec);
+      detail::require(this->spec.precision < 0,
+                      "precision is not allowed for char");
+    } else {
+      detail::check_integer_spec(this->spec);
+    }
+    return first;
+  }
+  void format(char value, format_buffer &out) const {
+    if (this->spec.type == 0 || this->spec.type == 'c') {
+      detail::write_padded(out, this->spec, &value, 1, '<');
+      return;
+    }
+    detail::format_integer(out, this->spec,
+                           static_cast<unsigned char>(value));
+  }
+};
+
+// Floating point: shortest round-trip by default; e, E, f, F, g, G or a
+// precision select printf's notations.
+template <class T>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+struct formatter<T> {
+  format_spec spec;
+
+  constexpr const char *parse(const char *first, const char *last) {
+    first = this->spec.parse(first, last);
+    char type = this->spec.type;
+    detail::require(type == 0 || type == 'e' || type == 'E' || type == 'f' ||
+                        type == 'F' || type == 'g' || type == 'G',
+                    "invalid type for a floating-point number");
+    return first;
+  }
+  void format(T value, format_buffer &out) const {
+    detail::format_float(out, this->spec, value);
+  }
+};
+
+// Strings: s, with precision as the maximum length.
+template <> struct formatter<string_view> {
+  format_spec spec;
+
+  constexpr const char *parse(const char *first, const char *last) {
+    first = this->spec.parse(first, last);
+    detail::require(this->spec.type == 0 || this->spec.type == 's',
+                    "invalid type for a string");
+    detail::require_no_numeric_flags(this->spec);
+    return first;
+  }
+  void format(string_view value, format_buffer &out) const {
+    std::size_t size = value.size();
+    if (this->spec.precision >= 0) {
+      size = std::min(size, static_cast<std::size_t>(this->spec.precision));
+    }
+    if (this->spec.width == 0) {
+      out.append(value.data(), size);
+      return;
+    }
+    detail::write_padded(out, this->spec, value.data(), size, '<');
+  }
+};
+
+template <> struct formatter<const char *> : formatter<string_view> {
+  void format(const char *value, format_buffer &out) const {
+    formatter<string_view>::format(string_view(value), out);
+  }
+};
+template <> struct formatter<char *> : formatter<const char *> {};
+
+template <class Allocator>
+struct formatter<basic_string<char, Allocator>> : formatter<string_view> {};
+
+// Pointers: 0x followed by the address in hex (p, the default).
+template <> struct formatter<const void *> {
+  format_spec spec;
+
+  constexpr const char *parse(const char *first, const char *last) {
+    first = this->spec.parse(first, last);
+    detail::require(this->spec.type == 0 || this->spec.type == 'p',
+                    "invalid type for a pointer");
+    detail::require_no_numeric_flags(this->spec);
+    detail::require(this->spec.precision < 0,
+                    "precision is not allowed for pointers");
+    return first;
+  }
+  void format(const void *value, format_buffer &out) const {
+    format_spec hex = this->spec;
+    hex.type = 'x';
+    hex.alternate = true;
+    detail::format_integer(out, hex, reinterpret_cast<std::uintptr_t>(value));
+  }
+};
+template <> struct formatter<void *> : formatter<const void *> {};
+template <> struct formatter<std::nullptr_t> : formatter<const void *> {};
+} // namespace isl
+
+namespace isl::detail {
+// Formatters whose whole parsed state is a format_spec.
+template <class T>
+concept spec_formatter = requires(formatter<T> &f) {
+  { f.spec } -> std::same_as<format_spec &>;
+} && sizeof(formatter<T>) == sizeof(format_spec);
+
+// Type-erased argument: a pointer to the value and the function that
+// formats it, so the format string is walked by a single non-template
+// function whatever the argument types.
+struct format_arg {
+  const void *value;
+  void (*format)(const void *value, const format_spec *spec,
+                 const char *spec_first, const char *spec_last,
+                 format_buffer &out);
+};
+
+// `spec` is the placeholder's specification parsed while checking the
+// format string, or nullptr if it was not kept.
+template <class T>
+void format_erased(const void *value, const format_spec *spec,
+                   const char *spec_first, const char *spec_last,
+                   format_buffer &out) {
+  using type = std::decay_t<T>;
+  formatter<type> f;
+  if (spec_first != spec_last) {
+    if constexpr (spec_formatter<type>) {
+      if (spec != nullptr) {
+        f.spec = *spec;
+      } else {
+        f.parse(spec_first, spec_last);
+      }
+    } else {
+      f.parse(spec_first, spec_last);
+    }
+  }
+  f.format(*static_cast<const T *>(value), out);
+}
+
+template <class T> format_arg make_format_arg(const T &value) noexcept {
+  return {&value, &format_erased<T>};
+}
+
+constexpr bool is_ascii_digit(char c) { return c >= '0' && c <= '9'; }
+
+template <class T>
+constexpr format_spec check_spec(const char *first, const char *last) {
+  formatter<T> f;
+  require(f.parse(first, last) == last, "invalid format specification");
+  if constexpr (spec_formatter<T>) {
+    return f.spec;
+  } else {
+    return format_spec{};
+  }
+}
+
+template <class... Args>
+constexpr format_spec check_spec(std::size_t index,
+                                 [[maybe_unused]] const char *first,
+                                 [[maybe_unused]] const char *last) {
+  format_spec spec;
+  std::size_t i = 0;
+  ((i++ == index ? void(spec = check_spec<std::decay_t<Args>>(first, last))
+                 : void()),
+   ...);
+  return spec;
+}
+
+/// Checks the grammar of a format string, that every placeholder refers to
+/// an argument, that every argument is used and that each specification
+/// suits its argument's type. The parsed specifications of the first
+/// sizeof...(Args) placeholders are stored to `specs`.
+template <class... Args>
+constexpr void check_format_string(const char *p, const char *end,
+                                   format_spec *specs) {
+  constexpr std::size_t count = sizeof...(Args);
+  bool used[count + 1] = {};
+  std::size_t next = 0;
+  std::size_t placeholder = 0;
+  bool automatic = false;
+  bool manual = false;
+
+  while (p != end) {
+    char c = *p++;
+    if (c == '}') {
+      require(p != end && *p == '}', "unmatched '}' in format string");
+      ++p;
+      continue;
+    }
+    if (c != '{') {
+      continue;
+    }
+    if (p != end && *p == '{') {
+      ++p;
+      continue;
+    }
+
+    std::size_t index;
+    if (p != end && is_ascii_digit(*p)) {
+      index = 0;
+      for (; p != end && is_ascii_digit(*p); ++p) {
+        index = index * 10 + (*p - '0');
+        require(index <= count, "argument index out of range");
+      }
+      manual = true;
+    } else {
+      index = next++;
+      automatic = true;
+    }
+    require(!(automatic && manual),
+            "cannot mix automatic and manual argument indexing");
+    require(index < count, "format string refers to a missing argument");
+    used[index] = true;
+
+    const char *spec = p;
+    if (p != end && *p == ':') {
+      spec = ++p;
+    }
+    while (p != end && *p != '}' && *p != '{') {
+      ++p;
+    }
+    require(p != end && *p == '}', "unmatched '{' in format string");
+    format_spec parsed = check_spec<Args...>(index, spec, p);
+    if (placeholder < count) {
+      specs[placeholder] = parsed;
+    }
+    ++placeholder;
+    ++p;
+  }
+
+  for (std::size_t i = 0; i != count; ++i) {
+    require(used[i], "argument not used by the format string");
+  }
+}
+
+/// Formats `text`, already checked, with `args`; `specs` holds the parsed
+/// specifications of its first `spec_count` placeholders.
+inline void vformat_to(format_buffer &out, string_view text,
+                       const format_arg *args, const format_spec *specs,
+                       std::size_t spec_count) {
+  const char *p = text.data();
+  const char *end = p + text.size();
+  std::size_t next = 0;
+  std::size_t placeholder = 0;
+
+  while (p != end) {
+    // literal runs are short, a plain loop beats a vector search here
+    const char *brace = p;
+    while (brace != end && *brace != '{' && *brace != '}') {
+      ++brace;
+    }
+    out.append(p, brace - p);
+    p = brace;
+    if (p == end) {
+      return;
+    }
+    if (*p == '}' || p[1] == '{') {
+      // "}}" or "{{"
+      out.push_back(*p);
+      p += 2;
+      continue;
+    }
+
+    ++p;
+    std::size_t index;
+    if (is_ascii_digit(*p)) {
+      index = 0;
+      for (; is_ascii_digit(*p); ++p) {
+        index = index * 10 + (*p - '0');
+      }
+    } else {
+      index = next++;
+    }
+    const char *spec = *p == ':' ? p + 1 : p;
+    const char *close = spec;
+    while (*close != '}') {
+      ++close;
+    }
+    const format_spec *parsed =
+        placeholder < spec_count ? specs + placeholder : nullptr;
+    ++placeholder;
+    args[index].format(args[index].value, parsed, spec, close, out);
+    p = close + 1;
+  }
+}
+
+/// Collects output in a stack buffer, appending it to `container` when full
+/// and on finish().
+template <class Container> class appending_buffer final : public format_buffer {
+  Container &container;
+  char scratch[256];
+
+  static void flush(format_buffer &self) {
+    auto &buffer = static_cast<appending_buffer &>(self);
+    const char *first = buffer.scratch;
+    if constexpr (requires { buffer.container.append(first, std::size_t{}); }) {
+      buffer.container.append(first, buffer.size_);
+    } else {
+      buffer.container.insert(buffer.container.end(), first,
+                              first + buffer.size_);
+    }
+    buffer.size_ = 0;
+  }
+
+public:
+  explicit appending_buffer(Container &container) noexcept
+      : format_buffer(&flush, this->scratch, sizeof(this->scratch)),
+        container(container) {}
+
+  void finish() { flush(*this); }
+};
+
+/// Writes into [first, first + limit) and counts, without storing, what
+/// does not fit.
+class truncating_buffer final : public format_buffer {
+  std::size_t limit;
+  std::size_t discarded{0};
+  char scratch[64];
+
+  static void discard(format_buffer &self) {
+    auto &buffer = static_cast<truncating_buffer &>(self);
+    buffer.discarded += buffer.size_;
+    buffer.size_ = 0;
+    buffer.data_ = buffer.scratch;
+    buffer.capacity_ = sizeof(buffer.scratch);
+  }
+
+public:
+  truncating_buffer(char *first, std::size_t limit) noexcept
+      : format_buffer(&discard, first, limit), limit(limit) {}
+
+  std::size_t total() const noexcept { return this->discarded + this->size_; }
+  std::size_t written() const noexcept {
+    return std::min(this->total(), this->limit);
+  }
+};
+} // namespace isl::detail
+
+export namespace isl {
+/// Format string for `Args`, checked while compiling: braces must match,
+/// placeholders ("{}", "{0}", "{:>8.3f}") must refer to arguments, every
+/// argument must be used, and each specification must suit its argument.
+/// The specifications are kept as parsed, so formatting does not parse them
+/// again.
+template <class... Args> class basic_format_string {
+  string_view text;
+  // one per placeholder; only repeated manual indices have more placeholders
+  std::array<format_spec, sizeof...(Args)> specs_{};
+
+public:
+  template <class S>
+    requires std::is_convertible_v<const S &, string_view>
+  consteval basic_format_string(const S &s) : text(s) {
+    detail::check_format_string<Args...>(
+        this->text.data(), this->text.data() + this->text.size(),
+        this->specs_.data());
+  }
+
+  constexpr string_view get() const noexcept { return this->text; }
+  /// Parsed specifications of the first sizeof...(Args) placeholders.
+  constexpr const std::array<format_spec, sizeof...(Args)> &
+  specs() const noexcept {
+    return this->specs_;
+  }
+};
+
+template <class... Args>
+using format_string = basic_format_string<std::type_identity_t<Args>...>;
+
+/// Formats into `out`; for formatters of composite types.
+template <class... Args>
+void format_to(format_buffer &out, format_string<Args...> fmt,
+               const Args &...args) {
+  const detail::format_arg erased[] = {detail::make_format_arg(args)...,
+                                       {nullptr, nullptr}};
+  detail::vformat_to(out, fmt.get(), erased, fmt.specs().data(),
+                     fmt.specs().size());
+}
+
+/// Appends to `out`. Once `out` has grown to the usual message size this
+/// allocates nothing.
+template <class Allocator, class... Args>
+void format_to(vector<char, Allocator> &out, format_string<Args...> fmt,
+               const Args &...args) {
+  detail::appending_buffer buffer(out);
+  isl::format_to(buffer, fmt, args...);
+  buffer.finish();
+}
+template <class Allocator, class... Args>
+void format_to(basic_string<char, Allocator> &out, format_string<Args...> fmt,
+               const Args &...args) {
+  detail::appending_buffer buffer(out);
+  isl::format_to(buffer, fmt, args...);
+  buffer.finish();
+}
+
+struct format_to_n_result {
+  char *out;        // end of what was written
+  std::size_t size; // size of the whole output, written or not
+};
+
+/// Writes at most `n` chars to `first`, e.g. a stack buffer; like
+/// std::format_to_n.
+template <class... Args>
+format_to_n_result format_to_n(char *first, std::size_t n,
+                               format_string<Args...> fmt,
+                               const Args &...args) {
+  detail::truncating_buffer buffer(first, n);
+  isl::format_to(buffer, fmt, args...);
+  return {first + buffer.written(), buffer.total()};
+}
+
+/// Number of chars the output would take.
+template <class... Args>
+std::size_t formatted_size(format_string<Args...> fmt, const Args &...args) {
+  detail::truncating_buffer buffer(nullptr, 0);
+  isl::format_to(buffer, fmt, args...);
+  return buffer.total();
+}
+
+template <class... Args>
+string format(format_string<Args...> fmt, const Args &...args) {
+  string result;
+  isl::format_to(result, fmt, args...);
+  return result;
+}
+} // namespace isl
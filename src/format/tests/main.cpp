@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>   // std::int64_t, std::uint8_t
+#include <limits>    // std::numeric_limits
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::string
+
+import format;
+import string;
+import string_view;
+import vector;
+
+namespace {
+struct point {
+  int x;
+  int y;
+};
+} // namespace
+
+template <> struct isl::formatter<point> {
+  constexpr const char *parse(const char *first, const char *) {
+    return first;
+  }
+  void format(const point &p, isl::format_buffer &out) const {
+    isl::format_to(out, "({}, {})", p.x, p.y);
+  }
+};
+
+namespace {
+template <class... Args>
+std::string to_std_string(isl::format_string<Args...> fmt,
+                          const Args &...args) {
+  isl::vector<char> out;
+  isl::format_to(out, fmt, args...);
+  return std::string(out.data(), out.size());
+}
+} // namespace
+
+TEST(format, TestBasic) {
+  ASSERT_EQ(to_std_string("plain"), "plain");
+  ASSERT_EQ(to_std_string("{} + {} = {}", 1, 2, 3), "1 + 2 = 3");
+  ASSERT_EQ(to_std_string("{1}{0}{1}", 'a', 'b'), "bab");
+  ASSERT_EQ(to_std_string("{{{}}}", 5), "{5}");
+  ASSERT_EQ(to_std_string("{} {} {}", true, "text", isl::string_view("view")),
+            "true text view");
+  ASSERT_EQ(to_std_string("{}", isl::string("owned")), "owned");
+  ASSERT_EQ(to_std_string("{}", point{1, -2}), "(1, -2)");
+  // more placeholders than arguments
+  ASSERT_EQ(to_std_string("{0:x} {0} {1} {0:>4} {1}", 255, point{0, 1}),
+            "ff 255 (0, 1)  255 (0, 1)");
+}
+
+TEST(format, TestIntegers) {
+  ASSERT_EQ(to_std_string("{}", std::numeric_limits<std::int64_t>::min()),
+            "-9223372036854775808");
+  ASSERT_EQ(to_std_string("{:x} {:X} {:#x} {:#b} {:o} {:#o}", 255, 255, 255,
+                          5, 8, 0),
+            "ff FF 0xff 0b101 10 0");
+  ASSERT_EQ(to_std_string("{:+} {: } {:+}", 7, 7, -7), "+7  7 -7");
+  ASSERT_EQ(to_std_string("{:06}|{:#06x}|{:<6}|{:^6}|{:*>6}", -42, 42, 1, 2, 3),
+            "-00042|0x002a|1     |  2   |*****3");
+  ASSERT_EQ(to_std_string("{}", std::uint8_t{200}), "200");
+  ASSERT_EQ(to_std_string("{:d}", 'A'), "65");
+  ASSERT_EQ(to_std_string("{:d}", true), "1");
+}
+
+TEST(format, TestFloats) {
+  ASSERT_EQ(to_std_string("{}", 0.1), "0.1");
+  ASSERT_EQ(to_std_string("{}", 1e300), "1e+300");
+  ASSERT_EQ(to_std_string("{}", 2.5f), "2.5");
+  ASSERT_EQ(to_std_string("{:+}", 1.5), "+1.5");
+  ASSERT_EQ(to_std_string("{:+}", -1.5), "-1.5");
+  ASSERT_EQ(to_std_string("{:.3f}", 3.14159), "3.142");
+  ASSERT_EQ(to_std_string("{:.2e}", 12345.0), "1.23e+04");
+  ASSERT_EQ(to_std_string("{:.3}", 2.0 / 3), "0.667");
+  ASSERT_EQ(to_std_string("{:08.2f}", -1.5), "-0001.50");
+  ASSERT_EQ(to_std_string("{:>8}", 0.5), "     0.5");
+  ASSERT_EQ(to_std_string("{:06}", std::numeric_limits<double>::infinity()),
+            "   inf");
+  // longer than the stack buffer snprintf writes to first
+  ASSERT_EQ(to_std_string("{:.1f}", 0x1p600).size(), 183);
+}
+
+TEST(format, TestStrings) {
+  ASSERT_EQ(to_std_string("[{:>6}]", "ab"), "[    ab]");
+  ASSERT_EQ(to_std_string("[{:-^7}]", "ab"), "[--ab---]");
+  ASSERT_EQ(to_std_string("[{:.2}]", "abcdef"), "[ab]");
+  ASSERT_EQ(to_std_string("[{:<3}]", 'x'), "[x  ]");
+  ASSERT_EQ(to_std_string("{}", static_cast<const void *>(nullptr)), "0x0");
+}
+
+// Output longer than the stack buffer is flushed in pieces, and appends to
+// what the destination already holds.
+TEST(format, TestAppend) {
+  isl::vector<char> out;
+  out.push_back('>');
+  std::string expected = ">";
+  for (int i = 0; i < 100; ++i) {
+    isl::format_to(out, "{:>20}|{}|", i, "line");
+    expected += to_std_string("{:>20}|{}|", i, "line");
+  }
+  ASSERT_EQ(std::string(out.data(), out.size()), expected);
+
+  isl::string text = "id=";
+  isl::format_to(text, "{}", 42);
+  ASSERT_EQ(text, "id=42");
+  ASSERT_EQ(isl::format("{}-{}", 1, 2), "1-2");
+}
+
+TEST(format, TestFixedBuffer) {
+  char buffer[8];
+  auto result = isl::format_to_n(buffer, sizeof(buffer), "{}:{}", "key", 12);
+  ASSERT_EQ(result.size, 6);
+  ASSERT_EQ(std::string(buffer, result.out), "key:12");
+
+  result = isl::format_to_n(buffer, 4, "{:>100}", "truncated");
+  ASSERT_EQ(result.size, 100);
+  ASSERT_EQ(result.out, buffer + 4);
+  ASSERT_EQ(std::string(buffer, 4), "    ");
+
+  ASSERT_EQ(isl::formatted_size("{:10}|{}", 1, 2.5), 14);
+}
+
+// Format strings are checked while compiling; the specification parser is
+// also usable directly and reports errors by throwing.
+TEST(format, TestSpecErrors) {
+  isl::format_spec spec;
+  const char *text = "*^+#012.5x";
+  ASSERT_EQ(spec.parse(text, text + 10), text + 10);
+  ASSERT_EQ(spec.fill, '*');
+  ASSERT_EQ(spec.align, '^');
+  ASSERT_EQ(spec.sign, '+');
+  ASSERT_TRUE(spec.alternate);
+  ASSERT_TRUE(spec.zero_pad);
+  ASSERT_EQ(spec.width, 12);
+  ASSERT_EQ(spec.precision, 5);
+  ASSERT_EQ(spec.type, 'x');
+
+  const char *missing = "8.f";
+  ASSERT_THROW(isl::format_spec{}.parse(missing, missing + 3),
+               isl::format_error);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
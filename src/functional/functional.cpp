@@ -1,3 +1,9 @@
+module;
+
+#include <functional>  // std::invoke
+#include <tuple>       // std::tuple, std::apply
+#include <type_traits> // std::decay_t
+
 export module functional;
 
 import type_traits;
@@ -55,6 +61,12 @@ template <class> class function;
 template <class R, class... Args> class function<R(Args...)>;
 
 template <class T> class reference_wrapper;
+
+// partial function application
+template <class F, class... Args>
+constexpr auto bind_front(F &&f, Args &&...args);
+template <class F, class... Args>
+constexpr auto bind_back(F &&f, Args &&...args);
 } // namespace isl
 
 export namespace isl {
@@ -308,6 +320,47 @@ template <> struct bit_not<> {
 };
 } // namespace isl
 
+// bind_front, bind_back
+export namespace isl::detail {
+/// Result of bind_front (Front) and bind_back. A named type rather than a
+/// lambda, so algorithms can recognize a comparator bound to values.
+template <bool Front, class F, class... Bound> struct bound_call {
+  F f;
+  std::tuple<Bound...> bound;
+
+  template <class... Rest>
+  constexpr decltype(auto) operator()(Rest &&...rest) const {
+    return std::apply(
+        [&](const Bound &...args) -> decltype(auto) {
+          if constexpr (Front) {
+            return std::invoke(this->f, args..., isl::forward<Rest>(rest)...);
+          } else {
+            return std::invoke(this->f, isl::forward<Rest>(rest)..., args...);
+          }
+        },
+        this->bound);
+  }
+};
+} // namespace isl::detail
+
+export namespace isl {
+/// Binds the first arguments of `f`: bind_front(isl::less<>{}, 5)(x) is
+/// 5 < x. `f` and the arguments are stored by value.
+template <class F, class... Args>
+constexpr auto bind_front(F &&f, Args &&...args) {
+  return detail::bound_call<true, std::decay_t<F>, std::decay_t<Args>...>{
+      isl::forward<F>(f), {isl::forward<Args>(args)...}};
+}
+
+/// Binds the last arguments of `f`: bind_back(isl::less<>{}, 5)(x) is
+/// x < 5.
+template <class F, class... Args>
+constexpr auto bind_back(F &&f, Args &&...args) {
+  return detail::bound_call<false, std::decay_t<F>, std::decay_t<Args>...>{
+      isl::forward<F>(f), {isl::forward<Args>(args)...}};
+}
+} // namespace isl
+
 // function
 export namespace isl {
 template <class R, class... Args> class function<R(Args...)> {
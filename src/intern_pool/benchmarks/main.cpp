@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>       // std::uint32_t
+#include <string>        // std::string, std::to_string
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+import intern_pool;
+import string_view;
+
+// Identifier-like strings, each seen several times, as a lexer would.
+
+static std::vector<std::string> make_words() {
+  std::vector<std::string> words;
+  for (int i = 0; i < 100000; ++i) {
+    words.push_back("identifier_" + std::to_string(i % 20000));
+  }
+  return words;
+}
+
+static void BM_IslInternPool(benchmark::State &state) {
+  std::vector<std::string> words = make_words();
+  for (auto _ : state) {
+    isl::intern_pool pool;
+    for (const std::string &word : words) {
+      benchmark::DoNotOptimize(
+          pool.intern(isl::string_view(word.data(), word.size())));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * words.size());
+}
+BENCHMARK(BM_IslInternPool);
+
+static void BM_StdUnorderedMap(benchmark::State &state) {
+  std::vector<std::string> words = make_words();
+  for (auto _ : state) {
+    std::unordered_map<std::string, std::uint32_t> pool;
+    for (const std::string &word : words) {
+      auto id = static_cast<std::uint32_t>(pool.size());
+      benchmark::DoNotOptimize(pool.try_emplace(word, id).first->second);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * words.size());
+}
+BENCHMARK(BM_StdUnorderedMap);
+
+static void BM_IslConcurrentInternPool(benchmark::State &state) {
+  static isl::concurrent_intern_pool pool;
+  std::vector<std::string> words = make_words();
+  for (auto _ : state) {
+    for (const std::string &word : words) {
+      benchmark::DoNotOptimize(
+          pool.intern(isl::string_view(word.data(), word.size())));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * words.size());
+}
+BENCHMARK(BM_IslConcurrentInternPool)->Threads(1)->Threads(4);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,495 @@
+module;
+
+#include <atomic>       // std::atomic
+#include <bit>          // std::bit_width, std::bit_ceil
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstring>      // std::memcpy, std::memcmp
+#include <memory>       // std::allocator, std::allocator_traits
+#include <mutex>        // std::unique_lock
+#include <optional>     // std::optional
+#include <shared_mutex> // std::shared_mutex, std::shared_lock
+#include <stdexcept>    // std::length_error
+#include <utility>      // std::exchange, std::swap
+
+#include "../internal/concurrency/cache_line.hpp"
+
+export module intern_pool;
+
+import string_view;
+import vector;
+
+export namespace isl {
+/// Interned string: a dense index into the intern_pool that issued it.
+/// Symbols of one pool number 0, 1, 2, ... in order of first interning.
+struct symbol {
+  std::uint32_t id;
+
+  friend constexpr bool operator==(symbol, symbol) noexcept = default;
+  friend constexpr auto operator<=>(symbol, symbol) noexcept = default;
+};
+} // namespace isl
+
+namespace isl::detail {
+// 64-bit string hash in the style of wyhash: 16 bytes per multiply-fold,
+// and inputs of up to 16 bytes read as two possibly overlapping words.
+inline std::uint64_t fold_multiply(std::uint64_t a, std::uint64_t b) noexcept {
+  auto product = static_cast<unsigned __int128>(a) * b;
+  return static_cast<std::uint64_t>(product) ^
+         static_cast<std::uint64_t>(product >> 64);
+}
+
+inline std::uint64_t read_u64(const char *p) noexcept {
+  std::uint64_t v;
+  std::memcpy(&v, p, 8);
+  return v;
+}
+inline std::uint64_t read_u32(const char *p) noexcept {
+  std::uint32_t v;
+  std::memcpy(&v, p, 4);
+  return v;
+}
+
+inline std::uint64_t hash_bytes(const char *p, std::size_t n) noexcept {
+  constexpr std::uint64_t k0 = 0xa0761d6478bd642f;
+  constexpr std::uint64_t k1 = 0xe7037ed1a0b428db;
+  constexpr std::uint64_t k2 = 0x8ebc6af09c88c6e3;
+
+  std::uint64_t seed = k0 ^ n;
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+  if (n <= 16) {
+    if (n >= 8) {
+      a = read_u64(p);
+      b = read_u64(p + n - 8);
+    } else if (n >= 4) {
+      a = read_u32(p);
+      b = read_u32(p + n - 4);
+    } else if (n != 0) {
+      a = std::uint64_t{static_cast<unsigned char>(p[0])} << 16 |
+          std::uint64_t{static_cast<unsigned char>(p[n >> 1])} << 8 |
+          static_cast<unsigned char>(p[n - 1]);
+    }
+  } else {
+    for (; n > 16; p += 16, n -= 16) {
+      seed = fold_multiply(read_u64(p) ^ k1, read_u64(p + 8) ^ seed);
+    }
+    a = read_u64(p + n - 16);
+    b = read_u64(p + n - 8);
+  }
+  return fold_multiply(k1 ^ seed, fold_multiply(a ^ k1, b ^ seed ^ k2));
+}
+
+struct intern_entry {
+  const char *data;
+  std::uint32_t size;
+  std::uint32_t hash;
+};
+
+/// Append-only byte storage in chunks that never move, so views into it
+/// stay valid for the arena's lifetime. Strings are NUL-terminated.
+template <class Allocator> class string_arena {
+  using char_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<char>;
+  using traits = std::allocator_traits<char_allocator>;
+
+  struct chunk {
+    char *data;
+    std::size_t capacity;
+  };
+
+  static constexpr std::size_t first_chunk_size = 4096;
+  static constexpr std::size_t max_chunk_size = std::size_t{1} << 20;
+
+  [[no_unique_address]] char_allocator allocator;
+  vector<chunk> chunks;
+  char *position{nullptr};
+  char *end{nullptr};
+
+  void release() noexcept {
+    for (chunk &c : this->chunks) {
+      traits::deallocate(this->allocator, c.data, c.capacity);
+    }
+  }
+
+public:
+  string_arena() = default;
+  explicit string_arena(const Allocator &alloc) : allocator(alloc) {}
+  string_arena(string_arena &&other) noexcept
+      : allocator(other.allocator), chunks(std::move(other.chunks)),
+        position(std::exchange(other.position, nullptr)),
+        end(std::exchange(other.end, nullptr)) {}
+  string_arena &operator=(string_arena &&other) noexcept {
+    this->swap(other);
+    return *this;
+  }
+  ~string_arena() { this->release(); }
+
+  void swap(string_arena &other) noexcept {
+    std::swap(this->allocator, other.allocator);
+    std::swap(this->chunks, other.chunks);
+    std::swap(this->position, other.position);
+    std::swap(this->end, other.end);
+  }
+
+  /// Copies [s, s + n) and a NUL terminator in; returns the copy.
+  const char *store(const char *s, std::size_t n) {
+    if (static_cast<std::size_t>(this->end - this->position) < n + 1) {
+      // chunks double up to a cap; longer strings get a chunk of their own
+      std::size_t size = this->chunks.empty()
+                             ? first_chunk_size
+                             : this->chunks.back().capacity * 2;
+      size = size < max_chunk_size ? size : max_chunk_size;
+      size = size < n + 1 ? n + 1 : size;
+      char *data = traits::allocate(this->allocator, size);
+      this->chunks.push_back(chunk{data, size});
+      this->position = data;
+      this->end = data + size;
+    }
+    char *copy = this->position;
+    if (n != 0) {
+      std::memcpy(copy, s, n);
+    }
+    copy[n] = '\0';
+    this->position += n + 1;
+    return copy;
+  }
+
+  std::size_t capacity() const noexcept {
+    std::size_t total = 0;
+    for (const chunk &c : this->chunks) {
+      total += c.capacity;
+    }
+    return total;
+  }
+};
+
+/// Open-addressing hash index from string to id. Slots keep the hash next
+/// to the id, so probes compare bytes only on a full 32-bit hash match and
+/// growing never looks at the strings. Linear probing, at most 3/4 full.
+template <class Allocator> class intern_index {
+  struct slot {
+    std::uint32_t id;
+    std::uint32_t hash;
+  };
+  using slot_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+
+  static constexpr std::uint32_t empty = ~std::uint32_t{0};
+
+  vector<slot, slot_allocator> slots;
+  std::size_t used{0};
+
+  void rehash(std::size_t capacity) {
+    vector<slot, slot_allocator> old(std::move(this->slots));
+    this->slots = vector<slot, slot_allocator>();
+    this->slots.resize(capacity, slot{empty, 0});
+    std::size_t mask = capacity - 1;
+    for (const slot &s : old) {
+      if (s.id != empty) {
+        std::size_t i = s.hash & mask;
+        while (this->slots[i].id != empty) {
+          i = (i + 1) & mask;
+        }
+        this->slots[i] = s;
+      }
+    }
+  }
+
+public:
+  /// Id of the string [s, s + n) with `hash`, or `empty`. `entry(id)`
+  /// returns the intern_entry of an id.
+  template <class EntryOf>
+  std::uint32_t find(const char *s, std::size_t n, std::uint32_t hash,
+                     EntryOf entry) const {
+    if (this->slots.empty()) {
+      return empty;
+    }
+    std::size_t mask = this->slots.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+      const slot &candidate = this->slots[i];
+      if (candidate.id == empty) {
+        return empty;
+      }
+      if (candidate.hash == hash) {
+        const intern_entry &e = entry(candidate.id);
+        if (e.size == n && (n == 0 || std::memcmp(e.data, s, n) == 0)) {
+          return candidate.id;
+        }
+      }
+    }
+  }
+
+  /// Adds `id`, which must not be present.
+  void insert(std::uint32_t id, std::uint32_t hash) {
+    if ((this->used + 1) * 4 > this->slots.size() * 3) {
+      this->rehash(this->slots.empty() ? 64 : this->slots.size() * 2);
+    }
+    std::size_t mask = this->slots.size() - 1;
+    std::size_t i = hash & mask;
+    while (this->slots[i].id != empty) {
+      i = (i + 1) & mask;
+    }
+    this->slots[i] = slot{id, hash};
+    this->used += 1;
+  }
+
+  void reserve(std::size_t count) {
+    std::size_t capacity = std::bit_ceil((count * 4 + 2) / 3);
+    if (capacity > this->slots.size()) {
+      this->rehash(capacity < 64 ? 64 : capacity);
+    }
+  }
+
+  static constexpr std::uint32_t not_found = empty;
+};
+
+/// Entries split into segments of doubling size that never move: segment
+/// k holds ids [first_segment_size * (2^k - 1), first_segment_size *
+/// (2^(k+1) - 1)). Readers find an entry without locking; segments are
+/// published with release stores as they are created.
+template <class Allocator> class segmented_entries {
+  using entry_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<intern_entry>;
+  using traits = std::allocator_traits<entry_allocator>;
+
+  static constexpr int first_segment_bits = 10;
+  static constexpr int segment_count = 33 - first_segment_bits;
+
+  [[no_unique_address]] entry_allocator allocator;
+  std::atomic<intern_entry *> segments[segment_count] = {};
+
+  static std::size_t segment_size(int k) noexcept {
+    return std::size_t{1} << (first_segment_bits + k);
+  }
+
+public:
+  segmented_entries() = default;
+  explicit segmented_entries(const Allocator &alloc) : allocator(alloc) {}
+  segmented_entries(const segmented_entries &) = delete;
+  segmented_entries &operator=(const segmented_entries &) = delete;
+  ~segmented_entries() {
+    for (int k = 0; k != segment_count; ++k) {
+      if (intern_entry *segment = this->segments[k].load()) {
+        traits::deallocate(this->allocator, segment, segment_size(k));
+      }
+    }
+  }
+
+  const intern_entry &operator[](std::uint32_t id) const noexcept {
+    std::uint64_t j = std::uint64_t{id} + segment_size(0);
+    int k = std::bit_width(j) - 1 - first_segment_bits;
+    intern_entry *segment = this->segments[k].load(std::memory_order_acquire);
+    return segment[j - segment_size(k)];
+  }
+
+  /// Stores the entry of `id`, the next id; called under the writer lock.
+  void set(std::uint32_t id, const intern_entry &entry) {
+    std::uint64_t j = std::uint64_t{id} + segment_size(0);
+    int k = std::bit_width(j) - 1 - first_segment_bits;
+    intern_entry *segment = this->segments[k].load(std::memory_order_relaxed);
+    if (!segment) {
+      segment = traits::allocate(this->allocator, segment_size(k));
+      this->segments[k].store(segment, std::memory_order_release);
+    }
+    segment[j - segment_size(k)] = entry;
+  }
+};
+
+inline std::uint32_t checked_size(std::size_t n) {
+  if (n > ~std::uint32_t{0}) {
+    throw std::length_error{"STRING TOO LONG!"};
+  }
+  return static_cast<std::uint32_t>(n);
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// String interning table: maps strings to dense 32-bit symbols and back.
+///
+/// Each distinct string is copied once into an arena of chunks that never
+/// move, so views of interned strings stay valid for the pool's lifetime.
+/// symbol to string is an index into a table of {pointer, size, hash};
+/// string to symbol hashes once and probes an open-addressing index that
+/// compares bytes only on a full hash match.
+template <class Allocator = std::allocator<char>> class basic_intern_pool {
+  using entry_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<detail::intern_entry>;
+
+  detail::string_arena<Allocator> arena;
+  vector<detail::intern_entry, entry_allocator> entries;
+  detail::intern_index<Allocator> index;
+
+  std::uint32_t find_id(string_view s, std::uint32_t hash) const {
+    return this->index.find(s.data(), s.size(), hash,
+                            [this](std::uint32_t id) -> const auto & {
+                              return this->entries[id];
+                            });
+  }
+
+public:
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+  basic_intern_pool() = default;
+  explicit basic_intern_pool(const Allocator &alloc) : arena(alloc) {}
+  basic_intern_pool(const basic_intern_pool &) = delete;
+  basic_intern_pool &operator=(const basic_intern_pool &) = delete;
+  basic_intern_pool(basic_intern_pool &&) noexcept = default;
+  basic_intern_pool &operator=(basic_intern_pool &&) noexcept = default;
+
+  /// Symbol of `s`, interning it first if this pool has not seen it.
+  symbol intern(string_view s) {
+    auto hash = static_cast<std::uint32_t>(detail::hash_bytes(s.data(),
+                                                              s.size()));
+    std::uint32_t id = this->find_id(s, hash);
+    if (id != detail::intern_index<Allocator>::not_found) {
+      return symbol{id};
+    }
+    std::uint32_t size = detail::checked_size(s.size());
+    // the last id is the index's empty marker
+    if (this->entries.size() >= ~std::uint32_t{0}) {
+      throw std::length_error{"TOO MANY SYMBOLS!"};
+    }
+    id = static_cast<std::uint32_t>(this->entries.size());
+    const char *copy = this->arena.store(s.data(), size);
+    this->entries.push_back(detail::intern_entry{copy, size, hash});
+    this->index.insert(id, hash);
+    return symbol{id};
+  }
+
+  /// Symbol of `s` if it has been interned.
+  std::optional<symbol> find(string_view s) const {
+    auto hash = static_cast<std::uint32_t>(detail::hash_bytes(s.data(),
+                                                              s.size()));
+    std::uint32_t id = this->find_id(s, hash);
+    if (id == detail::intern_index<Allocator>::not_found) {
+      return std::nullopt;
+    }
+    return symbol{id};
+  }
+  bool contains(string_view s) const { return this->find(s).has_value(); }
+
+  /// The interned string; `sym` must come from this pool.
+  string_view view(symbol sym) const noexcept {
+    const detail::intern_entry &e = this->entries[sym.id];
+    return string_view(e.data, e.size);
+  }
+  /// Same, NUL-terminated.
+  const char *c_str(symbol sym) const noexcept {
+    return this->entries[sym.id].data;
+  }
+
+  /// Number of symbols; they are 0 to size() - 1.
+  size_type size() const noexcept { return this->entries.size(); }
+  [[nodiscard]] bool empty() const noexcept { return this->entries.empty(); }
+
+  /// Makes room for `count` symbols without rehashing.
+  void reserve(size_type count) {
+    this->entries.reserve(count);
+    this->index.reserve(count);
+  }
+};
+
+using intern_pool = basic_intern_pool<>;
+
+/// Thread-safe intern_pool for read-mostly use.
+///
+/// find and intern of a known string take the lock shared; only a new
+/// string takes it exclusively, and checks again before inserting. view
+/// and c_str take no lock at all: entries live in segments that never
+/// move, so any symbol a thread has been handed can be resolved while
+/// other threads intern.
+template <class Allocator = std::allocator<char>>
+class basic_concurrent_intern_pool {
+  static constexpr std::size_t cache_line =
+      isl::internal::concurrency::cache_line_size;
+
+  alignas(cache_line) mutable std::shared_mutex mutex;
+  detail::string_arena<Allocator> arena;
+  detail::intern_index<Allocator> index;
+  std::atomic<std::uint32_t> count{0};
+
+  alignas(cache_line) detail::segmented_entries<Allocator> entries;
+
+  std::uint32_t find_id(string_view s, std::uint32_t hash) const {
+    return this->index.find(s.data(), s.size(), hash,
+                            [this](std::uint32_t id) -> const auto & {
+                              return this->entries[id];
+                            });
+  }
+
+public:
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+  basic_concurrent_intern_pool() = default;
+  explicit basic_concurrent_intern_pool(const Allocator &alloc)
+      : arena(alloc), entries(alloc) {}
+  basic_concurrent_intern_pool(const basic_concurrent_intern_pool &) = delete;
+  basic_concurrent_intern_pool &
+  operator=(const basic_concurrent_intern_pool &) = delete;
+
+  symbol intern(string_view s) {
+    auto hash = static_cast<std::uint32_t>(detail::hash_bytes(s.data(),
+                                                              s.size()));
+    {
+      std::shared_lock lock(this->mutex);
+      std::uint32_t id = this->find_id(s, hash);
+      if (id != detail::intern_index<Allocator>::not_found) {
+        return symbol{id};
+      }
+    }
+
+    std::unique_lock lock(this->mutex);
+    // another thread may have interned it between the two locks
+    std::uint32_t id = this->find_id(s, hash);
+    if (id != detail::intern_index<Allocator>::not_found) {
+      return symbol{id};
+    }
+    std::uint32_t size = detail::checked_size(s.size());
+    id = this->count.load(std::memory_order_relaxed);
+    if (id == ~std::uint32_t{0}) {
+      throw std::length_error{"TOO MANY SYMBOLS!"};
+    }
+    const char *copy = this->arena.store(s.data(), size);
+    this->entries.set(id, detail::intern_entry{copy, size, hash});
+    this->index.insert(id, hash);
+    this->count.store(id + 1, std::memory_order_release);
+    return symbol{id};
+  }
+
+  std::optional<symbol> find(string_view s) const {
+    auto hash = static_cast<std::uint32_t>(detail::hash_bytes(s.data(),
+                                                              s.size()));
+    std::shared_lock lock(this->mutex);
+    std::uint32_t id = this->find_id(s, hash);
+    if (id == detail::intern_index<Allocator>::not_found) {
+      return std::nullopt;
+    }
+    return symbol{id};
+  }
+  bool contains(string_view s) const { return this->find(s).has_value(); }
+
+  /// Lock-free; `sym` must come from this pool.
+  string_view view(symbol sym) const noexcept {
+    const detail::intern_entry &e = this->entries[sym.id];
+    return string_view(e.data, e.size);
+  }
+  const char *c_str(symbol sym) const noexcept {
+    return this->entries[sym.id].data;
+  }
+
+  /// Snapshot; symbols below it are valid.
+  size_type size() const noexcept {
+    return this->count.load(std::memory_order_acquire);
+  }
+
+  void reserve(size_type count) {
+    std::unique_lock lock(this->mutex);
+    this->index.reserve(count);
+  }
+};
+
+using concurrent_intern_pool = basic_concurrent_intern_pool<>;
+} // namespace isl
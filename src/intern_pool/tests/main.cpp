@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <string>  // std::string, std::to_string
+#include <thread>  // std::thread
+#include <vector>  // std::vector
+
+import intern_pool;
+import string_view;
+
+TEST(intern_pool, TestIntern) {
+  isl::intern_pool pool;
+  ASSERT_TRUE(pool.empty());
+
+  isl::symbol a = pool.intern("alpha");
+  isl::symbol b = pool.intern("beta");
+  isl::symbol empty = pool.intern("");
+  ASSERT_EQ(a.id, 0);
+  ASSERT_EQ(b.id, 1);
+  ASSERT_EQ(empty.id, 2);
+  ASSERT_EQ(pool.intern("alpha"), a);
+  ASSERT_EQ(pool.intern(std::string("beta").c_str()), b);
+  ASSERT_EQ(pool.size(), 3);
+
+  ASSERT_EQ(pool.view(a), "alpha");
+  ASSERT_EQ(pool.view(empty), "");
+  ASSERT_EQ(std::string(pool.c_str(b)), "beta");
+
+  ASSERT_EQ(pool.find("beta"), b);
+  ASSERT_FALSE(pool.find("gamma").has_value());
+  ASSERT_FALSE(pool.contains("alph"));
+}
+
+// Views handed out early stay valid while the arena and index grow, and
+// ids stay dense in order of first interning.
+TEST(intern_pool, TestStability) {
+  isl::intern_pool pool;
+  pool.reserve(100);
+  isl::string_view first = pool.view(pool.intern("first"));
+  std::string long_string(100000, 'x');
+  isl::symbol long_symbol = pool.intern(
+      isl::string_view(long_string.data(), long_string.size()));
+
+  for (int i = 0; i < 100000; ++i) {
+    std::string s = "symbol" + std::to_string(i);
+    ASSERT_EQ(pool.intern(isl::string_view(s.data(), s.size())).id, i + 2);
+  }
+  ASSERT_EQ(first, "first");
+  ASSERT_EQ(pool.view(long_symbol).size(), 100000);
+  for (int i = 0; i < 100000; i += 997) {
+    std::string s = "symbol" + std::to_string(i);
+    isl::symbol sym{static_cast<std::uint32_t>(i + 2)};
+    ASSERT_EQ(pool.view(sym), isl::string_view(s.data(), s.size()));
+    ASSERT_EQ(pool.find(isl::string_view(s.data(), s.size())), sym);
+  }
+
+  isl::intern_pool moved = std::move(pool);
+  ASSERT_EQ(moved.find("first")->id, 0);
+}
+
+// Threads intern overlapping sets of strings and read back each other's
+// symbols; every string must end up with exactly one id.
+TEST(intern_pool, TestConcurrent) {
+  isl::concurrent_intern_pool pool;
+  constexpr int thread_count = 8;
+  constexpr int strings = 20000;
+  std::vector<std::vector<isl::symbol>> seen(thread_count);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < strings; ++i) {
+        // each thread walks the same strings from a different start
+        std::string s = std::to_string((i + t * 2500) % strings);
+        isl::symbol sym = pool.intern(isl::string_view(s.data(), s.size()));
+        seen[t].push_back(sym);
+        if (pool.view(sym) != isl::string_view(s.data(), s.size())) {
+          ADD_FAILURE() << s;
+        }
+        // any symbol below size() resolves without locking
+        std::uint32_t other = static_cast<std::uint32_t>(i % pool.size());
+        if (pool.view(isl::symbol{other}).empty()) {
+          ADD_FAILURE() << other;
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(pool.size(), strings);
+  for (int t = 0; t < thread_count; ++t) {
+    for (int i = 0; i < strings; ++i) {
+      std::string s = std::to_string((i + t * 2500) % strings);
+      ASSERT_EQ(pool.find(isl::string_view(s.data(), s.size())), seen[t][i]);
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // _mm_pause
+#endif
+
+namespace isl::internal::concurrency {
+	// Size of the region two cores must not share to avoid false sharing.
+	// Apple's AArch64 cores use 128-byte lines, everything else we target
+	// uses 64.
+#if defined(__APPLE__) && defined(__aarch64__)
+	inline constexpr std::size_t cache_line_size = 128;
+#else
+	inline constexpr std::size_t cache_line_size = 64;
+#endif
+
+	// Busy-wait hint for spin loops.
+	inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+		_mm_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace isl::internal::concurrency {
+	// Thin wrappers over the Linux futex syscall; other platforms fall back to
+	// C++20 atomic waiting, which is implemented the same way where available.
+	using futex_word = std::atomic<std::uint32_t>;
+
+	static_assert(sizeof(futex_word) == sizeof(std::uint32_t));
+
+	// Blocks while `word` still holds `expected`. May return spuriously.
+	inline void futex_wait(futex_word &word, std::uint32_t expected) noexcept {
+#if defined(__linux__)
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word),
+		        FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+		word.wait(expected, std::memory_order_relaxed);
+#endif
+	}
+
+	inline void futex_wake_one(futex_word &word) noexcept {
+#if defined(__linux__)
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word),
+		        FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+		word.notify_one();
+#endif
+	}
+
+	inline void futex_wake_all(futex_word &word) noexcept {
+#if defined(__linux__)
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word),
+		        FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+		word.notify_all();
+#endif
+	}
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "cache_line.hpp"
+
+namespace isl::internal::concurrency {
+	// Chase-Lev work-stealing deque of pointers, with the memory orders of
+	// Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient
+	// Work-Stealing for Weak Memory Models" (PPoPP 2013). The owner thread
+	// pushes and pops at the bottom; any thread steals from the top. The
+	// ring doubles when full; the rings it outgrows stay allocated until
+	// the deque is destroyed, since a thief may still be reading one.
+	template <class T>
+	class work_deque {
+		struct ring {
+			std::int64_t mask;
+			std::atomic<T*>* slots;
+
+			explicit ring(std::int64_t capacity)
+			    : mask(capacity - 1), slots(new std::atomic<T*>[capacity]) {}
+			~ring() { delete[] this->slots; }
+
+			T* get(std::int64_t i) const noexcept {
+				return this->slots[i & this->mask].load(std::memory_order_relaxed);
+			}
+			void put(std::int64_t i, T* value) noexcept {
+				this->slots[i & this->mask].store(value, std::memory_order_relaxed);
+			}
+		};
+
+		alignas(cache_line_size) std::atomic<std::int64_t> top{0};
+		alignas(cache_line_size) std::atomic<std::int64_t> bottom{0};
+		std::atomic<ring*> current;
+		std::vector<ring*> retired;
+
+		ring* grow(ring* old, std::int64_t top, std::int64_t bottom) {
+			ring* bigger = new ring((old->mask + 1) * 2);
+			for (std::int64_t i = top; i != bottom; ++i) {
+				bigger->put(i, old->get(i));
+			}
+			this->retired.push_back(old);
+			this->current.store(bigger, std::memory_order_release);
+			return bigger;
+		}
+
+	public:
+		explicit work_deque(std::int64_t capacity = 256)
+		    : current(new ring(capacity)) {}
+		work_deque(const work_deque&) = delete;
+		work_deque& operator=(const work_deque&) = delete;
+		~work_deque() {
+			delete this->current.load(std::memory_order_relaxed);
+			for (ring* old : this->retired) {
+				delete old;
+			}
+		}
+
+		// Owner only.
+		void push(T* value) {
+			std::int64_t b = this->bottom.load(std::memory_order_relaxed);
+			std::int64_t t = this->top.load(std::memory_order_acquire);
+			ring* r = this->current.load(std::memory_order_relaxed);
+			if (b - t > r->mask) {
+				r = this->grow(r, t, b);
+			}
+			r->put(b, value);
+			this->bottom.store(b + 1, std::memory_order_release);
+		}
+
+		// Owner only. Null when empty.
+		T* pop() noexcept {
+			std::int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+			ring* r = this->current.load(std::memory_order_relaxed);
+			this->bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t t = this->top.load(std::memory_order_relaxed);
+			if (t > b) {
+				this->bottom.store(b + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			T* value = r->get(b);
+			if (t == b) {
+				// the last element: a thief may be taking it too
+				if (!this->top.compare_exchange_strong(t, t + 1,
+				                                       std::memory_order_seq_cst,
+				                                       std::memory_order_relaxed)) {
+					value = nullptr;
+				}
+				this->bottom.store(b + 1, std::memory_order_relaxed);
+			}
+			return value;
+		}
+
+		// Any thread. Null when empty or when another thread won the race
+		// for the top element.
+		T* steal() noexcept {
+			std::int64_t t = this->top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t b = this->bottom.load(std::memory_order_acquire);
+			if (t >= b) {
+				return nullptr;
+			}
+			ring* r = this->current.load(std::memory_order_acquire);
+			T* value = r->get(t);
+			if (!this->top.compare_exchange_strong(t, t + 1,
+			                                       std::memory_order_seq_cst,
+			                                       std::memory_order_relaxed)) {
+				return nullptr;
+			}
+			return value;
+		}
+
+		// Snapshot; may be stale by the time it is returned.
+		bool empty() const noexcept {
+			std::int64_t b = this->bottom.load(std::memory_order_relaxed);
+			std::int64_t t = this->top.load(std::memory_order_relaxed);
+			return b <= t;
+		}
+	};
+}
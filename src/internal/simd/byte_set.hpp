@@ -0,0 +1,235 @@
+#pragma once
+
+#include <bit>     // std::countr_zero
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+#include "simd.hpp"
+
+// Set membership over arbitrary byte sets with nibble lookup tables: the
+// low nibble of a byte selects a row, the high nibble selects a bit within
+// it. A block of bytes is classified with three shuffles, whatever the size
+// of the set.
+namespace isl::internal::simd {
+	struct byte_set {
+		// rows[lo] holds bit h for byte (h << 4 | lo), h in [0, 8); rows[16 + lo]
+		// holds the same for h in [8, 16).
+		alignas(16) unsigned char rows[32] = {};
+
+		constexpr byte_set() noexcept = default;
+		constexpr byte_set(const char* set, std::size_t k) noexcept {
+			for (std::size_t j = 0; j != k; ++j) {
+				this->insert(static_cast<unsigned char>(set[j]));
+			}
+		}
+
+		constexpr void insert(unsigned char c) noexcept {
+			this->rows[(c & 15) | ((c >> 3) & 16)] |= static_cast<unsigned char>(1 << ((c >> 4) & 7));
+		}
+		constexpr bool contains(unsigned char c) const noexcept {
+			return (this->rows[(c & 15) | ((c >> 3) & 16)] >> ((c >> 4) & 7)) & 1;
+		}
+	};
+
+	namespace scalar {
+		// First byte whose membership equals `members`.
+		inline std::size_t find_in_set(const char* s, std::size_t n,
+		                               const byte_set& set, bool members) noexcept {
+			for (std::size_t i = 0; i != n; ++i) {
+				if (set.contains(static_cast<unsigned char>(s[i])) == members) {
+					return i;
+				}
+			}
+			return not_found;
+		}
+	}
+
+#if defined(__SSE2__)
+	// pshufb needs SSSE3; the tier is keyed on SSE4.2, which implies it.
+	namespace sse42 {
+		inline constexpr std::size_t width = 16;
+
+		struct tables {
+			__m128i rows_low;
+			__m128i rows_high;
+			__m128i bits;
+		};
+
+		ISL_TARGET("sse4.2") inline tables load_tables(const byte_set& set) noexcept {
+			return {
+				_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows)),
+				_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows + 16)),
+				_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128),
+			};
+		}
+
+		// Bit i is set iff byte i of the block is in the set.
+		ISL_TARGET("sse4.2")
+		inline std::uint32_t classify(const char* p, const tables& t) noexcept {
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			// pshufb yields zero for indices with the top bit set, so each
+			// table only answers for its half of the high nibbles
+			__m128i low = _mm_and_si128(block, _mm_set1_epi8(static_cast<char>(0x8F)));
+			__m128i row = _mm_or_si128(
+				_mm_shuffle_epi8(t.rows_low, low),
+				_mm_shuffle_epi8(t.rows_high, _mm_xor_si128(low, _mm_set1_epi8(static_cast<char>(0x80)))));
+			__m128i high = _mm_and_si128(_mm_srli_epi16(block, 4), _mm_set1_epi8(0x0F));
+			__m128i bit = _mm_shuffle_epi8(t.bits, high);
+			__m128i member = _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(member));
+		}
+
+		// Requires n >= width.
+		ISL_TARGET("sse4.2")
+		inline std::size_t find_in_set(const char* s, std::size_t n,
+		                               const byte_set& set, bool members) noexcept {
+			tables t = load_tables(set);
+			std::uint32_t flip = members ? 0 : 0xFFFF;
+			std::size_t i = 0;
+			for (; i + width <= n; i += width) {
+				if (std::uint32_t mask = classify(s + i, t) ^ flip) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			if (i != n) {
+				std::size_t at = n - width;
+				if (std::uint32_t mask = (classify(s + at, t) ^ flip) >> (i - at)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			return not_found;
+		}
+	}
+
+	namespace avx2 {
+		struct tables {
+			__m256i rows_low;
+			__m256i rows_high;
+			__m256i bits;
+		};
+
+		// vpshufb shuffles within 128-bit lanes, so every table is repeated
+		// in both lanes.
+		ISL_TARGET("avx2") inline tables load_tables(const byte_set& set) noexcept {
+			return {
+				_mm256_broadcastsi128_si256(
+					_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows))),
+				_mm256_broadcastsi128_si256(
+					_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows + 16))),
+				_mm256_broadcastsi128_si256(
+					_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128)),
+			};
+		}
+
+		ISL_TARGET("avx2")
+		inline std::uint32_t classify(const char* p, const tables& t) noexcept {
+			__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			__m256i low = _mm256_and_si256(block, _mm256_set1_epi8(static_cast<char>(0x8F)));
+			__m256i row = _mm256_or_si256(
+				_mm256_shuffle_epi8(t.rows_low, low),
+				_mm256_shuffle_epi8(t.rows_high,
+				                    _mm256_xor_si256(low, _mm256_set1_epi8(static_cast<char>(0x80)))));
+			__m256i high = _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(0x0F));
+			__m256i bit = _mm256_shuffle_epi8(t.bits, high);
+			__m256i member = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(member));
+		}
+
+		// Requires n >= 32.
+		ISL_TARGET("avx2")
+		inline std::size_t find_in_set(const char* s, std::size_t n,
+		                               const byte_set& set, bool members) noexcept {
+			constexpr std::size_t width = 32;
+			tables t = load_tables(set);
+			std::uint32_t flip = members ? 0 : ~std::uint32_t{0};
+			std::size_t i = 0;
+			for (; i + width <= n; i += width) {
+				if (std::uint32_t mask = classify(s + i, t) ^ flip) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			if (i != n) {
+				std::size_t at = n - width;
+				if (std::uint32_t mask = (classify(s + at, t) ^ flip) >> (i - at)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			return not_found;
+		}
+	}
+
+	namespace avx512 {
+		struct tables {
+			__m512i rows_low;
+			__m512i rows_high;
+			__m512i bits;
+		};
+
+		ISL_TARGET("avx512f,avx512bw")
+		inline tables load_tables(const byte_set& set) noexcept {
+			return {
+				_mm512_broadcast_i32x4(
+					_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows))),
+				_mm512_broadcast_i32x4(
+					_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows + 16))),
+				_mm512_broadcast_i32x4(
+					_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128)),
+			};
+		}
+
+		// Lanes outside `lanes` are neither loaded nor reported.
+		ISL_TARGET("avx512f,avx512bw")
+		inline std::uint64_t classify(const char* p, __mmask64 lanes,
+		                              const tables& t) noexcept {
+			__m512i block = _mm512_maskz_loadu_epi8(lanes, p);
+			__m512i low = _mm512_and_si512(block, _mm512_set1_epi8(static_cast<char>(0x8F)));
+			__m512i row = _mm512_or_si512(
+				_mm512_shuffle_epi8(t.rows_low, low),
+				_mm512_shuffle_epi8(t.rows_high,
+				                    _mm512_xor_si512(low, _mm512_set1_epi8(static_cast<char>(0x80)))));
+			__m512i high = _mm512_and_si512(_mm512_srli_epi16(block, 4), _mm512_set1_epi8(0x0F));
+			__m512i bit = _mm512_shuffle_epi8(t.bits, high);
+			return _mm512_mask_test_epi8_mask(lanes, row, bit);
+		}
+
+		// Requires n >= 64.
+		ISL_TARGET("avx512f,avx512bw")
+		inline std::size_t find_in_set(const char* s, std::size_t n,
+		                               const byte_set& set, bool members) noexcept {
+			constexpr std::size_t width = 64;
+			tables t = load_tables(set);
+			std::uint64_t flip = members ? 0 : ~std::uint64_t{0};
+			std::size_t i = 0;
+			for (; i + width <= n; i += width) {
+				if (std::uint64_t mask = classify(s + i, ~__mmask64{0}, t) ^ flip) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			if (i != n) {
+				__mmask64 lanes = (std::uint64_t{1} << (n - i)) - 1;
+				if (std::uint64_t mask = (classify(s + i, lanes, t) ^ flip) & lanes) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			return not_found;
+		}
+	}
+#endif
+
+	// First byte in the set (members) or not in it (!members).
+	inline std::size_t find_in_set(const char* s, std::size_t n,
+	                               const byte_set& set, bool members) noexcept {
+#if defined(__SSE2__)
+		if (n >= 64 && has_avx512bw()) {
+			return avx512::find_in_set(s, n, set, members);
+		}
+		if (n >= 32 && has_avx2()) {
+			return avx2::find_in_set(s, n, set, members);
+		}
+		if (n >= 16 && has_sse42()) {
+			return sse42::find_in_set(s, n, set, members);
+		}
+#endif
+		return scalar::find_in_set(s, n, set, members);
+	}
+}
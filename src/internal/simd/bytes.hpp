@@ -0,0 +1,624 @@
+#pragma once
+
+#include <bit>     // std::countr_zero, std::countl_zero, std::popcount
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t, std::uintptr_t
+#include <cstring> // std::memchr, std::memcmp
+
+#include "byte_set.hpp"
+#include "simd.hpp"
+
+// Byte-string kernels behind isl::string_view and the bytes module. Every
+// function takes a pointer and a length and returns an index, or not_found.
+// Inputs are never read past their end: the last partial block is handled
+// by reloading the final full block and masking off the lanes that were
+// already checked, or by a masked load on AVX-512.
+namespace isl::internal::simd {
+	namespace scalar {
+		inline std::size_t find_byte(const char* s, std::size_t n, char c) noexcept {
+			const void* match = n != 0 ? std::memchr(s, c, n) : nullptr;
+			return match ? static_cast<const char*>(match) - s : not_found;
+		}
+
+		inline std::size_t rfind_byte(const char* s, std::size_t n, char c) noexcept {
+			while (n != 0) {
+				if (s[--n] == c) {
+					return n;
+				}
+			}
+			return not_found;
+		}
+
+		// First position in [first, last) where `needle` (m >= 1) matches.
+		inline std::size_t find(const char* s, std::size_t first, std::size_t last,
+		                        const char* needle, std::size_t m) noexcept {
+			for (std::size_t i = first; i < last; ++i) {
+				if (s[i] == needle[0] && s[i + m - 1] == needle[m - 1] &&
+				    std::memcmp(s + i, needle, m) == 0) {
+					return i;
+				}
+			}
+			return not_found;
+		}
+
+		// Last position in [0, last) where `needle` (m >= 1) matches.
+		inline std::size_t rfind(const char* s, std::size_t last,
+		                         const char* needle, std::size_t m) noexcept {
+			while (last != 0) {
+				std::size_t i = --last;
+				if (s[i] == needle[0] && s[i + m - 1] == needle[m - 1] &&
+				    std::memcmp(s + i, needle, m) == 0) {
+					return i;
+				}
+			}
+			return not_found;
+		}
+
+		inline std::size_t find_first_of(const char* s, std::size_t n,
+		                                 const char* set, std::size_t k) noexcept {
+			for (std::size_t i = 0; i != n; ++i) {
+				if (std::memchr(set, s[i], k)) {
+					return i;
+				}
+			}
+			return not_found;
+		}
+
+		inline std::size_t count_byte(const char* s, std::size_t n, char c) noexcept {
+			std::size_t count = 0;
+			for (std::size_t i = 0; i != n; ++i) {
+				count += s[i] == c;
+			}
+			return count;
+		}
+
+		inline std::size_t mismatch(const char* a, const char* b, std::size_t n) noexcept {
+			for (std::size_t i = 0; i != n; ++i) {
+				if (a[i] != b[i]) {
+					return i;
+				}
+			}
+			return n;
+		}
+	}
+
+	// Checks the candidate positions `at + bit` for every set bit of `mask`,
+	// lowest first. Candidates already match the first and last needle byte.
+	inline std::size_t verify_forward(const char* s, std::size_t at, std::uint32_t mask,
+	                                  const char* needle, std::size_t m) noexcept {
+		for (; mask != 0; mask &= mask - 1) {
+			std::size_t pos = at + std::countr_zero(mask);
+			if (m <= 2 || std::memcmp(s + pos + 1, needle + 1, m - 2) == 0) {
+				return pos;
+			}
+		}
+		return not_found;
+	}
+
+	// As verify_forward(), highest bit first.
+	inline std::size_t verify_backward(const char* s, std::size_t at, std::uint32_t mask,
+	                                   const char* needle, std::size_t m) noexcept {
+		while (mask != 0) {
+			int bit = 31 - std::countl_zero(mask);
+			std::size_t pos = at + bit;
+			if (m <= 2 || std::memcmp(s + pos + 1, needle + 1, m - 2) == 0) {
+				return pos;
+			}
+			mask &= ~(std::uint32_t{1} << bit);
+		}
+		return not_found;
+	}
+
+#if defined(__SSE2__)
+	namespace sse2 {
+		inline constexpr std::size_t width = 16;
+
+		inline __m128i load(const char* p) noexcept {
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		}
+		inline std::uint32_t match(__m128i block, __m128i value) noexcept {
+			return static_cast<std::uint32_t>(
+				_mm_movemask_epi8(_mm_cmpeq_epi8(block, value)));
+		}
+		// Positions in [at, at + width) whose first and last needle bytes match.
+		inline std::uint32_t candidates(const char* s, std::size_t at, std::size_t m,
+		                                __m128i first, __m128i last) noexcept {
+			return match(load(s + at), first) & match(load(s + at + m - 1), last);
+		}
+		inline std::uint32_t any_match(const char* p, const __m128i* values,
+		                               std::size_t k) noexcept {
+			__m128i block = load(p);
+			__m128i any = _mm_setzero_si128();
+			for (std::size_t j = 0; j != k; ++j) {
+				any = _mm_or_si128(any, _mm_cmpeq_epi8(block, values[j]));
+			}
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(any));
+		}
+
+		inline std::size_t find_byte(const char* s, std::size_t n, char c) noexcept {
+			if (n < width) {
+				return scalar::find_byte(s, n, c);
+			}
+			const __m128i value = _mm_set1_epi8(c);
+			std::size_t i = 0;
+			for (; i + width <= n; i += width) {
+				if (std::uint32_t mask = match(load(s + i), value)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			if (i != n) {
+				std::size_t at = n - width;
+				if (std::uint32_t mask = match(load(s + at), value) >> (i - at)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			return not_found;
+		}
+
+		// Only positions where both the first and the last needle byte match
+		// are verified with memcmp. Requires 1 <= m <= n.
+		inline std::size_t find(const char* s, std::size_t n,
+		                        const char* needle, std::size_t m) noexcept {
+			std::size_t positions = n - m + 1;
+			if (positions < width) {
+				return scalar::find(s, 0, positions, needle, m);
+			}
+			const __m128i first = _mm_set1_epi8(needle[0]);
+			const __m128i last = _mm_set1_epi8(needle[m - 1]);
+			std::size_t i = 0;
+			for (; i + width <= positions; i += width) {
+				std::uint32_t mask = candidates(s, i, m, first, last);
+				if (std::size_t pos = verify_forward(s, i, mask, needle, m);
+				    pos != not_found) {
+					return pos;
+				}
+			}
+			if (i != positions) {
+				std::size_t at = positions - width;
+				std::uint32_t mask = candidates(s, at, m, first, last) >> (i - at);
+				return verify_forward(s, i, mask, needle, m);
+			}
+			return not_found;
+		}
+
+		// Same filter as find(), scanning blocks from the back. Requires
+		// 1 <= m <= n.
+		inline std::size_t rfind(const char* s, std::size_t n,
+		                         const char* needle, std::size_t m) noexcept {
+			std::size_t positions = n - m + 1;
+			if (positions < width) {
+				return scalar::rfind(s, positions, needle, m);
+			}
+			const __m128i first = _mm_set1_epi8(needle[0]);
+			const __m128i last = _mm_set1_epi8(needle[m - 1]);
+			// positions [0, end) are still unchecked
+			std::size_t end = positions;
+			for (; end >= width; end -= width) {
+				std::uint32_t mask = candidates(s, end - width, m, first, last);
+				if (std::size_t pos = verify_backward(s, end - width, mask, needle, m);
+				    pos != not_found) {
+					return pos;
+				}
+			}
+			if (end != 0) {
+				std::uint32_t mask = candidates(s, 0, m, first, last);
+				return verify_backward(s, 0, mask & ((std::uint32_t{1} << end) - 1),
+				                       needle, m);
+			}
+			return not_found;
+		}
+
+		// Broadcast-and-compare against every set member. Requires k <= 16.
+		inline std::size_t find_first_of(const char* s, std::size_t n,
+		                                 const char* set, std::size_t k) noexcept {
+			if (n < width) {
+				return scalar::find_first_of(s, n, set, k);
+			}
+			__m128i values[16];
+			for (std::size_t j = 0; j != k; ++j) {
+				values[j] = _mm_set1_epi8(set[j]);
+			}
+			std::size_t i = 0;
+			for (; i + width <= n; i += width) {
+				if (std::uint32_t mask = any_match(s + i, values, k)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			if (i != n) {
+				std::size_t at = n - width;
+				if (std::uint32_t mask = any_match(s + at, values, k) >> (i - at)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			return not_found;
+		}
+
+		// Matches accumulate in per-lane byte counters, which are widened with
+		// psadbw before they can overflow.
+		inline std::size_t count_byte(const char* s, std::size_t n, char c) noexcept {
+			if (n < width) {
+				return scalar::count_byte(s, n, c);
+			}
+			const __m128i value = _mm_set1_epi8(c);
+			std::size_t count = 0;
+			std::size_t i = 0;
+			while (i + width <= n) {
+				std::size_t blocks = (n - i) / width < 255 ? (n - i) / width : 255;
+				__m128i counters = _mm_setzero_si128();
+				for (std::size_t b = 0; b != blocks; ++b, i += width) {
+					counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(load(s + i), value));
+				}
+				__m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+				count += _mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4);
+			}
+			if (i != n) {
+				std::size_t at = n - width;
+				count += std::popcount(match(load(s + at), value) >> (i - at));
+			}
+			return count;
+		}
+
+		// Index of the first differing byte, or n.
+		inline std::size_t mismatch(const char* a, const char* b, std::size_t n) noexcept {
+			if (n < width) {
+				return scalar::mismatch(a, b, n);
+			}
+			std::size_t i = 0;
+			for (; i + width <= n; i += width) {
+				if (std::uint32_t mask = match(load(a + i), load(b + i)) ^ 0xFFFF) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			if (i != n) {
+				// the overlapping lanes are already known to be equal
+				std::size_t at = n - width;
+				if (std::uint32_t mask = match(load(a + at), load(b + at)) ^ 0xFFFF) {
+					return at + std::countr_zero(mask);
+				}
+			}
+			return n;
+		}
+	}
+
+	// Mirrors sse2:: with 32-byte blocks. The dispatchers below only take
+	// this path for inputs of at least one block.
+	namespace avx2 {
+		inline constexpr std::size_t width = 32;
+
+		ISL_TARGET("avx2") inline __m256i load(const char* p) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		}
+		ISL_TARGET("avx2")
+		inline std::uint32_t match(__m256i block, __m256i value) noexcept {
+			return static_cast<std::uint32_t>(
+				_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, value)));
+		}
+		ISL_TARGET("avx2")
+		inline std::uint32_t candidates(const char* s, std::size_t at, std::size_t m,
+		                                __m256i first, __m256i last) noexcept {
+			return match(load(s + at), first) & match(load(s + at + m - 1), last);
+		}
+		ISL_TARGET("avx2")
+		inline std::uint32_t any_match(const char* p, const __m256i* values,
+		                               std::size_t k) noexcept {
+			__m256i block = load(p);
+			__m256i any = _mm256_setzero_si256();
+			for (std::size_t j = 0; j != k; ++j) {
+				any = _mm256_or_si256(any, _mm256_cmpeq_epi8(block, values[j]));
+			}
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(any));
+		}
+
+		ISL_TARGET("avx2")
+		inline std::size_t find_byte(const char* s, std::size_t n, char c) noexcept {
+			const __m256i value = _mm256_set1_epi8(c);
+			if (std::uint32_t mask = match(load(s), value)) {
+				return std::countr_zero(mask);
+			}
+			// continue from the next aligned block, so no load splits a line
+			std::size_t i = width - (reinterpret_cast<std::uintptr_t>(s) & (width - 1));
+			// four blocks per iteration, since most blocks have no match
+			for (; i + 4 * width <= n; i += 4 * width) {
+				__m256i b0 = _mm256_cmpeq_epi8(load(s + i), value);
+				__m256i b1 = _mm256_cmpeq_epi8(load(s + i + width), value);
+				__m256i b2 = _mm256_cmpeq_epi8(load(s + i + 2 * width), value);
+				__m256i b3 = _mm256_cmpeq_epi8(load(s + i + 3 * width), value);
+				__m256i any = _mm256_or_si256(_mm256_or_si256(b0, b1),
+				                              _mm256_or_si256(b2, b3));
+				if (_mm256_testz_si256(any, any)) {
+					continue;
+				}
+				__m256i blocks[4] = {b0, b1, b2, b3};
+				for (std::size_t j = 0;; ++j) {
+					auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(blocks[j]));
+					if (mask != 0) {
+						return i + j * width + std::countr_zero(mask);
+					}
+				}
+			}
+			for (; i + width <= n; i += width) {
+				if (std::uint32_t mask = match(load(s + i), value)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			if (i != n) {
+				std::size_t at = n - width;
+				if (std::uint32_t mask = match(load(s + at), value) >> (i - at)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			return not_found;
+		}
+
+		ISL_TARGET("avx2")
+		inline std::size_t find(const char* s, std::size_t n,
+		                        const char* needle, std::size_t m) noexcept {
+			std::size_t positions = n - m + 1;
+			const __m256i first = _mm256_set1_epi8(needle[0]);
+			const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+			std::size_t i = 0;
+			// two blocks per iteration, as in find_byte()
+			for (; i + 2 * width <= positions; i += 2 * width) {
+				std::uint32_t lo = candidates(s, i, m, first, last);
+				std::uint32_t hi = candidates(s, i + width, m, first, last);
+				if ((lo | hi) == 0) {
+					continue;
+				}
+				if (std::size_t pos = verify_forward(s, i, lo, needle, m);
+				    pos != not_found) {
+					return pos;
+				}
+				if (std::size_t pos = verify_forward(s, i + width, hi, needle, m);
+				    pos != not_found) {
+					return pos;
+				}
+			}
+			for (; i + width <= positions; i += width) {
+				std::uint32_t mask = candidates(s, i, m, first, last);
+				if (std::size_t pos = verify_forward(s, i, mask, needle, m);
+				    pos != not_found) {
+					return pos;
+				}
+			}
+			if (i != positions) {
+				std::size_t at = positions - width;
+				std::uint32_t mask = candidates(s, at, m, first, last) >> (i - at);
+				return verify_forward(s, i, mask, needle, m);
+			}
+			return not_found;
+		}
+
+		ISL_TARGET("avx2")
+		inline std::size_t rfind(const char* s, std::size_t n,
+		                         const char* needle, std::size_t m) noexcept {
+			std::size_t positions = n - m + 1;
+			const __m256i first = _mm256_set1_epi8(needle[0]);
+			const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+			std::size_t end = positions;
+			for (; end >= width; end -= width) {
+				std::uint32_t mask = candidates(s, end - width, m, first, last);
+				if (std::size_t pos = verify_backward(s, end - width, mask, needle, m);
+				    pos != not_found) {
+					return pos;
+				}
+			}
+			if (end != 0) {
+				std::uint32_t mask = candidates(s, 0, m, first, last);
+				return verify_backward(s, 0, mask & ((std::uint32_t{1} << end) - 1),
+				                       needle, m);
+			}
+			return not_found;
+		}
+
+		ISL_TARGET("avx2")
+		inline std::size_t find_first_of(const char* s, std::size_t n,
+		                                 const char* set, std::size_t k) noexcept {
+			__m256i values[16];
+			for (std::size_t j = 0; j != k; ++j) {
+				values[j] = _mm256_set1_epi8(set[j]);
+			}
+			std::size_t i = 0;
+			for (; i + width <= n; i += width) {
+				if (std::uint32_t mask = any_match(s + i, values, k)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			if (i != n) {
+				std::size_t at = n - width;
+				if (std::uint32_t mask = any_match(s + at, values, k) >> (i - at)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			return not_found;
+		}
+
+		ISL_TARGET("avx2")
+		inline std::size_t count_byte(const char* s, std::size_t n, char c) noexcept {
+			const __m256i value = _mm256_set1_epi8(c);
+			std::size_t count = 0;
+			std::size_t i = 0;
+			while (i + width <= n) {
+				std::size_t blocks = (n - i) / width < 255 ? (n - i) / width : 255;
+				__m256i counters = _mm256_setzero_si256();
+				for (std::size_t b = 0; b != blocks; ++b, i += width) {
+					counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(load(s + i), value));
+				}
+				__m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+				__m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums),
+				                               _mm256_extracti128_si256(sums, 1));
+				count += _mm_cvtsi128_si32(halves) + _mm_extract_epi16(halves, 4);
+			}
+			if (i != n) {
+				std::size_t at = n - width;
+				count += std::popcount(match(load(s + at), value) >> (i - at));
+			}
+			return count;
+		}
+
+		ISL_TARGET("avx2")
+		inline std::size_t mismatch(const char* a, const char* b, std::size_t n) noexcept {
+			std::size_t i = 0;
+			for (; i + width <= n; i += width) {
+				if (std::uint32_t mask = ~match(load(a + i), load(b + i))) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			if (i != n) {
+				std::size_t at = n - width;
+				if (std::uint32_t mask = ~match(load(a + at), load(b + at))) {
+					return at + std::countr_zero(mask);
+				}
+			}
+			return n;
+		}
+	}
+
+	// 64-byte blocks compare straight into mask registers, and the final
+	// partial block is read with a masked load instead of a reload.
+	namespace avx512 {
+		inline constexpr std::size_t width = 64;
+
+		// Lanes below `count` (at most width), the rest stay untouched.
+		inline __mmask64 first_lanes(std::size_t count) noexcept {
+			return count >= width ? ~__mmask64{0} : (__mmask64{1} << count) - 1;
+		}
+		ISL_TARGET("avx512f,avx512bw")
+		inline std::uint64_t match(const char* p, __mmask64 lanes, __m512i value) noexcept {
+			return _mm512_mask_cmpeq_epi8_mask(lanes, _mm512_maskz_loadu_epi8(lanes, p), value);
+		}
+
+		ISL_TARGET("avx512f,avx512bw")
+		inline std::size_t find_byte(const char* s, std::size_t n, char c) noexcept {
+			const __m512i value = _mm512_set1_epi8(c);
+			for (std::size_t i = 0; i < n; i += width) {
+				if (std::uint64_t mask = match(s + i, first_lanes(n - i), value)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			return not_found;
+		}
+
+		ISL_TARGET("avx512f,avx512bw")
+		inline std::size_t rfind_byte(const char* s, std::size_t n, char c) noexcept {
+			const __m512i value = _mm512_set1_epi8(c);
+			// bytes [0, end) are still unchecked
+			for (std::size_t end = n; end != 0;) {
+				std::size_t at = end > width ? end - width : 0;
+				if (std::uint64_t mask = match(s + at, first_lanes(end - at), value)) {
+					return at + 63 - std::countl_zero(mask);
+				}
+				end = at;
+			}
+			return not_found;
+		}
+
+		ISL_TARGET("avx512f,avx512bw,popcnt")
+		inline std::size_t count_byte(const char* s, std::size_t n, char c) noexcept {
+			const __m512i value = _mm512_set1_epi8(c);
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < n; i += width) {
+				count += std::popcount(match(s + i, first_lanes(n - i), value));
+			}
+			return count;
+		}
+	}
+#endif
+
+	// Dispatch. A wider kernel is worth its setup only once the input spans
+	// one of its blocks; shorter inputs go straight to the SSE2 kernels.
+
+	inline std::size_t find_byte(const char* s, std::size_t n, char c) noexcept {
+#if defined(__SSE2__)
+		if (n >= 64 && has_avx512bw()) {
+			return avx512::find_byte(s, n, c);
+		}
+		if (n >= 32 && has_avx2()) {
+			return avx2::find_byte(s, n, c);
+		}
+		return sse2::find_byte(s, n, c);
+#else
+		return scalar::find_byte(s, n, c);
+#endif
+	}
+
+	inline std::size_t rfind_byte(const char* s, std::size_t n, char c) noexcept {
+#if defined(__SSE2__)
+		if (n >= 64 && has_avx512bw()) {
+			return avx512::rfind_byte(s, n, c);
+		}
+		if (n >= 32 && has_avx2()) {
+			return avx2::rfind(s, n, &c, 1);
+		}
+		return sse2::rfind(s, n, &c, 1);
+#else
+		return scalar::rfind_byte(s, n, c);
+#endif
+	}
+
+	// Requires 1 <= m <= n.
+	inline std::size_t find(const char* s, std::size_t n,
+	                        const char* needle, std::size_t m) noexcept {
+#if defined(__SSE2__)
+		if (n - m + 1 >= 32 && has_avx2()) {
+			return avx2::find(s, n, needle, m);
+		}
+		return sse2::find(s, n, needle, m);
+#else
+		return scalar::find(s, 0, n - m + 1, needle, m);
+#endif
+	}
+
+	// Requires 1 <= m <= n.
+	inline std::size_t rfind(const char* s, std::size_t n,
+	                         const char* needle, std::size_t m) noexcept {
+#if defined(__SSE2__)
+		if (n - m + 1 >= 32 && has_avx2()) {
+			return avx2::rfind(s, n, needle, m);
+		}
+		return sse2::rfind(s, n, needle, m);
+#else
+		return scalar::rfind(s, n - m + 1, needle, m);
+#endif
+	}
+
+	inline std::size_t find_first_of(const char* s, std::size_t n,
+	                                 const char* set, std::size_t k) noexcept {
+#if defined(__SSE2__)
+		// a few broadcasts are cheaper than the three shuffles of a byte_set
+		if (k <= 4) {
+			if (n >= 32 && has_avx2()) {
+				return avx2::find_first_of(s, n, set, k);
+			}
+			return sse2::find_first_of(s, n, set, k);
+		}
+		return find_in_set(s, n, byte_set(set, k), true);
+#else
+		return scalar::find_first_of(s, n, set, k);
+#endif
+	}
+
+	inline std::size_t count_byte(const char* s, std::size_t n, char c) noexcept {
+#if defined(__SSE2__)
+		if (n >= 64 && has_avx512bw()) {
+			return avx512::count_byte(s, n, c);
+		}
+		if (n >= 32 && has_avx2()) {
+			return avx2::count_byte(s, n, c);
+		}
+		return sse2::count_byte(s, n, c);
+#else
+		return scalar::count_byte(s, n, c);
+#endif
+	}
+
+	inline std::size_t mismatch(const char* a, const char* b, std::size_t n) noexcept {
+#if defined(__SSE2__)
+		if (n >= 32 && has_avx2()) {
+			return avx2::mismatch(a, b, n);
+		}
+		return sse2::mismatch(a, b, n);
+#else
+		return scalar::mismatch(a, b, n);
+#endif
+	}
+}
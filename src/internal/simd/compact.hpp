@@ -0,0 +1,457 @@
+#pragma once
+
+#include <bit>         // std::countr_zero, std::popcount
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <type_traits> // std::is_same_v, std::is_floating_point_v
+
+#include "find.hpp"
+#include "simd.hpp"
+
+// Stream compaction kernels behind isl::remove, isl::remove_if,
+// isl::unique, isl::copy_if, isl::partition and isl::erase_if. T is
+// std::uint32_t, std::uint64_t, float or double, as in the search
+// kernels. A kernel asks `keep` which elements of each block it keeps,
+// as a mask with bit i set for p[i], and moves those with a single
+// permutation of the block: an AVX-512 compress, or under AVX2 a
+// permutation looked up by the mask.
+namespace isl::internal::simd {
+	// Keeps the elements that do not compare equal to value.
+	template <class T> struct keep_unequal {
+		T value;
+	};
+
+	// Keeps the elements that do not compare equal to the one before
+	// them; `previous` is the element before the first.
+	template <class T> struct keep_distinct {
+		T previous;
+	};
+
+	// Keeps the elements x for which bool(pred(x)) == Value, with x seen
+	// as the caller's Element.
+	template <class T, class Element, class Predicate, bool Value>
+	struct keep_where {
+		Predicate& pred;
+
+		std::uint64_t operator()(const T* p, std::size_t count) {
+			const Element* elements = reinterpret_cast<const Element*>(p);
+			std::uint64_t mask = 0;
+			for (std::size_t i = 0; i != count; ++i) {
+				mask |= std::uint64_t{static_cast<bool>(this->pred(elements[i])) == Value} << i;
+			}
+			return mask;
+		}
+	};
+
+	template <class Keep> inline constexpr bool is_keep_unequal = false;
+	template <class T> inline constexpr bool is_keep_unequal<keep_unequal<T>> = true;
+	template <class Keep> inline constexpr bool is_keep_distinct = false;
+	template <class T> inline constexpr bool is_keep_distinct<keep_distinct<T>> = true;
+
+	namespace scalar {
+		inline constexpr std::size_t compact_block = 64;
+
+		template <class T, class Keep>
+		std::uint64_t keep_mask(const T* p, std::size_t count, Keep& keep) {
+			if constexpr (is_keep_unequal<Keep>) {
+				std::uint64_t mask = 0;
+				for (std::size_t i = 0; i != count; ++i) {
+					mask |= std::uint64_t{!(p[i] == keep.value)} << i;
+				}
+				return mask;
+			} else if constexpr (is_keep_distinct<Keep>) {
+				std::uint64_t mask = 0;
+				for (std::size_t i = 0; i != count; ++i) {
+					mask |= std::uint64_t{!(p[i] == keep.previous)} << i;
+					keep.previous = p[i];
+				}
+				return mask;
+			} else {
+				return keep(p, count);
+			}
+		}
+
+		// Writes the kept elements of s to out, which is s or does not
+		// overlap it, and returns how many there are.
+		template <class T, class Keep>
+		std::size_t compact(const T* s, std::size_t n, T* out, Keep& keep) {
+			std::size_t kept = 0;
+			for (std::size_t i = 0; i < n; i += compact_block) {
+				std::size_t count = n - i < compact_block ? n - i : compact_block;
+				std::uint64_t mask = keep_mask(s + i, count, keep);
+				for (; mask != 0; mask &= mask - 1) {
+					out[kept++] = s[i + std::countr_zero(mask)];
+				}
+			}
+			return kept;
+		}
+
+		// Moves the kept elements to the front and returns how many there
+		// are; the rest follow in no particular order.
+		template <class T, class Keep>
+		std::size_t partition(T* s, std::size_t n, Keep& keep) {
+			std::size_t kept = 0;
+			for (std::size_t i = 0; i != n; ++i) {
+				if (keep_mask(s + i, 1, keep) != 0) {
+					T value = s[i];
+					s[i] = s[kept];
+					s[kept++] = value;
+				}
+			}
+			return kept;
+		}
+	}
+
+	// Entry m lists, a byte each, the 32-bit lanes of a 256-bit register
+	// in the order that puts the elements whose bits are set in m first
+	// and the others after them, both in their order. Elements span
+	// 8 / elements lanes.
+	struct partition_table {
+		std::uint64_t entries[256];
+	};
+
+	constexpr partition_table make_partition_table(unsigned elements) {
+		partition_table table{};
+		unsigned span = 8 / elements;
+		for (unsigned m = 0; m != 1u << elements; ++m) {
+			unsigned position = 0;
+			for (unsigned pass = 0; pass != 2; ++pass) {
+				unsigned kept = 1 - pass;
+				for (unsigned e = 0; e != elements; ++e) {
+					if ((m >> e & 1) != kept) {
+						continue;
+					}
+					for (unsigned lane = e * span; lane != (e + 1) * span; ++lane) {
+						table.entries[m] |= std::uint64_t{lane} << 8 * position++;
+					}
+				}
+			}
+		}
+		return table;
+	}
+
+	inline constexpr partition_table partition_table_32 = make_partition_table(8);
+	inline constexpr partition_table partition_table_64 = make_partition_table(4);
+
+#if defined(__SSE2__)
+	namespace avx2 {
+		// One bit per element of a compare result.
+		template <class T>
+		ISL_TARGET("avx2") inline std::uint32_t element_mask(__m256i block) noexcept {
+			if constexpr (sizeof(T) == 4) {
+				return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(block)));
+			} else {
+				return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(block)));
+			}
+		}
+
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i partition_block(__m256i x, std::uint32_t mask) noexcept {
+			const partition_table& table = sizeof(T) == 4 ? partition_table_32 : partition_table_64;
+			__m128i bytes = _mm_cvtsi64_si128(static_cast<long long>(table.entries[mask]));
+			return _mm256_permutevar8x32_epi32(x, _mm256_cvtepu8_epi32(bytes));
+		}
+
+		// Each element moved up by one, the last one wrapping to the first.
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i rotate_up(__m256i x) noexcept {
+			if constexpr (sizeof(T) == 4) {
+				return _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+			} else {
+				return _mm256_permute4x64_epi64(x, 0x93);
+			}
+		}
+
+		// Stores the first count elements of x only.
+		template <class T>
+		ISL_TARGET("avx2") inline void store_first(T* p, __m256i x, std::size_t count) noexcept {
+			if constexpr (sizeof(T) == 4) {
+				__m256i lanes = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)),
+				                                   _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+				_mm256_maskstore_epi32(reinterpret_cast<int*>(p), lanes, x);
+			} else {
+				__m256i lanes = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(count)),
+				                                   _mm256_setr_epi64x(0, 1, 2, 3));
+				_mm256_maskstore_epi64(reinterpret_cast<long long*>(p), lanes, x);
+			}
+		}
+
+		// In place a whole block is stored: the lanes past the kept
+		// elements land on elements already read.
+		template <class T, class Keep>
+		ISL_TARGET("avx2,popcnt")
+		std::size_t compact(const T* s, std::size_t n, T* out, Keep& keep) {
+			constexpr std::size_t lanes = width / sizeof(T);
+			constexpr std::uint32_t all = (1u << lanes) - 1;
+			const bool in_place = out == s;
+			__m256i value = _mm256_setzero_si256();
+			__m256i previous = _mm256_setzero_si256();
+			if constexpr (is_keep_unequal<Keep>) {
+				value = splat(keep.value);
+			} else if constexpr (is_keep_distinct<Keep>) {
+				previous = splat(keep.previous);
+			}
+			std::size_t kept = 0;
+			std::size_t i = 0;
+			for (; i + lanes <= n; i += lanes) {
+				__m256i x = load(s + i);
+				std::uint32_t mask;
+				if constexpr (is_keep_unequal<Keep>) {
+					mask = ~element_mask<T>(equal<T>(x, value)) & all;
+				} else if constexpr (is_keep_distinct<Keep>) {
+					__m256i rotated = rotate_up<T>(x);
+					__m256i before = _mm256_blend_epi32(rotated, previous, sizeof(T) == 4 ? 0x01 : 0x03);
+					mask = ~element_mask<T>(equal<T>(x, before)) & all;
+					previous = rotated;
+					keep.previous = s[i + lanes - 1];
+				} else {
+					mask = static_cast<__mmask16>(keep(s + i, lanes));
+				}
+				__m256i block = partition_block<T>(x, mask);
+				std::size_t count = static_cast<std::size_t>(std::popcount(mask));
+				if (in_place) {
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + kept), block);
+				} else {
+					store_first(out + kept, block, count);
+				}
+				kept += count;
+			}
+			return kept + scalar::compact(s + i, n - i, out + kept, keep);
+		}
+
+		// Partitions in place with the scheme of Bramas, "A Novel Hybrid
+		// Quicksort Algorithm Vectorized using AVX-512 on Intel Skylake"
+		// (IJACSA 2017): the first and last blocks are held back, so both
+		// ends keep a block of room, and each block read from the end with
+		// less room is permuted once and stored whole to both ends, the
+		// kept elements at the front and the rest at the back. Needs at
+		// least two blocks.
+		template <class T, class Keep>
+		ISL_TARGET("avx2,popcnt")
+		std::size_t partition(T* s, std::size_t n, Keep& keep) {
+			constexpr std::size_t lanes = width / sizeof(T);
+			__m256i first_block = load(s);
+			__m256i last_block = load(s + n - lanes);
+			std::size_t read_left = lanes;
+			std::size_t read_right = n - lanes;
+			std::size_t write_left = 0;
+			std::size_t write_right = n;
+			while (read_right - read_left >= lanes) {
+				const T* p;
+				if (read_left - write_left <= write_right - read_right) {
+					p = s + read_left;
+					read_left += lanes;
+				} else {
+					read_right -= lanes;
+					p = s + read_right;
+				}
+				__m256i x = load(p);
+				auto mask = static_cast<__mmask16>(keep(p, lanes));
+				__m256i block = partition_block<T>(x, mask);
+				std::size_t count = static_cast<std::size_t>(std::popcount(mask));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(s + write_left), block);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(s + write_right - lanes), block);
+				write_left += count;
+				write_right -= lanes - count;
+			}
+			// the unread middle and the held-back blocks fill the gap
+			T rest[3 * lanes];
+			std::size_t middle = read_right - read_left;
+			for (std::size_t j = 0; j != middle; ++j) {
+				rest[j] = s[read_left + j];
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(rest + middle), first_block);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(rest + middle + lanes), last_block);
+			std::uint64_t mask = keep(rest, middle + 2 * lanes);
+			for (std::size_t j = 0; j != middle + 2 * lanes; ++j) {
+				if (mask >> j & 1) {
+					s[write_left++] = rest[j];
+				} else {
+					s[--write_right] = rest[j];
+				}
+			}
+			return write_left;
+		}
+	}
+
+	namespace avx512 {
+		// Masks stay __mmask16 on this path: GCC 12 may spill a widened mask
+		// register with a 16-bit kmovw and reload all 32 bits.
+		template <class T>
+		ISL_TARGET("avx512f,avx512bw")
+		inline __mmask16 unequal_mask(__m512i a, __m512i b) noexcept {
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm512_cmpneq_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b));
+			} else if constexpr (std::is_same_v<T, double>) {
+				return _mm512_cmpneq_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b));
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm512_cmpneq_epi32_mask(a, b);
+			} else {
+				return _mm512_cmpneq_epi64_mask(a, b);
+			}
+		}
+
+		template <class T>
+		ISL_TARGET("avx512f,avx512bw")
+		inline __m512i splat(T value) noexcept {
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm512_castps_si512(_mm512_set1_ps(value));
+			} else if constexpr (std::is_same_v<T, double>) {
+				return _mm512_castpd_si512(_mm512_set1_pd(value));
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm512_set1_epi32(static_cast<int>(value));
+			} else {
+				return _mm512_set1_epi64(static_cast<long long>(value));
+			}
+		}
+
+		// The elements of x selected by mask, packed at the bottom.
+		template <class T>
+		ISL_TARGET("avx512f,avx512bw")
+		inline __m512i compress(__m512i x, __mmask16 mask) noexcept {
+			if constexpr (sizeof(T) == 4) {
+				return _mm512_maskz_compress_epi32(mask, x);
+			} else {
+				return _mm512_maskz_compress_epi64(static_cast<__mmask8>(mask), x);
+			}
+		}
+
+		template <class T>
+		ISL_TARGET("avx512f,avx512bw")
+		inline void store_first(T* p, __m512i x, std::size_t count) noexcept {
+			if constexpr (sizeof(T) == 4) {
+				_mm512_mask_storeu_epi32(p, static_cast<__mmask16>((1u << count) - 1), x);
+			} else {
+				_mm512_mask_storeu_epi64(p, static_cast<__mmask8>((1u << count) - 1), x);
+			}
+		}
+
+		// Each element preceded by the one before it, the first by the
+		// last element of previous.
+		template <class T>
+		ISL_TARGET("avx512f,avx512bw")
+		inline __m512i shift_in(__m512i x, __m512i previous) noexcept {
+			if constexpr (sizeof(T) == 4) {
+				return _mm512_alignr_epi32(x, previous, 15);
+			} else {
+				return _mm512_alignr_epi64(x, previous, 7);
+			}
+		}
+
+		template <class T, class Keep>
+		ISL_TARGET("avx512f,avx512bw,popcnt")
+		std::size_t compact(const T* s, std::size_t n, T* out, Keep& keep) {
+			constexpr std::size_t lanes = width / sizeof(T);
+			const bool in_place = out == s;
+			__m512i value = _mm512_setzero_si512();
+			__m512i previous = _mm512_setzero_si512();
+			if constexpr (is_keep_unequal<Keep>) {
+				value = splat(keep.value);
+			} else if constexpr (is_keep_distinct<Keep>) {
+				previous = splat(keep.previous);
+			}
+			std::size_t kept = 0;
+			std::size_t i = 0;
+			for (; i + lanes <= n; i += lanes) {
+				__m512i x = _mm512_loadu_si512(s + i);
+				__mmask16 mask;
+				if constexpr (is_keep_unequal<Keep>) {
+					mask = unequal_mask<T>(x, value);
+				} else if constexpr (is_keep_distinct<Keep>) {
+					mask = unequal_mask<T>(x, shift_in<T>(x, previous));
+					previous = x;
+					keep.previous = s[i + lanes - 1];
+				} else {
+					mask = static_cast<__mmask16>(keep(s + i, lanes));
+				}
+				__m512i block = compress<T>(x, mask);
+				std::size_t count = static_cast<std::size_t>(std::popcount(mask));
+				if (in_place) {
+					_mm512_storeu_si512(out + kept, block);
+				} else {
+					store_first(out + kept, block, count);
+				}
+				kept += count;
+			}
+			return kept + scalar::compact(s + i, n - i, out + kept, keep);
+		}
+
+		// avx2::partition with compresses: the kept elements go to the
+		// front whole and the rest to the back through a masked store.
+		template <class T, class Keep>
+		ISL_TARGET("avx512f,avx512bw,popcnt")
+		std::size_t partition(T* s, std::size_t n, Keep& keep) {
+			constexpr std::size_t lanes = width / sizeof(T);
+			constexpr std::uint32_t all = (1u << lanes) - 1;
+			__m512i first_block = _mm512_loadu_si512(s);
+			__m512i last_block = _mm512_loadu_si512(s + n - lanes);
+			std::size_t read_left = lanes;
+			std::size_t read_right = n - lanes;
+			std::size_t write_left = 0;
+			std::size_t write_right = n;
+			while (read_right - read_left >= lanes) {
+				const T* p;
+				if (read_left - write_left <= write_right - read_right) {
+					p = s + read_left;
+					read_left += lanes;
+				} else {
+					read_right -= lanes;
+					p = s + read_right;
+				}
+				__m512i x = _mm512_loadu_si512(p);
+				auto mask = static_cast<__mmask16>(keep(p, lanes));
+				std::size_t count = static_cast<std::size_t>(std::popcount(mask));
+				_mm512_storeu_si512(s + write_left, compress<T>(x, mask));
+				write_left += count;
+				write_right -= lanes - count;
+				store_first(s + write_right, compress<T>(x, static_cast<__mmask16>(~mask & all)), lanes - count);
+			}
+			T rest[3 * lanes];
+			std::size_t middle = read_right - read_left;
+			for (std::size_t j = 0; j != middle; ++j) {
+				rest[j] = s[read_left + j];
+			}
+			_mm512_storeu_si512(rest + middle, first_block);
+			_mm512_storeu_si512(rest + middle + lanes, last_block);
+			std::uint64_t mask = keep(rest, middle + 2 * lanes);
+			for (std::size_t j = 0; j != middle + 2 * lanes; ++j) {
+				if (mask >> j & 1) {
+					s[write_left++] = rest[j];
+				} else {
+					s[--write_right] = rest[j];
+				}
+			}
+			return write_left;
+		}
+	}
+#endif
+
+	// Dispatch, with the thresholds of the search kernels.
+
+	template <class T, class Keep>
+	std::size_t compact(const T* s, std::size_t n, T* out, Keep keep) {
+#if defined(__SSE2__)
+		if (n * sizeof(T) >= 64 && has_avx512bw()) {
+			return avx512::compact(s, n, out, keep);
+		}
+		if (n * sizeof(T) >= 32 && has_avx2()) {
+			return avx2::compact(s, n, out, keep);
+		}
+#endif
+		return scalar::compact(s, n, out, keep);
+	}
+
+	// The partitions need two blocks and take callable keeps only.
+	template <class T, class Keep>
+	std::size_t partition(T* s, std::size_t n, Keep keep) {
+#if defined(__SSE2__)
+		if (n * sizeof(T) >= 2 * 64 && has_avx512bw()) {
+			return avx512::partition(s, n, keep);
+		}
+		if (n * sizeof(T) >= 2 * 32 && has_avx2()) {
+			return avx2::partition(s, n, keep);
+		}
+#endif
+		return scalar::partition(s, n, keep);
+	}
+}
@@ -0,0 +1,339 @@
+#pragma once
+
+#include <array>   // std::array
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+#include "simd.hpp"
+
+// Base64 (RFC 4648, standard alphabet, padded) and hex kernels behind the
+// encoding module. Outputs must have room for the whole result; decoders
+// may write up to 8 bytes past what they report while more input follows,
+// but never past the size the encoding module documents.
+namespace isl::internal::simd {
+	// Result of a decoder: on failure `read` is the offset of the first
+	// offending input char and `written` what the input before its group
+	// produced.
+	struct decoded {
+		std::size_t read;
+		std::size_t written;
+		bool valid;
+	};
+
+	inline constexpr unsigned char invalid_digit = 0xFF;
+
+	inline constexpr char base64_alphabet[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	inline constexpr std::array<unsigned char, 256> base64_values = [] {
+		std::array<unsigned char, 256> values{};
+		values.fill(invalid_digit);
+		for (unsigned char i = 0; i != 64; ++i) {
+			values[static_cast<unsigned char>(base64_alphabet[i])] = i;
+		}
+		return values;
+	}();
+
+	inline constexpr std::array<unsigned char, 256> hex_values = [] {
+		std::array<unsigned char, 256> values{};
+		values.fill(invalid_digit);
+		for (unsigned char i = 0; i != 10; ++i) {
+			values['0' + i] = i;
+		}
+		for (unsigned char i = 0; i != 6; ++i) {
+			values['a' + i] = 10 + i;
+			values['A' + i] = 10 + i;
+		}
+		return values;
+	}();
+
+	namespace scalar {
+		// Encodes [i, n) to out + w; i must be a multiple of 3.
+		inline std::size_t base64_encode(const unsigned char* s, std::size_t n,
+		                                 std::size_t i, char* out,
+		                                 std::size_t w) noexcept {
+			for (; i + 3 <= n; i += 3, w += 4) {
+				std::uint32_t v = std::uint32_t{s[i]} << 16 |
+				                  std::uint32_t{s[i + 1]} << 8 | s[i + 2];
+				out[w] = base64_alphabet[v >> 18];
+				out[w + 1] = base64_alphabet[v >> 12 & 0x3F];
+				out[w + 2] = base64_alphabet[v >> 6 & 0x3F];
+				out[w + 3] = base64_alphabet[v & 0x3F];
+			}
+			if (i != n) {
+				std::uint32_t v = std::uint32_t{s[i]} << 16;
+				if (i + 2 == n) {
+					v |= std::uint32_t{s[i + 1]} << 8;
+				}
+				out[w] = base64_alphabet[v >> 18];
+				out[w + 1] = base64_alphabet[v >> 12 & 0x3F];
+				out[w + 2] = i + 2 == n ? base64_alphabet[v >> 6 & 0x3F] : '=';
+				out[w + 3] = '=';
+				w += 4;
+			}
+			return w;
+		}
+
+		// Decodes [i, n) of unpadded base64 to out + w.
+		inline decoded base64_decode(const unsigned char* s, std::size_t n,
+		                             std::size_t i, unsigned char* out,
+		                             std::size_t w) noexcept {
+			for (; i + 4 <= n; i += 4, w += 3) {
+				unsigned char a = base64_values[s[i]];
+				unsigned char b = base64_values[s[i + 1]];
+				unsigned char c = base64_values[s[i + 2]];
+				unsigned char d = base64_values[s[i + 3]];
+				// invalid_digit is the only value with the top bits set
+				if (((a | b | c | d) & 0xC0) != 0) {
+					std::size_t k = 0;
+					while (base64_values[s[i + k]] != invalid_digit) {
+						++k;
+					}
+					return {i + k, w, false};
+				}
+				std::uint32_t v = std::uint32_t{a} << 18 | std::uint32_t{b} << 12 |
+				                  std::uint32_t{c} << 6 | d;
+				out[w] = static_cast<unsigned char>(v >> 16);
+				out[w + 1] = static_cast<unsigned char>(v >> 8);
+				out[w + 2] = static_cast<unsigned char>(v);
+			}
+			if (i == n) {
+				return {n, w, true};
+			}
+			// two or three chars left; one cannot encode a whole byte
+			std::uint32_t v = 0;
+			for (std::size_t k = 0; k != n - i; ++k) {
+				unsigned char digit = base64_values[s[i + k]];
+				if (digit == invalid_digit) {
+					return {i + k, w, false};
+				}
+				v |= std::uint32_t{digit} << (18 - 6 * k);
+			}
+			if (n - i == 1) {
+				return {i, w, false};
+			}
+			out[w++] = static_cast<unsigned char>(v >> 16);
+			if (n - i == 3) {
+				out[w++] = static_cast<unsigned char>(v >> 8);
+			}
+			return {n, w, true};
+		}
+
+		inline void hex_encode(const unsigned char* s, std::size_t n,
+		                       std::size_t i, char* out,
+		                       const char* digits) noexcept {
+			for (; i != n; ++i) {
+				out[2 * i] = digits[s[i] >> 4];
+				out[2 * i + 1] = digits[s[i] & 0x0F];
+			}
+		}
+
+		// Decodes pairs [i, n) to out + i / 2; n must be even.
+		inline decoded hex_decode(const unsigned char* s, std::size_t n,
+		                          std::size_t i, unsigned char* out) noexcept {
+			for (; i != n; i += 2) {
+				unsigned char high = hex_values[s[i]];
+				unsigned char low = hex_values[s[i + 1]];
+				if (((high | low) & 0xF0) != 0) {
+					return {high == invalid_digit ? i : i + 1, i / 2, false};
+				}
+				out[i / 2] = static_cast<unsigned char>(high << 4 | low);
+			}
+			return {n, n / 2, true};
+		}
+	}
+
+#if defined(__SSE2__)
+	namespace avx2 {
+		// Base64 after Muła and Lemire, "Faster Base64 Encoding and Decoding
+		// Using AVX2 Instructions" (2018), as implemented by aklomp/base64.
+
+		// 24 input bytes, 12 per lane, to 32 six-bit values.
+		ISL_TARGET("avx2")
+		inline __m256i base64_split(const unsigned char* s) noexcept {
+			__m256i in = _mm256_inserti128_si256(
+				_mm256_castsi128_si256(
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(s))),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 12)), 1);
+			// every 3 bytes abc to the 4 bytes b a c b, then isolate each
+			// 6-bit field with a multiply-shift per 16-bit half
+			in = _mm256_shuffle_epi8(in, _mm256_setr_epi8(
+				1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+				1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+			__m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00));
+			__m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+			__m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0));
+			__m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+			return _mm256_or_si256(t1, t3);
+		}
+
+		// Six-bit values to alphabet chars: one offset per value range,
+		// picked by a shuffle.
+		ISL_TARGET("avx2")
+		inline __m256i base64_translate(__m256i values) noexcept {
+			const __m256i offsets = _mm256_setr_epi8(
+				65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+				65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+			__m256i index = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+			index = _mm256_sub_epi8(
+				index, _mm256_cmpgt_epi8(values, _mm256_set1_epi8(25)));
+			return _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, index));
+		}
+
+		ISL_TARGET("avx2")
+		inline std::size_t base64_encode(const unsigned char* s, std::size_t n,
+		                                 char* out) noexcept {
+			std::size_t i = 0;
+			std::size_t w = 0;
+			// the second lane's load reads 28 bytes
+			for (; i + 28 <= n; i += 24, w += 32) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + w),
+				                    base64_translate(base64_split(s + i)));
+			}
+			return scalar::base64_encode(s, n, i, out, w);
+		}
+
+		ISL_TARGET("avx2")
+		inline decoded base64_decode(const unsigned char* s, std::size_t n,
+		                             unsigned char* out) noexcept {
+			const __m256i low_table = _mm256_setr_epi8(
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+				0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+				0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+			const __m256i high_table = _mm256_setr_epi8(
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+				0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+				0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+			const __m256i roll_table = _mm256_setr_epi8(
+				0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+			const __m256i slash = _mm256_set1_epi8(0x2F);
+
+			std::size_t i = 0;
+			std::size_t w = 0;
+			// each step stores 32 bytes of which 24 are output, so stop while
+			// at least 12 more chars, 9 more output bytes, follow
+			for (; i + 44 <= n; i += 32, w += 24) {
+				__m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+				// a char is valid iff its nibble classes share no bit
+				__m256i high_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), slash);
+				__m256i low_nibbles = _mm256_and_si256(in, slash);
+				__m256i high = _mm256_shuffle_epi8(high_table, high_nibbles);
+				__m256i low = _mm256_shuffle_epi8(low_table, low_nibbles);
+				if (!_mm256_testz_si256(low, high)) {
+					break;
+				}
+				__m256i roll = _mm256_shuffle_epi8(
+					roll_table,
+					_mm256_add_epi8(_mm256_cmpeq_epi8(in, slash), high_nibbles));
+				__m256i values = _mm256_add_epi8(in, roll);
+
+				// pack 4 six-bit values to 3 bytes per 32-bit lane
+				__m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+				__m256i words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+				words = _mm256_shuffle_epi8(words, _mm256_setr_epi8(
+					2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+					2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+				words = _mm256_permutevar8x32_epi32(
+					words, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + w), words);
+			}
+			return scalar::base64_decode(s, n, i, out, w);
+		}
+
+		ISL_TARGET("avx2")
+		inline void hex_encode(const unsigned char* s, std::size_t n, char* out,
+		                       const char* digits) noexcept {
+			const __m256i table = _mm256_broadcastsi128_si256(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+			const __m256i low_nibble = _mm256_set1_epi16(0x0F);
+			std::size_t i = 0;
+			for (; i + 16 <= n; i += 16) {
+				__m256i in = _mm256_cvtepu8_epi16(
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+				// high nibble to the first byte of each pair, low to the second
+				__m256i nibbles = _mm256_or_si256(
+					_mm256_srli_epi16(in, 4),
+					_mm256_slli_epi16(_mm256_and_si256(in, low_nibble), 8));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i),
+				                    _mm256_shuffle_epi8(table, nibbles));
+			}
+			scalar::hex_encode(s, n, i, out, digits);
+		}
+
+		// n must be even.
+		ISL_TARGET("avx2")
+		inline decoded hex_decode(const unsigned char* s, std::size_t n,
+		                          unsigned char* out) noexcept {
+			std::size_t i = 0;
+			for (; i + 32 <= n; i += 32) {
+				__m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+				__m256i digit = _mm256_sub_epi8(in, _mm256_set1_epi8('0'));
+				__m256i letter = _mm256_sub_epi8(
+					_mm256_or_si256(in, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+				__m256i is_digit = _mm256_cmpeq_epi8(
+					_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+				__m256i is_letter = _mm256_cmpeq_epi8(
+					_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+				if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1) {
+					break;
+				}
+				__m256i values = _mm256_blendv_epi8(
+					_mm256_add_epi8(letter, _mm256_set1_epi8(10)), digit, is_digit);
+				// pairs (high, low) to high * 16 + low, then narrow
+				__m256i bytes = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+				bytes = _mm256_packus_epi16(bytes, bytes);
+				bytes = _mm256_permute4x64_epi64(bytes, 0x08);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2),
+				                 _mm256_castsi256_si128(bytes));
+			}
+			return scalar::hex_decode(s, n, i, out);
+		}
+	}
+#endif
+
+	// Dispatch. Decoders take the input without its padding.
+
+	inline std::size_t base64_encode(const unsigned char* s, std::size_t n,
+	                                 char* out) noexcept {
+#if defined(__SSE2__)
+		if (n >= 28 && has_avx2()) {
+			return avx2::base64_encode(s, n, out);
+		}
+#endif
+		return scalar::base64_encode(s, n, 0, out, 0);
+	}
+
+	inline decoded base64_decode(const unsigned char* s, std::size_t n,
+	                             unsigned char* out) noexcept {
+#if defined(__SSE2__)
+		if (n >= 44 && has_avx2()) {
+			return avx2::base64_decode(s, n, out);
+		}
+#endif
+		return scalar::base64_decode(s, n, 0, out, 0);
+	}
+
+	inline void hex_encode(const unsigned char* s, std::size_t n, char* out,
+	                       const char* digits) noexcept {
+#if defined(__SSE2__)
+		if (n >= 16 && has_avx2()) {
+			avx2::hex_encode(s, n, out, digits);
+			return;
+		}
+#endif
+		scalar::hex_encode(s, n, 0, out, digits);
+	}
+
+	inline decoded hex_decode(const unsigned char* s, std::size_t n,
+	                          unsigned char* out) noexcept {
+#if defined(__SSE2__)
+		if (n >= 32 && has_avx2()) {
+			return avx2::hex_decode(s, n, out);
+		}
+#endif
+		return scalar::hex_decode(s, n, 0, out);
+	}
+}
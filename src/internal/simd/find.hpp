@@ -0,0 +1,389 @@
+#pragma once
+
+#include <bit>         // std::countr_zero, std::popcount
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint16_t, std::uint32_t, std::uint64_t
+#include <type_traits> // std::is_same_v, std::conditional_t
+
+#include "bytes.hpp"
+#include "simd.hpp"
+
+// Search kernels for arrays of wider elements behind isl::find and
+// isl::count. T is std::uint16_t, std::uint32_t, std::uint64_t, float or
+// double: integers compare bitwise, so signed callers pass their values
+// reinterpreted, and floats compare as floats, so NaN matches nothing and
+// 0.0 matches -0.0. Single bytes go to the byte kernels.
+namespace isl::internal::simd {
+	namespace scalar {
+		template <class T>
+		std::size_t find_value(const T* s, std::size_t n, T value) noexcept {
+			for (std::size_t i = 0; i != n; ++i) {
+				if (s[i] == value) {
+					return i;
+				}
+			}
+			return not_found;
+		}
+
+		template <class T>
+		std::size_t count_value(const T* s, std::size_t n, T value) noexcept {
+			std::size_t count = 0;
+			for (std::size_t i = 0; i != n; ++i) {
+				count += s[i] == value;
+			}
+			return count;
+		}
+	}
+
+	// Lane counters are flushed before 16-bit lanes can overflow.
+	inline constexpr std::size_t max_counted_blocks = 0xFFFF;
+
+	// Sums the lanes of a counter block stored to memory.
+	template <class T, std::size_t bytes>
+	std::size_t sum_counters(const unsigned char (&block)[bytes]) noexcept {
+		using lane = std::conditional_t<sizeof(T) == 2, std::uint16_t,
+		             std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+		std::size_t sum = 0;
+		for (std::size_t i = 0; i != bytes; i += sizeof(T)) {
+			lane value;
+			__builtin_memcpy(&value, block + i, sizeof(T));
+			sum += value;
+		}
+		return sum;
+	}
+
+#if defined(__SSE2__)
+	// The block widths are the byte kernels'. Movemask yields sizeof(T)
+	// bits per element, so indices are bit positions divided by sizeof(T).
+	namespace sse2 {
+		template <class T> inline __m128i load(const T* p) noexcept {
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		}
+
+		template <class T> inline __m128i splat(T value) noexcept {
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm_castps_si128(_mm_set1_ps(value));
+			} else if constexpr (std::is_same_v<T, double>) {
+				return _mm_castpd_si128(_mm_set1_pd(value));
+			} else if constexpr (sizeof(T) == 2) {
+				return _mm_set1_epi16(static_cast<short>(value));
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm_set1_epi32(static_cast<int>(value));
+			} else {
+				return _mm_set1_epi64x(static_cast<long long>(value));
+			}
+		}
+
+		// All ones in the lanes that are equal.
+		template <class T> inline __m128i equal(__m128i a, __m128i b) noexcept {
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+			} else if constexpr (std::is_same_v<T, double>) {
+				return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+			} else if constexpr (sizeof(T) == 2) {
+				return _mm_cmpeq_epi16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm_cmpeq_epi32(a, b);
+			} else {
+				// both halves of a 64-bit lane must match
+				__m128i halves = _mm_cmpeq_epi32(a, b);
+				return _mm_and_si128(halves, _mm_shuffle_epi32(halves, 0xB1));
+			}
+		}
+
+		template <class T> inline __m128i subtract(__m128i a, __m128i b) noexcept {
+			if constexpr (sizeof(T) == 2) {
+				return _mm_sub_epi16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm_sub_epi32(a, b);
+			} else {
+				return _mm_sub_epi64(a, b);
+			}
+		}
+
+		template <class T>
+		inline std::uint32_t match(const T* p, __m128i value) noexcept {
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(equal<T>(load(p), value)));
+		}
+
+		template <class T>
+		std::size_t find_value(const T* s, std::size_t n, T v) noexcept {
+			constexpr std::size_t lanes = width / sizeof(T);
+			if (n < lanes) {
+				return scalar::find_value(s, n, v);
+			}
+			const __m128i value = splat(v);
+			std::size_t i = 0;
+			for (; i + lanes <= n; i += lanes) {
+				if (std::uint32_t mask = match(s + i, value)) {
+					return i + std::countr_zero(mask) / sizeof(T);
+				}
+			}
+			if (i != n) {
+				std::size_t at = n - lanes;
+				if (std::uint32_t mask = match(s + at, value) >> ((i - at) * sizeof(T))) {
+					return i + std::countr_zero(mask) / sizeof(T);
+				}
+			}
+			return not_found;
+		}
+
+		// Matches accumulate in per-lane counters: equal lanes are -1.
+		template <class T>
+		std::size_t count_value(const T* s, std::size_t n, T v) noexcept {
+			constexpr std::size_t lanes = width / sizeof(T);
+			if (n < lanes) {
+				return scalar::count_value(s, n, v);
+			}
+			const __m128i value = splat(v);
+			std::size_t count = 0;
+			std::size_t i = 0;
+			while (i + lanes <= n) {
+				std::size_t blocks = (n - i) / lanes;
+				blocks = blocks < max_counted_blocks ? blocks : max_counted_blocks;
+				__m128i counters = _mm_setzero_si128();
+				for (std::size_t b = 0; b != blocks; ++b, i += lanes) {
+					counters = subtract<T>(counters, equal<T>(load(s + i), value));
+				}
+				unsigned char block[width];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(block), counters);
+				count += sum_counters<T>(block);
+			}
+			if (i != n) {
+				std::size_t at = n - lanes;
+				count += std::popcount(match(s + at, value) >> ((i - at) * sizeof(T))) / sizeof(T);
+			}
+			return count;
+		}
+	}
+
+	namespace avx2 {
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i load(const T* p) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		}
+
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i splat(T value) noexcept {
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm256_castps_si256(_mm256_set1_ps(value));
+			} else if constexpr (std::is_same_v<T, double>) {
+				return _mm256_castpd_si256(_mm256_set1_pd(value));
+			} else if constexpr (sizeof(T) == 2) {
+				return _mm256_set1_epi16(static_cast<short>(value));
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm256_set1_epi32(static_cast<int>(value));
+			} else {
+				return _mm256_set1_epi64x(static_cast<long long>(value));
+			}
+		}
+
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i equal(__m256i a, __m256i b) noexcept {
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm256_castps_si256(_mm256_cmp_ps(
+					_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+			} else if constexpr (std::is_same_v<T, double>) {
+				return _mm256_castpd_si256(_mm256_cmp_pd(
+					_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+			} else if constexpr (sizeof(T) == 2) {
+				return _mm256_cmpeq_epi16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm256_cmpeq_epi32(a, b);
+			} else {
+				return _mm256_cmpeq_epi64(a, b);
+			}
+		}
+
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i subtract(__m256i a, __m256i b) noexcept {
+			if constexpr (sizeof(T) == 2) {
+				return _mm256_sub_epi16(a, b);
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm256_sub_epi32(a, b);
+			} else {
+				return _mm256_sub_epi64(a, b);
+			}
+		}
+
+		ISL_TARGET("avx2") inline std::uint32_t mask_of(__m256i block) noexcept {
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(block));
+		}
+
+		template <class T>
+		ISL_TARGET("avx2")
+		inline std::uint32_t match(const T* p, __m256i value) noexcept {
+			return mask_of(equal<T>(load(p), value));
+		}
+
+		template <class T>
+		ISL_TARGET("avx2")
+		std::size_t find_value(const T* s, std::size_t n, T v) noexcept {
+			constexpr std::size_t lanes = width / sizeof(T);
+			const __m256i value = splat(v);
+			std::size_t i = 0;
+			// four blocks per iteration, since most blocks have no match
+			for (; i + 4 * lanes <= n; i += 4 * lanes) {
+				__m256i b0 = equal<T>(load(s + i), value);
+				__m256i b1 = equal<T>(load(s + i + lanes), value);
+				__m256i b2 = equal<T>(load(s + i + 2 * lanes), value);
+				__m256i b3 = equal<T>(load(s + i + 3 * lanes), value);
+				__m256i any = _mm256_or_si256(_mm256_or_si256(b0, b1),
+				                              _mm256_or_si256(b2, b3));
+				if (_mm256_testz_si256(any, any)) {
+					continue;
+				}
+				__m256i blocks[4] = {b0, b1, b2, b3};
+				for (std::size_t j = 0;; ++j) {
+					if (std::uint32_t mask = mask_of(blocks[j])) {
+						return i + j * lanes + std::countr_zero(mask) / sizeof(T);
+					}
+				}
+			}
+			for (; i + lanes <= n; i += lanes) {
+				if (std::uint32_t mask = match(s + i, value)) {
+					return i + std::countr_zero(mask) / sizeof(T);
+				}
+			}
+			if (i != n) {
+				std::size_t at = n - lanes;
+				if (std::uint32_t mask = match(s + at, value) >> ((i - at) * sizeof(T))) {
+					return i + std::countr_zero(mask) / sizeof(T);
+				}
+			}
+			return not_found;
+		}
+
+		template <class T>
+		ISL_TARGET("avx2,popcnt")
+		std::size_t count_value(const T* s, std::size_t n, T v) noexcept {
+			constexpr std::size_t lanes = width / sizeof(T);
+			const __m256i value = splat(v);
+			std::size_t count = 0;
+			std::size_t i = 0;
+			while (i + lanes <= n) {
+				std::size_t blocks = (n - i) / lanes;
+				blocks = blocks < max_counted_blocks ? blocks : max_counted_blocks;
+				// two chains of counters to hide the compare latency
+				__m256i c0 = _mm256_setzero_si256();
+				__m256i c1 = _mm256_setzero_si256();
+				std::size_t b = 0;
+				for (; b + 2 <= blocks; b += 2, i += 2 * lanes) {
+					c0 = subtract<T>(c0, equal<T>(load(s + i), value));
+					c1 = subtract<T>(c1, equal<T>(load(s + i + lanes), value));
+				}
+				if (b != blocks) {
+					c0 = subtract<T>(c0, equal<T>(load(s + i), value));
+					i += lanes;
+				}
+				unsigned char block[width];
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(block), c0);
+				count += sum_counters<T>(block);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(block), c1);
+				count += sum_counters<T>(block);
+			}
+			if (i != n) {
+				std::size_t at = n - lanes;
+				count += std::popcount(match(s + at, value) >> ((i - at) * sizeof(T))) / sizeof(T);
+			}
+			return count;
+		}
+	}
+
+	// Compares go straight into mask registers with one bit per element,
+	// and the final partial block is read with a masked load.
+	namespace avx512 {
+		template <class T>
+		ISL_TARGET("avx512f,avx512bw")
+		inline std::uint64_t match(const T* p, std::size_t count, T v) noexcept {
+			constexpr std::size_t lanes = width / sizeof(T);
+			__mmask64 mask = count >= lanes ? ~__mmask64{0} : (__mmask64{1} << count) - 1;
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm512_mask_cmp_ps_mask(static_cast<__mmask16>(mask),
+				                               _mm512_maskz_loadu_ps(static_cast<__mmask16>(mask), p),
+				                               _mm512_set1_ps(v), _CMP_EQ_OQ);
+			} else if constexpr (std::is_same_v<T, double>) {
+				return _mm512_mask_cmp_pd_mask(static_cast<__mmask8>(mask),
+				                               _mm512_maskz_loadu_pd(static_cast<__mmask8>(mask), p),
+				                               _mm512_set1_pd(v), _CMP_EQ_OQ);
+			} else if constexpr (sizeof(T) == 2) {
+				auto lanes_mask = static_cast<__mmask32>(mask);
+				return _mm512_mask_cmpeq_epi16_mask(lanes_mask, _mm512_maskz_loadu_epi16(lanes_mask, p),
+				                                    _mm512_set1_epi16(static_cast<short>(v)));
+			} else if constexpr (sizeof(T) == 4) {
+				auto lanes_mask = static_cast<__mmask16>(mask);
+				return _mm512_mask_cmpeq_epi32_mask(lanes_mask, _mm512_maskz_loadu_epi32(lanes_mask, p),
+				                                    _mm512_set1_epi32(static_cast<int>(v)));
+			} else {
+				auto lanes_mask = static_cast<__mmask8>(mask);
+				return _mm512_mask_cmpeq_epi64_mask(lanes_mask, _mm512_maskz_loadu_epi64(lanes_mask, p),
+				                                    _mm512_set1_epi64(static_cast<long long>(v)));
+			}
+		}
+
+		template <class T>
+		ISL_TARGET("avx512f,avx512bw")
+		std::size_t find_value(const T* s, std::size_t n, T value) noexcept {
+			constexpr std::size_t lanes = width / sizeof(T);
+			for (std::size_t i = 0; i < n; i += lanes) {
+				if (std::uint64_t mask = match(s + i, n - i, value)) {
+					return i + std::countr_zero(mask);
+				}
+			}
+			return not_found;
+		}
+
+		template <class T>
+		ISL_TARGET("avx512f,avx512bw,popcnt")
+		std::size_t count_value(const T* s, std::size_t n, T value) noexcept {
+			constexpr std::size_t lanes = width / sizeof(T);
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < n; i += lanes) {
+				count += std::popcount(match(s + i, n - i, value));
+			}
+			return count;
+		}
+	}
+#endif
+
+	// Dispatch, with the same thresholds as the byte kernels: a wider
+	// kernel once the input spans one of its blocks.
+
+	template <class T>
+	std::size_t find_value(const T* s, std::size_t n, T value) noexcept {
+		if constexpr (sizeof(T) == 1) {
+			return find_byte(reinterpret_cast<const char*>(s), n, static_cast<char>(value));
+		} else {
+#if defined(__SSE2__)
+			if (n * sizeof(T) >= 64 && has_avx512bw()) {
+				return avx512::find_value(s, n, value);
+			}
+			if (n * sizeof(T) >= 32 && has_avx2()) {
+				return avx2::find_value(s, n, value);
+			}
+			return sse2::find_value(s, n, value);
+#else
+			return scalar::find_value(s, n, value);
+#endif
+		}
+	}
+
+	template <class T>
+	std::size_t count_value(const T* s, std::size_t n, T value) noexcept {
+		if constexpr (sizeof(T) == 1) {
+			return count_byte(reinterpret_cast<const char*>(s), n, static_cast<char>(value));
+		} else {
+#if defined(__SSE2__)
+			if (n * sizeof(T) >= 64 && has_avx512bw()) {
+				return avx512::count_value(s, n, value);
+			}
+			if (n * sizeof(T) >= 32 && has_avx2()) {
+				return avx2::count_value(s, n, value);
+			}
+			return sse2::count_value(s, n, value);
+#else
+			return scalar::count_value(s, n, value);
+#endif
+		}
+	}
+}
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <type_traits> // std::is_same_v, std::is_floating_point_v
+
+#include "simd.hpp"
+
+// Reduction and prefix-sum kernels behind isl::reduce, isl::accumulate,
+// isl::transform_reduce and the scans. T is std::uint32_t,
+// std::uint64_t, float or double: integers add and multiply modulo 2^N,
+// so signed callers pass their values reinterpreted. The kernels combine
+// elements in an order of their own, which changes float results by
+// rounding only.
+namespace isl::internal::simd {
+	enum class reduction { sum, product };
+
+	// x + identity == x for every x; for floats that is -0.0, since
+	// -0.0 + 0.0 is 0.0.
+	template <class T>
+	inline constexpr T sum_identity = std::is_floating_point_v<T> ? T(-0.0) : T(0);
+
+	namespace scalar {
+		template <reduction op, class T> inline T combine(T a, T b) noexcept {
+			if constexpr (op == reduction::sum) {
+				return static_cast<T>(a + b);
+			} else {
+				return static_cast<T>(a * b);
+			}
+		}
+
+		// Independent accumulators hide the latency of each combine, and
+		// the compiler may keep them in vector registers.
+		inline constexpr std::size_t ways = 8;
+
+		template <reduction op, class T>
+		T reduce(const T* s, std::size_t n, T init) noexcept {
+			std::size_t i = 0;
+			if (n >= ways) {
+				T acc[ways];
+				for (std::size_t j = 0; j != ways; ++j) {
+					acc[j] = s[j];
+				}
+				for (i = ways; i + ways <= n; i += ways) {
+					for (std::size_t j = 0; j != ways; ++j) {
+						acc[j] = combine<op>(acc[j], s[i + j]);
+					}
+				}
+				for (std::size_t half = ways / 2; half != 0; half /= 2) {
+					for (std::size_t j = 0; j != half; ++j) {
+						acc[j] = combine<op>(acc[j], acc[j + half]);
+					}
+				}
+				init = combine<op>(init, acc[0]);
+			}
+			for (; i != n; ++i) {
+				init = combine<op>(init, s[i]);
+			}
+			return init;
+		}
+
+		template <class T>
+		T dot(const T* a, const T* b, std::size_t n, T init) noexcept {
+			std::size_t i = 0;
+			if (n >= ways) {
+				T acc[ways];
+				for (std::size_t j = 0; j != ways; ++j) {
+					acc[j] = static_cast<T>(a[j] * b[j]);
+				}
+				for (i = ways; i + ways <= n; i += ways) {
+					for (std::size_t j = 0; j != ways; ++j) {
+						acc[j] = static_cast<T>(acc[j] + a[i + j] * b[i + j]);
+					}
+				}
+				for (std::size_t half = ways / 2; half != 0; half /= 2) {
+					for (std::size_t j = 0; j != half; ++j) {
+						acc[j] = static_cast<T>(acc[j] + acc[j + half]);
+					}
+				}
+				init = static_cast<T>(init + acc[0]);
+			}
+			for (; i != n; ++i) {
+				init = static_cast<T>(init + a[i] * b[i]);
+			}
+			return init;
+		}
+
+		// out[i] = init + s[0] + ... + s[i], or up to s[i - 1] when
+		// exclusive. out may be s.
+		template <bool inclusive, class T>
+		T scan_sum(const T* s, std::size_t n, T* out, T init) noexcept {
+			for (std::size_t i = 0; i != n; ++i) {
+				T next = static_cast<T>(init + s[i]);
+				out[i] = inclusive ? next : init;
+				init = next;
+			}
+			return init;
+		}
+	}
+
+#if defined(__SSE2__)
+	namespace avx2 {
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i load(const T* p) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		}
+
+		template <class T>
+		ISL_TARGET("avx2") inline void store(T* p, __m256i value) noexcept {
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), value);
+		}
+
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i add(__m256i a, __m256i b) noexcept {
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm256_castps_si256(
+					_mm256_add_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+			} else if constexpr (std::is_same_v<T, double>) {
+				return _mm256_castpd_si256(
+					_mm256_add_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+			} else if constexpr (sizeof(T) == 4) {
+				return _mm256_add_epi32(a, b);
+			} else {
+				return _mm256_add_epi64(a, b);
+			}
+		}
+
+		// AVX2 has no 64-bit integer multiply; those products stay scalar.
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i multiply(__m256i a, __m256i b) noexcept {
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm256_castps_si256(
+					_mm256_mul_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+			} else if constexpr (std::is_same_v<T, double>) {
+				return _mm256_castpd_si256(
+					_mm256_mul_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+			} else {
+				static_assert(sizeof(T) == 4);
+				return _mm256_mullo_epi32(a, b);
+			}
+		}
+
+		template <reduction op, class T>
+		ISL_TARGET("avx2") inline __m256i combine(__m256i a, __m256i b) noexcept {
+			if constexpr (op == reduction::sum) {
+				return add<T>(a, b);
+			} else {
+				return multiply<T>(a, b);
+			}
+		}
+
+		// Four accumulators of a block each, enough to cover the latency of
+		// a float add with the two adds a cycle of recent cores.
+		inline constexpr std::size_t accumulators = 4;
+
+		template <reduction op, class T>
+		ISL_TARGET("avx2")
+		T reduce(const T* s, std::size_t n, T init) noexcept {
+			constexpr std::size_t lanes = 32 / sizeof(T);
+			constexpr std::size_t step = accumulators * lanes;
+			__m256i acc0 = load(s);
+			__m256i acc1 = load(s + lanes);
+			__m256i acc2 = load(s + 2 * lanes);
+			__m256i acc3 = load(s + 3 * lanes);
+			std::size_t i = step;
+			for (; i + step <= n; i += step) {
+				acc0 = combine<op, T>(acc0, load(s + i));
+				acc1 = combine<op, T>(acc1, load(s + i + lanes));
+				acc2 = combine<op, T>(acc2, load(s + i + 2 * lanes));
+				acc3 = combine<op, T>(acc3, load(s + i + 3 * lanes));
+			}
+			acc0 = combine<op, T>(combine<op, T>(acc0, acc1), combine<op, T>(acc2, acc3));
+			T block[lanes];
+			store(block, acc0);
+			init = scalar::combine<op>(init, scalar::reduce<op>(block + 1, lanes - 1, block[0]));
+			return scalar::reduce<op>(s + i, n - i, init);
+		}
+
+		template <class T>
+		ISL_TARGET("avx2")
+		T dot(const T* a, const T* b, std::size_t n, T init) noexcept {
+			constexpr std::size_t lanes = 32 / sizeof(T);
+			constexpr std::size_t step = accumulators * lanes;
+			__m256i acc0 = multiply<T>(load(a), load(b));
+			__m256i acc1 = multiply<T>(load(a + lanes), load(b + lanes));
+			__m256i acc2 = multiply<T>(load(a + 2 * lanes), load(b + 2 * lanes));
+			__m256i acc3 = multiply<T>(load(a + 3 * lanes), load(b + 3 * lanes));
+			std::size_t i = step;
+			for (; i + step <= n; i += step) {
+				const T* x = a + i;
+				const T* y = b + i;
+				acc0 = add<T>(acc0, multiply<T>(load(x), load(y)));
+				acc1 = add<T>(acc1, multiply<T>(load(x + lanes), load(y + lanes)));
+				acc2 = add<T>(acc2, multiply<T>(load(x + 2 * lanes), load(y + 2 * lanes)));
+				acc3 = add<T>(acc3, multiply<T>(load(x + 3 * lanes), load(y + 3 * lanes)));
+			}
+			acc0 = add<T>(add<T>(acc0, acc1), add<T>(acc2, acc3));
+			T block[lanes];
+			store(block, acc0);
+			init = static_cast<T>(init + scalar::reduce<reduction::sum>(block + 1, lanes - 1, block[0]));
+			return scalar::dot(a + i, b + i, n - i, init);
+		}
+
+		// Lanes of -0.0 where a shift vacates float lanes, so that the
+		// shifted-in values are the identity of the add that follows.
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i vacated(int half_lanes, bool low_half) noexcept {
+			if constexpr (!std::is_floating_point_v<T>) {
+				return _mm256_setzero_si256();
+			} else if constexpr (sizeof(T) == 4) {
+				const int m = static_cast<int>(0x80000000u);
+				if (low_half) {
+					return _mm256_setr_epi32(m, m, m, m, 0, 0, 0, 0);
+				}
+				return half_lanes == 1 ? _mm256_setr_epi32(m, 0, 0, 0, m, 0, 0, 0)
+				                       : _mm256_setr_epi32(m, m, 0, 0, m, m, 0, 0);
+			} else {
+				const long long m = static_cast<long long>(0x8000000000000000ull);
+				return low_half ? _mm256_setr_epi64x(m, m, 0, 0)
+				                : _mm256_setr_epi64x(m, 0, m, 0);
+			}
+		}
+
+		// In-register inclusive scan of one block: a log-step scan within
+		// each 128-bit half, then the low half's total added to the high.
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i scan_block(__m256i x) noexcept {
+			if constexpr (sizeof(T) == 4) {
+				x = add<T>(x, _mm256_or_si256(_mm256_slli_si256(x, 4), vacated<T>(1, false)));
+				x = add<T>(x, _mm256_or_si256(_mm256_slli_si256(x, 8), vacated<T>(2, false)));
+				__m256i total = _mm256_shuffle_epi32(x, 0xFF);
+				total = _mm256_permute2x128_si256(total, total, 0x08);
+				return add<T>(x, _mm256_or_si256(total, vacated<T>(0, true)));
+			} else {
+				x = add<T>(x, _mm256_or_si256(_mm256_slli_si256(x, 8), vacated<T>(1, false)));
+				__m256i total = _mm256_unpackhi_epi64(x, x);
+				total = _mm256_permute2x128_si256(total, total, 0x08);
+				return add<T>(x, _mm256_or_si256(total, vacated<T>(0, true)));
+			}
+		}
+
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i broadcast_last(__m256i x) noexcept {
+			if constexpr (sizeof(T) == 4) {
+				return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+			} else {
+				return _mm256_permute4x64_epi64(x, 0xFF);
+			}
+		}
+
+		// Every lane moved up by one, with the first lane of carry in lane 0.
+		template <class T>
+		ISL_TARGET("avx2") inline __m256i shift_in(__m256i x, __m256i carry) noexcept {
+			if constexpr (sizeof(T) == 4) {
+				x = _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+				return _mm256_blend_epi32(x, carry, 0x01);
+			} else {
+				x = _mm256_permute4x64_epi64(x, 0x93);
+				return _mm256_blend_epi32(x, carry, 0x03);
+			}
+		}
+
+		// The carry is the only dependency between blocks, one add long.
+		template <bool inclusive, class T>
+		ISL_TARGET("avx2")
+		T scan_sum(const T* s, std::size_t n, T* out, T init) noexcept {
+			constexpr std::size_t lanes = 32 / sizeof(T);
+			__m256i carry;
+			if constexpr (sizeof(T) == 4) {
+				carry = _mm256_set1_epi32(static_cast<int>(__builtin_bit_cast(std::uint32_t, init)));
+			} else {
+				carry = _mm256_set1_epi64x(static_cast<long long>(__builtin_bit_cast(std::uint64_t, init)));
+			}
+			std::size_t i = 0;
+			for (; i + lanes <= n; i += lanes) {
+				__m256i sums = add<T>(carry, scan_block<T>(load(s + i)));
+				store(out + i, inclusive ? sums : shift_in<T>(sums, carry));
+				carry = broadcast_last<T>(sums);
+			}
+			T block[lanes];
+			store(block, carry);
+			return scalar::scan_sum<inclusive>(s + i, n - i, out + i, block[0]);
+		}
+	}
+#endif
+
+	// Dispatch: the AVX2 kernels once the input spans their accumulators,
+	// or a block for the scans.
+
+	template <reduction op, class T>
+	T reduce(const T* s, std::size_t n, T init) noexcept {
+#if defined(__SSE2__)
+		if constexpr (op == reduction::sum || sizeof(T) == 4 ||
+		              std::is_floating_point_v<T>) {
+			if (n * sizeof(T) >= avx2::accumulators * 32 && has_avx2()) {
+				return avx2::reduce<op>(s, n, init);
+			}
+		}
+#endif
+		return scalar::reduce<op>(s, n, init);
+	}
+
+	// init + a[0] * b[0] + ... + a[n - 1] * b[n - 1]
+	template <class T>
+	T dot(const T* a, const T* b, std::size_t n, T init) noexcept {
+#if defined(__SSE2__)
+		if constexpr (sizeof(T) == 4 || std::is_floating_point_v<T>) {
+			if (n * sizeof(T) >= avx2::accumulators * 32 && has_avx2()) {
+				return avx2::dot(a, b, n, init);
+			}
+		}
+#endif
+		return scalar::dot(a, b, n, init);
+	}
+
+	// Writes the prefix sums of s to out, which may be s, and returns
+	// init plus the sum of all n elements.
+	template <bool inclusive, class T>
+	T scan_sum(const T* s, std::size_t n, T* out, T init) noexcept {
+#if defined(__SSE2__)
+		if (n * sizeof(T) >= 32 && has_avx2()) {
+			return avx2::scan_sum<inclusive>(s, n, out, init);
+		}
+#endif
+		return scalar::scan_sum<inclusive>(s, n, out, init);
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+
+#if defined(__SSE2__)
+#include <immintrin.h> // __m128i, __m256i, __m512i
+#endif
+
+// Compiles a single function for an instruction set extension beyond the
+// target baseline. Callers must check the matching cpu feature first.
+#if defined(__GNUC__)
+#define ISL_TARGET(features) __attribute__((target(features)))
+#else
+#define ISL_TARGET(features)
+#endif
+
+namespace isl::internal::simd {
+	// Returned by search kernels that find nothing.
+	inline constexpr std::size_t not_found = static_cast<std::size_t>(-1);
+
+	// x86 extensions probed once at startup. SSE2 is part of the x86-64
+	// baseline and is selected at compile time through __SSE2__.
+	struct cpu_features {
+		bool sse42 = false;
+		bool avx2 = false;
+		bool avx512bw = false;
+	};
+
+	inline cpu_features detect_cpu_features() noexcept {
+		cpu_features features;
+#if defined(__SSE2__) && defined(__GNUC__)
+		__builtin_cpu_init();
+		features.sse42 = __builtin_cpu_supports("sse4.2");
+		features.avx2 = __builtin_cpu_supports("avx2");
+		features.avx512bw = __builtin_cpu_supports("avx512f") &&
+		                    __builtin_cpu_supports("avx512bw");
+#endif
+		return features;
+	}
+
+	// Reads as all-false if used before dynamic initialization, which only
+	// costs the wider kernels.
+	inline const cpu_features cpu = detect_cpu_features();
+
+	inline bool has_sse42() noexcept {
+#if defined(__SSE4_2__)
+		return true;
+#else
+		return cpu.sse42;
+#endif
+	}
+
+	inline bool has_avx2() noexcept {
+#if defined(__AVX2__)
+		return true;
+#else
+		return cpu.avx2;
+#endif
+	}
+
+	inline bool has_avx512bw() noexcept {
+#if defined(__AVX512BW__)
+		return true;
+#else
+		return cpu.avx512bw;
+#endif
+	}
+}
@@ -0,0 +1,680 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstring> // std::memcpy
+
+#include "simd.hpp"
+
+// UTF-8 validation and UTF-8/16/32 transcoding kernels behind the unicode
+// module. Inputs are a pointer and a length in code units; outputs must
+// have room for the worst case (see the unicode module), so the kernels
+// never check them.
+namespace isl::internal::simd {
+	// Result of a transcoding kernel: on failure `read` is the offset of the
+	// first code unit of the invalid sequence and `written` what the valid
+	// prefix produced.
+	struct transcoded {
+		std::size_t read;
+		std::size_t written;
+		bool valid;
+	};
+
+	namespace scalar {
+		inline bool is_continuation(unsigned char c) noexcept {
+			return (c & 0xC0) == 0x80;
+		}
+
+		// Decodes the sequence at s[0], which must not be ASCII. Returns its
+		// length, or 0 if it is invalid, truncated, overlong or a surrogate.
+		inline std::size_t decode_utf8(const unsigned char* s, std::size_t n,
+		                               char32_t& code_point) noexcept {
+			unsigned char lead = s[0];
+			if (lead < 0xC2) {
+				return 0;
+			}
+			if (lead < 0xE0) {
+				if (n < 2 || !is_continuation(s[1])) {
+					return 0;
+				}
+				code_point = (char32_t{lead} & 0x1F) << 6 | (s[1] & 0x3F);
+				return 2;
+			}
+			if (lead < 0xF0) {
+				// E0 needs A0..BF (no overlongs), ED 80..9F (no surrogates)
+				unsigned char low = lead == 0xE0 ? 0xA0 : 0x80;
+				unsigned char high = lead == 0xED ? 0x9F : 0xBF;
+				if (n < 3 || s[1] < low || s[1] > high || !is_continuation(s[2])) {
+					return 0;
+				}
+				code_point = (char32_t{lead} & 0x0F) << 12 |
+				             (char32_t{s[1]} & 0x3F) << 6 | (s[2] & 0x3F);
+				return 3;
+			}
+			if (lead < 0xF5) {
+				// F0 needs 90..BF (no overlongs), F4 80..8F (at most U+10FFFF)
+				unsigned char low = lead == 0xF0 ? 0x90 : 0x80;
+				unsigned char high = lead == 0xF4 ? 0x8F : 0xBF;
+				if (n < 4 || s[1] < low || s[1] > high || !is_continuation(s[2]) ||
+				    !is_continuation(s[3])) {
+					return 0;
+				}
+				code_point = (char32_t{lead} & 0x07) << 18 |
+				             (char32_t{s[1]} & 0x3F) << 12 |
+				             (char32_t{s[2]} & 0x3F) << 6 | (s[3] & 0x3F);
+				return 4;
+			}
+			return 0;
+		}
+
+		// Writes the UTF-8 form of a valid code point; returns its length.
+		inline std::size_t encode_utf8(char32_t c, unsigned char* out) noexcept {
+			if (c < 0x80) {
+				out[0] = static_cast<unsigned char>(c);
+				return 1;
+			}
+			if (c < 0x800) {
+				out[0] = static_cast<unsigned char>(0xC0 | c >> 6);
+				out[1] = static_cast<unsigned char>(0x80 | (c & 0x3F));
+				return 2;
+			}
+			if (c < 0x10000) {
+				out[0] = static_cast<unsigned char>(0xE0 | c >> 12);
+				out[1] = static_cast<unsigned char>(0x80 | (c >> 6 & 0x3F));
+				out[2] = static_cast<unsigned char>(0x80 | (c & 0x3F));
+				return 3;
+			}
+			out[0] = static_cast<unsigned char>(0xF0 | c >> 18);
+			out[1] = static_cast<unsigned char>(0x80 | (c >> 12 & 0x3F));
+			out[2] = static_cast<unsigned char>(0x80 | (c >> 6 & 0x3F));
+			out[3] = static_cast<unsigned char>(0x80 | (c & 0x3F));
+			return 4;
+		}
+
+		inline bool is_surrogate(char32_t c) noexcept {
+			return c >= 0xD800 && c <= 0xDFFF;
+		}
+
+		// Offset of the first invalid sequence, or not_found. ASCII runs are
+		// skipped eight bytes at a time.
+		inline std::size_t find_invalid_utf8(const unsigned char* s,
+		                                     std::size_t n) noexcept {
+			std::size_t i = 0;
+			while (i < n) {
+				if (i + 8 <= n) {
+					std::uint64_t word;
+					std::memcpy(&word, s + i, 8);
+					if ((word & 0x8080808080808080) == 0) {
+						i += 8;
+						continue;
+					}
+				}
+				if (s[i] < 0x80) {
+					++i;
+					continue;
+				}
+				char32_t code_point;
+				std::size_t length = decode_utf8(s + i, n - i, code_point);
+				if (length == 0) {
+					return i;
+				}
+				i += length;
+			}
+			return not_found;
+		}
+
+		// The transcoders below convert [*i, end) in place of a block their
+		// SIMD caller could not take as ASCII, advancing *i and *w; they stop
+		// at `end` or on the first character that reaches past it.
+
+		inline bool utf8_to_utf16(const unsigned char* s, std::size_t n,
+		                          std::size_t end, char16_t* out, std::size_t& i,
+		                          std::size_t& w) noexcept {
+			while (i < end) {
+				if (s[i] < 0x80) {
+					out[w++] = s[i++];
+					continue;
+				}
+				char32_t c;
+				std::size_t length = decode_utf8(s + i, n - i, c);
+				if (length == 0) {
+					return false;
+				}
+				if (c >= 0x10000) {
+					c -= 0x10000;
+					out[w++] = static_cast<char16_t>(0xD800 + (c >> 10));
+					out[w++] = static_cast<char16_t>(0xDC00 + (c & 0x3FF));
+				} else {
+					out[w++] = static_cast<char16_t>(c);
+				}
+				i += length;
+			}
+			return true;
+		}
+
+		inline bool utf8_to_utf32(const unsigned char* s, std::size_t n,
+		                          std::size_t end, char32_t* out, std::size_t& i,
+		                          std::size_t& w) noexcept {
+			while (i < end) {
+				if (s[i] < 0x80) {
+					out[w++] = s[i++];
+					continue;
+				}
+				char32_t c;
+				std::size_t length = decode_utf8(s + i, n - i, c);
+				if (length == 0) {
+					return false;
+				}
+				out[w++] = c;
+				i += length;
+			}
+			return true;
+		}
+
+		inline bool utf16_to_utf8(const char16_t* s, std::size_t n,
+		                          std::size_t end, unsigned char* out,
+		                          std::size_t& i, std::size_t& w) noexcept {
+			while (i < end) {
+				char32_t c = s[i];
+				if (c >= 0xD800 && c <= 0xDFFF) {
+					// a high surrogate followed by a low one
+					if (c > 0xDBFF || i + 1 == n || s[i + 1] < 0xDC00 ||
+					    s[i + 1] > 0xDFFF) {
+						return false;
+					}
+					c = 0x10000 + ((c - 0xD800) << 10) + (s[i + 1] - 0xDC00);
+					++i;
+				}
+				w += encode_utf8(c, out + w);
+				++i;
+			}
+			return true;
+		}
+
+		inline bool utf32_to_utf8(const char32_t* s, std::size_t end,
+		                          unsigned char* out, std::size_t& i,
+		                          std::size_t& w) noexcept {
+			while (i < end) {
+				char32_t c = s[i];
+				if (c > 0x10FFFF || is_surrogate(c)) {
+					return false;
+				}
+				w += encode_utf8(c, out + w);
+				++i;
+			}
+			return true;
+		}
+
+		inline transcoded utf16_to_utf32(const char16_t* s, std::size_t n,
+		                                 char32_t* out) noexcept {
+			std::size_t w = 0;
+			for (std::size_t i = 0; i < n; ++i) {
+				char32_t c = s[i];
+				if (c >= 0xD800 && c <= 0xDFFF) {
+					if (c > 0xDBFF || i + 1 == n || s[i + 1] < 0xDC00 ||
+					    s[i + 1] > 0xDFFF) {
+						return {i, w, false};
+					}
+					c = 0x10000 + ((c - 0xD800) << 10) + (s[i + 1] - 0xDC00);
+					++i;
+				}
+				out[w++] = c;
+			}
+			return {n, w, true};
+		}
+
+		inline transcoded utf32_to_utf16(const char32_t* s, std::size_t n,
+		                                 char16_t* out) noexcept {
+			std::size_t w = 0;
+			for (std::size_t i = 0; i < n; ++i) {
+				char32_t c = s[i];
+				if (c > 0x10FFFF || is_surrogate(c)) {
+					return {i, w, false};
+				}
+				if (c >= 0x10000) {
+					c -= 0x10000;
+					out[w++] = static_cast<char16_t>(0xD800 + (c >> 10));
+					out[w++] = static_cast<char16_t>(0xDC00 + (c & 0x3FF));
+				} else {
+					out[w++] = static_cast<char16_t>(c);
+				}
+			}
+			return {n, w, true};
+		}
+	}
+
+#if defined(__SSE2__)
+	// Lookup tables of the Keiser-Lemire validator ("Validating UTF-8 in
+	// less than one instruction per byte", 2021). Each byte pair (prev, cur)
+	// is classified by prev's high nibble, prev's low nibble and cur's high
+	// nibble; a bit set in all three lookups flags one of the errors below.
+	// Sequences longer than two bytes are checked separately: the third and
+	// fourth bytes of a sequence must be continuations and nothing else may
+	// be.
+	namespace utf8_tables {
+		inline constexpr unsigned char too_short = 1 << 0;  // lead, non-continuation
+		inline constexpr unsigned char too_long = 1 << 1;   // ASCII, continuation
+		inline constexpr unsigned char overlong_3 = 1 << 2; // E0 80..9F
+		inline constexpr unsigned char too_large = 1 << 3;  // F4 90..BF, F5..FF
+		inline constexpr unsigned char surrogate = 1 << 4;  // ED A0..BF
+		inline constexpr unsigned char overlong_2 = 1 << 5; // C0..C1 continuation
+		inline constexpr unsigned char too_large_1000 = 1 << 6; // F5..FF 80..8F
+		inline constexpr unsigned char overlong_4 = 1 << 6; // F0 80..8F
+		inline constexpr unsigned char two_continuations = 1 << 7;
+		inline constexpr unsigned char carry = too_short | too_long | two_continuations;
+
+		alignas(16) inline constexpr unsigned char byte_1_high[16] = {
+			too_long, too_long, too_long, too_long,
+			too_long, too_long, too_long, too_long,
+			two_continuations, two_continuations,
+			two_continuations, two_continuations,
+			too_short | overlong_2,
+			too_short,
+			too_short | overlong_3 | surrogate,
+			too_short | too_large | too_large_1000 | overlong_4,
+		};
+		alignas(16) inline constexpr unsigned char byte_1_low[16] = {
+			carry | overlong_3 | overlong_2 | overlong_4,
+			carry | overlong_2,
+			carry,
+			carry,
+			carry | too_large,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000 | surrogate,
+			carry | too_large | too_large_1000,
+			carry | too_large | too_large_1000,
+		};
+		alignas(16) inline constexpr unsigned char byte_2_high[16] = {
+			too_short, too_short, too_short, too_short,
+			too_short, too_short, too_short, too_short,
+			too_long | overlong_2 | two_continuations | overlong_3 |
+				too_large_1000 | overlong_4,
+			too_long | overlong_2 | two_continuations | overlong_3 | too_large,
+			too_long | overlong_2 | two_continuations | surrogate | too_large,
+			too_long | overlong_2 | two_continuations | surrogate | too_large,
+			too_short, too_short, too_short, too_short,
+		};
+	}
+
+	// Start of the character an error found in the group at `at` belongs to:
+	// everything before `at` is valid but for a sequence cut off by `at`.
+	inline std::size_t rescan_invalid_utf8(const unsigned char* s, std::size_t n,
+	                                       std::size_t at) noexcept {
+		std::size_t start = at;
+		while (start > 0 && at - start < 3 && scalar::is_continuation(s[start - 1])) {
+			--start;
+		}
+		if (start > 0 && s[start - 1] >= 0xC0) {
+			--start;
+		}
+		std::size_t index = scalar::find_invalid_utf8(s + start, n - start);
+		return index == not_found ? not_found : start + index;
+	}
+
+	namespace sse42 {
+		ISL_TARGET("sse4.2") inline __m128i load(const unsigned char* p) noexcept {
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		}
+
+		// The block shifted N bytes later, with the end of `previous` in front.
+		template <int N>
+		ISL_TARGET("sse4.2")
+		inline __m128i prev(__m128i input, __m128i previous) noexcept {
+			return _mm_alignr_epi8(input, previous, 16 - N);
+		}
+
+		// Non-zero lanes mark errors among the bytes of `input`.
+		ISL_TARGET("sse4.2")
+		inline __m128i check_block(__m128i input, __m128i previous) noexcept {
+			const __m128i low_nibble = _mm_set1_epi8(0x0F);
+			__m128i prev1 = prev<1>(input, previous);
+			__m128i byte_1_high = _mm_shuffle_epi8(
+				load(utf8_tables::byte_1_high),
+				_mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble));
+			__m128i byte_1_low = _mm_shuffle_epi8(
+				load(utf8_tables::byte_1_low), _mm_and_si128(prev1, low_nibble));
+			__m128i byte_2_high = _mm_shuffle_epi8(
+				load(utf8_tables::byte_2_high),
+				_mm_and_si128(_mm_srli_epi16(input, 4), low_nibble));
+			__m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low),
+			                                byte_2_high);
+
+			// only 111_____ two back or 1111____ three back saturate to >= 0x80
+			__m128i third = _mm_subs_epu8(prev<2>(input, previous),
+			                              _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			__m128i fourth = _mm_subs_epu8(prev<3>(input, previous),
+			                               _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			__m128i must_continue = _mm_and_si128(_mm_or_si128(third, fourth),
+			                                      _mm_set1_epi8(static_cast<char>(0x80)));
+			return _mm_xor_si128(must_continue, special);
+		}
+
+		// Non-zero if the block ends inside a sequence.
+		ISL_TARGET("sse4.2") inline __m128i incomplete(__m128i input) noexcept {
+			const __m128i max = _mm_setr_epi8(
+				-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				static_cast<char>(0xEF), static_cast<char>(0xDF),
+				static_cast<char>(0xBF));
+			return _mm_subs_epu8(input, max);
+		}
+
+		// Carries the last block and its unfinished sequence, if any, from
+		// one group of 64 bytes to the next.
+		struct validator {
+			__m128i previous;
+			__m128i pending;
+
+			// True if the group has an error, skipping the table lookups for
+			// all-ASCII groups.
+			ISL_TARGET("sse4.2") bool check(const unsigned char* p) noexcept {
+				__m128i b0 = load(p);
+				__m128i b1 = load(p + 16);
+				__m128i b2 = load(p + 32);
+				__m128i b3 = load(p + 48);
+				__m128i any = _mm_or_si128(_mm_or_si128(b0, b1), _mm_or_si128(b2, b3));
+				__m128i error;
+				if (_mm_movemask_epi8(any) == 0) {
+					error = this->pending;
+					this->pending = _mm_setzero_si128();
+				} else {
+					error = _mm_or_si128(
+						_mm_or_si128(check_block(b0, this->previous), check_block(b1, b0)),
+						_mm_or_si128(check_block(b2, b1), check_block(b3, b2)));
+					this->pending = incomplete(b3);
+				}
+				this->previous = b3;
+				return !_mm_testz_si128(error, error);
+			}
+		};
+
+		// The tail goes through the same check zero-padded.
+		ISL_TARGET("sse4.2")
+		inline std::size_t find_invalid_utf8(const unsigned char* s,
+		                                     std::size_t n) noexcept {
+			validator state{_mm_setzero_si128(), _mm_setzero_si128()};
+			std::size_t i = 0;
+			for (; i + 64 <= n; i += 64) {
+				if (state.check(s + i)) {
+					return rescan_invalid_utf8(s, n, i);
+				}
+			}
+			alignas(16) unsigned char tail[64] = {};
+			std::memcpy(tail, s + i, n - i);
+			return state.check(tail) ? rescan_invalid_utf8(s, n, i) : not_found;
+		}
+	}
+
+	namespace avx2 {
+		ISL_TARGET("avx2") inline __m256i load(const unsigned char* p) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		}
+		ISL_TARGET("avx2") inline __m256i load_table(const unsigned char* p) noexcept {
+			return _mm256_broadcastsi128_si256(
+				_mm_load_si128(reinterpret_cast<const __m128i*>(p)));
+		}
+
+		template <int N>
+		ISL_TARGET("avx2")
+		inline __m256i prev(__m256i input, __m256i previous) noexcept {
+			return _mm256_alignr_epi8(
+				input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+		}
+
+		ISL_TARGET("avx2")
+		inline __m256i check_block(__m256i input, __m256i previous) noexcept {
+			const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+			__m256i prev1 = prev<1>(input, previous);
+			__m256i byte_1_high = _mm256_shuffle_epi8(
+				load_table(utf8_tables::byte_1_high),
+				_mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+			__m256i byte_1_low = _mm256_shuffle_epi8(
+				load_table(utf8_tables::byte_1_low),
+				_mm256_and_si256(prev1, low_nibble));
+			__m256i byte_2_high = _mm256_shuffle_epi8(
+				load_table(utf8_tables::byte_2_high),
+				_mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+			__m256i special = _mm256_and_si256(
+				_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+			__m256i third = _mm256_subs_epu8(
+				prev<2>(input, previous),
+				_mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			__m256i fourth = _mm256_subs_epu8(
+				prev<3>(input, previous),
+				_mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			__m256i must_continue = _mm256_and_si256(
+				_mm256_or_si256(third, fourth),
+				_mm256_set1_epi8(static_cast<char>(0x80)));
+			return _mm256_xor_si256(must_continue, special);
+		}
+
+		ISL_TARGET("avx2") inline __m256i incomplete(__m256i input) noexcept {
+			const __m256i max = _mm256_setr_epi8(
+				-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				static_cast<char>(0xEF), static_cast<char>(0xDF),
+				static_cast<char>(0xBF));
+			return _mm256_subs_epu8(input, max);
+		}
+
+		// Mirrors sse42::validator with two 32-byte blocks per group.
+		struct validator {
+			__m256i previous;
+			__m256i pending;
+
+			ISL_TARGET("avx2") bool check(const unsigned char* p) noexcept {
+				__m256i b0 = load(p);
+				__m256i b1 = load(p + 32);
+				__m256i error;
+				if (_mm256_movemask_epi8(_mm256_or_si256(b0, b1)) == 0) {
+					error = this->pending;
+					this->pending = _mm256_setzero_si256();
+				} else {
+					error = _mm256_or_si256(check_block(b0, this->previous),
+					                        check_block(b1, b0));
+					this->pending = incomplete(b1);
+				}
+				this->previous = b1;
+				return !_mm256_testz_si256(error, error);
+			}
+		};
+
+		ISL_TARGET("avx2")
+		inline std::size_t find_invalid_utf8(const unsigned char* s,
+		                                     std::size_t n) noexcept {
+			validator state{_mm256_setzero_si256(), _mm256_setzero_si256()};
+			std::size_t i = 0;
+			for (; i + 64 <= n; i += 64) {
+				if (state.check(s + i)) {
+					return rescan_invalid_utf8(s, n, i);
+				}
+			}
+			alignas(32) unsigned char tail[64] = {};
+			std::memcpy(tail, s + i, n - i);
+			return state.check(tail) ? rescan_invalid_utf8(s, n, i) : not_found;
+		}
+	}
+
+	// ASCII fast paths for the transcoders: 16 input units that are all
+	// ASCII are widened or narrowed with one or two shuffles, anything else
+	// goes through the scalar code one block at a time. SSE2 is enough here;
+	// the work outside ASCII runs is scalar either way.
+	namespace sse2 {
+		inline transcoded utf8_to_utf16(const unsigned char* s, std::size_t n,
+		                                char16_t* out) noexcept {
+			const __m128i zero = _mm_setzero_si128();
+			std::size_t i = 0;
+			std::size_t w = 0;
+			while (i + 16 <= n) {
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				if (_mm_movemask_epi8(block) == 0) {
+					auto* target = reinterpret_cast<__m128i*>(out + w);
+					_mm_storeu_si128(target, _mm_unpacklo_epi8(block, zero));
+					_mm_storeu_si128(target + 1, _mm_unpackhi_epi8(block, zero));
+					i += 16;
+					w += 16;
+				} else if (!scalar::utf8_to_utf16(s, n, i + 16, out, i, w)) {
+					return {i, w, false};
+				}
+			}
+			if (!scalar::utf8_to_utf16(s, n, n, out, i, w)) {
+				return {i, w, false};
+			}
+			return {n, w, true};
+		}
+
+		inline transcoded utf8_to_utf32(const unsigned char* s, std::size_t n,
+		                                char32_t* out) noexcept {
+			const __m128i zero = _mm_setzero_si128();
+			std::size_t i = 0;
+			std::size_t w = 0;
+			while (i + 16 <= n) {
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+				if (_mm_movemask_epi8(block) == 0) {
+					__m128i low = _mm_unpacklo_epi8(block, zero);
+					__m128i high = _mm_unpackhi_epi8(block, zero);
+					auto* target = reinterpret_cast<__m128i*>(out + w);
+					_mm_storeu_si128(target, _mm_unpacklo_epi16(low, zero));
+					_mm_storeu_si128(target + 1, _mm_unpackhi_epi16(low, zero));
+					_mm_storeu_si128(target + 2, _mm_unpacklo_epi16(high, zero));
+					_mm_storeu_si128(target + 3, _mm_unpackhi_epi16(high, zero));
+					i += 16;
+					w += 16;
+				} else if (!scalar::utf8_to_utf32(s, n, i + 16, out, i, w)) {
+					return {i, w, false};
+				}
+			}
+			if (!scalar::utf8_to_utf32(s, n, n, out, i, w)) {
+				return {i, w, false};
+			}
+			return {n, w, true};
+		}
+
+		inline transcoded utf16_to_utf8(const char16_t* s, std::size_t n,
+		                                unsigned char* out) noexcept {
+			const __m128i non_ascii = _mm_set1_epi16(static_cast<short>(0xFF80));
+			std::size_t i = 0;
+			std::size_t w = 0;
+			while (i + 16 <= n) {
+				auto* source = reinterpret_cast<const __m128i*>(s + i);
+				__m128i low = _mm_loadu_si128(source);
+				__m128i high = _mm_loadu_si128(source + 1);
+				__m128i wide = _mm_and_si128(_mm_or_si128(low, high), non_ascii);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(wide, _mm_setzero_si128())) ==
+				    0xFFFF) {
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + w),
+					                 _mm_packus_epi16(low, high));
+					i += 16;
+					w += 16;
+				} else if (!scalar::utf16_to_utf8(s, n, i + 16, out, i, w)) {
+					return {i, w, false};
+				}
+			}
+			if (!scalar::utf16_to_utf8(s, n, n, out, i, w)) {
+				return {i, w, false};
+			}
+			return {n, w, true};
+		}
+
+		inline transcoded utf32_to_utf8(const char32_t* s, std::size_t n,
+		                                unsigned char* out) noexcept {
+			const __m128i non_ascii = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+			std::size_t i = 0;
+			std::size_t w = 0;
+			while (i + 16 <= n) {
+				auto* source = reinterpret_cast<const __m128i*>(s + i);
+				__m128i b0 = _mm_loadu_si128(source);
+				__m128i b1 = _mm_loadu_si128(source + 1);
+				__m128i b2 = _mm_loadu_si128(source + 2);
+				__m128i b3 = _mm_loadu_si128(source + 3);
+				__m128i any = _mm_or_si128(_mm_or_si128(b0, b1), _mm_or_si128(b2, b3));
+				__m128i wide = _mm_and_si128(any, non_ascii);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(wide, _mm_setzero_si128())) ==
+				    0xFFFF) {
+					__m128i packed = _mm_packus_epi16(_mm_packs_epi32(b0, b1),
+					                                  _mm_packs_epi32(b2, b3));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + w), packed);
+					i += 16;
+					w += 16;
+				} else if (!scalar::utf32_to_utf8(s, i + 16, out, i, w)) {
+					return {i, w, false};
+				}
+			}
+			if (!scalar::utf32_to_utf8(s, n, out, i, w)) {
+				return {i, w, false};
+			}
+			return {n, w, true};
+		}
+	}
+#endif
+
+	// Dispatch.
+
+	inline std::size_t find_invalid_utf8(const unsigned char* s,
+	                                     std::size_t n) noexcept {
+#if defined(__SSE2__)
+		if (n >= 64 && has_avx2()) {
+			return avx2::find_invalid_utf8(s, n);
+		}
+		if (n >= 64 && has_sse42()) {
+			return sse42::find_invalid_utf8(s, n);
+		}
+#endif
+		return scalar::find_invalid_utf8(s, n);
+	}
+
+	inline transcoded utf8_to_utf16(const unsigned char* s, std::size_t n,
+	                                char16_t* out) noexcept {
+#if defined(__SSE2__)
+		return sse2::utf8_to_utf16(s, n, out);
+#else
+		std::size_t i = 0;
+		std::size_t w = 0;
+		bool valid = scalar::utf8_to_utf16(s, n, n, out, i, w);
+		return {i, w, valid};
+#endif
+	}
+
+	inline transcoded utf8_to_utf32(const unsigned char* s, std::size_t n,
+	                                char32_t* out) noexcept {
+#if defined(__SSE2__)
+		return sse2::utf8_to_utf32(s, n, out);
+#else
+		std::size_t i = 0;
+		std::size_t w = 0;
+		bool valid = scalar::utf8_to_utf32(s, n, n, out, i, w);
+		return {i, w, valid};
+#endif
+	}
+
+	inline transcoded utf16_to_utf8(const char16_t* s, std::size_t n,
+	                                unsigned char* out) noexcept {
+#if defined(__SSE2__)
+		return sse2::utf16_to_utf8(s, n, out);
+#else
+		std::size_t i = 0;
+		std::size_t w = 0;
+		bool valid = scalar::utf16_to_utf8(s, n, n, out, i, w);
+		return {i, w, valid};
+#endif
+	}
+
+	inline transcoded utf32_to_utf8(const char32_t* s, std::size_t n,
+	                                unsigned char* out) noexcept {
+#if defined(__SSE2__)
+		return sse2::utf32_to_utf8(s, n, out);
+#else
+		std::size_t i = 0;
+		std::size_t w = 0;
+		bool valid = scalar::utf32_to_utf8(s, n, out, i, w);
+		return {i, w, valid};
+#endif
+	}
+}
@@ -0,0 +1,220 @@
+module;
+
+#include <atomic>      // std::atomic, std::atomic_thread_fence
+#include <bit>         // std::bit_ceil
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <cstdint>     // std::uint32_t
+#include <memory>      // std::allocator, std::allocator_traits
+#include <new>         // std::launder
+#include <type_traits> // std::is_nothrow_constructible_v
+#include <utility>     // std::move, std::forward
+
+#include "../internal/concurrency/cache_line.hpp"
+#include "../internal/concurrency/futex.hpp"
+
+export module mpmc_queue;
+
+namespace isl::detail {
+namespace concurrency = isl::internal::concurrency;
+
+// One slot of the queue. `sequence` says whose turn it is: a producer may
+// fill slot `i` at position `pos` when sequence == pos, a consumer may drain
+// it when sequence == pos + 1.
+template <class T> struct alignas(concurrency::cache_line_size) mpmc_cell {
+  std::atomic<std::size_t> sequence;
+  alignas(T) unsigned char storage[sizeof(T)];
+
+  T *value() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+};
+
+// Futex-backed "something changed" signal. Waiters register before they
+// re-check the queue, signalers only touch the futex when somebody is
+// registered, so non-blocking users pay one fence and one load.
+struct mpmc_signal {
+  concurrency::futex_word epoch{0};
+  std::atomic<std::uint32_t> waiters{0};
+
+  void notify() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->waiters.load(std::memory_order_relaxed) != 0) {
+      this->epoch.fetch_add(1, std::memory_order_relaxed);
+      concurrency::futex_wake_one(this->epoch);
+    }
+  }
+
+  template <class TryOperation> void wait_until(TryOperation try_operation) {
+    while (!try_operation()) {
+      this->waiters.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      std::uint32_t observed = this->epoch.load(std::memory_order_relaxed);
+      bool done = try_operation();
+      if (!done) {
+        concurrency::futex_wait(this->epoch, observed);
+      }
+
+      this->waiters.fetch_sub(1, std::memory_order_relaxed);
+      if (done) {
+        return;
+      }
+    }
+  }
+};
+} // namespace isl::detail
+
+export namespace isl {
+/// Bounded multi-producer/multi-consumer queue (D. Vyukov's array queue).
+///
+/// Producers and consumers claim positions with a CAS on their own counter
+/// and then synchronize with each other only through the per-slot sequence
+/// numbers. try_* never block; push/pop sleep on a futex while the queue is
+/// full/empty. Elements are constructed in place and moved out, so move-only
+/// types such as isl::function work. A slot is published only once its
+/// element exists, so a constructor that may throw runs on a temporary
+/// before the slot is claimed and the element is then moved in; a failed
+/// try_emplace may therefore have consumed its arguments. T's move
+/// constructor must not throw.
+template <class T, class Allocator = std::allocator<T>> class mpmc_queue {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "mpmc_queue requires a nothrow move constructor");
+
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+private:
+  using cell = detail::mpmc_cell<T>;
+  using cell_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<cell>;
+  using traits = std::allocator_traits<cell_allocator>;
+  static constexpr std::size_t cache_line =
+      isl::internal::concurrency::cache_line_size;
+
+  alignas(cache_line) std::atomic<std::size_t> enqueue_position{0};
+  alignas(cache_line) std::atomic<std::size_t> dequeue_position{0};
+
+  alignas(cache_line) cell *cells;
+  std::size_t mask;
+  [[no_unique_address]] cell_allocator allocator;
+
+  alignas(cache_line) detail::mpmc_signal pushed;
+  alignas(cache_line) detail::mpmc_signal popped;
+
+public:
+  /// `capacity` is rounded up to the next power of two.
+  explicit mpmc_queue(size_type capacity, const Allocator &alloc = Allocator())
+      : allocator(alloc) {
+    std::size_t size = std::bit_ceil(capacity < 2 ? 2 : capacity);
+    this->cells = traits::allocate(this->allocator, size);
+    this->mask = size - 1;
+    for (std::size_t i = 0; i != size; ++i) {
+      std::construct_at(&this->cells[i].sequence, i);
+    }
+  }
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+  ~mpmc_queue() {
+    std::size_t last = this->enqueue_position.load(std::memory_order_relaxed);
+    std::size_t first = this->dequeue_position.load(std::memory_order_relaxed);
+    for (; first != last; ++first) {
+      std::destroy_at(this->cells[first & this->mask].value());
+    }
+    traits::deallocate(this->allocator, this->cells, this->capacity());
+  }
+
+  size_type capacity() const noexcept { return this->mask + 1; }
+  /// Snapshot; may be stale by the time it is returned.
+  size_type size() const noexcept {
+    std::size_t last = this->enqueue_position.load(std::memory_order_acquire);
+    std::size_t first = this->dequeue_position.load(std::memory_order_acquire);
+    return last > first ? last - first : 0;
+  }
+  [[nodiscard]] bool empty() const noexcept { return this->size() == 0; }
+
+  // non-blocking
+
+  template <class... Args> bool try_emplace(Args &&...args) {
+    if constexpr (!std::is_nothrow_constructible_v<T, Args...>) {
+      T value(std::forward<Args>(args)...);
+      return this->try_emplace(std::move(value));
+    }
+    std::size_t position =
+        this->enqueue_position.load(std::memory_order_relaxed);
+    cell *target;
+    for (;;) {
+      target = &this->cells[position & this->mask];
+      std::size_t sequence = target->sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+      if (difference == 0) {
+        if (this->enqueue_position.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false; // full
+      } else {
+        position = this->enqueue_position.load(std::memory_order_relaxed);
+      }
+    }
+
+    std::construct_at(reinterpret_cast<T *>(target->storage),
+                      std::forward<Args>(args)...);
+    target->sequence.store(position + 1, std::memory_order_release);
+    this->pushed.notify();
+    return true;
+  }
+  bool try_push(const T &value) { return this->try_emplace(value); }
+  bool try_push(T &&value) { return this->try_emplace(std::move(value)); }
+
+  bool try_pop(T &value) {
+    std::size_t position =
+        this->dequeue_position.load(std::memory_order_relaxed);
+    cell *source;
+    for (;;) {
+      source = &this->cells[position & this->mask];
+      std::size_t sequence = source->sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+      if (difference == 0) {
+        if (this->dequeue_position.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false; // empty
+      } else {
+        position = this->dequeue_position.load(std::memory_order_relaxed);
+      }
+    }
+
+    T *element = source->value();
+    value = std::move(*element);
+    std::destroy_at(element);
+    source->sequence.store(position + this->mask + 1,
+                           std::memory_order_release);
+    this->popped.notify();
+    return true;
+  }
+
+  // blocking
+
+  template <class... Args> void emplace(Args &&...args) {
+    if constexpr (!std::is_nothrow_constructible_v<T, Args...>) {
+      T value(std::forward<Args>(args)...);
+      this->emplace(std::move(value));
+    } else {
+      // Arguments are only consumed by the attempt that succeeds.
+      this->popped.wait_until(
+          [&] { return this->try_emplace(std::forward<Args>(args)...); });
+    }
+  }
+  void push(const T &value) { this->emplace(value); }
+  void push(T &&value) { this->emplace(std::move(value)); }
+
+  void pop(T &value) {
+    this->pushed.wait_until([&] { return this->try_pop(value); });
+  }
+};
+} // namespace isl
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <atomic>    // std::atomic
+#include <memory>    // std::unique_ptr
+#include <stdexcept> // std::runtime_error
+#include <thread>    // std::thread
+#include <vector>    // std::vector
+
+import mpmc_queue;
+
+TEST(mpmc_queue, TestTryPushTryPop) {
+  isl::mpmc_queue<int> queue(3);
+
+  ASSERT_EQ(queue.capacity(), 4);
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_push(i));
+  }
+  ASSERT_FALSE(queue.try_push(4));
+
+  int value = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(queue.try_pop(value));
+}
+
+TEST(mpmc_queue, TestMoveOnly) {
+  isl::mpmc_queue<std::unique_ptr<int>> queue(4);
+
+  ASSERT_TRUE(queue.try_emplace(new int(42)));
+  queue.push(std::make_unique<int>(7));
+
+  std::unique_ptr<int> value;
+  queue.pop(value);
+  ASSERT_EQ(*value, 42);
+  queue.pop(value);
+  ASSERT_EQ(*value, 7);
+}
+
+namespace {
+struct throwing_copy {
+  int value;
+
+  explicit throwing_copy(int value) : value(value) {}
+  throwing_copy(const throwing_copy &other) : value(other.value) {
+    if (value < 0) {
+      throw std::runtime_error("negative");
+    }
+  }
+  throwing_copy(throwing_copy &&) noexcept = default;
+  throwing_copy &operator=(throwing_copy &&) noexcept = default;
+};
+} // namespace
+
+TEST(mpmc_queue, TestThrowingConstructor) {
+  isl::mpmc_queue<throwing_copy> queue(4);
+  throwing_copy good(1);
+  throwing_copy bad(-1);
+
+  ASSERT_TRUE(queue.try_push(good));
+  ASSERT_THROW(queue.try_push(bad), std::runtime_error);
+  ASSERT_THROW(queue.push(bad), std::runtime_error);
+  queue.push(throwing_copy(2));
+
+  // the failed pushes claimed no slot
+  ASSERT_EQ(queue.size(), 2);
+  throwing_copy value(0);
+  ASSERT_TRUE(queue.try_pop(value));
+  ASSERT_EQ(value.value, 1);
+  ASSERT_TRUE(queue.try_pop(value));
+  ASSERT_EQ(value.value, 2);
+  ASSERT_FALSE(queue.try_pop(value));
+}
+
+TEST(mpmc_queue, TestBlockingFanInFanOut) {
+  constexpr int producers = 4;
+  constexpr int consumers = 4;
+  constexpr int per_producer = 10000;
+
+  isl::mpmc_queue<int> queue(16);
+  std::atomic<long long> sum{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue] {
+      for (int i = 1; i <= per_producer; ++i) {
+        queue.push(i);
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&queue, &sum] {
+      for (int i = 0; i < producers * per_producer / consumers; ++i) {
+        int value = 0;
+        queue.pop(value);
+        sum.fetch_add(value, std::memory_order_relaxed);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(sum.load(), producers * (per_producer * (per_producer + 1LL) / 2));
+  ASSERT_TRUE(queue.empty());
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <numeric> // std::accumulate, std::reduce, std::inclusive_scan, ...
+#include <vector>  // std::vector
+
+import numeric;
+
+namespace {
+template <class T> std::vector<T> values(std::size_t n) {
+  std::vector<T> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = static_cast<T>(i % 1000) / 8;
+  }
+  return values;
+}
+} // namespace
+
+template <class T> static void BM_IslReduce(benchmark::State &state) {
+  auto data = values<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::reduce(data.begin(), data.end()));
+  }
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_IslReduce<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_IslReduce<float>)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_IslReduce<double>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_StdReduce(benchmark::State &state) {
+  auto data = values<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::reduce(data.begin(), data.end()));
+  }
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_StdReduce<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_StdReduce<float>)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_StdReduce<double>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_StdAccumulate(benchmark::State &state) {
+  auto data = values<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::accumulate(data.begin(), data.end(), T{}));
+  }
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_StdAccumulate<float>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_IslDot(benchmark::State &state) {
+  auto a = values<T>(state.range(0));
+  auto b = values<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        isl::transform_reduce(a.begin(), a.end(), b.begin(), T{}));
+  }
+  state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(BM_IslDot<float>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_StdDot(benchmark::State &state) {
+  auto a = values<T>(state.range(0));
+  auto b = values<T>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::transform_reduce(a.begin(), a.end(), b.begin(), T{}));
+  }
+  state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(BM_StdDot<float>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_IslInclusiveScan(benchmark::State &state) {
+  auto data = values<T>(state.range(0));
+  std::vector<T> out(data.size());
+  for (auto _ : state) {
+    isl::inclusive_scan(data.begin(), data.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_IslInclusiveScan<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_IslInclusiveScan<float>)->Arg(1 << 10)->Arg(1 << 20);
+
+template <class T> static void BM_StdInclusiveScan(benchmark::State &state) {
+  auto data = values<T>(state.range(0));
+  std::vector<T> out(data.size());
+  for (auto _ : state) {
+    std::inclusive_scan(data.begin(), data.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_StdInclusiveScan<std::uint32_t>)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_StdInclusiveScan<float>)->Arg(1 << 10)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,349 @@
+module;
+
+#include <cstddef>     // std::size_t
+#include <iterator>    // std::iterator_traits, std::iter_value_t, ...
+#include <memory>      // std::to_address
+#include <type_traits> // std::is_integral_v, std::integral_constant, ...
+#include <utility>     // std::move
+
+#include "../internal/simd/numeric.hpp"
+
+export module numeric;
+
+import functional;
+
+namespace isl::detail {
+namespace simd = isl::internal::simd;
+
+// Element types the numeric kernels handle: 32- and 64-bit integers, as
+// their unsigned bit patterns, and float and double.
+template <class T>
+concept simd_arithmetic =
+    (std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+     (sizeof(T) == 4 || sizeof(T) == 8)) ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <class T> struct numeric_lane {
+  using type = T;
+};
+template <class T>
+  requires std::is_integral_v<T>
+struct numeric_lane<T> {
+  using type = std::make_unsigned_t<T>;
+};
+template <class T> using numeric_lane_t = typename numeric_lane<T>::type;
+
+// The kernel reduction an isl operation performs on two T, if it has one.
+template <class Op, class T> struct simd_reduction_of {};
+template <class T>
+struct simd_reduction_of<isl::plus<>, T>
+    : std::integral_constant<simd::reduction, simd::reduction::sum> {};
+template <class T>
+struct simd_reduction_of<isl::plus<T>, T>
+    : std::integral_constant<simd::reduction, simd::reduction::sum> {};
+template <class T>
+struct simd_reduction_of<isl::multiplies<>, T>
+    : std::integral_constant<simd::reduction, simd::reduction::product> {};
+template <class T>
+struct simd_reduction_of<isl::multiplies<T>, T>
+    : std::integral_constant<simd::reduction, simd::reduction::product> {};
+
+template <class It, class T>
+concept simd_numeric_range =
+    std::contiguous_iterator<It> && simd_arithmetic<T> &&
+    std::is_same_v<std::iter_value_t<It>, T>;
+
+// Reductions take the kernels when the range is contiguous, the
+// accumulator has the element type and the operation is isl's plus or
+// multiplies. The kernels reassociate, which a left fold may only do
+// when the result cannot change: over integers.
+template <class It, class T, class Op>
+concept simd_reducible = simd_numeric_range<It, T> && requires {
+  simd_reduction_of<Op, T>::value;
+};
+
+template <class It, class T, class Op>
+concept simd_accumulable =
+    simd_reducible<It, T, Op> && std::is_integral_v<T>;
+
+// Scans take them for the sum of a contiguous range into a contiguous
+// range of the same arithmetic type.
+template <class InputIt, class OutputIt, class T, class Op>
+concept simd_scannable =
+    simd_numeric_range<InputIt, T> && simd_numeric_range<OutputIt, T> &&
+    requires {
+      requires simd_reduction_of<Op, T>::value == simd::reduction::sum;
+    };
+
+template <class T, class It> auto *lanes_of(It it) noexcept {
+  using lane = numeric_lane_t<T>;
+  using pointer = decltype(std::to_address(it));
+  if constexpr (std::is_const_v<std::remove_pointer_t<pointer>>) {
+    return reinterpret_cast<const lane *>(std::to_address(it));
+  } else {
+    return reinterpret_cast<lane *>(std::to_address(it));
+  }
+}
+
+template <class It, class T, class Op>
+T simd_reduce(It first, It last, T init) noexcept {
+  using lane = numeric_lane_t<T>;
+  return static_cast<T>(simd::reduce<simd_reduction_of<Op, T>::value>(
+      lanes_of<T>(first), static_cast<std::size_t>(last - first),
+      static_cast<lane>(init)));
+}
+
+template <bool inclusive, class InputIt, class OutputIt, class T>
+OutputIt simd_scan(InputIt first, InputIt last, OutputIt d_first,
+                   T init) noexcept {
+  using lane = numeric_lane_t<T>;
+  auto n = static_cast<std::size_t>(last - first);
+  simd::scan_sum<inclusive>(lanes_of<T>(first), n, lanes_of<T>(d_first),
+                            static_cast<lane>(init));
+  return d_first + n;
+}
+
+// Four partial results advance independently, so an operation with
+// latency runs up to four times wider than in a left fold. element(i) is
+// the i-th operand.
+inline constexpr std::size_t unordered_reduce_threshold = 8;
+
+template <class T, class Reduce, class Element>
+constexpr T unordered_reduce(std::size_t n, T init, Reduce &reduce,
+                             Element element) {
+  if (n < unordered_reduce_threshold) {
+    for (std::size_t i = 0; i != n; ++i) {
+      init = reduce(std::move(init), element(i));
+    }
+    return init;
+  }
+  T a = reduce(element(0), element(1));
+  T b = reduce(element(2), element(3));
+  T c = reduce(element(4), element(5));
+  T d = reduce(element(6), element(7));
+  std::size_t i = unordered_reduce_threshold;
+  for (; i + 4 <= n; i += 4) {
+    a = reduce(std::move(a), element(i));
+    b = reduce(std::move(b), element(i + 1));
+    c = reduce(std::move(c), element(i + 2));
+    d = reduce(std::move(d), element(i + 3));
+  }
+  for (; i != n; ++i) {
+    a = reduce(std::move(a), element(i));
+  }
+  T ab = reduce(std::move(a), std::move(b));
+  T cd = reduce(std::move(c), std::move(d));
+  return reduce(std::move(init), reduce(std::move(ab), std::move(cd)));
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// Left fold: init = op(init, x) for every element x in order.
+template <class InputIt, class T, class BinaryOp>
+constexpr T accumulate(InputIt first, InputIt last, T init, BinaryOp op) {
+  if constexpr (detail::simd_accumulable<InputIt, T, BinaryOp>) {
+    if (!std::is_constant_evaluated()) {
+      return detail::simd_reduce<InputIt, T, BinaryOp>(first, last, init);
+    }
+  }
+  for (; first != last; ++first) {
+    init = op(std::move(init), *first);
+  }
+  return init;
+}
+template <class InputIt, class T>
+constexpr T accumulate(InputIt first, InputIt last, T init) {
+  return isl::accumulate(first, last, std::move(init), isl::plus<>{});
+}
+
+/// Like accumulate, but the elements may be combined in any order and
+/// grouping, so op must be associative and commutative. Contiguous
+/// ranges of integers and floats summed or multiplied with isl::plus or
+/// isl::multiplies go to SIMD kernels with several accumulators; other
+/// random-access ranges keep four partial results.
+template <class InputIt, class T, class BinaryOp>
+constexpr T reduce(InputIt first, InputIt last, T init, BinaryOp op) {
+  if constexpr (detail::simd_reducible<InputIt, T, BinaryOp>) {
+    if (!std::is_constant_evaluated()) {
+      return detail::simd_reduce<InputIt, T, BinaryOp>(first, last, init);
+    }
+  }
+  if constexpr (std::random_access_iterator<InputIt>) {
+    return detail::unordered_reduce(
+        static_cast<std::size_t>(last - first), std::move(init), op,
+        [first](std::size_t i) -> decltype(auto) { return first[i]; });
+  } else {
+    for (; first != last; ++first) {
+      init = op(std::move(init), *first);
+    }
+    return init;
+  }
+}
+template <class InputIt, class T>
+constexpr T reduce(InputIt first, InputIt last, T init) {
+  return isl::reduce(first, last, std::move(init), isl::plus<>{});
+}
+template <class InputIt>
+constexpr typename std::iterator_traits<InputIt>::value_type
+reduce(InputIt first, InputIt last) {
+  return isl::reduce(first, last,
+                     typename std::iterator_traits<InputIt>::value_type{},
+                     isl::plus<>{});
+}
+
+/// reduce over transform(x, y) for the pairs of elements of the two
+/// ranges.
+template <class InputIt1, class InputIt2, class T, class BinaryReduceOp,
+          class BinaryTransformOp>
+constexpr T transform_reduce(InputIt1 first1, InputIt1 last1,
+                             InputIt2 first2, T init, BinaryReduceOp reduce,
+                             BinaryTransformOp transform) {
+  if constexpr (std::random_access_iterator<InputIt1> &&
+                std::random_access_iterator<InputIt2>) {
+    return detail::unordered_reduce(
+        static_cast<std::size_t>(last1 - first1), std::move(init), reduce,
+        [&](std::size_t i) -> decltype(auto) {
+          return transform(first1[i], first2[i]);
+        });
+  } else {
+    for (; first1 != last1; ++first1, ++first2) {
+      init = reduce(std::move(init), transform(*first1, *first2));
+    }
+    return init;
+  }
+}
+/// Inner product. Contiguous ranges of one arithmetic type go to SIMD
+/// kernels.
+template <class InputIt1, class InputIt2, class T>
+constexpr T transform_reduce(InputIt1 first1, InputIt1 last1,
+                             InputIt2 first2, T init) {
+  if constexpr (detail::simd_numeric_range<InputIt1, T> &&
+                detail::simd_numeric_range<InputIt2, T>) {
+    if (!std::is_constant_evaluated()) {
+      using lane = detail::numeric_lane_t<T>;
+      return static_cast<T>(detail::simd::dot(
+          detail::lanes_of<T>(first1), detail::lanes_of<T>(first2),
+          static_cast<std::size_t>(last1 - first1), static_cast<lane>(init)));
+    }
+  }
+  return isl::transform_reduce(first1, last1, first2, std::move(init),
+                               isl::plus<>{}, isl::multiplies<>{});
+}
+/// reduce over transform(x) for the elements of the range.
+template <class InputIt, class T, class BinaryReduceOp,
+          class UnaryTransformOp>
+constexpr T transform_reduce(InputIt first, InputIt last, T init,
+                             BinaryReduceOp reduce,
+                             UnaryTransformOp transform) {
+  if constexpr (std::random_access_iterator<InputIt>) {
+    return detail::unordered_reduce(
+        static_cast<std::size_t>(last - first), std::move(init), reduce,
+        [&](std::size_t i) -> decltype(auto) { return transform(first[i]); });
+  } else {
+    for (; first != last; ++first) {
+      init = reduce(std::move(init), transform(*first));
+    }
+    return init;
+  }
+}
+
+/// Writes the running results of op from init, or from the first element
+/// without one, including each element's own. op must be associative.
+/// d_first may be first. Sums of contiguous integers and floats are
+/// scanned a SIMD block at a time.
+template <class InputIt, class OutputIt, class BinaryOp, class T>
+constexpr OutputIt inclusive_scan(InputIt first, InputIt last,
+                                  OutputIt d_first, BinaryOp op, T init) {
+  if constexpr (detail::simd_scannable<InputIt, OutputIt, T, BinaryOp>) {
+    if (!std::is_constant_evaluated()) {
+      return detail::simd_scan<true>(first, last, d_first, init);
+    }
+  }
+  for (; first != last; ++first, ++d_first) {
+    init = op(std::move(init), *first);
+    *d_first = init;
+  }
+  return d_first;
+}
+template <class InputIt, class OutputIt, class BinaryOp>
+constexpr OutputIt inclusive_scan(InputIt first, InputIt last,
+                                  OutputIt d_first, BinaryOp op) {
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  if constexpr (detail::simd_scannable<InputIt, OutputIt, T, BinaryOp>) {
+    if (!std::is_constant_evaluated()) {
+      return detail::simd_scan<true>(first, last, d_first,
+                                     detail::simd::sum_identity<T>);
+    }
+  }
+  if (first == last) {
+    return d_first;
+  }
+  T sum = *first;
+  *d_first = sum;
+  for (++first, ++d_first; first != last; ++first, ++d_first) {
+    sum = op(std::move(sum), *first);
+    *d_first = sum;
+  }
+  return d_first;
+}
+template <class InputIt, class OutputIt>
+constexpr OutputIt inclusive_scan(InputIt first, InputIt last,
+                                  OutputIt d_first) {
+  return isl::inclusive_scan(first, last, d_first, isl::plus<>{});
+}
+
+/// As inclusive_scan from init, but each result leaves out its own
+/// element.
+template <class InputIt, class OutputIt, class T, class BinaryOp>
+constexpr OutputIt exclusive_scan(InputIt first, InputIt last,
+                                  OutputIt d_first, T init, BinaryOp op) {
+  if constexpr (detail::simd_scannable<InputIt, OutputIt, T, BinaryOp>) {
+    if (!std::is_constant_evaluated()) {
+      return detail::simd_scan<false>(first, last, d_first, init);
+    }
+  }
+  for (; first != last; ++first, ++d_first) {
+    T next = op(init, *first);
+    *d_first = std::move(init);
+    init = std::move(next);
+  }
+  return d_first;
+}
+template <class InputIt, class OutputIt, class T>
+constexpr OutputIt exclusive_scan(InputIt first, InputIt last,
+                                  OutputIt d_first, T init) {
+  return isl::exclusive_scan(first, last, d_first, std::move(init),
+                             isl::plus<>{});
+}
+
+/// Assigns value, ++value, ... to the elements in order.
+template <class ForwardIt, class T>
+constexpr void iota(ForwardIt first, ForwardIt last, T value) {
+  for (; first != last; ++first, ++value) {
+    *first = value;
+  }
+}
+
+/// Writes the first element, then op(x, previous) for every later
+/// element x. d_first may be first.
+template <class InputIt, class OutputIt, class BinaryOp>
+constexpr OutputIt adjacent_difference(InputIt first, InputIt last,
+                                       OutputIt d_first, BinaryOp op) {
+  if (first == last) {
+    return d_first;
+  }
+  typename std::iterator_traits<InputIt>::value_type previous = *first;
+  *d_first = previous;
+  while (++first != last) {
+    typename std::iterator_traits<InputIt>::value_type current = *first;
+    *++d_first = op(current, std::move(previous));
+    previous = std::move(current);
+  }
+  return ++d_first;
+}
+template <class InputIt, class OutputIt>
+constexpr OutputIt adjacent_difference(InputIt first, InputIt last,
+                                       OutputIt d_first) {
+  return isl::adjacent_difference(first, last, d_first, isl::minus<>{});
+}
+} // namespace isl
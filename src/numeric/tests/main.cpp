@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include <cmath>   // std::fabs, std::signbit
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int16_t, std::int32_t, std::uint32_t, ...
+#include <list>    // std::list
+#include <numeric> // std::accumulate, std::inclusive_scan, ...
+#include <random>  // std::mt19937_64
+#include <vector>  // std::vector
+
+import functional;
+import numeric;
+
+namespace {
+template <class T> std::vector<T> random_values(std::size_t n, unsigned seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<T> values(n);
+  for (T &value : values) {
+    if constexpr (std::is_floating_point_v<T>) {
+      value = static_cast<T>(static_cast<int>(rng() % 2001) - 1000) / 64;
+    } else if constexpr (std::is_signed_v<T>) {
+      // small enough that no sum or dot product overflows
+      value = static_cast<T>(static_cast<int>(rng() % 201) - 100);
+    } else {
+      value = static_cast<T>(rng());
+    }
+  }
+  return values;
+}
+
+// Floats combined in another order differ by rounding only. The sums of
+// these inputs, multiples of 1/64, are exact; their dot products are not.
+template <class T> void expect_same(T expected, T actual) {
+  if constexpr (std::is_floating_point_v<T>) {
+    EXPECT_NEAR(expected, actual, 1e-5 * (1 + std::fabs(expected)));
+  } else {
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+template <class T> void check_reductions() {
+  for (std::size_t n = 0; n < 300; ++n) {
+    auto values = random_values<T>(n, static_cast<unsigned>(n));
+    auto first = values.begin();
+    auto last = values.end();
+    T init = static_cast<T>(3);
+
+    expect_same(std::accumulate(first, last, init),
+                isl::accumulate(first, last, init));
+    expect_same(std::accumulate(first, last, init),
+                isl::reduce(first, last, init));
+    expect_same(std::accumulate(first, last, T{}), isl::reduce(first, last));
+    expect_same(std::accumulate(first, last, init),
+                isl::reduce(first, last, init, isl::plus<T>{}));
+    expect_same(std::inner_product(first, last, first, init),
+                isl::transform_reduce(first, last, first, init));
+    if constexpr (std::is_unsigned_v<T>) {
+      // unsigned products wrap; other products overflow
+      expect_same(std::accumulate(first, last, init, std::multiplies<>{}),
+                  isl::reduce(first, last, init, isl::multiplies<>{}));
+      expect_same(std::accumulate(first, last, init, std::multiplies<>{}),
+                  isl::accumulate(first, last, init, isl::multiplies<>{}));
+    }
+  }
+}
+
+template <class T> void check_scans() {
+  for (std::size_t n = 0; n < 100; ++n) {
+    auto values = random_values<T>(n, static_cast<unsigned>(n));
+    std::vector<T> expected(n);
+    std::vector<T> actual(n);
+    T init = static_cast<T>(5);
+
+    std::inclusive_scan(values.begin(), values.end(), expected.begin());
+    EXPECT_EQ(isl::inclusive_scan(values.begin(), values.end(),
+                                  actual.begin()),
+              actual.end());
+    EXPECT_EQ(expected, actual);
+
+    std::inclusive_scan(values.begin(), values.end(), expected.begin(),
+                        std::plus<>{}, init);
+    isl::inclusive_scan(values.begin(), values.end(), actual.begin(),
+                        isl::plus<>{}, init);
+    EXPECT_EQ(expected, actual);
+
+    std::exclusive_scan(values.begin(), values.end(), expected.begin(),
+                        init);
+    EXPECT_EQ(isl::exclusive_scan(values.begin(), values.end(),
+                                  actual.begin(), init),
+              actual.end());
+    EXPECT_EQ(expected, actual);
+
+    // in place
+    actual = values;
+    isl::exclusive_scan(actual.begin(), actual.end(), actual.begin(), init);
+    EXPECT_EQ(expected, actual);
+  }
+}
+} // namespace
+
+TEST(TestNumeric, TestReduce) {
+  check_reductions<std::int32_t>();
+  check_reductions<std::uint32_t>();
+  check_reductions<std::int64_t>();
+  check_reductions<std::uint64_t>();
+  check_reductions<std::int16_t>();
+  check_reductions<float>();
+  check_reductions<double>();
+}
+
+TEST(TestNumeric, TestReduceGeneric) {
+  // a user operation over random access keeps partial results
+  auto values = random_values<std::int64_t>(1000, 7);
+  auto max = [](std::int64_t a, std::int64_t b) { return a < b ? b : a; };
+  for (std::size_t n = 0; n < 40; ++n) {
+    EXPECT_EQ(std::accumulate(values.begin(), values.begin() + n,
+                              std::int64_t{0}, max),
+              isl::reduce(values.begin(), values.begin() + n,
+                          std::int64_t{0}, max));
+  }
+
+  std::list<int> list{1, 2, 3, 4, 5};
+  EXPECT_EQ(isl::reduce(list.begin(), list.end()), 15);
+  EXPECT_EQ(isl::accumulate(list.begin(), list.end(), 1, isl::multiplies<>{}),
+            120);
+  EXPECT_EQ(isl::transform_reduce(list.begin(), list.end(), 0, isl::plus<>{},
+                                  [](int x) { return x * x; }),
+            55);
+
+  std::vector<int> naturals(100);
+  isl::iota(naturals.begin(), naturals.end(), 1);
+  EXPECT_EQ(isl::transform_reduce(naturals.begin(), naturals.end(), 0L,
+                                  isl::plus<>{},
+                                  [](int x) { return long(x) * x; }),
+            338350);
+  EXPECT_EQ(isl::transform_reduce(naturals.begin(), naturals.end(),
+                                  naturals.begin(), 0L, isl::plus<>{},
+                                  isl::plus<>{}),
+            10100);
+}
+
+TEST(TestNumeric, TestScan) {
+  check_scans<std::int32_t>();
+  check_scans<std::uint64_t>();
+  check_scans<float>();
+  check_scans<double>();
+  check_scans<std::int16_t>();
+
+  std::list<int> list{1, 2, 3, 4};
+  std::vector<int> out(4);
+  isl::inclusive_scan(list.begin(), list.end(), out.begin(),
+                      isl::multiplies<>{});
+  EXPECT_EQ(out, (std::vector<int>{1, 2, 6, 24}));
+  isl::exclusive_scan(list.begin(), list.end(), out.begin(), 1,
+                      isl::multiplies<>{});
+  EXPECT_EQ(out, (std::vector<int>{1, 1, 2, 6}));
+}
+
+TEST(TestNumeric, TestScanNegativeZero) {
+  std::vector<double> values(20, -0.0);
+  std::vector<double> out(20);
+  isl::inclusive_scan(values.begin(), values.end(), out.begin());
+  for (double x : out) {
+    EXPECT_TRUE(std::signbit(x));
+  }
+}
+
+TEST(TestNumeric, TestIotaAndAdjacentDifference) {
+  std::vector<int> values(50);
+  isl::iota(values.begin(), values.end(), -10);
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(values[i], i - 10);
+  }
+
+  std::vector<int> squares(50);
+  for (int i = 0; i < 50; ++i) {
+    squares[i] = i * i;
+  }
+  std::vector<int> expected(50);
+  std::adjacent_difference(squares.begin(), squares.end(), expected.begin());
+  std::vector<int> actual(50);
+  EXPECT_EQ(isl::adjacent_difference(squares.begin(), squares.end(),
+                                     actual.begin()),
+            actual.end());
+  EXPECT_EQ(expected, actual);
+
+  // in place
+  isl::adjacent_difference(squares.begin(), squares.end(), squares.begin());
+  EXPECT_EQ(expected, squares);
+}
+
+TEST(TestNumeric, TestConstexpr) {
+  constexpr int sum = [] {
+    int values[10] = {};
+    isl::iota(values, values + 10, 1);
+    int prefix[10] = {};
+    isl::inclusive_scan(values, values + 10, prefix);
+    return isl::reduce(values, values + 10) +
+           isl::accumulate(values, values + 10, 0) + prefix[9];
+  }();
+  static_assert(sum == 165);
+  EXPECT_EQ(sum, 165);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,251 @@
+module;
+
+#include <algorithm> // std::copy_n, std::min, std::move
+#include <bit>       // std::bit_ceil, std::has_single_bit
+#include <cstddef>   // std::size_t
+#include <memory>    // std::allocator, std::allocator_traits
+#include <span>      // std::span
+#include <utility>   // std::move, std::exchange
+
+export module ring_buffer;
+
+import array;
+import utility;
+
+export namespace isl {
+inline constexpr std::size_t dynamic_capacity = static_cast<std::size_t>(-1);
+
+template <class T, std::size_t Capacity = dynamic_capacity,
+          class Allocator = std::allocator<T>>
+class ring_buffer;
+} // namespace isl
+
+namespace isl::detail {
+// Compile-time capacity: elements live inline in an isl::array.
+template <class T, std::size_t Capacity, class Allocator>
+struct ring_buffer_storage {
+  static_assert(std::has_single_bit(Capacity),
+                "ring_buffer capacity must be a power of two");
+
+  isl::array<T, Capacity> elements{};
+
+  constexpr ring_buffer_storage() = default;
+  constexpr explicit ring_buffer_storage(const Allocator &) {}
+
+  constexpr T *data() noexcept { return elements.data(); }
+  constexpr const T *data() const noexcept { return elements.data(); }
+  constexpr std::size_t capacity() const noexcept { return Capacity; }
+};
+
+// Runtime capacity: elements are obtained from the allocator, the requested
+// capacity is rounded up to the next power of two.
+template <class T, class Allocator>
+struct ring_buffer_storage<T, dynamic_capacity, Allocator> {
+  using traits = std::allocator_traits<Allocator>;
+
+  [[no_unique_address]] Allocator allocator;
+  T *elements{nullptr};
+  std::size_t capacity_{0};
+
+  constexpr ring_buffer_storage(std::size_t capacity, const Allocator &alloc)
+      : allocator(alloc),
+        capacity_(capacity == 0 ? 0 : std::bit_ceil(capacity)) {
+    this->elements = traits::allocate(this->allocator, this->capacity_);
+    std::uninitialized_value_construct_n(this->elements, this->capacity_);
+  }
+  constexpr ring_buffer_storage(ring_buffer_storage &&other) noexcept
+      : allocator(std::move(other.allocator)),
+        elements(std::exchange(other.elements, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+  ring_buffer_storage(const ring_buffer_storage &) = delete;
+  ring_buffer_storage &operator=(const ring_buffer_storage &) = delete;
+  ring_buffer_storage &operator=(ring_buffer_storage &&) = delete;
+  constexpr ~ring_buffer_storage() {
+    if (this->elements == nullptr) {
+      return;
+    }
+    std::destroy_n(this->elements, this->capacity_);
+    traits::deallocate(this->allocator, this->elements, this->capacity_);
+  }
+
+  constexpr T *data() noexcept { return this->elements; }
+  constexpr const T *data() const noexcept { return this->elements; }
+  constexpr std::size_t capacity() const noexcept { return this->capacity_; }
+};
+} // namespace isl::detail
+
+export namespace isl {
+/// Fixed-capacity FIFO over a power-of-two circular storage.
+///
+/// Read and write positions are free-running counters masked on access, so
+/// the whole capacity is usable and size() is a single subtraction. Bulk
+/// operations work on at most two contiguous segments, which makes them
+/// a pair of std::copy_n calls (memmove for trivially copyable T).
+template <class T, std::size_t Capacity, class Allocator> class ring_buffer {
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+  using segments = isl::pair<std::span<T>, std::span<T>>;
+  using const_segments = isl::pair<std::span<const T>, std::span<const T>>;
+
+private:
+  detail::ring_buffer_storage<T, Capacity, Allocator> storage;
+
+  std::size_t head{0}; // next element to read
+  std::size_t tail{0}; // next slot to write
+
+  constexpr std::size_t mask() const noexcept {
+    return this->storage.capacity() - 1;
+  }
+
+  template <class U>
+  constexpr auto split(U *base, std::size_t from, std::size_t count) const
+      noexcept {
+    std::size_t offset = from & this->mask();
+    std::size_t first = std::min(count, this->capacity() - offset);
+    return isl::pair<std::span<U>, std::span<U>>(
+        std::span<U>(base + offset, first),
+        std::span<U>(base, count - first));
+  }
+
+public:
+  constexpr ring_buffer() requires(Capacity != dynamic_capacity) = default;
+  constexpr explicit ring_buffer(const Allocator &alloc) requires(
+      Capacity != dynamic_capacity)
+      : storage(alloc) {}
+  constexpr explicit ring_buffer(size_type capacity,
+                                 const Allocator &alloc = Allocator()) requires(
+      Capacity == dynamic_capacity)
+      : storage(capacity, alloc) {}
+
+  constexpr ring_buffer(ring_buffer &&other) noexcept
+      : storage(std::move(other.storage)),
+        head(std::exchange(other.head, 0)),
+        tail(std::exchange(other.tail, 0)) {}
+  ring_buffer(const ring_buffer &) = delete;
+  ring_buffer &operator=(const ring_buffer &) = delete;
+
+  // capacity
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return this->head == this->tail;
+  }
+  constexpr bool full() const noexcept {
+    return this->size() == this->capacity();
+  }
+  constexpr size_type size() const noexcept { return this->tail - this->head; }
+  constexpr size_type capacity() const noexcept {
+    return this->storage.capacity();
+  }
+  constexpr size_type available() const noexcept {
+    return this->capacity() - this->size();
+  }
+
+  // element access
+
+  constexpr reference front() {
+    return this->storage.data()[this->head & this->mask()];
+  }
+  constexpr const_reference front() const {
+    return this->storage.data()[this->head & this->mask()];
+  }
+  constexpr reference back() {
+    return this->storage.data()[(this->tail - 1) & this->mask()];
+  }
+  constexpr const_reference back() const {
+    return this->storage.data()[(this->tail - 1) & this->mask()];
+  }
+  constexpr reference operator[](size_type pos) {
+    return this->storage.data()[(this->head + pos) & this->mask()];
+  }
+  constexpr const_reference operator[](size_type pos) const {
+    return this->storage.data()[(this->head + pos) & this->mask()];
+  }
+
+  // single element
+
+  constexpr bool push(const T &value) {
+    if (this->full()) {
+      return false;
+    }
+    this->storage.data()[this->tail++ & this->mask()] = value;
+    return true;
+  }
+  constexpr bool push(T &&value) {
+    if (this->full()) {
+      return false;
+    }
+    this->storage.data()[this->tail++ & this->mask()] = std::move(value);
+    return true;
+  }
+  constexpr bool pop(T &value) {
+    if (this->empty()) {
+      return false;
+    }
+    value = std::move(this->storage.data()[this->head++ & this->mask()]);
+    return true;
+  }
+
+  // bulk
+
+  /// Copies as many elements of `values` as fit, returns how many were
+  /// pushed.
+  constexpr size_type push(std::span<const T> values) {
+    size_type count = std::min(values.size(), this->available());
+    auto [first, second] = this->writable();
+
+    size_type head_part = std::min(count, first.size());
+    std::copy_n(values.data(), head_part, first.data());
+    std::copy_n(values.data() + head_part, count - head_part, second.data());
+
+    this->tail += count;
+    return count;
+  }
+  /// Moves up to `values.size()` elements out of the buffer, returns how
+  /// many were popped.
+  constexpr size_type pop(std::span<T> values) {
+    size_type count = std::min(values.size(), this->size());
+    auto [first, second] = this->split(this->storage.data(), this->head, count);
+
+    std::move(first.begin(), first.end(), values.begin());
+    std::move(second.begin(), second.end(), values.begin() + first.size());
+
+    this->head += count;
+    return count;
+  }
+  /// Like pop(std::span<T>), but leaves the elements in the buffer.
+  constexpr size_type peek(std::span<T> values) const {
+    size_type count = std::min(values.size(), this->size());
+    auto [first, second] = this->readable();
+
+    size_type head_part = std::min(count, first.size());
+    std::copy_n(first.data(), head_part, values.data());
+    std::copy_n(second.data(), count - head_part, values.data() + head_part);
+
+    return count;
+  }
+
+  // zero-copy access
+
+  /// Occupied elements in FIFO order, as up to two contiguous segments.
+  constexpr const_segments readable() const noexcept {
+    return this->split(static_cast<const T *>(this->storage.data()), this->head,
+                       this->size());
+  }
+  /// Free slots in FIFO order. Fill them, then publish with commit().
+  constexpr segments writable() noexcept {
+    return this->split(this->storage.data(), this->tail, this->available());
+  }
+  constexpr void commit(size_type count) noexcept { this->tail += count; }
+  constexpr void consume(size_type count) noexcept { this->head += count; }
+
+  constexpr void clear() noexcept { this->head = this->tail = 0; }
+};
+} // namespace isl
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <array>  // std::array
+#include <memory> // std::unique_ptr, std::make_unique
+#include <span>   // std::span
+
+import ring_buffer;
+
+TEST(ring_buffer, TestPushPop) {
+  isl::ring_buffer<int, 4> buffer;
+
+  ASSERT_TRUE(buffer.empty());
+  ASSERT_EQ(buffer.capacity(), 4);
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(buffer.push(i));
+  }
+  ASSERT_TRUE(buffer.full());
+  ASSERT_FALSE(buffer.push(4));
+
+  int value = -1;
+  ASSERT_TRUE(buffer.pop(value));
+  ASSERT_EQ(value, 0);
+  ASSERT_EQ(buffer.front(), 1);
+  ASSERT_EQ(buffer.back(), 3);
+}
+
+TEST(ring_buffer, TestRuntimeCapacityIsRoundedUp) {
+  isl::ring_buffer<int> buffer(5);
+
+  ASSERT_EQ(buffer.capacity(), 8);
+  ASSERT_EQ(buffer.available(), 8);
+}
+
+TEST(ring_buffer, TestBulkWrapsAround) {
+  isl::ring_buffer<int> buffer(8);
+  std::array<int, 6> input{1, 2, 3, 4, 5, 6};
+  std::array<int, 6> output{};
+
+  ASSERT_EQ(buffer.push(input), 6);
+  ASSERT_EQ(buffer.pop(std::span<int>(output.data(), 4)), 4);
+
+  // tail is at 6, so the next six elements are split 2 + 4
+  ASSERT_EQ(buffer.push(input), 6);
+  auto [first, second] = buffer.readable();
+  ASSERT_EQ(first.size(), 4);
+  ASSERT_EQ(second.size(), 4);
+
+  ASSERT_EQ(buffer.push(input), 0);
+
+  std::array<int, 8> drained{};
+  ASSERT_EQ(buffer.pop(drained), 8);
+  ASSERT_EQ(drained, (std::array<int, 8>{5, 6, 1, 2, 3, 4, 5, 6}));
+  ASSERT_TRUE(buffer.empty());
+}
+
+TEST(ring_buffer, TestBulkPopMoves) {
+  isl::ring_buffer<std::unique_ptr<int>, 4> buffer;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(buffer.push(std::make_unique<int>(i)));
+  }
+  std::unique_ptr<int> value;
+  ASSERT_TRUE(buffer.pop(value));
+  ASSERT_TRUE(buffer.push(std::make_unique<int>(4)));
+
+  // the occupied range wraps around
+  std::array<std::unique_ptr<int>, 4> output;
+  ASSERT_EQ(buffer.pop(output), 4);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(*output[i], i + 1);
+  }
+  ASSERT_TRUE(buffer.empty());
+}
+
+TEST(ring_buffer, TestWritableCommit) {
+  isl::ring_buffer<char, 8> buffer;
+
+  auto [first, second] = buffer.writable();
+  ASSERT_EQ(first.size() + second.size(), 8);
+
+  first[0] = 'a';
+  first[1] = 'b';
+  buffer.commit(2);
+
+  ASSERT_EQ(buffer.size(), 2);
+  ASSERT_EQ(buffer[1], 'b');
+
+  buffer.consume(1);
+  ASSERT_EQ(buffer.front(), 'b');
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
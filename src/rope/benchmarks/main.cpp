@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <string> // std::string
+
+import rope;
+import string;
+import string_view;
+
+// Building a multi-megabyte response out of many small fragments.
+
+static constexpr int fragment_count = 100000;
+
+static void BM_RopeAppend(benchmark::State &state) {
+  for (auto _ : state) {
+    isl::rope response;
+    for (int i = 0; i < fragment_count; ++i) {
+      response += "<li>item</li>\n";
+      response += "<p>some paragraph text</p>\n";
+    }
+    benchmark::DoNotOptimize(response.size());
+  }
+}
+BENCHMARK(BM_RopeAppend);
+
+static void BM_IslStringAppend(benchmark::State &state) {
+  for (auto _ : state) {
+    isl::string response;
+    for (int i = 0; i < fragment_count; ++i) {
+      response.append("<li>item</li>\n");
+      response.append("<p>some paragraph text</p>\n");
+    }
+    benchmark::DoNotOptimize(response.data());
+  }
+}
+BENCHMARK(BM_IslStringAppend);
+
+static void BM_StdStringAppend(benchmark::State &state) {
+  for (auto _ : state) {
+    std::string response;
+    for (int i = 0; i < fragment_count; ++i) {
+      response += "<li>item</li>\n";
+      response += "<p>some paragraph text</p>\n";
+    }
+    benchmark::DoNotOptimize(response.data());
+  }
+}
+BENCHMARK(BM_StdStringAppend);
+
+// Splicing large shared bodies together: the rope links, strings copy.
+
+static void BM_RopeConcatLarge(benchmark::State &state) {
+  isl::rope body(isl::string_view(std::string(1 << 20, 'x').c_str()));
+  for (auto _ : state) {
+    isl::rope response;
+    for (int i = 0; i < 16; ++i) {
+      response += body;
+    }
+    benchmark::DoNotOptimize(response.size());
+  }
+}
+BENCHMARK(BM_RopeConcatLarge);
+
+static void BM_StdStringConcatLarge(benchmark::State &state) {
+  std::string body(1 << 20, 'x');
+  for (auto _ : state) {
+    std::string response;
+    for (int i = 0; i < 16; ++i) {
+      response += body;
+    }
+    benchmark::DoNotOptimize(response.data());
+  }
+}
+BENCHMARK(BM_StdStringConcatLarge);
+
+BENCHMARK_MAIN();
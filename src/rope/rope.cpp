@@ -0,0 +1,646 @@
+module;
+
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::size_t, std::ptrdiff_t
+#include <cstdint>   // std::uint8_t, std::uint32_t
+#include <cstring>   // std::memcpy, std::memcmp
+#include <iterator>  // std::forward_iterator_tag, std::default_sentinel_t
+#include <new>       // ::operator new, ::operator delete
+#include <stdexcept> // std::out_of_range
+#include <utility>   // std::exchange, std::move, std::swap
+
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h> // iovec
+#endif
+
+export module rope;
+
+import string;
+import string_view;
+
+namespace isl::detail {
+enum class rope_kind : std::uint8_t { flat, substring, concat };
+
+// Every node starts with this header. Leaves (flat, substring) have depth
+// 0; a concat node is one deeper than its deeper child.
+struct rope_node {
+  std::atomic<std::uint32_t> refs{1};
+  rope_kind kind;
+  std::uint8_t depth;
+  std::size_t size;
+};
+
+// Owns its bytes, which follow the node in the same allocation.
+struct rope_flat : rope_node {
+  std::size_t capacity;
+
+  char *data() noexcept { return reinterpret_cast<char *>(this + 1); }
+  const char *data() const noexcept {
+    return reinterpret_cast<const char *>(this + 1);
+  }
+};
+
+// A slice of a flat it holds a reference to.
+struct rope_substring : rope_node {
+  rope_flat *base;
+  std::size_t offset;
+};
+
+struct rope_concat : rope_node {
+  rope_node *left;
+  rope_node *right;
+};
+
+// Pieces up to this size are copied rather than linked, so that ropes built
+// from many small strings do not degrade into a node per string.
+inline constexpr std::size_t rope_small_size = 256;
+// Capacity range of the flats small appends go to; later small appends
+// fill them in place while the path to them is not shared. They grow with
+// the rope, so a rope built by appending has few chunks and a short spine.
+inline constexpr std::size_t rope_flat_capacity = 4096 - sizeof(rope_flat);
+inline constexpr std::size_t rope_max_flat_capacity =
+    (std::size_t{1} << 18) - sizeof(rope_flat);
+// Concat nodes are kept AVL-balanced, so a tree of at most 2^64 leaves is
+// shallower than this.
+inline constexpr std::size_t rope_max_depth = 96;
+
+inline void rope_retain(rope_node *node) noexcept {
+  node->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void rope_release(rope_node *node) noexcept {
+  if (node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  switch (node->kind) {
+  case rope_kind::flat:
+    static_cast<rope_flat *>(node)->~rope_flat();
+    break;
+  case rope_kind::substring: {
+    auto *substring = static_cast<rope_substring *>(node);
+    rope_release(substring->base);
+    substring->~rope_substring();
+    break;
+  }
+  case rope_kind::concat: {
+    auto *concat = static_cast<rope_concat *>(node);
+    rope_release(concat->left);
+    rope_release(concat->right);
+    concat->~rope_concat();
+    break;
+  }
+  }
+  ::operator delete(node);
+}
+
+/// Owning reference to a node; null for the empty rope.
+class rope_ptr {
+  rope_node *node{nullptr};
+
+public:
+  rope_ptr() = default;
+  explicit rope_ptr(rope_node *adopted) noexcept : node(adopted) {}
+  rope_ptr(const rope_ptr &other) noexcept : node(other.node) {
+    if (this->node) {
+      rope_retain(this->node);
+    }
+  }
+  rope_ptr(rope_ptr &&other) noexcept
+      : node(std::exchange(other.node, nullptr)) {}
+  rope_ptr &operator=(rope_ptr other) noexcept {
+    std::swap(this->node, other.node);
+    return *this;
+  }
+  ~rope_ptr() {
+    if (this->node) {
+      rope_release(this->node);
+    }
+  }
+
+  rope_node *get() const noexcept { return this->node; }
+  /// Gives up ownership without releasing.
+  rope_node *release() noexcept { return std::exchange(this->node, nullptr); }
+  rope_node *operator->() const noexcept { return this->node; }
+  explicit operator bool() const noexcept { return this->node != nullptr; }
+};
+
+inline string_view rope_leaf_view(const rope_node *node) noexcept {
+  if (node->kind == rope_kind::flat) {
+    auto *flat = static_cast<const rope_flat *>(node);
+    return string_view(flat->data(), flat->size);
+  }
+  auto *substring = static_cast<const rope_substring *>(node);
+  return string_view(substring->base->data() + substring->offset,
+                     substring->size);
+}
+
+inline rope_flat *rope_make_flat(std::size_t capacity) {
+  void *memory = ::operator new(sizeof(rope_flat) + capacity);
+  auto *flat = new (memory) rope_flat;
+  flat->kind = rope_kind::flat;
+  flat->depth = 0;
+  flat->size = 0;
+  flat->capacity = capacity;
+  return flat;
+}
+
+/// Flat copy of `s`; small ones get room to grow in place, more the longer
+/// the rope they are appended to.
+inline rope_ptr rope_make_leaf(string_view s, std::size_t rope_size = 0) {
+  std::size_t capacity = s.size();
+  if (capacity <= rope_small_size) {
+    capacity = rope_size / 8;
+    capacity = capacity < rope_flat_capacity ? rope_flat_capacity : capacity;
+    capacity = capacity > rope_max_flat_capacity ? rope_max_flat_capacity
+                                                 : capacity;
+  }
+  rope_flat *flat = rope_make_flat(capacity);
+  std::memcpy(flat->data(), s.data(), s.size());
+  flat->size = s.size();
+  return rope_ptr(flat);
+}
+
+inline rope_ptr rope_make_concat(rope_ptr left, rope_ptr right) {
+  auto *concat = new (::operator new(sizeof(rope_concat))) rope_concat;
+  concat->kind = rope_kind::concat;
+  concat->depth = static_cast<std::uint8_t>(
+      1 + (left->depth > right->depth ? left->depth : right->depth));
+  concat->size = left->size + right->size;
+  concat->left = left.release();
+  concat->right = right.release();
+  return rope_ptr(concat);
+}
+
+inline rope_ptr rope_left(const rope_ptr &concat) {
+  rope_node *child = static_cast<rope_concat *>(concat.get())->left;
+  rope_retain(child);
+  return rope_ptr(child);
+}
+inline rope_ptr rope_right(const rope_ptr &concat) {
+  rope_node *child = static_cast<rope_concat *>(concat.get())->right;
+  rope_retain(child);
+  return rope_ptr(child);
+}
+
+inline void rope_copy_out(const rope_node *node, std::size_t pos,
+                          std::size_t count, char *out) {
+  while (node->kind == rope_kind::concat) {
+    auto *concat = static_cast<const rope_concat *>(node);
+    std::size_t left_size = concat->left->size;
+    if (pos + count <= left_size) {
+      node = concat->left;
+    } else if (pos >= left_size) {
+      pos -= left_size;
+      node = concat->right;
+    } else {
+      std::size_t head = left_size - pos;
+      rope_copy_out(concat->left, pos, head, out);
+      out += head;
+      count -= head;
+      pos = 0;
+      node = concat->right;
+    }
+  }
+  std::memcpy(out, rope_leaf_view(node).data() + pos, count);
+}
+
+/// Flat copy of both trees; only used on small ones.
+inline rope_ptr rope_merge_small(const rope_ptr &left, const rope_ptr &right) {
+  std::size_t size = left->size + right->size;
+  rope_flat *flat = rope_make_flat(size);
+  rope_copy_out(left.get(), 0, left->size, flat->data());
+  rope_copy_out(right.get(), 0, right->size, flat->data() + left->size);
+  flat->size = size;
+  return rope_ptr(flat);
+}
+
+inline bool rope_is_small_leaf(const rope_node *node) noexcept {
+  return node->kind != rope_kind::concat && node->size <= rope_small_size;
+}
+
+/// Concatenation of two AVL-balanced trees in O(|depth difference|): the
+/// shallower tree joins the deeper one's spine where depths match and the
+/// path back up is rebalanced with rotations. Small neighbouring leaves
+/// at the seam are merged.
+inline rope_ptr rope_join(rope_ptr left, rope_ptr right) {
+  if (!left) {
+    return right;
+  }
+  if (!right) {
+    return left;
+  }
+  if (left->size + right->size <= rope_small_size) {
+    return rope_merge_small(left, right);
+  }
+  if (rope_is_small_leaf(right.get()) && left->kind == rope_kind::concat) {
+    auto *concat = static_cast<rope_concat *>(left.get());
+    if (rope_is_small_leaf(concat->right) &&
+        concat->right->size + right->size <= rope_small_size) {
+      rope_ptr merged = rope_merge_small(rope_right(left), right);
+      return rope_join(rope_left(left), std::move(merged));
+    }
+  }
+  if (rope_is_small_leaf(left.get()) && right->kind == rope_kind::concat) {
+    auto *concat = static_cast<rope_concat *>(right.get());
+    if (rope_is_small_leaf(concat->left) &&
+        left->size + concat->left->size <= rope_small_size) {
+      rope_ptr merged = rope_merge_small(left, rope_left(right));
+      return rope_join(std::move(merged), rope_right(right));
+    }
+  }
+
+  if (left->depth > right->depth + 1) {
+    rope_ptr outer = rope_left(left);
+    rope_ptr inner = rope_join(rope_right(left), std::move(right));
+    if (inner->depth <= outer->depth + 1) {
+      return rope_make_concat(std::move(outer), std::move(inner));
+    }
+    // inner is two deeper than outer: rotate left, twice if its heavy
+    // side is the inside
+    rope_ptr inner_left = rope_left(inner);
+    rope_ptr inner_right = rope_right(inner);
+    if (inner_left->depth <= inner_right->depth) {
+      return rope_make_concat(
+          rope_make_concat(std::move(outer), std::move(inner_left)),
+          std::move(inner_right));
+    }
+    return rope_make_concat(
+        rope_make_concat(std::move(outer), rope_left(inner_left)),
+        rope_make_concat(rope_right(inner_left), std::move(inner_right)));
+  }
+  if (right->depth > left->depth + 1) {
+    rope_ptr outer = rope_right(right);
+    rope_ptr inner = rope_join(std::move(left), rope_left(right));
+    if (inner->depth <= outer->depth + 1) {
+      return rope_make_concat(std::move(inner), std::move(outer));
+    }
+    rope_ptr inner_left = rope_left(inner);
+    rope_ptr inner_right = rope_right(inner);
+    if (inner_right->depth <= inner_left->depth) {
+      return rope_make_concat(
+          std::move(inner_left),
+          rope_make_concat(std::move(inner_right), std::move(outer)));
+    }
+    return rope_make_concat(
+        rope_make_concat(std::move(inner_left), rope_left(inner_right)),
+        rope_make_concat(rope_right(inner_right), std::move(outer)));
+  }
+  return rope_make_concat(std::move(left), std::move(right));
+}
+
+/// [pos, pos + count) of `node` in O(log n), sharing everything but the
+/// nodes along the two cut paths.
+inline rope_ptr rope_slice(const rope_ptr &node, std::size_t pos,
+                           std::size_t count) {
+  if (count == 0) {
+    return rope_ptr();
+  }
+  if (pos == 0 && count == node->size) {
+    return node;
+  }
+  if (count <= rope_small_size) {
+    rope_flat *flat = rope_make_flat(count);
+    rope_copy_out(node.get(), pos, count, flat->data());
+    flat->size = count;
+    return rope_ptr(flat);
+  }
+  switch (node->kind) {
+  case rope_kind::flat:
+  case rope_kind::substring: {
+    rope_flat *base;
+    if (node->kind == rope_kind::flat) {
+      base = static_cast<rope_flat *>(node.get());
+    } else {
+      auto *substring = static_cast<rope_substring *>(node.get());
+      base = substring->base;
+      pos += substring->offset;
+    }
+    auto *slice = new (::operator new(sizeof(rope_substring))) rope_substring;
+    slice->kind = rope_kind::substring;
+    slice->depth = 0;
+    slice->size = count;
+    rope_retain(base);
+    slice->base = base;
+    slice->offset = pos;
+    return rope_ptr(slice);
+  }
+  case rope_kind::concat:
+    break;
+  }
+  std::size_t left_size = static_cast<rope_concat *>(node.get())->left->size;
+  if (pos + count <= left_size) {
+    return rope_slice(rope_left(node), pos, count);
+  }
+  if (pos >= left_size) {
+    return rope_slice(rope_right(node), pos - left_size, count);
+  }
+  return rope_join(rope_slice(rope_left(node), pos, left_size - pos),
+                   rope_slice(rope_right(node), 0, pos + count - left_size));
+}
+
+/// Appends in place when every node down the right spine is owned by this
+/// rope alone and the last leaf is a flat with room.
+inline bool rope_append_in_place(rope_node *root, string_view s) noexcept {
+  rope_node *node = root;
+  while (node->refs.load(std::memory_order_acquire) == 1 &&
+         node->kind == rope_kind::concat) {
+    node = static_cast<rope_concat *>(node)->right;
+  }
+  if (node->refs.load(std::memory_order_acquire) != 1 ||
+      node->kind != rope_kind::flat) {
+    return false;
+  }
+  auto *flat = static_cast<rope_flat *>(node);
+  if (flat->capacity - flat->size < s.size()) {
+    return false;
+  }
+  std::memcpy(flat->data() + flat->size, s.data(), s.size());
+  for (node = root; node != flat;
+       node = static_cast<rope_concat *>(node)->right) {
+    node->size += s.size();
+  }
+  flat->size += s.size();
+  return true;
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// Immutable-ish text built from shared chunks: a binary tree of
+/// ref-counted leaves.
+///
+/// Copying a rope, concatenating two ropes and taking a substring share
+/// the underlying bytes instead of copying them; the last two cost
+/// O(log n) new nodes. Concat nodes are kept AVL-balanced. Pieces of up
+/// to a few hundred bytes are copied into flat leaves instead of being
+/// linked, and small appends fill the last leaf in place while nothing
+/// else shares it, so a rope built by appending behaves like a chunked
+/// string builder. Chunks can be handed to writev without flattening.
+class rope {
+  detail::rope_ptr root;
+
+  explicit rope(detail::rope_ptr node) noexcept : root(std::move(node)) {}
+
+public:
+  using value_type = char;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+  /// Forward iterator over the leaves, as views, in order.
+  class chunk_iterator {
+    const detail::rope_node *pending[detail::rope_max_depth] = {};
+    std::size_t pending_count{0};
+    string_view chunk;
+
+    void descend(const detail::rope_node *node) noexcept {
+      while (node->kind == detail::rope_kind::concat) {
+        auto *concat = static_cast<const detail::rope_concat *>(node);
+        this->pending[this->pending_count++] = concat->right;
+        node = concat->left;
+      }
+      this->chunk = detail::rope_leaf_view(node);
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const string_view *;
+    using reference = const string_view &;
+
+    chunk_iterator() = default;
+    explicit chunk_iterator(const detail::rope_node *root) noexcept {
+      if (root) {
+        this->descend(root);
+      }
+    }
+
+    reference operator*() const noexcept { return this->chunk; }
+    pointer operator->() const noexcept { return &this->chunk; }
+
+    chunk_iterator &operator++() noexcept {
+      if (this->pending_count == 0) {
+        this->chunk = string_view();
+      } else {
+        this->descend(this->pending[--this->pending_count]);
+      }
+      return *this;
+    }
+    chunk_iterator operator++(int) noexcept {
+      chunk_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    friend bool operator==(const chunk_iterator &lhs,
+                           const chunk_iterator &rhs) noexcept {
+      return lhs.chunk.data() == rhs.chunk.data() &&
+             lhs.chunk.size() == rhs.chunk.size() &&
+             lhs.pending_count == rhs.pending_count;
+    }
+    friend bool operator==(const chunk_iterator &it,
+                           std::default_sentinel_t) noexcept {
+      return it.chunk.empty();
+    }
+  };
+
+  struct chunk_range {
+    chunk_iterator first;
+
+    chunk_iterator begin() const noexcept { return this->first; }
+    std::default_sentinel_t end() const noexcept { return {}; }
+  };
+
+  rope() = default;
+  rope(string_view s) {
+    if (!s.empty()) {
+      this->root = detail::rope_make_leaf(s);
+    }
+  }
+  rope(const char *s) : rope(string_view(s)) {}
+  rope(const rope &) = default;
+  rope(rope &&) noexcept = default;
+  rope &operator=(const rope &) = default;
+  rope &operator=(rope &&) noexcept = default;
+
+  size_type size() const noexcept {
+    return this->root ? this->root->size : 0;
+  }
+  [[nodiscard]] bool empty() const noexcept { return !this->root; }
+  /// Height of the tree; 0 for a single chunk.
+  size_type depth() const noexcept {
+    return this->root ? this->root->depth : 0;
+  }
+
+  /// O(log n).
+  char operator[](size_type pos) const noexcept {
+    const detail::rope_node *node = this->root.get();
+    while (node->kind == detail::rope_kind::concat) {
+      auto *concat = static_cast<const detail::rope_concat *>(node);
+      if (pos < concat->left->size) {
+        node = concat->left;
+      } else {
+        pos -= concat->left->size;
+        node = concat->right;
+      }
+    }
+    return detail::rope_leaf_view(node)[pos];
+  }
+  char at(size_type pos) const {
+    if (pos >= this->size()) {
+      throw std::out_of_range{"OUT OF BOUNDS!"};
+    }
+    return (*this)[pos];
+  }
+
+  rope &append(string_view s) {
+    if (s.empty()) {
+      return *this;
+    }
+    if (this->root && s.size() <= detail::rope_small_size &&
+        detail::rope_append_in_place(this->root.get(), s)) {
+      return *this;
+    }
+    this->root = detail::rope_join(std::move(this->root),
+                                   detail::rope_make_leaf(s, this->size()));
+    return *this;
+  }
+  /// Shares `other`'s chunks.
+  rope &append(const rope &other) {
+    this->root = detail::rope_join(std::move(this->root), other.root);
+    return *this;
+  }
+  rope &operator+=(string_view s) { return this->append(s); }
+  rope &operator+=(const char *s) { return this->append(string_view(s)); }
+  rope &operator+=(const rope &other) { return this->append(other); }
+
+  friend rope operator+(const rope &lhs, const rope &rhs) {
+    return rope(detail::rope_join(lhs.root, rhs.root));
+  }
+
+  /// [pos, pos + count), clamped to the end; shares the bytes.
+  rope substr(size_type pos = 0, size_type count = npos) const {
+    size_type size = this->size();
+    if (pos > size) {
+      throw std::out_of_range{"OUT OF BOUNDS!"};
+    }
+    count = count < size - pos ? count : size - pos;
+    if (count == 0) {
+      return rope();
+    }
+    return rope(detail::rope_slice(this->root, pos, count));
+  }
+
+  chunk_range chunks() const noexcept {
+    return chunk_range{chunk_iterator(this->root.get())};
+  }
+
+  /// Copies up to `count` chars starting at `pos` to `dest`; returns how
+  /// many.
+  size_type copy(char *dest, size_type count, size_type pos = 0) const {
+    size_type size = this->size();
+    if (pos > size) {
+      throw std::out_of_range{"OUT OF BOUNDS!"};
+    }
+    count = count < size - pos ? count : size - pos;
+    if (count != 0) {
+      detail::rope_copy_out(this->root.get(), pos, count, dest);
+    }
+    return count;
+  }
+
+  /// Contiguous copy of the whole text.
+  string str() const {
+    string result;
+    result.resize_and_overwrite(this->size(), [this](char *out,
+                                                     std::size_t n) {
+      if (n != 0) {
+        detail::rope_copy_out(this->root.get(), 0, n, out);
+      }
+      return n;
+    });
+    return result;
+  }
+
+  /// Collapses the rope into a single chunk and returns a view of it,
+  /// valid until the rope is next modified.
+  string_view flatten() {
+    if (!this->root) {
+      return string_view();
+    }
+    if (this->root->kind != detail::rope_kind::concat) {
+      return detail::rope_leaf_view(this->root.get());
+    }
+    std::size_t size = this->root->size;
+    detail::rope_flat *flat = detail::rope_make_flat(size);
+    detail::rope_copy_out(this->root.get(), 0, size, flat->data());
+    flat->size = size;
+    this->root = detail::rope_ptr(flat);
+    return string_view(flat->data(), size);
+  }
+
+  void swap(rope &other) noexcept { std::swap(this->root, other.root); }
+
+  friend bool operator==(const rope &lhs, string_view rhs) noexcept {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    const char *position = rhs.data();
+    for (string_view chunk : lhs.chunks()) {
+      if (std::memcmp(chunk.data(), position, chunk.size()) != 0) {
+        return false;
+      }
+      position += chunk.size();
+    }
+    return true;
+  }
+  friend bool operator==(const rope &lhs, const char *rhs) noexcept {
+    return lhs == string_view(rhs);
+  }
+  friend bool operator==(const rope &lhs, const rope &rhs) noexcept {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    if (lhs.root.get() == rhs.root.get()) {
+      return true;
+    }
+    // walk both chunk sequences, whose boundaries need not line up
+    chunk_iterator left(lhs.root.get());
+    chunk_iterator right(rhs.root.get());
+    string_view a = left == std::default_sentinel ? string_view() : *left;
+    string_view b = right == std::default_sentinel ? string_view() : *right;
+    while (!a.empty()) {
+      std::size_t n = a.size() < b.size() ? a.size() : b.size();
+      if (std::memcmp(a.data(), b.data(), n) != 0) {
+        return false;
+      }
+      a.remove_prefix(n);
+      b.remove_prefix(n);
+      if (a.empty() && ++left != std::default_sentinel) {
+        a = *left;
+      }
+      if (b.empty() && ++right != std::default_sentinel) {
+        b = *right;
+      }
+    }
+    return true;
+  }
+};
+
+inline void swap(rope &lhs, rope &rhs) noexcept { lhs.swap(rhs); }
+
+#if __has_include(<sys/uio.h>)
+/// Fills up to `count` iovecs from `it` onwards and advances it past them;
+/// returns how many were filled. Feed writev until `it` reaches the end.
+inline std::size_t fill_iovec(rope::chunk_iterator &it, ::iovec *out,
+                              std::size_t count) noexcept {
+  std::size_t filled = 0;
+  for (; filled != count && it != std::default_sentinel; ++it, ++filled) {
+    out[filled].iov_base = const_cast<char *>(it->data());
+    out[filled].iov_len = it->size();
+  }
+  return filled;
+}
+#endif
+} // namespace isl
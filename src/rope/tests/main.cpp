@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <cmath>   // std::log2
+#include <random>  // std::mt19937
+#include <string>  // std::string, std::to_string
+
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h> // iovec
+#endif
+
+import rope;
+import string_view;
+
+namespace {
+std::string to_std_string(const isl::rope &r) {
+  std::string result;
+  for (isl::string_view chunk : r.chunks()) {
+    result.append(chunk.data(), chunk.size());
+  }
+  return result;
+}
+
+isl::string_view view_of(const std::string &s) {
+  return isl::string_view(s.data(), s.size());
+}
+} // namespace
+
+TEST(rope, TestBasic) {
+  isl::rope empty;
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(empty.size(), 0);
+  ASSERT_TRUE(empty.chunks().begin() == std::default_sentinel);
+
+  isl::rope r = "hello";
+  r += ", ";
+  r += isl::rope("world");
+  ASSERT_EQ(r.size(), 12);
+  ASSERT_EQ(r, "hello, world");
+  ASSERT_EQ(r[7], 'w');
+  ASSERT_EQ(r.at(11), 'd');
+  ASSERT_THROW(r.at(12), std::out_of_range);
+  ASSERT_EQ(r.str(), "hello, world");
+  // small pieces are merged into one chunk
+  ASSERT_EQ(r.depth(), 0);
+  ASSERT_EQ(r.substr(7, 3), "wor");
+  ASSERT_EQ(r.substr(7), "world");
+  ASSERT_THROW(r.substr(13), std::out_of_range);
+}
+
+// Large pieces are linked, not copied; the tree stays logarithmically deep
+// however it is built.
+TEST(rope, TestConcatenation) {
+  std::string expected;
+  isl::rope r;
+  for (int i = 0; i < 2000; ++i) {
+    std::string piece(300 + i % 50, static_cast<char>('a' + i % 26));
+    isl::rope chunk(view_of(piece));
+    if (i % 3 == 0) {
+      r = chunk + r;
+      expected = piece + expected;
+    } else {
+      r += chunk;
+      expected += piece;
+    }
+  }
+  ASSERT_EQ(r.size(), expected.size());
+  ASSERT_EQ(to_std_string(r), expected);
+  ASSERT_LE(r.depth(), 1.45 * std::log2(2000 + 2));
+
+  isl::rope copy = r;
+  copy += copy;
+  ASSERT_EQ(to_std_string(copy), expected + expected);
+  ASSERT_EQ(to_std_string(r), expected);
+  ASSERT_TRUE(copy.substr(0, r.size()) == r);
+}
+
+TEST(rope, TestSubstr) {
+  std::string expected;
+  isl::rope r;
+  for (int i = 0; i < 500; ++i) {
+    std::string piece = std::to_string(i * 7919) + std::string(i % 400, '.');
+    r += view_of(piece);
+    expected += piece;
+  }
+  std::mt19937 rng(1);
+  for (int i = 0; i < 2000; ++i) {
+    std::size_t pos = rng() % expected.size();
+    std::size_t count = rng() % (expected.size() - pos + 1);
+    isl::rope part = r.substr(pos, count);
+    ASSERT_EQ(to_std_string(part), expected.substr(pos, count));
+    ASSERT_EQ(part, view_of(expected.substr(pos, count)));
+
+    // a substring of a substring, appended to
+    if (count > 10) {
+      isl::rope inner = part.substr(5, count - 10);
+      inner += "tail";
+      ASSERT_EQ(to_std_string(inner),
+                expected.substr(pos + 5, count - 10) + "tail");
+    }
+  }
+
+  char buffer[64];
+  ASSERT_EQ(r.copy(buffer, sizeof(buffer), r.size() - 10), 10);
+  ASSERT_EQ(std::string(buffer, 10), expected.substr(expected.size() - 10));
+}
+
+// Small appends fill a chunk in place; a shared rope is left untouched.
+TEST(rope, TestAppendInPlace) {
+  isl::rope r;
+  std::string expected;
+  for (int i = 0; i < 10000; ++i) {
+    std::string piece = std::to_string(i) + ",";
+    r += view_of(piece);
+    expected += piece;
+  }
+  ASSERT_EQ(to_std_string(r), expected);
+  std::size_t chunk_count = 0;
+  std::size_t full_chunks = 0;
+  for (isl::string_view chunk : r.chunks()) {
+    full_chunks += chunk.size() > 4000;
+    ++chunk_count;
+  }
+  ASSERT_EQ(full_chunks, chunk_count - 1);
+
+  isl::rope shared = r;
+  r += "more";
+  ASSERT_EQ(to_std_string(shared), expected);
+  ASSERT_EQ(to_std_string(r), expected + "more");
+
+  isl::string_view flat = r.flatten();
+  ASSERT_EQ(std::string(flat.data(), flat.size()), expected + "more");
+  ASSERT_EQ(r.depth(), 0);
+}
+
+#if __has_include(<sys/uio.h>)
+TEST(rope, TestIovec) {
+  isl::rope r;
+  for (int i = 0; i < 20; ++i) {
+    r += isl::rope(view_of(std::string(1000, static_cast<char>('a' + i))));
+  }
+  std::string gathered;
+  auto it = r.chunks().begin();
+  ::iovec vectors[8];
+  while (std::size_t n = isl::fill_iovec(it, vectors, 8)) {
+    ASSERT_LE(n, 8);
+    for (std::size_t i = 0; i < n; ++i) {
+      gathered.append(static_cast<const char *>(vectors[i].iov_base),
+                      vectors[i].iov_len);
+    }
+  }
+  ASSERT_EQ(gathered, to_std_string(r));
+  ASSERT_EQ(r.str().size(), gathered.size());
+}
+#endif
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
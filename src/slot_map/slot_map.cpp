@@ -0,0 +1,202 @@
+module;
+
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint32_t, std::uint64_t
+#include <memory>    // std::allocator, std::allocator_traits
+#include <stdexcept> // std::out_of_range
+#include <utility>   // std::move, std::forward
+
+export module slot_map;
+
+import vector;
+
+export namespace isl {
+/// Stable reference into a slot_map. Packs into 64 bits: the slot index in
+/// the low half, the slot's generation in the high half.
+struct slot_map_handle {
+  std::uint32_t index;
+  std::uint32_t generation;
+
+  constexpr std::uint64_t to_integer() const noexcept {
+    return std::uint64_t{this->generation} << 32 | this->index;
+  }
+  static constexpr slot_map_handle from_integer(std::uint64_t bits) noexcept {
+    return {static_cast<std::uint32_t>(bits),
+            static_cast<std::uint32_t>(bits >> 32)};
+  }
+
+  friend constexpr bool operator==(slot_map_handle,
+                                   slot_map_handle) noexcept = default;
+};
+
+/// Unordered container with O(1) insert, erase and lookup through
+/// generational handles.
+///
+/// Values are kept densely packed in an isl::vector, so iteration is a
+/// linear scan; erase moves the last value into the hole. Handles go
+/// through an indirection table of slots. A slot's generation is odd while
+/// it is occupied and is bumped on every insert and erase, so a handle to an
+/// erased value never matches again, even after its slot is reused.
+template <class T, class Allocator = std::allocator<T>> class slot_map {
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using handle = slot_map_handle;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+  using iterator = typename isl::vector<T, Allocator>::iterator;
+  using const_iterator = typename isl::vector<T, Allocator>::const_iterator;
+
+private:
+  struct slot {
+    // position in `values` while occupied, next free slot otherwise
+    std::uint32_t index;
+    std::uint32_t generation;
+  };
+
+  template <class U>
+  using rebind = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<U>;
+
+  static constexpr std::uint32_t end_of_free_list = ~std::uint32_t{0};
+
+  isl::vector<T, Allocator> values;
+  isl::vector<std::uint32_t, rebind<std::uint32_t>> value_slots;
+  isl::vector<slot, rebind<slot>> slots;
+  std::uint32_t free_head{end_of_free_list};
+
+  std::uint32_t acquire_slot() {
+    if (this->free_head != end_of_free_list) {
+      std::uint32_t index = this->free_head;
+      this->free_head = this->slots[index].index;
+      return index;
+    }
+    this->slots.push_back(slot{0, 0});
+    return static_cast<std::uint32_t>(this->slots.size() - 1);
+  }
+  void release_slot(std::uint32_t index) noexcept {
+    slot &released = this->slots[index];
+    released.generation += 1;
+    released.index = this->free_head;
+    this->free_head = index;
+  }
+
+public:
+  slot_map() = default;
+  explicit slot_map(const Allocator &alloc)
+      : values(alloc), value_slots(alloc), slots(alloc) {}
+
+  // capacity
+
+  [[nodiscard]] bool empty() const noexcept { return this->values.empty(); }
+  size_type size() const noexcept { return this->values.size(); }
+  void reserve(size_type new_cap) {
+    this->values.reserve(new_cap);
+    this->value_slots.reserve(new_cap);
+    this->slots.reserve(new_cap);
+  }
+
+  // iterators, in dense (not insertion) order
+
+  iterator begin() noexcept { return this->values.begin(); }
+  const_iterator begin() const noexcept { return this->values.begin(); }
+  iterator end() noexcept { return this->values.end(); }
+  const_iterator end() const noexcept { return this->values.end(); }
+
+  T *data() noexcept { return this->values.data(); }
+  const T *data() const noexcept { return this->values.data(); }
+
+  /// Handle of the value at dense position `pos`.
+  handle handle_at(size_type pos) const noexcept {
+    std::uint32_t index = this->value_slots[pos];
+    return {index, this->slots[index].generation};
+  }
+
+  // lookup
+
+  bool contains(handle h) const noexcept {
+    return h.index < this->slots.size() &&
+           this->slots[h.index].generation == h.generation;
+  }
+  T *find(handle h) noexcept {
+    return this->contains(h) ? &this->values[this->slots[h.index].index]
+                             : nullptr;
+  }
+  const T *find(handle h) const noexcept {
+    return this->contains(h) ? &this->values[this->slots[h.index].index]
+                             : nullptr;
+  }
+  reference at(handle h) {
+    if (!this->contains(h)) {
+      throw std::out_of_range{"STALE HANDLE!"};
+    }
+    return this->values[this->slots[h.index].index];
+  }
+  /// Unchecked, `h` must be contained.
+  reference operator[](handle h) {
+    return this->values[this->slots[h.index].index];
+  }
+  const_reference operator[](handle h) const {
+    return this->values[this->slots[h.index].index];
+  }
+
+  // modifiers
+
+  template <class... Args> handle emplace(Args &&...args) {
+    std::uint32_t index = this->acquire_slot();
+    try {
+      this->value_slots.push_back(index);
+      this->values.emplace_back(std::forward<Args>(args)...);
+    } catch (...) {
+      // erase relies on one value slot per value
+      if (this->value_slots.size() != this->values.size()) {
+        this->value_slots.pop_back();
+      }
+      // the slot was never handed out, so its generation stays
+      this->slots[index].index = this->free_head;
+      this->free_head = index;
+      throw;
+    }
+
+    slot &acquired = this->slots[index];
+    acquired.generation += 1;
+    acquired.index = static_cast<std::uint32_t>(this->values.size() - 1);
+    return {index, acquired.generation};
+  }
+  handle insert(const T &value) { return this->emplace(value); }
+  handle insert(T &&value) { return this->emplace(std::move(value)); }
+
+  /// Swap-removes the value, returns false if `h` is stale.
+  bool erase(handle h) {
+    if (!this->contains(h)) {
+      return false;
+    }
+    std::uint32_t position = this->slots[h.index].index;
+    std::uint32_t last = static_cast<std::uint32_t>(this->values.size() - 1);
+
+    if (position != last) {
+      this->values[position] = std::move(this->values[last]);
+      this->value_slots[position] = this->value_slots[last];
+      this->slots[this->value_slots[position]].index = position;
+    }
+    this->values.pop_back();
+    this->value_slots.pop_back();
+
+    this->release_slot(h.index);
+    return true;
+  }
+
+  void clear() noexcept {
+    for (std::uint32_t index : this->value_slots) {
+      this->release_slot(index);
+    }
+    this->values.clear();
+    this->value_slots.clear();
+  }
+};
+} // namespace isl
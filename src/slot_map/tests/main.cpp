@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <memory>    // std::unique_ptr
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::string
+
+import slot_map;
+
+TEST(slot_map, TestInsertFind) {
+  isl::slot_map<std::string> map;
+
+  auto a = map.insert("a");
+  auto b = map.insert("b");
+
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_TRUE(map.contains(a));
+  ASSERT_EQ(map[a], "a");
+  ASSERT_EQ(*map.find(b), "b");
+}
+
+TEST(slot_map, TestEraseInvalidatesHandle) {
+  isl::slot_map<int> map;
+
+  auto a = map.insert(1);
+  auto b = map.insert(2);
+  auto c = map.insert(3);
+
+  ASSERT_TRUE(map.erase(a));
+  ASSERT_FALSE(map.erase(a));
+  ASSERT_FALSE(map.contains(a));
+  ASSERT_EQ(map.find(a), nullptr);
+
+  // the last value was moved into the hole, its handle still works
+  ASSERT_EQ(map[c], 3);
+  ASSERT_EQ(map[b], 2);
+  ASSERT_EQ(*map.begin(), 3);
+
+  // the slot is reused with a new generation
+  auto d = map.insert(4);
+  ASSERT_EQ(d.index, a.index);
+  ASSERT_NE(d.generation, a.generation);
+  ASSERT_FALSE(map.contains(a));
+  ASSERT_EQ(map[d], 4);
+}
+
+TEST(slot_map, TestInsertOwnElement) {
+  isl::slot_map<std::string> map;
+  auto first = map.insert(std::string(64, 'x'));
+
+  // the argument refers into the dense array while it reallocates
+  for (int i = 0; i < 20; ++i) {
+    auto h = map.insert(map[first]);
+    ASSERT_EQ(map[h], std::string(64, 'x'));
+  }
+  ASSERT_EQ(map.size(), 21);
+}
+
+namespace {
+struct may_throw {
+  int value;
+
+  explicit may_throw(int value) : value(value) {
+    if (value < 0) {
+      throw std::runtime_error("negative");
+    }
+  }
+};
+} // namespace
+
+TEST(slot_map, TestEmplaceThrows) {
+  isl::slot_map<may_throw> map;
+  auto a = map.emplace(1);
+  auto b = map.emplace(2);
+  auto c = map.emplace(3);
+  map.erase(a);
+
+  // neither the free slot nor a fresh one is lost
+  ASSERT_THROW(map.emplace(-1), std::runtime_error);
+  ASSERT_THROW(map.emplace(-1), std::runtime_error);
+  ASSERT_EQ(map.size(), 2);
+
+  auto d = map.emplace(4);
+  ASSERT_EQ(d.index, a.index);
+  ASSERT_EQ(map[d].value, 4);
+
+  // the dense arrays still agree
+  ASSERT_TRUE(map.erase(b));
+  ASSERT_EQ(map[c].value, 3);
+  ASSERT_EQ(map[d].value, 4);
+  ASSERT_EQ(map.handle_at(0), c);
+  ASSERT_EQ(map.handle_at(1), d);
+}
+
+TEST(slot_map, TestHandleRoundTrip) {
+  isl::slot_map<int> map;
+  auto h = map.insert(7);
+
+  auto bits = h.to_integer();
+  ASSERT_EQ(isl::slot_map_handle::from_integer(bits), h);
+}
+
+TEST(slot_map, TestMoveOnlyAndClear) {
+  isl::slot_map<std::unique_ptr<int>> map;
+
+  auto a = map.emplace(new int(1));
+  auto b = map.emplace(new int(2));
+  map.erase(a);
+  ASSERT_EQ(*map[b], 2);
+  ASSERT_EQ(map.handle_at(0), b);
+
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_FALSE(map.contains(b));
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include <array>   // std::array
+#include <cstdint> // std::uint64_t
+#include <thread>  // std::thread
+
+#include <pthread.h> // pthread_setaffinity_np
+
+import spsc_queue;
+
+namespace {
+// Producer runs on the benchmark thread, consumer on a second thread. Both
+// are pinned so the numbers measure the cross-core handoff and not the
+// scheduler.
+constexpr int producer_cpu = 0;
+constexpr int consumer_cpu = 2;
+
+void pin_to_cpu(int cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+constexpr std::uint64_t stop = ~std::uint64_t{0};
+} // namespace
+
+static void BM_SpscThroughput(benchmark::State &state) {
+  pin_to_cpu(producer_cpu);
+  isl::spsc_queue<std::uint64_t> queue(state.range(0));
+
+  std::thread consumer([&queue] {
+    pin_to_cpu(consumer_cpu);
+    std::uint64_t value = 0;
+    while (value != stop) {
+      while (!queue.try_pop(value)) {
+      }
+      benchmark::DoNotOptimize(value);
+    }
+  });
+
+  std::uint64_t next = 0;
+  for (auto _ : state) {
+    while (!queue.try_push(next)) {
+    }
+    ++next;
+  }
+  while (!queue.try_push(stop)) {
+  }
+  consumer.join();
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpscThroughput)->Arg(1 << 10)->Arg(1 << 16)->UseRealTime();
+
+static void BM_SpscBatchThroughput(benchmark::State &state) {
+  constexpr std::size_t batch = 64;
+
+  pin_to_cpu(producer_cpu);
+  isl::spsc_queue<std::uint64_t> queue(state.range(0));
+
+  std::thread consumer([&queue] {
+    pin_to_cpu(consumer_cpu);
+    std::array<std::uint64_t, batch> values{};
+    for (bool running = true; running;) {
+      std::size_t count = queue.try_pop_n(values.begin(), batch);
+      for (std::size_t i = 0; i != count; ++i) {
+        running &= values[i] != stop;
+      }
+      benchmark::DoNotOptimize(values);
+    }
+  });
+
+  std::array<std::uint64_t, batch> values{};
+  for (auto _ : state) {
+    for (std::size_t pushed = 0; pushed != batch;) {
+      pushed += queue.try_push_n(values.begin() + pushed, batch - pushed);
+    }
+  }
+  while (!queue.try_push(stop)) {
+  }
+  consumer.join();
+
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_SpscBatchThroughput)->Arg(1 << 10)->Arg(1 << 16)->UseRealTime();
+
+// One iteration is a full round trip: ping on one queue, pong on the other.
+static void BM_SpscRoundTripLatency(benchmark::State &state) {
+  pin_to_cpu(producer_cpu);
+  isl::spsc_queue<std::uint64_t> ping(64);
+  isl::spsc_queue<std::uint64_t> pong(64);
+
+  std::thread echo([&ping, &pong] {
+    pin_to_cpu(consumer_cpu);
+    std::uint64_t value = 0;
+    while (value != stop) {
+      while (!ping.try_pop(value)) {
+      }
+      while (!pong.try_push(value)) {
+      }
+    }
+  });
+
+  std::uint64_t value = 0;
+  for (auto _ : state) {
+    while (!ping.try_push(value)) {
+    }
+    while (!pong.try_pop(value)) {
+    }
+  }
+  while (!ping.try_push(stop)) {
+  }
+  echo.join();
+}
+BENCHMARK(BM_SpscRoundTripLatency)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,179 @@
+module;
+
+#include <algorithm> // std::min
+#include <atomic>    // std::atomic
+#include <bit>       // std::bit_ceil
+#include <cstddef>   // std::size_t
+#include <memory>    // std::allocator, std::allocator_traits
+#include <utility>   // std::move, std::forward
+
+#include "../internal/concurrency/cache_line.hpp"
+
+export module spsc_queue;
+
+export namespace isl {
+/// Bounded wait-free queue for exactly one producer and one consumer thread.
+///
+/// The producer owns `tail_`, the consumer owns `head_`; each index sits on its
+/// own cache line together with a private copy of the other side's index.
+/// The shared index is only re-read when the cached copy says the queue is
+/// full (producer) or empty (consumer), so in the steady state each side
+/// touches one foreign cache line per batch rather than per element.
+template <class T, class Allocator = std::allocator<T>> class spsc_queue {
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+private:
+  using traits = std::allocator_traits<Allocator>;
+  static constexpr std::size_t cache_line =
+      isl::internal::concurrency::cache_line_size;
+
+  // written by the producer
+  alignas(cache_line) std::atomic<std::size_t> tail_{0};
+  std::size_t cached_head{0};
+
+  // written by the consumer
+  alignas(cache_line) std::atomic<std::size_t> head_{0};
+  std::size_t cached_tail{0};
+
+  // read-only after construction
+  alignas(cache_line) T *slots;
+  std::size_t mask;
+  [[no_unique_address]] Allocator allocator;
+
+  T *slot(std::size_t index) noexcept { return this->slots + (index & mask); }
+
+  // Free slots as seen by the producer, refreshing the cached head only when
+  // fewer than `wanted` are known to be free.
+  std::size_t writable(std::size_t tail, std::size_t wanted) noexcept {
+    std::size_t free = this->capacity() - (tail - this->cached_head);
+    if (free < wanted) {
+      this->cached_head = this->head_.load(std::memory_order_acquire);
+      free = this->capacity() - (tail - this->cached_head);
+    }
+    return free;
+  }
+  // Occupied slots as seen by the consumer.
+  std::size_t readable(std::size_t head, std::size_t wanted) noexcept {
+    std::size_t used = this->cached_tail - head;
+    if (used < wanted) {
+      this->cached_tail = this->tail_.load(std::memory_order_acquire);
+      used = this->cached_tail - head;
+    }
+    return used;
+  }
+
+public:
+  /// `capacity` is rounded up to the next power of two.
+  explicit spsc_queue(size_type capacity, const Allocator &alloc = Allocator())
+      : allocator(alloc) {
+    std::size_t size = std::bit_ceil(capacity < 2 ? 2 : capacity);
+    this->slots = traits::allocate(this->allocator, size);
+    this->mask = size - 1;
+  }
+  spsc_queue(const spsc_queue &) = delete;
+  spsc_queue &operator=(const spsc_queue &) = delete;
+  ~spsc_queue() {
+    std::size_t last = this->tail_.load(std::memory_order_relaxed);
+    for (std::size_t i = this->head_.load(std::memory_order_relaxed); i != last;
+         ++i) {
+      std::destroy_at(this->slot(i));
+    }
+    traits::deallocate(this->allocator, this->slots, this->capacity());
+  }
+
+  size_type capacity() const noexcept { return this->mask + 1; }
+  /// Exact when called from the producer or the consumer, a snapshot
+  /// otherwise.
+  size_type size() const noexcept {
+    return this->tail_.load(std::memory_order_acquire) -
+           this->head_.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] bool empty() const noexcept { return this->size() == 0; }
+
+  // producer
+
+  template <class... Args> bool try_emplace(Args &&...args) {
+    std::size_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (this->writable(tail, 1) == 0) {
+      return false;
+    }
+    std::construct_at(this->slot(tail), std::forward<Args>(args)...);
+    this->tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+  bool try_push(const T &value) { return this->try_emplace(value); }
+  bool try_push(T &&value) { return this->try_emplace(std::move(value)); }
+
+  /// Pushes up to `count` elements from `first` and publishes them with a
+  /// single release store. Returns how many were pushed.
+  template <class InputIt>
+  size_type try_push_n(InputIt first, size_type count) {
+    std::size_t tail = this->tail_.load(std::memory_order_relaxed);
+    count = std::min(count, this->writable(tail, count));
+    std::size_t i = 0;
+    try {
+      for (; i != count; ++i, ++first) {
+        std::construct_at(this->slot(tail + i), *first);
+      }
+    } catch (...) {
+      // the elements built so far are live, publish them
+      this->tail_.store(tail + i, std::memory_order_release);
+      throw;
+    }
+    this->tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  // consumer
+
+  bool try_pop(T &value) {
+    std::size_t head = this->head_.load(std::memory_order_relaxed);
+    if (this->readable(head, 1) == 0) {
+      return false;
+    }
+    T *element = this->slot(head);
+    value = std::move(*element);
+    std::destroy_at(element);
+    this->head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Pops up to `count` elements into `out` and releases their slots with a
+  /// single store. Returns how many were popped.
+  template <class OutputIt>
+  size_type try_pop_n(OutputIt out, size_type count) {
+    std::size_t head = this->head_.load(std::memory_order_relaxed);
+    count = std::min(count, this->readable(head, count));
+    std::size_t i = 0;
+    try {
+      for (; i != count; ++i, ++out) {
+        T *element = this->slot(head + i);
+        *out = std::move(*element);
+        std::destroy_at(element);
+      }
+    } catch (...) {
+      // the elements destroyed so far are gone, release their slots
+      this->head_.store(head + i, std::memory_order_release);
+      throw;
+    }
+    this->head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  /// Oldest element, or nullptr if the queue is empty. Only the consumer may
+  /// call this.
+  T *front() noexcept {
+    std::size_t head = this->head_.load(std::memory_order_relaxed);
+    return this->readable(head, 1) == 0 ? nullptr : this->slot(head);
+  }
+  /// Drops the element returned by front().
+  void pop() noexcept {
+    std::size_t head = this->head_.load(std::memory_order_relaxed);
+    std::destroy_at(this->slot(head));
+    this->head_.store(head + 1, std::memory_order_release);
+  }
+};
+} // namespace isl
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <array>     // std::array
+#include <memory>    // std::unique_ptr, std::make_unique
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::string
+#include <thread>    // std::thread, std::this_thread::yield
+
+import spsc_queue;
+
+TEST(spsc_queue, TestTryPushTryPop) {
+  isl::spsc_queue<int> queue(3);
+
+  ASSERT_EQ(queue.capacity(), 4);
+  ASSERT_TRUE(queue.empty());
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_push(i));
+  }
+  ASSERT_EQ(queue.size(), 4);
+  ASSERT_FALSE(queue.try_push(4));
+
+  int value = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_FALSE(queue.try_pop(value));
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(queue.front(), nullptr);
+}
+
+TEST(spsc_queue, TestWraparound) {
+  isl::spsc_queue<int> queue(4);
+
+  // the indices run far past the capacity; slots are reused through the mask
+  int next_push = 0;
+  int next_pop = 0;
+  for (int round = 0; round < 100; ++round) {
+    ASSERT_TRUE(queue.try_push(next_push++));
+    ASSERT_TRUE(queue.try_push(next_push++));
+    ASSERT_TRUE(queue.try_push(next_push++));
+    for (int i = 0; i < 3; ++i) {
+      int *front = queue.front();
+      ASSERT_NE(front, nullptr);
+      ASSERT_EQ(*front, next_pop++);
+      queue.pop();
+    }
+  }
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(spsc_queue, TestBatches) {
+  isl::spsc_queue<int> queue(8);
+  std::array<int, 12> input{};
+  for (int i = 0; i < 12; ++i) {
+    input[i] = i;
+  }
+
+  // stops at the capacity
+  ASSERT_EQ(queue.try_push_n(input.begin(), 12), 8);
+  std::array<int, 12> output{};
+  ASSERT_EQ(queue.try_pop_n(output.begin(), 5), 5);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(output[i], i);
+  }
+
+  // this batch crosses the end of the slot array
+  ASSERT_EQ(queue.try_push_n(input.begin() + 8, 4), 4);
+  ASSERT_EQ(queue.try_pop_n(output.begin(), 12), 7);
+  for (int i = 0; i < 7; ++i) {
+    ASSERT_EQ(output[i], i + 5);
+  }
+  ASSERT_EQ(queue.try_pop_n(output.begin(), 12), 0);
+}
+
+TEST(spsc_queue, TestMoveOnly) {
+  isl::spsc_queue<std::unique_ptr<int>> queue(4);
+
+  ASSERT_TRUE(queue.try_emplace(new int(42)));
+  ASSERT_TRUE(queue.try_push(std::make_unique<int>(7)));
+  ASSERT_TRUE(queue.try_push(std::make_unique<int>(9)));
+
+  std::unique_ptr<int> value;
+  ASSERT_TRUE(queue.try_pop(value));
+  ASSERT_EQ(*value, 42);
+  ASSERT_TRUE(queue.try_pop(value));
+  ASSERT_EQ(*value, 7);
+  // the destructor frees the element left behind
+}
+
+namespace {
+struct throwing_copy {
+  std::string value;
+
+  explicit throwing_copy(std::string value) : value(std::move(value)) {}
+  throwing_copy(const throwing_copy &other) : value(other.value) {
+    if (value.empty()) {
+      throw std::runtime_error("empty");
+    }
+  }
+  throwing_copy &operator=(throwing_copy &&) = default;
+};
+} // namespace
+
+TEST(spsc_queue, TestBatchThrows) {
+  isl::spsc_queue<throwing_copy> queue(8);
+  std::array<throwing_copy, 4> input{
+      throwing_copy("a long string that lives on the heap"),
+      throwing_copy("another long string that lives on the heap"),
+      throwing_copy(""), throwing_copy("d")};
+
+  // the two elements built before the throw are pushed
+  ASSERT_THROW(queue.try_push_n(input.begin(), 4), std::runtime_error);
+  ASSERT_EQ(queue.size(), 2);
+
+  ASSERT_EQ(queue.try_push_n(input.begin() + 3, 1), 1);
+  std::array<throwing_copy, 3> output{throwing_copy("x"), throwing_copy("x"),
+                                      throwing_copy("x")};
+  ASSERT_EQ(queue.try_pop_n(output.begin(), 3), 3);
+  ASSERT_EQ(output[0].value, input[0].value);
+  ASSERT_EQ(output[1].value, input[1].value);
+  ASSERT_EQ(output[2].value, "d");
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(spsc_queue, TestProducerConsumer) {
+  constexpr int count = 200000;
+  isl::spsc_queue<int> queue(64);
+
+  std::thread producer([&queue] {
+    for (int i = 0; i < count;) {
+      if (queue.try_push(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int expected = 0;
+  while (expected < count) {
+    int value = -1;
+    if (queue.try_pop(value)) {
+      EXPECT_EQ(value, expected);
+      expected = value + 1;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  ASSERT_TRUE(queue.empty());
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
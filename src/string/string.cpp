@@ -0,0 +1,480 @@
+module;
+
+#include <bit>              // std::endian
+#include <compare>          // std::strong_ordering
+#include <cstddef>          // std::size_t
+#include <functional>       // std::less
+#include <initializer_list> // std::initializer_list
+#include <iterator>         // std::input_iterator, std::reverse_iterator
+#include <limits>           // std::numeric_limits
+#include <memory>           // std::allocator, std::allocator_traits
+#include <stdexcept>        // std::out_of_range, std::length_error
+#include <string>           // std::char_traits
+#include <utility>          // std::move, std::swap
+
+export module string;
+
+import string_view;
+import vector;
+
+export namespace isl {
+/// Contiguous character sequence with a 24-byte footprint (given an empty
+/// allocator) that stores up to 23 chars inline.
+///
+/// Inline ("short") mode keeps `inline_capacity - size()` in the last
+/// character slot, so a full inline string is terminated by that zero.
+/// Heap ("long") mode stores {data, size, capacity} and marks itself by
+/// the top bit of the capacity, which on little-endian targets lands in the
+/// top bit of the very same last byte. Heap growth and relocation follow
+/// isl::vector.
+template <class CharT, class Allocator = std::allocator<CharT>>
+class basic_string {
+  static_assert(std::endian::native == std::endian::little,
+                "basic_string's short/long discriminator assumes little "
+                "endian");
+
+public:
+  using traits_type = std::char_traits<CharT>;
+  using value_type = CharT;
+  using allocator_type = Allocator;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = CharT *;
+  using const_pointer = const CharT *;
+
+  using iterator = CharT *;
+  using const_iterator = const CharT *;
+
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  struct long_representation {
+    CharT *data;
+    std::size_t size;
+    std::size_t capacity; // excludes the terminator, top bit is long_flag
+  };
+  struct short_representation {
+    CharT data[sizeof(long_representation) / sizeof(CharT)];
+  };
+
+  static constexpr std::size_t long_flag = std::size_t{1}
+                                           << (sizeof(std::size_t) * 8 - 1);
+
+public:
+  static constexpr size_type inline_capacity =
+      sizeof(short_representation) / sizeof(CharT) - 1;
+
+private:
+  [[no_unique_address]] Allocator allocator;
+
+  union {
+    long_representation long_;
+    short_representation short_;
+  };
+
+  bool is_long() const noexcept {
+    auto bytes = reinterpret_cast<const unsigned char *>(&this->short_);
+    return (bytes[sizeof(short_representation) - 1] & 0x80) != 0;
+  }
+
+  void set_short_size(std::size_t size) noexcept {
+    this->short_.data[size] = CharT();
+    this->short_.data[inline_capacity] =
+        static_cast<CharT>(inline_capacity - size);
+  }
+  void set_size(std::size_t size) noexcept {
+    if (this->is_long()) {
+      this->long_.size = size;
+      this->long_.data[size] = CharT();
+    } else {
+      this->set_short_size(size);
+    }
+  }
+
+  void deallocate() noexcept {
+    if (this->is_long()) {
+      alloc_traits::deallocate(this->allocator, this->long_.data,
+                               this->capacity() + 1);
+    }
+  }
+
+  // Moves the characters and the terminator into a heap buffer of exactly
+  // `new_capacity` characters.
+  void reallocate(std::size_t new_capacity) {
+    if (new_capacity > this->max_size()) {
+      throw std::length_error{"STRING TOO LONG!"};
+    }
+    std::size_t size = this->size();
+    CharT *new_data = alloc_traits::allocate(this->allocator, new_capacity + 1);
+    detail::relocate(this->data(), size + 1, new_data);
+
+    this->deallocate();
+    this->long_ = {new_data, size, new_capacity | long_flag};
+  }
+  void grow_for(std::size_t new_size) {
+    if (new_size > this->capacity()) {
+      this->reallocate(detail::grow_capacity(new_size, this->capacity()));
+    }
+  }
+
+  void initialize(const CharT *s, std::size_t count) {
+    if (count <= inline_capacity) {
+      traits_type::copy(this->short_.data, s, count);
+      this->set_short_size(count);
+      return;
+    }
+    CharT *data = alloc_traits::allocate(this->allocator, count + 1);
+    traits_type::copy(data, s, count);
+    data[count] = CharT();
+    this->long_ = {data, count, count | long_flag};
+  }
+
+public:
+  // constructors
+
+  basic_string() noexcept(noexcept(Allocator())) : basic_string(Allocator()) {}
+  explicit basic_string(const Allocator &alloc) noexcept : allocator(alloc) {
+    this->set_short_size(0);
+  }
+  basic_string(const CharT *s, size_type count,
+               const Allocator &alloc = Allocator())
+      : allocator(alloc) {
+    this->initialize(s, count);
+  }
+  basic_string(const CharT *s, const Allocator &alloc = Allocator())
+      : basic_string(s, traits_type::length(s), alloc) {}
+  explicit basic_string(basic_string_view<CharT> sv,
+                        const Allocator &alloc = Allocator())
+      : basic_string(sv.data(), sv.size(), alloc) {}
+  basic_string(size_type count, CharT ch, const Allocator &alloc = Allocator())
+      : basic_string(alloc) {
+    this->append(count, ch);
+  }
+  template <std::input_iterator InputIt>
+  basic_string(InputIt first, InputIt last,
+               const Allocator &alloc = Allocator())
+      : basic_string(alloc) {
+    for (; first != last; ++first) {
+      this->push_back(*first);
+    }
+  }
+  basic_string(std::initializer_list<CharT> ilist,
+               const Allocator &alloc = Allocator())
+      : basic_string(ilist.begin(), ilist.size(), alloc) {}
+  basic_string(const basic_string &other)
+      : allocator(alloc_traits::select_on_container_copy_construction(
+            other.allocator)) {
+    this->initialize(other.data(), other.size());
+  }
+  basic_string(const basic_string &other, const Allocator &alloc)
+      : allocator(alloc) {
+    this->initialize(other.data(), other.size());
+  }
+  basic_string(basic_string &&other) noexcept
+      : allocator(std::move(other.allocator)) {
+    this->long_ = other.long_;
+    other.set_short_size(0);
+  }
+  basic_string(std::nullptr_t) = delete;
+
+  ~basic_string() { this->deallocate(); }
+
+  basic_string &operator=(const basic_string &other) {
+    if (this != &other) {
+      this->assign(other.data(), other.size());
+    }
+    return *this;
+  }
+  basic_string &operator=(basic_string &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
+    constexpr bool propagate =
+        alloc_traits::propagate_on_container_move_assignment::value;
+    if constexpr (!propagate && !alloc_traits::is_always_equal::value) {
+      // the buffer of `other` can only be freed by an equal allocator
+      if (this->allocator != other.allocator) {
+        this->assign(other.data(), other.size());
+        other.clear();
+        return *this;
+      }
+    }
+    this->deallocate();
+    if constexpr (propagate) {
+      this->allocator = std::move(other.allocator);
+    }
+    this->long_ = other.long_;
+    other.set_short_size(0);
+    return *this;
+  }
+  basic_string &operator=(const CharT *s) { return this->assign(s); }
+  basic_string &operator=(CharT ch) { return this->assign(1, ch); }
+
+  basic_string &assign(const CharT *s, size_type count) {
+    if (count <= this->capacity()) {
+      // `s` may be a substring of *this
+      traits_type::move(this->data(), s, count);
+      this->set_size(count);
+      return *this;
+    }
+    this->clear();
+    return this->append(s, count);
+  }
+  basic_string &assign(const CharT *s) {
+    return this->assign(s, traits_type::length(s));
+  }
+  basic_string &assign(size_type count, CharT ch) {
+    this->clear();
+    return this->append(count, ch);
+  }
+
+  allocator_type get_allocator() const noexcept { return this->allocator; }
+
+  // element access
+
+  reference at(size_type pos) {
+    if (!(pos < this->size())) {
+      throw std::out_of_range{"OUT OF BOUNDS!"};
+    }
+    return this->data()[pos];
+  }
+  const_reference at(size_type pos) const {
+    if (!(pos < this->size())) {
+      throw std::out_of_range{"OUT OF BOUNDS!"};
+    }
+    return this->data()[pos];
+  }
+  reference operator[](size_type pos) { return this->data()[pos]; }
+  const_reference operator[](size_type pos) const { return this->data()[pos]; }
+  reference front() { return this->data()[0]; }
+  const_reference front() const { return this->data()[0]; }
+  reference back() { return this->data()[this->size() - 1]; }
+  const_reference back() const { return this->data()[this->size() - 1]; }
+
+  CharT *data() noexcept {
+    return this->is_long() ? this->long_.data : this->short_.data;
+  }
+  const CharT *data() const noexcept {
+    return this->is_long() ? this->long_.data : this->short_.data;
+  }
+  const CharT *c_str() const noexcept { return this->data(); }
+
+  operator basic_string_view<CharT>() const noexcept {
+    return {this->data(), this->size()};
+  }
+
+  // iterators
+
+  iterator begin() noexcept { return this->data(); }
+  const_iterator begin() const noexcept { return this->data(); }
+  const_iterator cbegin() const noexcept { return this->data(); }
+  iterator end() noexcept { return this->data() + this->size(); }
+  const_iterator end() const noexcept { return this->data() + this->size(); }
+  const_iterator cend() const noexcept { return this->end(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(this->end()); }
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(this->end());
+  }
+  reverse_iterator rend() noexcept { return reverse_iterator(this->begin()); }
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(this->begin());
+  }
+
+  // capacity
+
+  [[nodiscard]] bool empty() const noexcept { return this->size() == 0; }
+  size_type size() const noexcept {
+    return this->is_long()
+               ? this->long_.size
+               : inline_capacity -
+                     static_cast<std::size_t>(
+                         this->short_.data[inline_capacity]);
+  }
+  size_type length() const noexcept { return this->size(); }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<difference_type>::max() / sizeof(CharT) - 1;
+  }
+  size_type capacity() const noexcept {
+    return this->is_long() ? this->long_.capacity & ~long_flag
+                           : inline_capacity;
+  }
+  void reserve(size_type new_cap) {
+    if (new_cap > this->capacity()) {
+      this->reallocate(new_cap);
+    }
+  }
+  void shrink_to_fit() {
+    if (!this->is_long()) {
+      return;
+    }
+    std::size_t size = this->size();
+    if (size <= inline_capacity) {
+      long_representation heap = this->long_;
+      traits_type::copy(this->short_.data, heap.data, size);
+      this->set_short_size(size);
+      alloc_traits::deallocate(this->allocator, heap.data,
+                               (heap.capacity & ~long_flag) + 1);
+    } else if (size < this->capacity()) {
+      this->reallocate(size);
+    }
+  }
+
+  // modifiers
+
+  void clear() noexcept { this->set_size(0); }
+
+  void push_back(CharT ch) {
+    std::size_t size = this->size();
+    this->grow_for(size + 1);
+    this->data()[size] = ch;
+    this->set_size(size + 1);
+  }
+  void pop_back() { this->set_size(this->size() - 1); }
+
+  basic_string &append(const CharT *s, size_type count) {
+    std::size_t size = this->size();
+    if (count > this->capacity() - size) {
+      // `s` may point into our own buffer, which is about to move.
+      const CharT *base = this->data();
+      bool aliases = !std::less<const CharT *>()(s, base) &&
+                     std::less<const CharT *>()(s, base + size + 1);
+      std::size_t offset = s - base;
+
+      this->grow_for(size + count);
+      if (aliases) {
+        s = this->data() + offset;
+      }
+    }
+    traits_type::move(this->data() + size, s, count);
+    this->set_size(size + count);
+    return *this;
+  }
+  basic_string &append(const CharT *s) {
+    return this->append(s, traits_type::length(s));
+  }
+  basic_string &append(const basic_string &str) {
+    return this->append(str.data(), str.size());
+  }
+  basic_string &append(size_type count, CharT ch) {
+    std::size_t size = this->size();
+    this->grow_for(size + count);
+    traits_type::assign(this->data() + size, count, ch);
+    this->set_size(size + count);
+    return *this;
+  }
+
+  basic_string &operator+=(const basic_string &str) {
+    return this->append(str);
+  }
+  basic_string &operator+=(CharT ch) {
+    this->push_back(ch);
+    return *this;
+  }
+  basic_string &operator+=(const CharT *s) { return this->append(s); }
+
+  void resize(size_type count, CharT ch) {
+    std::size_t size = this->size();
+    if (count > size) {
+      this->append(count - size, ch);
+    } else {
+      this->set_size(count);
+    }
+  }
+  void resize(size_type count) { this->resize(count, CharT()); }
+
+  /// Grows the string to `count` characters without initializing them and
+  /// lets `op(data(), count)` fill them in; op returns the final size,
+  /// which must not exceed `count`.
+  template <class Operation>
+  void resize_and_overwrite(size_type count, Operation op) {
+    this->grow_for(count);
+    auto result = std::move(op)(this->data(), count);
+    this->set_size(static_cast<size_type>(result));
+  }
+
+  void swap(basic_string &other) noexcept(
+      alloc_traits::propagate_on_container_swap::value ||
+      alloc_traits::is_always_equal::value) {
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(this->allocator, other.allocator);
+    } else if constexpr (!alloc_traits::is_always_equal::value) {
+      // each buffer stays with the allocator that owns it
+      if (this->allocator != other.allocator) {
+        basic_string copy(other.data(), other.size(), this->allocator);
+        other.assign(this->data(), this->size());
+        std::swap(this->long_, copy.long_);
+        return;
+      }
+    }
+    std::swap(this->long_, other.long_);
+  }
+
+  int compare(const basic_string &other) const noexcept {
+    return compare(this->data(), this->size(), other.data(), other.size());
+  }
+
+  static int compare(const CharT *lhs, std::size_t lhs_size, const CharT *rhs,
+                     std::size_t rhs_size) noexcept {
+    std::size_t common = lhs_size < rhs_size ? lhs_size : rhs_size;
+    if (int result = traits_type::compare(lhs, rhs, common); result != 0) {
+      return result;
+    }
+    return lhs_size < rhs_size ? -1 : (lhs_size > rhs_size ? 1 : 0);
+  }
+};
+
+using string = basic_string<char>;
+using u8string = basic_string<char8_t>;
+using u16string = basic_string<char16_t>;
+using u32string = basic_string<char32_t>;
+using wstring = basic_string<wchar_t>;
+
+template <class CharT, class Allocator>
+bool operator==(const basic_string<CharT, Allocator> &lhs,
+                const basic_string<CharT, Allocator> &rhs) noexcept {
+  return lhs.size() == rhs.size() &&
+         std::char_traits<CharT>::compare(lhs.data(), rhs.data(),
+                                          lhs.size()) == 0;
+}
+template <class CharT, class Allocator>
+bool operator==(const basic_string<CharT, Allocator> &lhs,
+                const CharT *rhs) noexcept {
+  std::size_t size = std::char_traits<CharT>::length(rhs);
+  return lhs.size() == size &&
+         std::char_traits<CharT>::compare(lhs.data(), rhs, size) == 0;
+}
+template <class CharT, class Allocator>
+std::strong_ordering
+operator<=>(const basic_string<CharT, Allocator> &lhs,
+            const basic_string<CharT, Allocator> &rhs) noexcept {
+  return lhs.compare(rhs) <=> 0;
+}
+
+template <class CharT, class Allocator>
+basic_string<CharT, Allocator>
+operator+(const basic_string<CharT, Allocator> &lhs,
+          const basic_string<CharT, Allocator> &rhs) {
+  basic_string<CharT, Allocator> result(lhs.get_allocator());
+  result.reserve(lhs.size() + rhs.size());
+  result.append(lhs);
+  result.append(rhs);
+  return result;
+}
+
+template <class CharT, class Allocator>
+void swap(basic_string<CharT, Allocator> &lhs,
+          basic_string<CharT, Allocator> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+} // namespace isl
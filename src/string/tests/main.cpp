@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <cstring> // std::memset
+#include <map>     // std::map
+#include <memory>  // std::allocator
+
+import string;
+
+namespace {
+// Remembers which allocator handed out each block; neither propagates.
+template <class T> struct tagged_allocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  static inline std::map<void *, int> owners;
+  int tag;
+
+  explicit tagged_allocator(int tag) : tag(tag) {}
+  template <class U>
+  tagged_allocator(const tagged_allocator<U> &other) : tag(other.tag) {}
+
+  T *allocate(std::size_t n) {
+    T *p = std::allocator<T>().allocate(n);
+    owners[p] = this->tag;
+    return p;
+  }
+  void deallocate(T *p, std::size_t n) {
+    EXPECT_EQ(owners[p], this->tag);
+    owners.erase(p);
+    std::allocator<T>().deallocate(p, n);
+  }
+  bool operator==(const tagged_allocator &other) const {
+    return this->tag == other.tag;
+  }
+};
+} // namespace
+
+TEST(string, TestFootprint) {
+  ASSERT_EQ(sizeof(isl::string), 24);
+  ASSERT_GE(isl::string::inline_capacity, 22);
+}
+
+TEST(string, TestShortString) {
+  isl::string s("hello");
+
+  ASSERT_EQ(s.size(), 5);
+  ASSERT_EQ(s.capacity(), isl::string::inline_capacity);
+  ASSERT_EQ(s, "hello");
+  ASSERT_EQ(s.c_str()[5], '\0');
+}
+
+TEST(string, TestFullInlineStringIsTerminated) {
+  isl::string s(isl::string::inline_capacity, 'x');
+
+  ASSERT_EQ(s.size(), isl::string::inline_capacity);
+  ASSERT_EQ(s.capacity(), isl::string::inline_capacity);
+  ASSERT_EQ(s.c_str()[s.size()], '\0');
+}
+
+TEST(string, TestCountAndCharacter) {
+  isl::string s(5, 65);
+  ASSERT_EQ(s, "AAAAA");
+
+  const char text[] = "iterators";
+  isl::string t(text, text + 4);
+  ASSERT_EQ(t, "iter");
+}
+
+TEST(string, TestGrowthToHeap) {
+  isl::string s;
+  for (int i = 0; i < 100; ++i) {
+    s.push_back(static_cast<char>('a' + i % 26));
+  }
+
+  ASSERT_EQ(s.size(), 100);
+  ASSERT_GE(s.capacity(), 100);
+  ASSERT_EQ(s[26], 'a');
+  ASSERT_EQ(s.back(), 'v');
+
+  s.resize(3);
+  s.shrink_to_fit();
+  ASSERT_EQ(s, "abc");
+  ASSERT_EQ(s.capacity(), isl::string::inline_capacity);
+}
+
+TEST(string, TestSelfAppend) {
+  isl::string s("0123456789");
+  s.append(s.data(), s.size());
+  s.append(s.data(), s.size());
+
+  ASSERT_EQ(s, "0123456789012345678901234567890123456789");
+}
+
+TEST(string, TestCopyMoveCompare) {
+  isl::string a("a fairly long string that lives on the heap");
+  isl::string b = a;
+  isl::string c = std::move(b);
+
+  ASSERT_EQ(a, c);
+  ASSERT_TRUE(b.empty());
+  ASSERT_TRUE(isl::string("abc") < isl::string("abd"));
+  ASSERT_TRUE(isl::string("ab") < isl::string("abc"));
+  ASSERT_EQ(isl::string("ab") + isl::string("cd"), "abcd");
+}
+
+TEST(string, TestUnequalAllocators) {
+  using tagged_string = isl::basic_string<char, tagged_allocator<char>>;
+  const char *text = "a fairly long string that lives on the heap";
+  tagged_string a("short", tagged_allocator<char>(1));
+  tagged_string b(text, tagged_allocator<char>(2));
+  tagged_string c("another string too long for the inline buffer",
+                  tagged_allocator<char>(3));
+
+  a = std::move(b);
+  ASSERT_EQ(a, tagged_string(text, tagged_allocator<char>(1)));
+  ASSERT_EQ(a.get_allocator().tag, 1);
+
+  a.swap(c);
+  ASSERT_EQ(c, tagged_string(text, tagged_allocator<char>(3)));
+  ASSERT_EQ(a.get_allocator().tag, 1);
+  ASSERT_EQ(c.get_allocator().tag, 3);
+  ASSERT_EQ(a, tagged_string("another string too long for the inline buffer",
+                             tagged_allocator<char>(1)));
+}
+
+TEST(string, TestResizeAndOverwrite) {
+  isl::string s("prefix:");
+  std::size_t prefix = s.size();
+
+  s.resize_and_overwrite(64, [prefix](char *data, std::size_t) {
+    std::memset(data + prefix, '-', 10);
+    return prefix + 10;
+  });
+
+  ASSERT_EQ(s, "prefix:----------");
+  ASSERT_GE(s.capacity(), 64);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <random>      // std::mt19937
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+import string_view;
+
+namespace {
+// A log-like buffer of `size` bytes: lowercase words, spaces and newlines,
+// ending in the needle.
+std::string make_log(std::size_t size) {
+  std::mt19937 rng(42);
+  std::string log(size, ' ');
+  for (char &c : log) {
+    unsigned r = rng() % 32;
+    c = r < 26 ? static_cast<char>('a' + r) : (r < 31 ? ' ' : '\n');
+  }
+  log.replace(size - 5, 5, "error");
+  return log;
+}
+} // namespace
+
+static void BM_IslFindChar(benchmark::State &state) {
+  std::string log = make_log(state.range(0));
+  isl::string_view sv(log.data(), log.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sv.find('|'));
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_IslFindChar)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_StdFindChar(benchmark::State &state) {
+  std::string log = make_log(state.range(0));
+  std::string_view sv = log;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sv.find('|'));
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_StdFindChar)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_IslFindSubstring(benchmark::State &state) {
+  std::string log = make_log(state.range(0));
+  isl::string_view sv(log.data(), log.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sv.find("error"));
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_IslFindSubstring)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_StdFindSubstring(benchmark::State &state) {
+  std::string log = make_log(state.range(0));
+  std::string_view sv = log;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sv.find("error"));
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_StdFindSubstring)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_IslFindFirstOf(benchmark::State &state) {
+  std::string log = make_log(state.range(0));
+  isl::string_view sv(log.data(), log.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sv.find_first_of("EF[]"));
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_IslFindFirstOf)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+static void BM_StdFindFirstOf(benchmark::State &state) {
+  std::string log = make_log(state.range(0));
+  std::string_view sv = log;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sv.find_first_of("EF[]"));
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+BENCHMARK(BM_StdFindFirstOf)->Arg(64)->Arg(4096)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,410 @@
+module;
+
+#include <compare>     // std::strong_ordering
+#include <cstddef>     // std::size_t
+#include <iterator>    // std::reverse_iterator
+#include <limits>      // std::numeric_limits
+#include <stdexcept>   // std::out_of_range
+#include <string>      // std::char_traits
+#include <type_traits> // std::is_constant_evaluated, std::type_identity_t
+
+#include "../internal/simd/bytes.hpp"
+
+export module string_view;
+
+namespace isl::detail {
+namespace simd = isl::internal::simd;
+
+// Byte-sized characters go through the SIMD kernels at runtime. Wider
+// characters and constant evaluation use the char_traits loops below.
+template <class CharT>
+constexpr bool use_byte_kernels() noexcept {
+  return sizeof(CharT) == 1 && !std::is_constant_evaluated();
+}
+
+template <class CharT> const char *as_bytes(const CharT *s) noexcept {
+  return reinterpret_cast<const char *>(s);
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// Non-owning view of a contiguous character sequence.
+///
+/// Searches and comparisons over byte-sized characters run SSE2 kernels, or
+/// AVX2 ones when the CPU has them. Multi-character needles are located by
+/// first matching the needle's first and last characters across a whole
+/// block and only then comparing the middle of each candidate.
+template <class CharT> class basic_string_view {
+public:
+  using traits_type = std::char_traits<CharT>;
+  using value_type = CharT;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = CharT *;
+  using const_pointer = const CharT *;
+
+  using iterator = const CharT *;
+  using const_iterator = const CharT *;
+
+  using reverse_iterator = std::reverse_iterator<const_iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+  const CharT *data_{nullptr};
+  size_type size_{0};
+
+  constexpr size_type clamp(size_type pos, size_type count) const noexcept {
+    return count < this->size_ - pos ? count : this->size_ - pos;
+  }
+
+public:
+  // constructors
+
+  constexpr basic_string_view() noexcept = default;
+  constexpr basic_string_view(const CharT *s, size_type count) noexcept
+      : data_(s), size_(count) {}
+  constexpr basic_string_view(const CharT *s)
+      : data_(s), size_(traits_type::length(s)) {}
+  basic_string_view(std::nullptr_t) = delete;
+
+  // element access
+
+  constexpr const_reference at(size_type pos) const {
+    if (pos >= this->size_) {
+      throw std::out_of_range{"OUT OF BOUNDS!"};
+    }
+    return this->data_[pos];
+  }
+  constexpr const_reference operator[](size_type pos) const noexcept {
+    return this->data_[pos];
+  }
+  constexpr const_reference front() const noexcept { return this->data_[0]; }
+  constexpr const_reference back() const noexcept {
+    return this->data_[this->size_ - 1];
+  }
+  constexpr const_pointer data() const noexcept { return this->data_; }
+
+  // iterators
+
+  constexpr const_iterator begin() const noexcept { return this->data_; }
+  constexpr const_iterator end() const noexcept {
+    return this->data_ + this->size_;
+  }
+  constexpr const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(this->end());
+  }
+  constexpr const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(this->begin());
+  }
+
+  // capacity
+
+  constexpr size_type size() const noexcept { return this->size_; }
+  constexpr size_type length() const noexcept { return this->size_; }
+  constexpr size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(CharT);
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return this->size_ == 0;
+  }
+
+  // modifiers
+
+  constexpr void remove_prefix(size_type n) noexcept {
+    this->data_ += n;
+    this->size_ -= n;
+  }
+  constexpr void remove_suffix(size_type n) noexcept { this->size_ -= n; }
+  constexpr void swap(basic_string_view &other) noexcept {
+    basic_string_view tmp = *this;
+    *this = other;
+    other = tmp;
+  }
+
+  // operations
+
+  constexpr basic_string_view substr(size_type pos = 0,
+                                     size_type count = npos) const {
+    if (pos > this->size_) {
+      throw std::out_of_range{"OUT OF BOUNDS!"};
+    }
+    return {this->data_ + pos, this->clamp(pos, count)};
+  }
+
+  constexpr int compare(basic_string_view other) const noexcept {
+    size_type common = this->size_ < other.size_ ? this->size_ : other.size_;
+    if (detail::use_byte_kernels<CharT>()) {
+      size_type i = detail::simd::mismatch(detail::as_bytes(this->data_),
+                                           detail::as_bytes(other.data_),
+                                           common);
+      if (i != common) {
+        return traits_type::lt(this->data_[i], other.data_[i]) ? -1 : 1;
+      }
+    } else if (int result =
+                   traits_type::compare(this->data_, other.data_, common);
+               result != 0) {
+      return result;
+    }
+    return this->size_ < other.size_ ? -1 : (this->size_ > other.size_ ? 1 : 0);
+  }
+  constexpr int compare(size_type pos, size_type count,
+                        basic_string_view other) const {
+    return this->substr(pos, count).compare(other);
+  }
+  constexpr int compare(const CharT *s) const {
+    return this->compare(basic_string_view(s));
+  }
+
+  constexpr bool starts_with(basic_string_view prefix) const noexcept {
+    return this->size_ >= prefix.size_ &&
+           basic_string_view(this->data_, prefix.size_).equals(prefix);
+  }
+  constexpr bool starts_with(CharT ch) const noexcept {
+    return !this->empty() && traits_type::eq(this->front(), ch);
+  }
+  constexpr bool starts_with(const CharT *s) const {
+    return this->starts_with(basic_string_view(s));
+  }
+
+  constexpr bool ends_with(basic_string_view suffix) const noexcept {
+    return this->size_ >= suffix.size_ &&
+           basic_string_view(this->end() - suffix.size_, suffix.size_)
+               .equals(suffix);
+  }
+  constexpr bool ends_with(CharT ch) const noexcept {
+    return !this->empty() && traits_type::eq(this->back(), ch);
+  }
+  constexpr bool ends_with(const CharT *s) const {
+    return this->ends_with(basic_string_view(s));
+  }
+
+  constexpr bool contains(basic_string_view needle) const noexcept {
+    return this->find(needle) != npos;
+  }
+  constexpr bool contains(CharT ch) const noexcept {
+    return this->find(ch) != npos;
+  }
+  constexpr bool contains(const CharT *s) const {
+    return this->find(s) != npos;
+  }
+
+  /// Whether both views hold the same characters.
+  constexpr bool equals(basic_string_view other) const noexcept {
+    if (this->size_ != other.size_) {
+      return false;
+    }
+    if (detail::use_byte_kernels<CharT>()) {
+      return detail::simd::mismatch(detail::as_bytes(this->data_),
+                                    detail::as_bytes(other.data_),
+                                    this->size_) == this->size_;
+    }
+    return traits_type::compare(this->data_, other.data_, this->size_) == 0;
+  }
+
+  // search
+
+  constexpr size_type find(CharT ch, size_type pos = 0) const noexcept {
+    if (pos >= this->size_) {
+      return npos;
+    }
+    if (detail::use_byte_kernels<CharT>()) {
+      size_type i = detail::simd::find_byte(
+          detail::as_bytes(this->data_ + pos), this->size_ - pos,
+          static_cast<char>(ch));
+      return i == detail::simd::not_found ? npos : pos + i;
+    }
+    const CharT *match =
+        traits_type::find(this->data_ + pos, this->size_ - pos, ch);
+    return match ? match - this->data_ : npos;
+  }
+  constexpr size_type find(basic_string_view needle,
+                           size_type pos = 0) const noexcept {
+    if (pos > this->size_ || needle.size_ > this->size_ - pos) {
+      return npos;
+    }
+    if (needle.empty()) {
+      return pos;
+    }
+    if (detail::use_byte_kernels<CharT>()) {
+      size_type i = detail::simd::find(detail::as_bytes(this->data_ + pos),
+                                       this->size_ - pos,
+                                       detail::as_bytes(needle.data_),
+                                       needle.size_);
+      return i == detail::simd::not_found ? npos : pos + i;
+    }
+    for (size_type last = this->size_ - needle.size_; pos <= last; ++pos) {
+      if (traits_type::eq(this->data_[pos], needle.data_[0]) &&
+          traits_type::compare(this->data_ + pos, needle.data_,
+                               needle.size_) == 0) {
+        return pos;
+      }
+    }
+    return npos;
+  }
+  constexpr size_type find(const CharT *s, size_type pos,
+                           size_type count) const noexcept {
+    return this->find(basic_string_view(s, count), pos);
+  }
+  constexpr size_type find(const CharT *s, size_type pos = 0) const {
+    return this->find(basic_string_view(s), pos);
+  }
+
+  constexpr size_type rfind(CharT ch, size_type pos = npos) const noexcept {
+    if (this->empty()) {
+      return npos;
+    }
+    size_type count = pos < this->size_ ? pos + 1 : this->size_;
+    if (detail::use_byte_kernels<CharT>()) {
+      size_type i = detail::simd::rfind_byte(detail::as_bytes(this->data_),
+                                             count, static_cast<char>(ch));
+      return i == detail::simd::not_found ? npos : i;
+    }
+    while (count != 0) {
+      if (traits_type::eq(this->data_[--count], ch)) {
+        return count;
+      }
+    }
+    return npos;
+  }
+  constexpr size_type rfind(basic_string_view needle,
+                            size_type pos = npos) const noexcept {
+    if (needle.size_ > this->size_) {
+      return npos;
+    }
+    size_type last = this->size_ - needle.size_;
+    if (pos > last) {
+      pos = last;
+    }
+    if (needle.empty()) {
+      return pos;
+    }
+    if (detail::use_byte_kernels<CharT>()) {
+      size_type i = detail::simd::rfind(detail::as_bytes(this->data_),
+                                        pos + needle.size_,
+                                        detail::as_bytes(needle.data_),
+                                        needle.size_);
+      return i == detail::simd::not_found ? npos : i;
+    }
+    for (size_type i = pos + 1; i != 0;) {
+      --i;
+      if (traits_type::eq(this->data_[i], needle.data_[0]) &&
+          traits_type::compare(this->data_ + i, needle.data_, needle.size_) ==
+              0) {
+        return i;
+      }
+    }
+    return npos;
+  }
+  constexpr size_type rfind(const CharT *s, size_type pos,
+                            size_type count) const noexcept {
+    return this->rfind(basic_string_view(s, count), pos);
+  }
+  constexpr size_type rfind(const CharT *s, size_type pos = npos) const {
+    return this->rfind(basic_string_view(s), pos);
+  }
+
+  constexpr size_type find_first_of(basic_string_view set,
+                                    size_type pos = 0) const noexcept {
+    if (pos >= this->size_ || set.empty()) {
+      return npos;
+    }
+    if (detail::use_byte_kernels<CharT>()) {
+      size_type i = detail::simd::find_first_of(
+          detail::as_bytes(this->data_ + pos), this->size_ - pos,
+          detail::as_bytes(set.data_), set.size_);
+      return i == detail::simd::not_found ? npos : pos + i;
+    }
+    for (; pos != this->size_; ++pos) {
+      if (traits_type::find(set.data_, set.size_, this->data_[pos])) {
+        return pos;
+      }
+    }
+    return npos;
+  }
+  constexpr size_type find_first_of(CharT ch,
+                                    size_type pos = 0) const noexcept {
+    return this->find(ch, pos);
+  }
+  constexpr size_type find_first_of(const CharT *s, size_type pos,
+                                    size_type count) const noexcept {
+    return this->find_first_of(basic_string_view(s, count), pos);
+  }
+  constexpr size_type find_first_of(const CharT *s, size_type pos = 0) const {
+    return this->find_first_of(basic_string_view(s), pos);
+  }
+
+  constexpr size_type find_last_of(basic_string_view set,
+                                   size_type pos = npos) const noexcept {
+    for (size_type i = pos < this->size_ ? pos + 1 : this->size_; i != 0;) {
+      if (traits_type::find(set.data_, set.size_, this->data_[--i])) {
+        return i;
+      }
+    }
+    return npos;
+  }
+  constexpr size_type find_last_of(CharT ch,
+                                   size_type pos = npos) const noexcept {
+    return this->rfind(ch, pos);
+  }
+
+  constexpr size_type find_first_not_of(basic_string_view set,
+                                        size_type pos = 0) const noexcept {
+    if (pos < this->size_ && detail::use_byte_kernels<CharT>()) {
+      size_type i = detail::simd::find_in_set(
+          detail::as_bytes(this->data_ + pos), this->size_ - pos,
+          detail::simd::byte_set(detail::as_bytes(set.data_), set.size_),
+          false);
+      return i == detail::simd::not_found ? npos : pos + i;
+    }
+    for (; pos < this->size_; ++pos) {
+      if (!traits_type::find(set.data_, set.size_, this->data_[pos])) {
+        return pos;
+      }
+    }
+    return npos;
+  }
+  constexpr size_type find_first_not_of(CharT ch,
+                                        size_type pos = 0) const noexcept {
+    return this->find_first_not_of(basic_string_view(&ch, 1), pos);
+  }
+
+  constexpr size_type find_last_not_of(basic_string_view set,
+                                       size_type pos = npos) const noexcept {
+    for (size_type i = pos < this->size_ ? pos + 1 : this->size_; i != 0;) {
+      if (!traits_type::find(set.data_, set.size_, this->data_[--i])) {
+        return i;
+      }
+    }
+    return npos;
+  }
+  constexpr size_type find_last_not_of(CharT ch,
+                                       size_type pos = npos) const noexcept {
+    return this->find_last_not_of(basic_string_view(&ch, 1), pos);
+  }
+};
+
+using string_view = basic_string_view<char>;
+using u8string_view = basic_string_view<char8_t>;
+using u16string_view = basic_string_view<char16_t>;
+using u32string_view = basic_string_view<char32_t>;
+using wstring_view = basic_string_view<wchar_t>;
+
+template <class CharT>
+constexpr bool operator==(basic_string_view<CharT> lhs,
+                          std::type_identity_t<basic_string_view<CharT>>
+                              rhs) noexcept {
+  return lhs.equals(rhs);
+}
+template <class CharT>
+constexpr std::strong_ordering
+operator<=>(basic_string_view<CharT> lhs,
+            std::type_identity_t<basic_string_view<CharT>> rhs) noexcept {
+  return lhs.compare(rhs) <=> 0;
+}
+} // namespace isl
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <random>      // std::mt19937
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+import string;
+import string_view;
+
+TEST(string_view, TestConstexpr) {
+  constexpr isl::string_view sv("key=value");
+
+  static_assert(sv.size() == 9);
+  static_assert(sv.find('=') == 3);
+  static_assert(sv.find("value") == 4);
+  static_assert(sv.rfind('e') == 8);
+  static_assert(sv.starts_with("key"));
+  static_assert(sv.substr(4) == "value");
+}
+
+TEST(string_view, TestFind) {
+  isl::string_view sv("GET /index.html HTTP/1.1 GET /favicon.ico HTTP/1.1");
+
+  ASSERT_EQ(sv.find('/'), 4);
+  ASSERT_EQ(sv.find('/', 5), 20);
+  ASSERT_EQ(sv.find('#'), isl::string_view::npos);
+  ASSERT_EQ(sv.find("HTTP"), 16);
+  ASSERT_EQ(sv.find("HTTP", 17), 42);
+  ASSERT_EQ(sv.find(""), 0);
+  ASSERT_EQ(sv.rfind("GET"), 25);
+  ASSERT_EQ(sv.rfind("GET", 24), 0);
+  ASSERT_EQ(sv.find_first_of(" ."), 3);
+  ASSERT_EQ(sv.find_first_of("?#"), isl::string_view::npos);
+}
+
+TEST(string_view, TestCompare) {
+  isl::string_view a("the quick brown fox jumps over the lazy dog");
+  isl::string_view b("the quick brown fox jumps over the lazy cat");
+
+  ASSERT_GT(a.compare(b), 0);
+  ASSERT_LT(b.compare(a), 0);
+  ASSERT_EQ(a.compare(a), 0);
+  ASSERT_LT(a.substr(0, 10).compare(a), 0);
+  ASSERT_TRUE(a.starts_with(b.substr(0, 40)));
+  ASSERT_TRUE(a.ends_with("dog"));
+  ASSERT_FALSE(a.ends_with(b));
+
+  // bytes compare as unsigned, like std::char_traits<char>
+  ASSERT_LT(isl::string_view("a").compare("\xff"), 0);
+}
+
+TEST(string_view, TestFromString) {
+  isl::string s("a string long enough to live on the heap");
+  isl::string_view sv = s;
+
+  ASSERT_EQ(sv.size(), s.size());
+  ASSERT_EQ(sv.find("heap"), s.size() - 4);
+  ASSERT_EQ(isl::string(sv.substr(2, 6)), "string");
+}
+
+// Covers every block boundary and tail length of the SIMD kernels.
+TEST(string_view, TestMatchesStd) {
+  std::mt19937 rng(7);
+  for (int round = 0; round < 2000; ++round) {
+    std::string haystack(rng() % 150, 'a');
+    for (char &c : haystack) {
+      c = static_cast<char>('a' + rng() % 3);
+    }
+    std::string needle(1 + rng() % 6, 'a');
+    for (char &c : needle) {
+      c = static_cast<char>('a' + rng() % 3);
+    }
+    std::size_t pos = rng() % (haystack.size() + 2);
+
+    isl::string_view sv(haystack.data(), haystack.size());
+    isl::string_view nv(needle.data(), needle.size());
+    std::string_view ssv = haystack;
+
+    ASSERT_EQ(sv.find(nv, pos), ssv.find(needle, pos));
+    ASSERT_EQ(sv.rfind(nv, pos), ssv.rfind(needle, pos));
+    ASSERT_EQ(sv.find(needle[0], pos), ssv.find(needle[0], pos));
+    ASSERT_EQ(sv.rfind(needle[0], pos), ssv.rfind(needle[0], pos));
+    ASSERT_EQ(sv.find_first_of(nv.substr(0, 2), pos),
+              ssv.find_first_of(needle.substr(0, 2), pos));
+    ASSERT_EQ(sv.find_first_of(nv, pos), ssv.find_first_of(needle, pos));
+    ASSERT_EQ(sv.find_first_not_of(nv, pos),
+              ssv.find_first_not_of(needle, pos));
+
+    std::string other = haystack;
+    if (!other.empty()) {
+      other[rng() % other.size()] = 'z';
+    }
+    ASSERT_EQ(sv.compare(isl::string_view(other.data(), other.size())) < 0,
+              ssv.compare(other) < 0);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
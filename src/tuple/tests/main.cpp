@@ -19,6 +19,21 @@ TEST(utility, TestTupleArgumentConstruction) {
   ASSERT_EQ(isl::get<2>(pair), "Hello");
 }
 
+TEST(utility, TestTupleComparison) {
+  isl::tuple<int, double, std::string> a{1, 2.0, "abc"};
+  isl::tuple<int, double, std::string> b{1, 2.0, "abd"};
+
+  ASSERT_TRUE(a == a);
+  ASSERT_FALSE(a == b);
+  ASSERT_TRUE(a < b);
+  ASSERT_TRUE(b > a);
+  ASSERT_TRUE((a <=> a) == 0);
+
+  isl::tuple<long, float> c{1, 3.0f};
+  ASSERT_TRUE(c == (isl::tuple<int, double>{1, 3.0}));
+  ASSERT_TRUE(c < (isl::tuple<int, double>{2, 0.0}));
+}
+
 int main(int argc, char *argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -67,6 +67,10 @@ constexpr const T &&get(const tuple<Types...> &&t) noexcept;
 // relational operators
 template <class... TTypes, class... UTypes>
 constexpr bool operator==(const tuple<TTypes...> &, const tuple<UTypes...> &);
+template <class... TTypes, class... UTypes>
+constexpr std::common_comparison_category_t<
+    std::compare_three_way_result_t<TTypes, UTypes>...>
+operator<=>(const tuple<TTypes...> &, const tuple<UTypes...> &);
 
 // specialized algorithms
 template <class... Types>
@@ -107,6 +111,15 @@ template <typename Tuple, size_t I> auto &__get_element(Tuple &t) {
   return __get_element<Tuple, I, tuple_element_t<I, Tuple>>(t);
 }
 
+template <typename Tuple, size_t I, typename Type>
+const tuple<I, Type> &__get_element(const Tuple &t) {
+  return static_cast<const tuple<I, Type> &>(t.head);
+}
+
+template <typename Tuple, size_t I> const auto &__get_element(const Tuple &t) {
+  return __get_element<Tuple, I, tuple_element_t<I, Tuple>>(t);
+}
+
 // get_underlying
 
 template <typename Tuple, size_t I> auto &__get_underlying(Tuple &t) {
@@ -225,7 +238,7 @@ public:
       : head{isl::forward<UTypes>(isl::get<I>(other))...} {}
 
   template <class... UTypes>
-  explicit(isl::is_convertible_v<UTypes &&, Types>)
+  explicit((... || !isl::is_convertible_v<UTypes &&, Types>))
       tuple(tuple<UTypes...> &&other) requires(
           sizeof...(Types) == sizeof...(UTypes) &&
           (... && isl::is_constructible_v<Types, UTypes &&>)&&(
@@ -370,4 +383,30 @@ template <class... Types>
 constexpr tuple<Types &&...> forward_as_tuple(Types &&...args) noexcept {
   return std::tuple<Types &&...>(isl::forward<Types>(args)...);
 }
-} // namespace isl
\ No newline at end of file
+
+// relational operators
+
+template <class... TTypes, class... UTypes>
+constexpr bool operator==(const tuple<TTypes...> &t,
+                          const tuple<UTypes...> &u) {
+  static_assert(sizeof...(TTypes) == sizeof...(UTypes));
+  return [&]<size_t... I>(std::index_sequence<I...>) {
+    // stops at the first unequal element
+    return (true && ... && (isl::get<I>(t) == isl::get<I>(u)));
+  }(std::index_sequence_for<TTypes...>{});
+}
+
+template <class... TTypes, class... UTypes>
+constexpr std::common_comparison_category_t<
+    std::compare_three_way_result_t<TTypes, UTypes>...>
+operator<=>(const tuple<TTypes...> &t, const tuple<UTypes...> &u) {
+  static_assert(sizeof...(TTypes) == sizeof...(UTypes));
+  std::common_comparison_category_t<
+      std::compare_three_way_result_t<TTypes, UTypes>...>
+      order = std::strong_ordering::equal;
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (void)(true && ... && ((order = isl::get<I>(t) <=> isl::get<I>(u)) == 0));
+  }(std::index_sequence_for<TTypes...>{});
+  return order;
+}
+} // namespace isl
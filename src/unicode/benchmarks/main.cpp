@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef> // std::size_t
+#include <random>  // std::mt19937
+#include <string>  // std::string, std::u16string, std::u32string
+
+import unicode;
+
+namespace {
+// 1 MiB of text; `non_ascii` of every 100 characters are two to four bytes.
+std::string make_text(int non_ascii) {
+  std::mt19937 rng(1);
+  std::u32string text;
+  while (text.size() < (1 << 20) / 2) {
+    if (static_cast<int>(rng() % 100) < non_ascii) {
+      text += static_cast<char32_t>(0x80 + rng() % 0x2000);
+    } else {
+      text += static_cast<char32_t>('a' + rng() % 26);
+    }
+  }
+  std::string utf8(text.size() * 4, '\0');
+  auto result = isl::utf32_to_utf8(text.data(), text.data() + text.size(),
+                                   utf8.data());
+  utf8.resize(result.written);
+  return utf8;
+}
+
+// A byte-at-a-time validator for comparison.
+bool naive_validate(const unsigned char *s, std::size_t n) {
+  for (std::size_t i = 0; i < n;) {
+    unsigned char c = s[i];
+    std::size_t length = c < 0x80 ? 1 : c < 0xC2 ? 0 : c < 0xE0 ? 2
+                                    : c < 0xF0   ? 3
+                                    : c < 0xF5   ? 4
+                                                 : 0;
+    if (length == 0 || i + length > n) {
+      return false;
+    }
+    for (std::size_t j = 1; j < length; ++j) {
+      if ((s[i + j] & 0xC0) != 0x80) {
+        return false;
+      }
+    }
+    i += length;
+  }
+  return true;
+}
+} // namespace
+
+static void BM_ValidateUtf8(benchmark::State &state) {
+  std::string text = make_text(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        isl::validate_utf8(text.data(), text.data() + text.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ValidateUtf8)->Arg(0)->Arg(10)->Arg(100);
+
+static void BM_NaiveValidateUtf8(benchmark::State &state) {
+  std::string text = make_text(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(naive_validate(
+        reinterpret_cast<const unsigned char *>(text.data()), text.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_NaiveValidateUtf8)->Arg(0)->Arg(10)->Arg(100);
+
+static void BM_Utf8ToUtf16(benchmark::State &state) {
+  std::string text = make_text(static_cast<int>(state.range(0)));
+  std::u16string out(text.size(), u'\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::utf8_to_utf16(
+        text.data(), text.data() + text.size(), out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Utf8ToUtf16)->Arg(0)->Arg(10)->Arg(100);
+
+static void BM_Utf16ToUtf8(benchmark::State &state) {
+  std::string text = make_text(static_cast<int>(state.range(0)));
+  std::u16string utf16(text.size(), u'\0');
+  auto result = isl::utf8_to_utf16(text.data(), text.data() + text.size(),
+                                   utf16.data());
+  utf16.resize(result.written);
+  std::string out(utf16.size() * 3, '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isl::utf16_to_utf8(
+        utf16.data(), utf16.data() + utf16.size(), out.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Utf16ToUtf8)->Arg(0)->Arg(10)->Arg(100);
+
+BENCHMARK_MAIN();
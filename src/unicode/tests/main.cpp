@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <cstddef> // std::size_t
+#include <random>  // std::mt19937
+#include <string>  // std::string, std::u16string, std::u32string
+
+import cstddef;
+import unicode;
+
+namespace {
+// Straightforward reference: offset of the first ill-formed sequence.
+std::size_t reference_find_invalid(const std::string &text) {
+  auto s = reinterpret_cast<const unsigned char *>(text.data());
+  std::size_t n = text.size();
+  for (std::size_t i = 0; i < n;) {
+    unsigned char lead = s[i];
+    std::size_t length = lead < 0x80   ? 1
+                         : lead < 0xC0 ? 0
+                         : lead < 0xE0 ? 2
+                         : lead < 0xF0 ? 3
+                         : lead < 0xF8 ? 4
+                                       : 0;
+    if (length == 0 || i + length > n) {
+      return i;
+    }
+    char32_t c = length == 1 ? lead : lead & (0x7F >> length);
+    for (std::size_t j = 1; j < length; ++j) {
+      if ((s[i + j] & 0xC0) != 0x80) {
+        return i;
+      }
+      c = c << 6 | (s[i + j] & 0x3F);
+    }
+    constexpr char32_t minimum[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (c < minimum[length] || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+      return i;
+    }
+    i += length;
+  }
+  return n;
+}
+
+std::size_t find_invalid(const std::string &text) {
+  return isl::find_invalid_utf8(text.data(), text.data() + text.size()) -
+         text.data();
+}
+
+std::string encode(const std::u32string &text) {
+  std::string result(text.size() * 4, '\0');
+  auto [read, written, valid] = isl::utf32_to_utf8(
+      text.data(), text.data() + text.size(), result.data());
+  EXPECT_TRUE(valid);
+  result.resize(written);
+  return result;
+}
+
+// Mostly ASCII with every sequence length mixed in.
+std::u32string random_text(std::mt19937 &rng, std::size_t length) {
+  std::u32string text;
+  for (std::size_t i = 0; i < length; ++i) {
+    switch (rng() % 8) {
+    case 0:
+      text += static_cast<char32_t>(0x80 + rng() % (0x800 - 0x80));
+      break;
+    case 1:
+      text += static_cast<char32_t>(0x800 + rng() % (0xD800 - 0x800));
+      break;
+    case 2:
+      text += static_cast<char32_t>(0x10000 + rng() % (0x110000 - 0x10000));
+      break;
+    default:
+      text += static_cast<char32_t>(rng() % 0x80);
+    }
+  }
+  return text;
+}
+} // namespace
+
+TEST(unicode, TestValidate) {
+  const char8_t text[] = u8"plain, café, €, \U0001F600";
+  ASSERT_TRUE(isl::validate_utf8(text, text + sizeof(text) - 1));
+  isl::byte bytes[] = {isl::byte{0xC3}, isl::byte{0xA9}};
+  ASSERT_TRUE(isl::validate_utf8(bytes, bytes + 2));
+  ASSERT_FALSE(isl::validate_utf8(bytes, bytes + 1));
+
+  // each error at every offset in and around the 64-byte groups
+  const std::string invalid[] = {
+      "\x80",             "\xC0\x80",         "\xC1\xBF",
+      "\xC3",             "\xC3\x41",         "\xE0\x80\x80",
+      "\xE0\x9F\xBF",     "\xED\xA0\x80",     "\xED\xBF\xBF",
+      "\xE2\x82",         "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80",
+      "\xF5\x80\x80\x80", "\xF0\x9F\x98",     "\xFF",
+      "\xC3\xA9\xA9",
+  };
+  for (const std::string &sequence : invalid) {
+    for (std::size_t offset :
+         {0, 1, 15, 31, 60, 61, 62, 63, 64, 65, 127, 200}) {
+      for (std::size_t after : {0, 1, 70}) {
+        std::string input = std::string(offset, 'a') + sequence +
+                            std::string(after, 'b');
+        ASSERT_EQ(find_invalid(input), reference_find_invalid(input))
+            << offset << " " << after;
+        ASSERT_LE(find_invalid(input), offset + 2);
+      }
+    }
+  }
+}
+
+// Random valid text with a random byte overwritten now and then; the SIMD
+// validator must agree with the reference on where the first error is.
+TEST(unicode, TestValidateRandom) {
+  std::mt19937 rng(11);
+  for (int round = 0; round < 3000; ++round) {
+    std::string input = encode(random_text(rng, rng() % 300));
+    if (round % 2 && !input.empty()) {
+      input[rng() % input.size()] = static_cast<char>(rng());
+    }
+    ASSERT_EQ(find_invalid(input), reference_find_invalid(input)) << round;
+  }
+}
+
+TEST(unicode, TestTranscode) {
+  std::u32string text = U"ascii é€\U0001F600 and more ascii text";
+  std::string utf8 = encode(text);
+  ASSERT_EQ(utf8, "ascii \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 and more ascii "
+                  "text");
+
+  std::u16string utf16(
+      isl::utf16_length_from_utf8(utf8.data(), utf8.data() + utf8.size()),
+      u'\0');
+  auto result = isl::utf8_to_utf16(utf8.data(), utf8.data() + utf8.size(),
+                                   utf16.data());
+  ASSERT_EQ(result, (isl::transcode_result{utf8.size(), utf16.size(), true}));
+  ASSERT_EQ(utf16, u"ascii é€\U0001F600 and more ascii text");
+
+  std::u32string utf32(utf16.size(), U'\0');
+  result = isl::utf16_to_utf32(utf16.data(), utf16.data() + utf16.size(),
+                               utf32.data());
+  utf32.resize(result.written);
+  ASSERT_EQ(utf32, text);
+
+  // a lone low surrogate, an overlong and an out of range code point
+  const char16_t bad16[] = u"ab\xDC00";
+  std::string out(16, '\0');
+  result = isl::utf16_to_utf8(bad16, bad16 + 3, out.data());
+  ASSERT_EQ(result, (isl::transcode_result{2, 2, false}));
+  std::string bad8 = "xyz\xC0\x80";
+  result = isl::utf8_to_utf32(bad8.data(), bad8.data() + bad8.size(),
+                              utf32.data());
+  ASSERT_EQ(result, (isl::transcode_result{3, 3, false}));
+  const char32_t bad32[] = {U'a', 0x110000};
+  result = isl::utf32_to_utf16(bad32, bad32 + 2, utf16.data());
+  ASSERT_EQ(result, (isl::transcode_result{1, 1, false}));
+}
+
+TEST(unicode, TestTranscodeRandom) {
+  std::mt19937 rng(13);
+  for (int round = 0; round < 2000; ++round) {
+    std::u32string text = random_text(rng, rng() % 200);
+    const char32_t *first = text.data();
+    const char32_t *last = first + text.size();
+    std::string utf8 = encode(text);
+    ASSERT_EQ(utf8.size(), isl::utf8_length_from_utf32(first, last));
+
+    std::u16string utf16(isl::utf16_length_from_utf32(first, last), u'\0');
+    isl::utf32_to_utf16(first, last, utf16.data());
+    ASSERT_EQ(utf16.size(), isl::utf16_length_from_utf8(
+                                utf8.data(), utf8.data() + utf8.size()));
+    ASSERT_EQ(utf8.size(), isl::utf8_length_from_utf16(
+                               utf16.data(), utf16.data() + utf16.size()));
+    ASSERT_EQ(text.size(), isl::utf32_length_from_utf16(
+                               utf16.data(), utf16.data() + utf16.size()));
+
+    std::u16string from8(utf16.size(), u'\0');
+    auto result = isl::utf8_to_utf16(utf8.data(), utf8.data() + utf8.size(),
+                                     from8.data());
+    ASSERT_TRUE(result.valid);
+    ASSERT_EQ(from8, utf16);
+
+    std::u32string to32(text.size(), U'\0');
+    result = isl::utf8_to_utf32(utf8.data(), utf8.data() + utf8.size(),
+                                to32.data());
+    ASSERT_EQ(result.written, text.size());
+    ASSERT_EQ(to32, text);
+
+    std::string to8(utf16.size() * 3, '\0');
+    result = isl::utf16_to_utf8(utf16.data(), utf16.data() + utf16.size(),
+                                to8.data());
+    to8.resize(result.written);
+    ASSERT_EQ(to8, utf8);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
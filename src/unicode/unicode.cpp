@@ -0,0 +1,197 @@
+module;
+
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::remove_const_t
+
+#include "../internal/simd/utf8.hpp"
+
+export module unicode;
+
+import bytes;
+
+namespace isl::detail {
+namespace simd = isl::internal::simd;
+
+template <class T> const unsigned char *as_utf8(T *p) noexcept {
+  return reinterpret_cast<const unsigned char *>(p);
+}
+} // namespace isl::detail
+
+export namespace isl {
+/// Outcome of a transcoding call. On success `read` is the whole input; on
+/// failure it is the offset of the first code unit of the invalid sequence
+/// and `written` what the valid prefix before it produced.
+struct transcode_result {
+  std::size_t read;
+  std::size_t written;
+  bool valid;
+
+  friend bool operator==(const transcode_result &,
+                         const transcode_result &) = default;
+};
+
+// UTF-8 ranges are contiguous ranges of any byte_like type: char8_t,
+// isl::byte, char and so on. Invalid means ill-formed per the Unicode
+// standard: overlong forms, surrogates, code points past U+10FFFF, stray
+// or missing continuation bytes and sequences cut off by the end.
+
+/// First byte of the first invalid UTF-8 sequence, or `last`. Runs the
+/// Keiser-Lemire lookup-table validator on AVX2 or SSE4.2.
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+T *find_invalid_utf8(T *first, T *last) noexcept {
+  std::size_t index = detail::simd::find_invalid_utf8(detail::as_utf8(first),
+                                                      last - first);
+  return index == detail::simd::not_found ? last : first + index;
+}
+
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+bool validate_utf8(T *first, T *last) noexcept {
+  return isl::find_invalid_utf8(first, last) == last;
+}
+
+inline bool validate_utf16(const char16_t *first,
+                           const char16_t *last) noexcept {
+  for (; first != last; ++first) {
+    if (*first >= 0xD800 && *first <= 0xDFFF) {
+      if (*first > 0xDBFF || first + 1 == last || first[1] < 0xDC00 ||
+          first[1] > 0xDFFF) {
+        return false;
+      }
+      ++first;
+    }
+  }
+  return true;
+}
+
+inline bool validate_utf32(const char32_t *first,
+                           const char32_t *last) noexcept {
+  bool valid = true;
+  for (; first != last; ++first) {
+    valid &= *first <= 0x10FFFF && (*first < 0xD800 || *first > 0xDFFF);
+  }
+  return valid;
+}
+
+// Output lengths, for sizing the buffers of the transcoders. They assume
+// valid input; on invalid input they bound nothing.
+
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+std::size_t utf16_length_from_utf8(T *first, T *last) noexcept {
+  const unsigned char *s = detail::as_utf8(first);
+  std::size_t length = 0;
+  for (std::size_t i = 0, n = last - first; i != n; ++i) {
+    // one unit per lead byte, two for four-byte sequences
+    length += (s[i] & 0xC0) != 0x80;
+    length += s[i] >= 0xF0;
+  }
+  return length;
+}
+
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+std::size_t utf32_length_from_utf8(T *first, T *last) noexcept {
+  const unsigned char *s = detail::as_utf8(first);
+  std::size_t length = 0;
+  for (std::size_t i = 0, n = last - first; i != n; ++i) {
+    length += (s[i] & 0xC0) != 0x80;
+  }
+  return length;
+}
+
+inline std::size_t utf8_length_from_utf16(const char16_t *first,
+                                          const char16_t *last) noexcept {
+  std::size_t length = 0;
+  for (; first != last; ++first) {
+    // each half of a surrogate pair counts two of the pair's four bytes
+    bool surrogate = *first >= 0xD800 && *first <= 0xDFFF;
+    length += 1 + (*first >= 0x80) + (*first >= 0x800 && !surrogate);
+  }
+  return length;
+}
+
+inline std::size_t utf8_length_from_utf32(const char32_t *first,
+                                          const char32_t *last) noexcept {
+  std::size_t length = 0;
+  for (; first != last; ++first) {
+    length += 1 + (*first >= 0x80) + (*first >= 0x800) + (*first >= 0x10000);
+  }
+  return length;
+}
+
+inline std::size_t utf16_length_from_utf32(const char32_t *first,
+                                           const char32_t *last) noexcept {
+  std::size_t length = 0;
+  for (; first != last; ++first) {
+    length += 1 + (*first >= 0x10000);
+  }
+  return length;
+}
+
+inline std::size_t utf32_length_from_utf16(const char16_t *first,
+                                           const char16_t *last) noexcept {
+  std::size_t length = 0;
+  for (; first != last; ++first) {
+    // one code point per unit but low surrogates
+    length += *first < 0xDC00 || *first > 0xDFFF;
+  }
+  return length;
+}
+
+// Transcoders validate as they go and stop at the first invalid sequence.
+// `out` must have room for the output of the whole input: the matching
+// length function above, or at most one unit per input unit when going
+// from UTF-8 or to UTF-32, two per unit from UTF-32 to UTF-16, three per
+// unit from UTF-16 to UTF-8 and four per unit from UTF-32 to UTF-8. Runs
+// of ASCII are converted 16 units at a time.
+
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+transcode_result utf8_to_utf16(T *first, T *last, char16_t *out) noexcept {
+  auto [read, written, valid] =
+      detail::simd::utf8_to_utf16(detail::as_utf8(first), last - first, out);
+  return {read, written, valid};
+}
+
+template <class T>
+  requires byte_like<std::remove_const_t<T>>
+transcode_result utf8_to_utf32(T *first, T *last, char32_t *out) noexcept {
+  auto [read, written, valid] =
+      detail::simd::utf8_to_utf32(detail::as_utf8(first), last - first, out);
+  return {read, written, valid};
+}
+
+template <byte_like T>
+transcode_result utf16_to_utf8(const char16_t *first, const char16_t *last,
+                               T *out) noexcept {
+  auto [read, written, valid] = detail::simd::utf16_to_utf8(
+      first, last - first, reinterpret_cast<unsigned char *>(out));
+  return {read, written, valid};
+}
+
+template <byte_like T>
+transcode_result utf32_to_utf8(const char32_t *first, const char32_t *last,
+                               T *out) noexcept {
+  auto [read, written, valid] = detail::simd::utf32_to_utf8(
+      first, last - first, reinterpret_cast<unsigned char *>(out));
+  return {read, written, valid};
+}
+
+inline transcode_result utf16_to_utf32(const char16_t *first,
+                                       const char16_t *last,
+                                       char32_t *out) noexcept {
+  auto [read, written, valid] =
+      detail::simd::scalar::utf16_to_utf32(first, last - first, out);
+  return {read, written, valid};
+}
+
+inline transcode_result utf32_to_utf16(const char32_t *first,
+                                       const char32_t *last,
+                                       char16_t *out) noexcept {
+  auto [read, written, valid] =
+      detail::simd::scalar::utf32_to_utf16(first, last - first, out);
+  return {read, written, valid};
+}
+} // namespace isl
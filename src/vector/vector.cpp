@@ -1,6 +1,7 @@
 module;
 
 #include <cstdint>  // std::size_t
+#include <cstring>  // std::memcpy
 #include <iterator> // std::reverse_iterator
 #include <memory>   // std::allocator
 
@@ -8,8 +9,12 @@ module;
 #include <initializer_list> // std::initializer_list
 #include <limits>           // std::numeric_limits
 
-#include <algorithm> // std::remove, std::remove_if
-#include <stdexcept> // std::out_of_range
+#include <algorithm>   // std::move
+#include <stdexcept>   // std::out_of_range
+#include <type_traits> // std::is_trivially_copyable, std::is_trivial, ...
+#include <utility>     // std::exchange, std::swap
+
+#include "../internal/simd/compact.hpp"
 
 export module vector;
 
@@ -19,6 +24,59 @@ template <class T = std::byte> class polymorphic_allocator;
 }
 } // namespace std
 
+export namespace isl::detail {
+/// Growth policy of isl::vector, shared with the other contiguous
+/// containers: keep doubling `current` until `required` elements fit.
+constexpr std::size_t grow_capacity(std::size_t required,
+                                    std::size_t current) noexcept {
+  if (current == 0) {
+    current = 1;
+  }
+  while (current < required) {
+    current *= 2;
+  }
+  return current;
+}
+
+/// Relocation policy of isl::vector: moves `count` elements into raw storage
+/// at `destination` and ends the lifetime of the originals. Trivially
+/// copyable types are relocated with a single memcpy.
+template <class T>
+constexpr void relocate(T *first, std::size_t count, T *destination) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (!std::is_constant_evaluated()) {
+      if (count != 0) {
+        std::memcpy(destination, first, count * sizeof(T));
+      }
+      return;
+    }
+  }
+  std::uninitialized_move_n(first, count, destination);
+  std::destroy_n(first, count);
+}
+} // namespace isl::detail
+
+namespace isl::detail {
+namespace simd = isl::internal::simd;
+
+// Element types erase and erase_if compact with the SIMD kernels, which
+// move integers as their unsigned bit patterns.
+template <class T>
+concept compactable = (std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                       (sizeof(T) == 4 || sizeof(T) == 8)) ||
+                      std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <class T> struct compact_lane {
+  using type = T;
+};
+template <class T>
+  requires std::is_integral_v<T>
+struct compact_lane<T> {
+  using type = std::make_unsigned_t<T>;
+};
+template <class T> using compact_lane_t = typename compact_lane<T>::type;
+} // namespace isl::detail
+
 export namespace isl {
 template <class T, class Allocator = std::allocator<T>> class vector {
 public:
@@ -44,18 +102,13 @@ public:
 private:
   Allocator allocator;
 
-  T *storage;
-  std::size_t capacity_;
-  std::size_t size_;
+  T *storage{nullptr};
+  std::size_t capacity_{0};
+  std::size_t size_{0};
 
-  int get_new_capacity(std::size_t old_capacity,
-                       std::size_t count_of_elements) {
-    if (count_of_elements > old_capacity) {
-      while (old_capacity < count_of_elements) {
-        old_capacity *= 2;
-      }
-    }
-    return old_capacity;
+  std::size_t get_new_capacity(std::size_t count_of_elements,
+                               std::size_t old_capacity) {
+    return detail::grow_capacity(count_of_elements, old_capacity);
   }
   void assign_size_capacity(std::size_t new_value) {
     this->capacity_ = new_value;
@@ -63,13 +116,13 @@ private:
   }
 
   void reallocate(std::size_t new_capacity, std::size_t old_capacity) {
-    T *new_storage;
-    allocator.allocate(new_storage, new_capacity);
+    T *new_storage = allocator.allocate(new_capacity);
 
-    std::copy(this->storage, this->storage + old_capacity, new_storage);
+    detail::relocate(this->storage, this->size_, new_storage);
 
-    std::destroy_at(this->storage, old_capacity);
-    allocator.deallocate(this->storage, old_capacity);
+    if (this->storage != nullptr) {
+      allocator.deallocate(this->storage, old_capacity);
+    }
 
     this->storage = new_storage;
     this->capacity_ = new_capacity;
@@ -100,13 +153,13 @@ public:
       : allocator(alloc) {}
   constexpr vector(size_type count, const T &value,
                    const Allocator &alloc = Allocator())
-      : allocator(alloc), capacity_(count), size_(capacity) {
+      : allocator(alloc), capacity_(count), size_(count) {
     this->storage = allocator.allocate(count);
     std::uninitialized_fill_n(storage, count, value);
   }
   constexpr explicit vector(size_type count,
                             const Allocator &alloc = Allocator())
-      : allocator(alloc), capacity_(count), size_(capacity) {
+      : allocator(alloc), capacity_(count), size_(count) {
     this->storage = allocator.allocate(count);
     std::uninitialized_default_construct_n(storage, count);
   }
@@ -141,14 +194,11 @@ public:
 
     std::copy_n(other.begin(), other_size, this->storage);
   }
-  constexpr vector(vector &&other) noexcept {
-    size_t other_size = other.size();
-
-    this->storage = allocator.allocate(other_size);
-    assign_size_capacity(other_size);
-
-    std::move(other.storage, other.storage + other_size, this->storage);
-  }
+  constexpr vector(vector &&other) noexcept
+      : allocator(std::move(other.allocator)),
+        storage(std::exchange(other.storage, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        size_(std::exchange(other.size_, 0)) {}
   constexpr vector(vector &&other, const Allocator &alloc) : allocator(alloc) {
     size_t other_size = other.size();
 
@@ -168,24 +218,48 @@ public:
     std::copy_n(init.begin(), init.end(), storage);
   }
   constexpr ~vector() {
-    allocator.deallocate(storage, capacity_);
-    std::destroy_at(storage, storage + capacity_);
+    std::destroy_n(storage, size_);
+    if (storage != nullptr) {
+      allocator.deallocate(storage, capacity_);
+    }
   }
 
   constexpr vector &operator=(const vector &other) {
-    size_t other_size = other.size();
+    if (this == &other) {
+      return *this;
+    }
+    this->clear();
+    this->reserve(other.size_);
 
-    assign_size_capacity(other_size);
-    std::copy(other.storage, other.storage + other_size, this->storage);
+    std::uninitialized_copy_n(other.storage, other.size_, this->storage);
+    this->size_ = other.size_;
+    return *this;
   }
   constexpr vector &operator=(vector &&other) noexcept(
       std::allocator_traits<
           Allocator>::propagate_on_container_move_assignment::value ||
       std::allocator_traits<Allocator>::is_always_equal::value) {
-    size_t other_size = other.size();
+    using traits = std::allocator_traits<Allocator>;
+    if constexpr (!traits::propagate_on_container_move_assignment::value &&
+                  !traits::is_always_equal::value) {
+      // the buffer of `other` can only be freed by an equal allocator
+      if (this->allocator != other.allocator) {
+        this->clear();
+        this->reserve(other.size_);
+        std::uninitialized_move_n(other.storage, other.size_, this->storage);
+        this->size_ = other.size_;
+        return *this;
+      }
+    }
+    vector moved(std::move(other));
 
-    assign_size_capacity(other_size);
-    std::move(other.storage, other.storage + other_size, this->storage);
+    std::swap(this->storage, moved.storage);
+    std::swap(this->capacity_, moved.capacity_);
+    std::swap(this->size_, moved.size_);
+    if constexpr (traits::propagate_on_container_move_assignment::value) {
+      std::swap(this->allocator, moved.allocator);
+    }
+    return *this;
   }
   constexpr vector &operator=(std::initializer_list<T> ilist) {
     size_t other_size = ilist.size();
@@ -208,19 +282,21 @@ public:
     return this->allocator;
   }
 
-  [[nodiscard]] constexpr bool empty() const noexcept { return this->size_; }
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return this->size_ == 0;
+  }
   constexpr size_type size() const noexcept { return this->size_; }
   constexpr size_type max_size() const noexcept {
     return std::numeric_limits<difference_type>::max();
   }
   constexpr void reserve(size_type new_cap) {
-    if (new_cap < this->capacity_) {
+    if (new_cap <= this->capacity_) {
       return;
     }
     this->reallocate(new_cap);
   }
   constexpr size_type capacity() const noexcept { return this->capacity_; }
-  constexpr void shrink_to_fit() { this->reallocate(this->size_, this->size_); }
+  constexpr void shrink_to_fit() { this->reallocate(this->size_); }
 
   constexpr iterator begin() noexcept { return this->storage; }
   constexpr const_iterator begin() const noexcept { return this->storage; }
@@ -263,15 +339,15 @@ public:
   }
   constexpr reference front() { return this->storage[0]; }
   constexpr const_reference front() const { return this->storage[0]; }
-  constexpr reference back() { return this->storage[this->capacity_ - 1]; }
+  constexpr reference back() { return this->storage[this->size_ - 1]; }
   constexpr const_reference back() const {
-    return this->storage[this->capacity_ - 1];
+    return this->storage[this->size_ - 1];
   }
-  constexpr T *data() noexcept { return &this->storage; }
-  constexpr const T *data() const noexcept { return &this->storage; }
+  constexpr T *data() noexcept { return this->storage; }
+  constexpr const T *data() const noexcept { return this->storage; }
 
   constexpr void clear() noexcept {
-    allocator.allocate(storage, this->capacity_);
+    std::destroy_n(this->storage, this->size_);
     this->size_ = 0;
   }
 
@@ -309,16 +385,27 @@ public:
   }
   template <class InputIt>
   constexpr iterator insert(const_iterator pos, InputIt first, InputIt last) {
-    size_t distance = std::distance(this->begin(), pos);
+    size_t distance = std::distance(this->cbegin(), pos);
     size_t count = std::distance(first, last);
 
-    this->reallocate_if_needed(this->size_ + 1);
-    this->right_shift(distance);
+    this->reallocate_if_needed(this->size_ + count);
 
-    for (auto it = this->begin() + distance; count != 0;
-         --count, ++it, ++first) {
-      *it = *first;
+    T *position = this->storage + distance;
+    T *old_end = this->storage + this->size_;
+    size_t tail = old_end - position;
+    if (tail > count) {
+      std::uninitialized_move(old_end - count, old_end, old_end);
+      std::move_backward(position, old_end - count, old_end);
+      std::copy(first, last, position);
+    } else {
+      // the new elements reach past the old end
+      InputIt middle = std::next(first, tail);
+      std::uninitialized_copy(middle, last, old_end);
+      std::uninitialized_move(position, old_end, position + count);
+      std::copy(first, middle, position);
     }
+    this->size_ += count;
+    return position;
   }
   constexpr iterator insert(const_iterator pos,
                             std::initializer_list<T> ilist) {
@@ -357,54 +444,55 @@ public:
   // erase
 
   constexpr iterator erase(const_iterator pos) {
-    auto previous = pos;
-    for (auto it = pos + 1; pos != this->end(); ++it) {
-      std::destroy_at(previous);
-      std::construct_at(previous, *it);
-      previous = it;
-    }
-    this->size_ -= 1;
-    return pos;
+    return this->erase(pos, pos + 1);
   }
   constexpr iterator erase(const_iterator first, const_iterator last) {
-    size_t count = last - first;
-    if (count == 0) {
-      return last;
+    iterator position = this->storage + (first - this->storage);
+    if (first == last) {
+      return position;
     }
-
-    auto previous_end = this->end();
-    for (auto it = last; last != previous_end; ++it) {
-      std::destroy_at(first);
-      *(first++) = *it;
-    }
-
-    this->size_ -= count;
-    if (last == previous_end) {
-      return this->end();
-    }
-    return first;
+    iterator tail = this->storage + (last - this->storage);
+    iterator new_end = std::move(tail, this->end(), position);
+    std::destroy(new_end, this->end());
+    this->size_ = static_cast<size_type>(new_end - this->storage);
+    return position;
   }
 
   // push_back
 
-  constexpr void push_back(const T &value) {
-    size_t previous_size = this->size_;
-    this->reallocate_if_needed(previous_size + 1);
-    this->storage[previous_size] = value;
-  }
-  constexpr void push_back(T &&value) {
-    size_t previous_size = this->size_;
-    this->reallocate_if_needed(previous_size + 1);
-    this->storage[previous_size] = std::move(value);
-  }
+  constexpr void push_back(const T &value) { this->emplace_back(value); }
+  constexpr void push_back(T &&value) { this->emplace_back(std::move(value)); }
 
   // emplace_back
 
+  /// `args` may refer to an element of this vector: when the vector grows,
+  /// the new element is constructed before the old buffer is released.
   template <class... Args> constexpr reference emplace_back(Args &&...args) {
+    using traits = std::allocator_traits<Allocator>;
     size_t previous_size = this->size_;
-    this->reallocate_if_needed(previous_size + 1);
-    this->allocator.construct(&this->storage[previous_size],
-                              std::forward<Args>(args)...);
+    if (!this->need_reallocation(previous_size + 1)) {
+      traits::construct(this->allocator, this->storage + previous_size,
+                        std::forward<Args>(args)...);
+    } else {
+      size_t old_capacity = this->capacity_;
+      size_t new_capacity =
+          this->get_new_capacity(previous_size + 1, old_capacity);
+      T *new_storage = this->allocator.allocate(new_capacity);
+      try {
+        traits::construct(this->allocator, new_storage + previous_size,
+                          std::forward<Args>(args)...);
+      } catch (...) {
+        this->allocator.deallocate(new_storage, new_capacity);
+        throw;
+      }
+      detail::relocate(this->storage, previous_size, new_storage);
+      if (this->storage != nullptr) {
+        this->allocator.deallocate(this->storage, old_capacity);
+      }
+      this->storage = new_storage;
+      this->capacity_ = new_capacity;
+    }
+    this->size_ = previous_size + 1;
     return this->storage[previous_size];
   }
 
@@ -417,44 +505,92 @@ public:
   // resize
 
   constexpr void resize(size_type count, const value_type &value) {
-    if (size_t old_capacity = this->capacity_; need_reallocation(count)) {
+    if (count > this->size_) {
       this->reallocate_if_needed(count);
-      for (auto it = this->storage + old_capacity; it != this->end(); ++it) {
-        std::construct_at(it, value);
-      }
+      std::uninitialized_fill(this->end(), this->storage + count, value);
     } else {
-      for (auto it = this->storage + count; it != this->end(); ++it) {
-        std::destroy_at(it);
-      }
-      this->size_ = count;
+      std::destroy(this->storage + count, this->end());
     }
+    this->size_ = count;
   }
   constexpr void resize(size_type count) { this->resize(count, value_type()); }
+
+  /// Grows the vector to `count` elements without initializing the new
+  /// ones and lets `op(data(), count)` fill them in, as
+  /// basic_string::resize_and_overwrite does; op returns the final size,
+  /// which must not exceed `count`.
+  template <class Operation>
+    requires std::is_trivial_v<T>
+  constexpr void resize_and_overwrite(size_type count, Operation op) {
+    this->reallocate_if_needed(count);
+    auto result = std::move(op)(this->storage, count);
+    this->size_ = static_cast<size_type>(result);
+  }
 };
 namespace pmr {
 template <class T>
 using vector = isl::vector<T, std::pmr::polymorphic_allocator<T>>;
 }
 
-template <class T, class Alloc, class U>
-constexpr typename std::vector<T, Alloc>::size_type
-erase(std::vector<T, Alloc> &c, const U &value) {
-  auto iterator = std::remove(c, value);
-  auto distance = std::distance(iterator, c.end());
-
-  c.erase(iterator, distance);
-
-  return distance;
-}
+/// Erases the elements for which `pred` holds in one pass, moving each
+/// kept element at most once, and returns how many were erased.
 template <class T, class Alloc, class Pred>
-constexpr typename std::vector<T, Alloc>::size_type
-erase_if(std::vector<T, Alloc> &c, Pred pred) {
-  auto iterator = std::remove_if(c, pred);
-  auto distance = std::distance(iterator, c.end());
-
-  c.erase(iterator, distance);
+constexpr typename isl::vector<T, Alloc>::size_type
+erase_if(isl::vector<T, Alloc> &c, Pred pred) {
+  T *first = c.data();
+  std::size_t size = c.size();
+  std::size_t kept = 0;
+  if constexpr (detail::compactable<T>) {
+    if (!std::is_constant_evaluated()) {
+      using lane = detail::compact_lane_t<T>;
+      auto *s = reinterpret_cast<lane *>(first);
+      kept = detail::simd::compact(
+          s, size, s, detail::simd::keep_where<lane, T, Pred, false>{pred});
+      c.erase(c.begin() + kept, c.end());
+      return size - kept;
+    }
+  }
+  for (std::size_t i = 0; i != size; ++i) {
+    if (!pred(first[i])) {
+      if (kept != i) {
+        first[kept] = std::move(first[i]);
+      }
+      ++kept;
+    }
+  }
+  c.erase(c.begin() + kept, c.end());
+  return size - kept;
+}
 
-  return distance;
+/// Erases the elements equal to `value` in one pass and returns how many
+/// there were. Vectors of 32- and 64-bit integers and floats are
+/// compacted a SIMD block at a time.
+template <class T, class Alloc, class U>
+constexpr typename isl::vector<T, Alloc>::size_type
+erase(isl::vector<T, Alloc> &c, const U &value) {
+  if constexpr (detail::compactable<T> &&
+                (std::is_same_v<T, U> ||
+                 (std::is_integral_v<T> && std::is_integral_v<U> &&
+                  !std::is_same_v<U, bool>))) {
+    if (!std::is_constant_evaluated()) {
+      using lane = detail::compact_lane_t<T>;
+      // a value out of the element type's range, or NaN, equals nothing
+      auto target = static_cast<T>(value);
+      if (!(target == value)) {
+        return 0;
+      }
+      auto *s = reinterpret_cast<lane *>(c.data());
+      std::size_t size = c.size();
+      std::size_t kept = detail::simd::compact(
+          s, size, s,
+          detail::simd::keep_unequal<lane>{static_cast<lane>(target)});
+      c.erase(c.begin() + kept, c.end());
+      return size - kept;
+    }
+  }
+  return isl::erase_if(c, [&value](const T &element) {
+    return element == value;
+  });
 }
 
 template <class InputIt,